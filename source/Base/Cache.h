@@ -1,9 +1,11 @@
 #pragma once
 
+#include <algorithm>
 #include <unordered_map>
 #include <list>
 #include <optional>
 
+//evicts the least recently used entry, insertions and successful lookups count as usage
 template<typename Key, typename Value, int MaxEntries>
 class Cache
 {
@@ -13,6 +15,8 @@ public:
     std::optional<Value> find(Key const& key);
 
 private:
+    void markAsUsed(Key const& key);
+
     std::unordered_map<Key, Value> _cacheMap;
     std::list<Key> _usedKeys;
 };
@@ -23,7 +27,7 @@ private:
 template <typename Key, typename Value, int MaxEntries>
 void Cache<Key, Value, MaxEntries>::insertOrAssign(Key const& key, Value const& value)
 {
-    if (_cacheMap.size() >= MaxEntries) {
+    if (_cacheMap.size() >= MaxEntries && !_cacheMap.contains(key)) {
         _cacheMap.erase(_usedKeys.front());
         _usedKeys.pop_front();
     }
@@ -31,6 +35,8 @@ void Cache<Key, Value, MaxEntries>::insertOrAssign(Key const& key, Value const&
         auto keyInserted = _cacheMap.insert_or_assign(key, value).second;
         if (keyInserted) {
             _usedKeys.emplace_back(key);
+        } else {
+            markAsUsed(key);
         }
     } catch (...) {
     }
@@ -41,8 +47,18 @@ std::optional<Value> Cache<Key, Value, MaxEntries>::find(Key const& key)
 {
     auto findResult = _cacheMap.find(key);
     if (findResult != _cacheMap.end()) {
+        markAsUsed(key);
         return findResult->second;
     } else {
         return std::nullopt;
     }
 }
+
+template <typename Key, typename Value, int MaxEntries>
+void Cache<Key, Value, MaxEntries>::markAsUsed(Key const& key)
+{
+    auto findResult = std::find(_usedKeys.begin(), _usedKeys.end(), key);
+    if (findResult != _usedKeys.end()) {
+        _usedKeys.splice(_usedKeys.end(), _usedKeys, findResult);
+    }
+}
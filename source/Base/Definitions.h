@@ -24,6 +24,9 @@ using std::uint64_t;
 class _FileLogger;
 using FileLogger = std::shared_ptr<_FileLogger>;
 
+class _DiskCache;
+using DiskCache = std::shared_ptr<_DiskCache>;
+
 constexpr float NEAR_ZERO = 1.0e-4f;
 
 template <typename T>
@@ -0,0 +1,362 @@
+#include "DiskCache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+#include "LoggingService.h"
+
+namespace
+{
+    auto constexpr IndexFilename = "index.json";
+    auto constexpr ContentFileExtension = ".bin";
+    auto constexpr TempFileExtension = ".tmp";
+    char const ContentFileMagic[4] = {'A', 'D', 'C', '1'};
+
+    //FNV-1a, hash values must be stable across program runs, collisions are resolved by comparing the content
+    std::string calcContentHash(std::vector<std::string_view> const& parts)
+    {
+        uint64_t result = 14695981039346656037ull;
+        auto hashBytes = [&](void const* data, size_t size) {
+            auto bytes = static_cast<unsigned char const*>(data);
+            for (size_t i = 0; i < size; ++i) {
+                result = (result ^ bytes[i]) * 1099511628211ull;
+            }
+        };
+        for (auto const& part : parts) {
+            uint64_t partSize = part.size();
+            hashBytes(&partSize, sizeof(partSize));
+            hashBytes(part.data(), part.size());
+        }
+        char buffer[17];
+        std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(result));
+        return buffer;
+    }
+
+    uint64_t calcContentFileSize(std::vector<std::string_view> const& parts)
+    {
+        uint64_t result = sizeof(ContentFileMagic) + sizeof(uint32_t) + parts.size() * sizeof(uint64_t);
+        for (auto const& part : parts) {
+            result += part.size();
+        }
+        return result;
+    }
+}
+
+_DiskCache::_DiskCache(std::filesystem::path const& directory, uint64_t maxBytes)
+    : _directory(directory)
+    , _maxBytes(maxBytes)
+{
+    std::error_code error;
+    std::filesystem::create_directories(_directory, error);
+    loadIndex();
+    evict();
+}
+
+_DiskCache::~_DiskCache()
+{
+    if (_indexModified) {
+        saveIndex();
+    }
+}
+
+std::optional<DiskCacheEntry> _DiskCache::find(std::string const& key, std::string const& version)
+{
+    std::lock_guard lock(_mutex);
+
+    auto findResult = _index.find(key);
+    if (findResult == _index.end()) {
+        return std::nullopt;
+    }
+    auto& indexEntry = findResult->second;
+    if (indexEntry.version && *indexEntry.version != version) {
+        log(Priority::Important, "disk cache: outdated entry for key=" + key + " removed");
+        removeIntern(key);
+        return std::nullopt;
+    }
+    auto result = readContentFile(indexEntry);
+    if (!result) {
+        log(Priority::Important, "disk cache: invalid entry for key=" + key + " removed");
+        removeIntern(key);
+        return std::nullopt;
+    }
+
+    //the index file is not rewritten for each lookup
+    indexEntry.version = version;
+    indexEntry.lastUsed = ++_useCounter;
+    _indexModified = true;
+    return result;
+}
+
+void _DiskCache::insertOrAssign(std::string const& key, std::optional<std::string> const& version, std::vector<std::string_view> const& parts)
+{
+    std::lock_guard lock(_mutex);
+
+    removeIntern(key);
+
+    IndexEntry indexEntry{.version = version, .size = calcContentFileSize(parts), .lastUsed = ++_useCounter};
+
+    //entries with equal content share their file, the content is compared since different contents can have equal hashes
+    auto contentHash = calcContentHash(parts);
+    for (int collisionIndex = 0;; ++collisionIndex) {
+        auto candidate = collisionIndex == 0 ? contentHash : contentHash + "-" + std::to_string(collisionIndex);
+        if (!_numReferencesByContentHash.contains(candidate)) {
+            if (!writeContentFile(candidate, parts)) {
+                return;
+            }
+            indexEntry.contentHash = candidate;
+            break;
+        }
+        auto existingEntry = readContentFile(IndexEntry{.contentHash = candidate, .size = indexEntry.size});
+        if (existingEntry && existingEntry->parts == parts) {
+            indexEntry.contentHash = candidate;
+            break;
+        }
+    }
+
+    addContentReference(indexEntry);
+    _index.emplace(key, indexEntry);
+    evict();
+    saveIndex();
+}
+
+void _DiskCache::remove(std::string const& key)
+{
+    std::lock_guard lock(_mutex);
+
+    removeIntern(key);
+    saveIndex();
+}
+
+uint64_t _DiskCache::getSize() const
+{
+    std::lock_guard lock(_mutex);
+    return _size;
+}
+
+uint64_t _DiskCache::getMaxBytes() const
+{
+    std::lock_guard lock(_mutex);
+    return _maxBytes;
+}
+
+void _DiskCache::setMaxBytes(uint64_t value)
+{
+    std::lock_guard lock(_mutex);
+
+    _maxBytes = value;
+    evict();
+    saveIndex();
+}
+
+std::filesystem::path _DiskCache::getContentFilename(std::string const& contentHash) const
+{
+    return _directory / (contentHash + ContentFileExtension);
+}
+
+bool _DiskCache::writeContentFile(std::string const& contentHash, std::vector<std::string_view> const& parts) const
+{
+    auto filename = getContentFilename(contentHash);
+    auto tempFilename = filename;
+    tempFilename.replace_extension(TempFileExtension);
+    std::error_code error;
+    {
+        std::ofstream stream(tempFilename, std::ios::binary | std::ios::trunc);
+        stream.write(ContentFileMagic, sizeof(ContentFileMagic));
+        uint32_t numParts = static_cast<uint32_t>(parts.size());
+        stream.write(reinterpret_cast<char const*>(&numParts), sizeof(numParts));
+        for (auto const& part : parts) {
+            uint64_t partSize = part.size();
+            stream.write(reinterpret_cast<char const*>(&partSize), sizeof(partSize));
+        }
+        for (auto const& part : parts) {
+            stream.write(part.data(), part.size());
+        }
+        if (!stream) {
+            log(Priority::Important, "disk cache: could not write " + tempFilename.string());
+            std::filesystem::remove(tempFilename, error);
+            return false;
+        }
+    }
+    std::filesystem::rename(tempFilename, filename, error);
+    if (error) {
+        log(Priority::Important, "disk cache: could not write " + filename.string());
+        std::filesystem::remove(tempFilename, error);
+        return false;
+    }
+    return true;
+}
+
+std::optional<DiskCacheEntry> _DiskCache::readContentFile(IndexEntry const& indexEntry) const
+{
+    try {
+        auto filename = getContentFilename(indexEntry.contentHash);
+        std::error_code error;
+        if (std::filesystem::file_size(filename, error) != indexEntry.size || error) {
+            return std::nullopt;
+        }
+        boost::interprocess::file_mapping mapping(filename.string().c_str(), boost::interprocess::read_only);
+        auto region = std::make_shared<boost::interprocess::mapped_region>(mapping, boost::interprocess::read_only);
+        auto data = static_cast<char const*>(region->get_address());
+        auto size = region->get_size();
+
+        //validate header
+        uint64_t pos = sizeof(ContentFileMagic) + sizeof(uint32_t);
+        if (size < pos || std::memcmp(data, ContentFileMagic, sizeof(ContentFileMagic)) != 0) {
+            return std::nullopt;
+        }
+        uint32_t numParts;
+        std::memcpy(&numParts, data + sizeof(ContentFileMagic), sizeof(numParts));
+        if (size < pos + uint64_t(numParts) * sizeof(uint64_t)) {
+            return std::nullopt;
+        }
+        std::vector<uint64_t> partSizes(numParts);
+        std::memcpy(partSizes.data(), data + pos, numParts * sizeof(uint64_t));
+        pos += numParts * sizeof(uint64_t);
+
+        DiskCacheEntry result;
+        for (auto const& partSize : partSizes) {
+            if (partSize > size - pos) {
+                return std::nullopt;
+            }
+            result.parts.emplace_back(data + pos, partSize);
+            pos += partSize;
+        }
+        if (pos != size) {
+            return std::nullopt;
+        }
+        result.storage = region;
+        return result;
+    } catch (...) {
+        return std::nullopt;
+    }
+}
+
+//entries with equal content share their file, hence its size is only counted for the first reference
+void _DiskCache::addContentReference(IndexEntry const& indexEntry)
+{
+    if (++_numReferencesByContentHash[indexEntry.contentHash] == 1) {
+        _size += indexEntry.size;
+    }
+}
+
+void _DiskCache::removeIntern(std::string const& key)
+{
+    auto findResult = _index.find(key);
+    if (findResult == _index.end()) {
+        return;
+    }
+    auto contentHash = findResult->second.contentHash;
+    auto size = findResult->second.size;
+    _index.erase(findResult);
+    _indexModified = true;
+
+    auto referencesFindResult = _numReferencesByContentHash.find(contentHash);
+    if (--referencesFindResult->second == 0) {
+        _numReferencesByContentHash.erase(referencesFindResult);
+        _size -= size;
+
+        //removal fails for files which are still mapped on some platforms, they are cleaned up when the index is loaded again
+        std::error_code error;
+        std::filesystem::remove(getContentFilename(contentHash), error);
+    }
+}
+
+void _DiskCache::evict()
+{
+    if (_size <= _maxBytes) {
+        return;
+    }
+    std::vector<std::pair<uint64_t, std::string>> lastUsedAndKeys;
+    for (auto const& [key, indexEntry] : _index) {
+        lastUsedAndKeys.emplace_back(indexEntry.lastUsed, key);
+    }
+    std::ranges::sort(lastUsedAndKeys);
+    for (auto const& [lastUsed, key] : lastUsedAndKeys) {
+        if (_size <= _maxBytes) {
+            break;
+        }
+        removeIntern(key);
+    }
+}
+
+void _DiskCache::loadIndex()
+{
+    _index.clear();
+    _numReferencesByContentHash.clear();
+    _size = 0;
+    _useCounter = 0;
+    try {
+        boost::property_tree::ptree tree;
+        boost::property_tree::read_json((_directory / IndexFilename).string(), tree);
+        for (auto const& [dummy, subTree] : tree.get_child("entries")) {
+            IndexEntry indexEntry;
+            if (auto version = subTree.get_optional<std::string>("version")) {
+                indexEntry.version = *version;
+            }
+            indexEntry.contentHash = subTree.get<std::string>("content hash");
+            indexEntry.size = subTree.get<uint64_t>("size");
+            indexEntry.lastUsed = subTree.get<uint64_t>("last used");
+
+            std::error_code error;
+            if (std::filesystem::file_size(getContentFilename(indexEntry.contentHash), error) != indexEntry.size || error) {
+                continue;
+            }
+            auto key = subTree.get<std::string>("key");
+            if (_index.contains(key)) {
+                continue;
+            }
+            _useCounter = std::max(_useCounter, indexEntry.lastUsed);
+            addContentReference(indexEntry);
+            _index.emplace(key, indexEntry);
+        }
+    } catch (...) {
+        _index.clear();
+        _numReferencesByContentHash.clear();
+        _size = 0;
+    }
+
+    //remove files which are not referenced
+    std::error_code error;
+    for (auto const& directoryEntry : std::filesystem::directory_iterator(_directory, error)) {
+        auto const& path = directoryEntry.path();
+        auto extension = path.extension().string();
+        if (extension == TempFileExtension || (extension == ContentFileExtension && !_numReferencesByContentHash.contains(path.stem().string()))) {
+            std::filesystem::remove(path, error);
+        }
+    }
+}
+
+void _DiskCache::saveIndex()
+{
+    _indexModified = false;
+    try {
+        boost::property_tree::ptree entriesTree;
+        for (auto const& [key, indexEntry] : _index) {
+            boost::property_tree::ptree subTree;
+            subTree.put("key", key);
+            if (indexEntry.version) {
+                subTree.put("version", *indexEntry.version);
+            }
+            subTree.put("content hash", indexEntry.contentHash);
+            subTree.put("size", indexEntry.size);
+            subTree.put("last used", indexEntry.lastUsed);
+            entriesTree.push_back(std::make_pair("", subTree));
+        }
+        boost::property_tree::ptree tree;
+        tree.add_child("entries", entriesTree);
+
+        auto filename = _directory / IndexFilename;
+        auto tempFilename = filename;
+        tempFilename.replace_extension(TempFileExtension);
+        boost::property_tree::write_json(tempFilename.string(), tree);
+        std::filesystem::rename(tempFilename, filename);
+    } catch (...) {
+        log(Priority::Important, "disk cache: could not write index");
+    }
+}
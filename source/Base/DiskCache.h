@@ -0,0 +1,68 @@
+#pragma once
+
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Definitions.h"
+
+//parts of a cache entry which remain valid as long as the entry exists
+struct DiskCacheEntry
+{
+    std::vector<std::string_view> parts;
+    std::shared_ptr<void const> storage;
+};
+
+/**
+ * Persistent cache for entries consisting of several data parts. Each entry is stored in a file named by the hash of its
+ * content and read via a memory mapping. Entries with equal content share their file. Entries are identified by a key and a version (e.g. a resource id and its
+ * timestamp). If the total size exceeds the byte budget, the least recently used entries are removed.
+ * Changes of the recency by lookups are persisted with the next modification or on destruction.
+ */
+class _DiskCache
+{
+public:
+    _DiskCache(std::filesystem::path const& directory, uint64_t maxBytes);
+    ~_DiskCache();
+
+    //an entry without version matches any version and adopts the version of the first lookup
+    std::optional<DiskCacheEntry> find(std::string const& key, std::string const& version);
+    void insertOrAssign(std::string const& key, std::optional<std::string> const& version, std::vector<std::string_view> const& parts);
+    void remove(std::string const& key);
+
+    uint64_t getSize() const;  //entries with equal content are counted once
+    uint64_t getMaxBytes() const;
+    void setMaxBytes(uint64_t value);
+
+private:
+    struct IndexEntry
+    {
+        std::optional<std::string> version;
+        std::string contentHash;  //names the content file, different contents with equal hash are distinguished by a suffix
+        uint64_t size = 0;
+        uint64_t lastUsed = 0;
+    };
+
+    std::filesystem::path getContentFilename(std::string const& contentHash) const;
+    bool writeContentFile(std::string const& contentHash, std::vector<std::string_view> const& parts) const;
+    std::optional<DiskCacheEntry> readContentFile(IndexEntry const& indexEntry) const;
+
+    void addContentReference(IndexEntry const& indexEntry);
+    void removeIntern(std::string const& key);
+    void evict();
+    void loadIndex();
+    void saveIndex();
+
+    mutable std::mutex _mutex;
+    std::filesystem::path _directory;
+    uint64_t _maxBytes = 0;
+    uint64_t _size = 0;
+    uint64_t _useCounter = 0;
+    std::unordered_map<std::string, IndexEntry> _index;
+    std::unordered_map<std::string, int> _numReferencesByContentHash;
+    bool _indexModified = false;  //true if the index file is outdated
+};
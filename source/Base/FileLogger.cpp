@@ -20,5 +20,10 @@ _FileLogger::~_FileLogger()
 
 void _FileLogger::newLogMessage(Priority priority, std::string const& message)
 {
-    _outfile << message << std::endl;
+    _outfile << message << '\n';
+}
+
+void _FileLogger::flushLogMessages()
+{
+    _outfile.flush();
 }
@@ -13,6 +13,7 @@ public:
     virtual ~_FileLogger();
 
     void newLogMessage(Priority priority, std::string const& message) override;
+    void flushLogMessages() override;
 
 private:
     std::ofstream _outfile;
@@ -0,0 +1,401 @@
+#include "JsonStream.h"
+
+#include <cstdint>
+#include <stdexcept>
+
+namespace
+{
+    auto constexpr MaxDepth = 256;
+
+    class Parser
+    {
+    public:
+        Parser(std::string_view json, JsonReader::ValueCallback const& callback)
+            : _json(json)
+            , _callback(callback)
+        {}
+
+        void parseDocument()
+        {
+            if (_json.starts_with("\xEF\xBB\xBF")) {
+                _pos = 3;
+            }
+            parseValue(true, 0);
+            skipWhitespace();
+            if (_pos != _json.size()) {
+                throwError();
+            }
+        }
+
+    private:
+        void parseValue(bool report, int depth)
+        {
+            if (depth > MaxDepth) {
+                throwError();
+            }
+            skipWhitespace();
+            auto c = peek();
+            if (c == '{') {
+                parseObject(report, depth);
+            } else if (c == '[') {
+                parseArray(depth);
+            } else if (c == '"') {
+                parseString(_value);
+                if (report) {
+                    _callback(_path, _value);
+                }
+            } else {
+                auto start = _pos;
+                if (c == 't') {
+                    expectLiteral("true");
+                } else if (c == 'f') {
+                    expectLiteral("false");
+                } else if (c == 'n') {
+                    expectLiteral("null");
+                } else {
+                    parseNumber();
+                }
+                if (report) {
+                    _callback(_path, _json.substr(start, _pos - start));
+                }
+            }
+        }
+
+        void parseObject(bool report, int depth)
+        {
+            ++_pos;
+            skipWhitespace();
+            if (peek() == '}') {
+                ++_pos;
+                return;
+            }
+            while (true) {
+                skipWhitespace();
+                parseString(_key);
+                skipWhitespace();
+                expect(':');
+
+                auto pathSize = _path.size();
+                if (report) {
+                    if (!_path.empty()) {
+                        _path.push_back('.');
+                    }
+                    _path.append(_key);
+                }
+                parseValue(report, depth + 1);
+                _path.resize(pathSize);
+
+                skipWhitespace();
+                auto c = next();
+                if (c == '}') {
+                    return;
+                }
+                if (c != ',') {
+                    throwError();
+                }
+            }
+        }
+
+        //elements are not reported
+        void parseArray(int depth)
+        {
+            ++_pos;
+            skipWhitespace();
+            if (peek() == ']') {
+                ++_pos;
+                return;
+            }
+            while (true) {
+                parseValue(false, depth + 1);
+                skipWhitespace();
+                auto c = next();
+                if (c == ']') {
+                    return;
+                }
+                if (c != ',') {
+                    throwError();
+                }
+            }
+        }
+
+        void parseString(std::string& result)
+        {
+            result.clear();
+            expect('"');
+            while (true) {
+                auto start = _pos;
+                while (_pos < _json.size() && _json[_pos] != '"' && _json[_pos] != '\\' && static_cast<unsigned char>(_json[_pos]) >= 0x20) {
+                    ++_pos;
+                }
+                result.append(_json.substr(start, _pos - start));
+
+                auto c = next();
+                if (c == '"') {
+                    return;
+                }
+                if (c != '\\') {
+                    throwError();
+                }
+                switch (next()) {
+                case '"':
+                    result.push_back('"');
+                    break;
+                case '\\':
+                    result.push_back('\\');
+                    break;
+                case '/':
+                    result.push_back('/');
+                    break;
+                case 'b':
+                    result.push_back('\b');
+                    break;
+                case 'f':
+                    result.push_back('\f');
+                    break;
+                case 'n':
+                    result.push_back('\n');
+                    break;
+                case 'r':
+                    result.push_back('\r');
+                    break;
+                case 't':
+                    result.push_back('\t');
+                    break;
+                case 'u':
+                    appendCodepoint(result, parseCodepoint());
+                    break;
+                default:
+                    throwError();
+                }
+            }
+        }
+
+        uint32_t parseCodepoint()
+        {
+            auto result = parseHex4();
+            if (result >= 0xDC00 && result <= 0xDFFF) {
+                throwError();
+            }
+            if (result >= 0xD800 && result <= 0xDBFF) {
+                expect('\\');
+                expect('u');
+                auto low = parseHex4();
+                if (low < 0xDC00 || low > 0xDFFF) {
+                    throwError();
+                }
+                result = 0x10000 + ((result - 0xD800) << 10) + (low - 0xDC00);
+            }
+            return result;
+        }
+
+        uint32_t parseHex4()
+        {
+            uint32_t result = 0;
+            for (int i = 0; i < 4; ++i) {
+                auto c = next();
+                result <<= 4;
+                if (c >= '0' && c <= '9') {
+                    result += c - '0';
+                } else if (c >= 'a' && c <= 'f') {
+                    result += c - 'a' + 10;
+                } else if (c >= 'A' && c <= 'F') {
+                    result += c - 'A' + 10;
+                } else {
+                    throwError();
+                }
+            }
+            return result;
+        }
+
+        void appendCodepoint(std::string& result, uint32_t codepoint)
+        {
+            if (codepoint < 0x80) {
+                result.push_back(static_cast<char>(codepoint));
+            } else if (codepoint < 0x800) {
+                result.push_back(static_cast<char>(0xC0 | (codepoint >> 6)));
+                result.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+            } else if (codepoint < 0x10000) {
+                result.push_back(static_cast<char>(0xE0 | (codepoint >> 12)));
+                result.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+                result.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+            } else {
+                result.push_back(static_cast<char>(0xF0 | (codepoint >> 18)));
+                result.push_back(static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F)));
+                result.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+                result.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+            }
+        }
+
+        void parseNumber()
+        {
+            if (peek() == '-') {
+                ++_pos;
+            }
+            if (peek() == '0') {
+                ++_pos;
+            } else {
+                parseDigits();
+            }
+            if (peek() == '.') {
+                ++_pos;
+                parseDigits();
+            }
+            if (peek() == 'e' || peek() == 'E') {
+                ++_pos;
+                if (peek() == '+' || peek() == '-') {
+                    ++_pos;
+                }
+                parseDigits();
+            }
+        }
+
+        void parseDigits()
+        {
+            if (!isDigit(peek())) {
+                throwError();
+            }
+            while (isDigit(peek())) {
+                ++_pos;
+            }
+        }
+
+        void expectLiteral(std::string_view literal)
+        {
+            if (!_json.substr(_pos).starts_with(literal)) {
+                throwError();
+            }
+            _pos += literal.size();
+        }
+
+        void expect(char c)
+        {
+            if (next() != c) {
+                throwError();
+            }
+        }
+
+        void skipWhitespace()
+        {
+            while (_pos < _json.size() && (_json[_pos] == ' ' || _json[_pos] == '\t' || _json[_pos] == '\n' || _json[_pos] == '\r')) {
+                ++_pos;
+            }
+        }
+
+        bool isDigit(char c) const { return c >= '0' && c <= '9'; }
+
+        char peek() const { return _pos < _json.size() ? _json[_pos] : '\0'; }
+
+        char next()
+        {
+            if (_pos >= _json.size()) {
+                throwError();
+            }
+            return _json[_pos++];
+        }
+
+        [[noreturn]] void throwError() const { throw std::runtime_error("Invalid JSON at position " + std::to_string(_pos) + "."); }
+
+        std::string_view _json;
+        JsonReader::ValueCallback const& _callback;
+        size_t _pos = 0;
+
+        std::string _path;
+        std::string _key;
+        std::string _value;
+    };
+}
+
+JsonWriter::JsonWriter(std::string& output)
+    : _output(output)
+{}
+
+void JsonWriter::beginObject(std::string_view key)
+{
+    if (!_hasChildren.empty()) {
+        beginChild(key);
+    }
+    _output.append("{\n");
+    _hasChildren.emplace_back(false);
+}
+
+void JsonWriter::endObject()
+{
+    if (_hasChildren.back()) {
+        _output.push_back('\n');
+    }
+    _hasChildren.pop_back();
+    _output.append(4 * _hasChildren.size(), ' ');
+    _output.push_back('}');
+    if (_hasChildren.empty()) {
+        _output.push_back('\n');
+    }
+}
+
+void JsonWriter::writeValue(std::string_view key, std::string_view value)
+{
+    beginChild(key);
+    _output.push_back('"');
+    appendEscaped(value);
+    _output.push_back('"');
+}
+
+void JsonWriter::beginChild(std::string_view key)
+{
+    if (_hasChildren.back()) {
+        _output.append(",\n");
+    }
+    _hasChildren.back() = true;
+    _output.append(4 * _hasChildren.size(), ' ');
+    _output.push_back('"');
+    appendEscaped(key);
+    _output.append("\": ");
+}
+
+void JsonWriter::appendEscaped(std::string_view text)
+{
+    for (auto c : text) {
+        auto u = static_cast<unsigned char>(c);
+        if (u >= 0x20 && c != '"' && c != '\\' && c != '/') {
+            _output.push_back(c);
+            continue;
+        }
+        switch (c) {
+        case '"':
+            _output.append("\\\"");
+            break;
+        case '\\':
+            _output.append("\\\\");
+            break;
+        case '/':
+            _output.append("\\/");
+            break;
+        case '\b':
+            _output.append("\\b");
+            break;
+        case '\f':
+            _output.append("\\f");
+            break;
+        case '\n':
+            _output.append("\\n");
+            break;
+        case '\r':
+            _output.append("\\r");
+            break;
+        case '\t':
+            _output.append("\\t");
+            break;
+        default: {
+            char const* hexDigits = "0123456789ABCDEF";
+            _output.append("\\u00");
+            _output.push_back(hexDigits[u / 16]);
+            _output.push_back(hexDigits[u % 16]);
+        }
+        }
+    }
+}
+
+void JsonReader::parse(std::string_view json, ValueCallback const& callback)
+{
+    Parser parser(json, callback);
+    parser.parseDocument();
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Writes JSON in the same layout as boost::property_tree::write_json (indentation, escaping, values as strings).
+ * Objects without children must not be written since write_json represents them as empty strings.
+ */
+class JsonWriter
+{
+public:
+    JsonWriter(std::string& output);  //output is appended
+
+    void beginObject(std::string_view key = std::string_view());  //key is ignored for the root object
+    void endObject();  //the root object is terminated by a line break
+
+    void writeValue(std::string_view key, std::string_view value);
+
+private:
+    void beginChild(std::string_view key);
+    void appendEscaped(std::string_view text);
+
+    std::string& _output;
+    std::vector<bool> _hasChildren;  //for each open object
+};
+
+/**
+ * Parses JSON and reports each value with its path (keys separated by '.') as boost::property_tree::read_json would
+ * store it, i.e. numbers and literals by their textual representation. Arrays are skipped.
+ * Throws std::runtime_error for malformed input.
+ */
+class JsonReader
+{
+public:
+    using ValueCallback = std::function<void(std::string_view path, std::string_view value)>;
+
+    static void parse(std::string_view json, ValueCallback const& callback);
+};
@@ -1,41 +1,192 @@
 #include "LoggingService.h"
 
-#include <iostream>
 #include <iomanip>
 #include <ctime>
 #include <sstream>
 #include <algorithm>
 
+namespace
+{
+    int getThreadNumber()
+    {
+        static std::atomic<int> numThreads{0};
+        thread_local int result = ++numThreads;
+        return result;
+    }
+}
+
 LoggingService& LoggingService::getInstance()
 {
     static LoggingService instance;
     return instance;
 }
 
+LoggingService::LoggingService()
+    : _entries(new Entry[QueueSize])
+{
+    for (int i = 0; i < QueueSize; ++i) {
+        _entries[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    _thread = std::thread(&LoggingService::runThreadLoop, this);
+}
+
+LoggingService::~LoggingService()
+{
+    _isShutdown = true;
+    _wakeupCounter.fetch_add(1);
+    _wakeupCounter.notify_one();
+    _thread.join();
+}
+
 void LoggingService::log(Priority priority, std::string const& message)
 {
-    std::lock_guard<std::mutex> lock(_mutex);
+    if (priority < _minPriority.load(std::memory_order_relaxed)) {
+        return;
+    }
 
-    auto t = std::time(nullptr);
-    auto tm = *std::localtime(&t);
+    //claim an entry (bounded MPMC queue by D. Vyukov, used with a single consumer)
+    auto pos = _enqueuePos.load(std::memory_order_relaxed);
+    Entry* entry;
+    while (true) {
+        entry = &_entries[pos & (QueueSize - 1)];
+        auto sequence = entry->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+        if (diff == 0) {
+            if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            _numDroppedMessages.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } else {
+            pos = _enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
 
-    std::stringstream stream;
-    stream << std::put_time(&tm, "%Y-%m-%d %H-%M-%S") << ": " << message;
+    entry->priority = priority;
+    entry->time = std::chrono::system_clock::now();
+    entry->threadNumber = getThreadNumber();
+    entry->message = message;  //reuses the capacity of earlier messages in this entry
+    entry->sequence.store(pos + 1, std::memory_order_release);
 
-    auto enrichedMessage = stream.str();
-    for (auto const& callback : _callbacks) {
-        callback->newLogMessage(priority, enrichedMessage);
+    //the writer thread sets _isWriterIdle before it reads the counter it waits on, so an increment is either seen
+    //by the writer or the writer is seen as idle here
+    _wakeupCounter.fetch_add(1);
+    if (_isWriterIdle.load()) {
+        _wakeupCounter.notify_one();
     }
 }
 
+void LoggingService::setMinPriority(Priority value)
+{
+    _minPriority = value;
+}
+
+uint64_t LoggingService::getNumDroppedMessages() const
+{
+    return _numDroppedMessages.load();
+}
+
+void LoggingService::flush()
+{
+    auto numEntries = _enqueuePos.load();
+    std::unique_lock lock(_flushMutex);
+    _flushCondition.wait(lock, [&] { return _numProcessedEntries >= numEntries; });
+}
+
 void LoggingService::registerCallBack(LoggingCallBack* callback)
 {
+    flush();
+
+    std::lock_guard lock(_callbackMutex);
     _callbacks.emplace_back(callback);
 }
 
 void LoggingService::unregisterCallBack(LoggingCallBack* callback)
 {
+    flush();
+
+    std::lock_guard lock(_callbackMutex);
     auto end = std::remove_if(_callbacks.begin(), _callbacks.end(), [&](auto const& callback_) { return callback_ == callback; });
 
     _callbacks.erase(end, _callbacks.end());
 }
+
+void LoggingService::runThreadLoop()
+{
+    while (true) {
+        if (deliverPendingMessages()) {
+            continue;
+        }
+
+        //the queue is checked again after announcing the idle state since loggers may not have notified before
+        _isWriterIdle = true;
+        auto wakeupCounter = _wakeupCounter.load();
+        if (!deliverPendingMessages()) {
+            if (_isShutdown) {
+                return;
+            }
+            _wakeupCounter.wait(wakeupCounter);
+        }
+        _isWriterIdle = false;
+    }
+}
+
+bool LoggingService::deliverPendingMessages()
+{
+    std::unique_lock callbackLock(_callbackMutex);
+
+    auto formatMessage = [](std::chrono::system_clock::time_point const& timepoint, int threadNumber, std::string const& message) {
+        auto t = std::chrono::system_clock::to_time_t(timepoint);
+        auto tm = *std::localtime(&t);
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(timepoint.time_since_epoch()).count() % 1000;
+
+        std::stringstream stream;
+        stream << std::put_time(&tm, "%Y-%m-%d %H-%M-%S") << "." << std::setw(3) << std::setfill('0') << ms << " [thread " << threadNumber
+               << "]: " << message;
+        return stream.str();
+    };
+
+    //the batch size is limited such that waiting flushes are not starved by continuous logging
+    auto numDelivered = 0;
+    while (numDelivered < QueueSize) {
+        auto& entry = _entries[_dequeuePos & (QueueSize - 1)];
+        if (entry.sequence.load(std::memory_order_acquire) != _dequeuePos + 1) {
+            break;
+        }
+        auto enrichedMessage = formatMessage(entry.time, entry.threadNumber, entry.message);
+        auto priority = entry.priority;
+        entry.sequence.store(_dequeuePos + QueueSize, std::memory_order_release);
+        ++_dequeuePos;
+
+        for (auto const& callback : _callbacks) {
+            callback->newLogMessage(priority, enrichedMessage);
+        }
+        ++numDelivered;
+    }
+
+    auto numDroppedMessages = _numDroppedMessages.load();
+    if (numDroppedMessages != _numReportedDroppedMessages) {
+        auto message = std::to_string(numDroppedMessages - _numReportedDroppedMessages) + " log messages dropped due to full queue";
+        _numReportedDroppedMessages = numDroppedMessages;
+        auto enrichedMessage = formatMessage(std::chrono::system_clock::now(), getThreadNumber(), message);
+        for (auto const& callback : _callbacks) {
+            callback->newLogMessage(Priority::Important, enrichedMessage);
+        }
+        ++numDelivered;
+    }
+
+    if (numDelivered > 0) {
+        for (auto const& callback : _callbacks) {
+            callback->flushLogMessages();
+        }
+    }
+    callbackLock.unlock();
+
+    {
+        std::lock_guard lock(_flushMutex);
+        _numProcessedEntries = _dequeuePos;
+    }
+    _flushCondition.notify_all();
+    return numDelivered > 0;
+}
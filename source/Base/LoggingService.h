@@ -1,8 +1,13 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
-#include <mutex>
 
 enum class Priority
 {
@@ -10,12 +15,19 @@ enum class Priority
     Important,
 };
 
+//call backs are invoked on the writer thread of LoggingService
 class LoggingCallBack
 {
 public:
     virtual void newLogMessage(Priority priority, std::string const& message) = 0;
+    virtual void flushLogMessages() {}  //called after each batch of messages
 };
 
+/**
+ * Log messages are put into a bounded lock-free queue and delivered to the call backs in batches by a background
+ * thread. Callers are not blocked by the call backs; if the queue is full, messages are dropped and counted.
+ * Messages are formatted with time stamp and thread number on the writer thread.
+ */
 class LoggingService
 {
 public:
@@ -23,17 +35,57 @@ public:
 
     void log(Priority priority, std::string const& message);
 
+    void setMinPriority(Priority value);  //messages with lower priority are discarded before queuing
+    uint64_t getNumDroppedMessages() const;
+
+    //blocks until all messages logged before have been delivered to the call backs
+    void flush();
+
+    //pending messages are delivered before registration and unregistration, i.e. a call back only receives messages
+    //logged while it is registered
     void registerCallBack(LoggingCallBack* callback);
     void unregisterCallBack(LoggingCallBack* callback);
 
 private:
-    LoggingService() = default;
+    LoggingService();
+    ~LoggingService();
+
+    struct Entry
+    {
+        std::atomic<uint64_t> sequence;
+        Priority priority = Priority::Unimportant;
+        std::chrono::system_clock::time_point time;
+        int threadNumber = 0;
+        std::string message;
+    };
+
+    void runThreadLoop();
+    bool deliverPendingMessages();
 
+    static int constexpr QueueSize = 8192;  //must be a power of 2
+
+    std::unique_ptr<Entry[]> _entries;
+    std::atomic<uint64_t> _enqueuePos{0};
+    uint64_t _dequeuePos = 0;  //only accessed by the writer thread
+    std::atomic<uint32_t> _wakeupCounter{0};
+    std::atomic<bool> _isWriterIdle{false};  //loggers only notify the writer thread if it may be waiting
+
+    std::atomic<Priority> _minPriority{Priority::Unimportant};
+    std::atomic<uint64_t> _numDroppedMessages{0};
+    uint64_t _numReportedDroppedMessages = 0;
+
+    std::mutex _callbackMutex;
     std::vector<LoggingCallBack*> _callbacks;
-    std::mutex _mutex;
+
+    std::mutex _flushMutex;
+    std::condition_variable _flushCondition;
+    uint64_t _numProcessedEntries = 0;  //guarded by _flushMutex
+
+    std::atomic<bool> _isShutdown{false};
+    std::thread _thread;
 };
 
 inline void log(Priority priority, std::string const& message)
 {
     LoggingService::getInstance().log(priority, message);
-}
\ No newline at end of file
+}
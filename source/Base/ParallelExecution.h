@@ -0,0 +1,87 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ParallelExecution
+{
+public:
+    static int getNumThreads();
+
+    //calls func(index) for all index in [0, numItems) on multiple threads, the first thrown exception is rethrown
+    template <typename Func>
+    static void forEach(size_t numItems, Func const& func, int maxThreads = 0);
+
+    //same as forEach, but the items are distributed in chunks to the threads in order to keep the scheduling overhead small
+    template <typename Func>
+    static void forEachInChunks(size_t numItems, size_t chunkSize, Func const& func, int maxThreads = 0);
+};
+
+/************************************************************************/
+/* Implementation                                                       */
+/************************************************************************/
+inline int ParallelExecution::getNumThreads()
+{
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+template <typename Func>
+void ParallelExecution::forEach(size_t numItems, Func const& func, int maxThreads)
+{
+    auto numThreads = std::min(static_cast<size_t>(maxThreads > 0 ? maxThreads : getNumThreads()), numItems);
+    if (numThreads <= 1) {
+        for (size_t index = 0; index < numItems; ++index) {
+            func(index);
+        }
+        return;
+    }
+
+    std::atomic<size_t> nextIndex = 0;
+    std::exception_ptr exception;
+    std::mutex exceptionMutex;
+    auto worker = [&] {
+        for (auto index = nextIndex++; index < numItems; index = nextIndex++) {
+            try {
+                func(index);
+            } catch (...) {
+                std::lock_guard lock(exceptionMutex);
+                if (!exception) {
+                    exception = std::current_exception();
+                }
+                nextIndex = numItems;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1);
+    for (size_t i = 1; i < numThreads; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+template <typename Func>
+void ParallelExecution::forEachInChunks(size_t numItems, size_t chunkSize, Func const& func, int maxThreads)
+{
+    auto numChunks = (numItems + chunkSize - 1) / chunkSize;
+    forEach(
+        numChunks,
+        [&](size_t chunkIndex) {
+            auto endIndex = std::min(numItems, (chunkIndex + 1) * chunkSize);
+            for (auto index = chunkIndex * chunkSize; index < endIndex; ++index) {
+                func(index);
+            }
+        },
+        maxThreads);
+}
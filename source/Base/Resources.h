@@ -11,6 +11,7 @@ namespace Const
     std::string const AutosaveFileWithoutPath = "autosave.sim";
     std::string const AutosaveFile = BasePath + AutosaveFileWithoutPath;
     std::string const SettingsFilename = BasePath + "settings.json";
+    std::string const DownloadCacheDirectory = BasePath + "download cache";
 
     std::string const SimulationFragmentShader = BasePath + "shader.fs";
     std::string const SimulationVertexShader = BasePath + "shader.vs";
@@ -0,0 +1,103 @@
+#include "ThreadPool.h"
+
+#include "ParallelExecution.h"
+
+ThreadPool::ThreadPool(int numThreads)
+{
+    auto numAdditionalThreads = (numThreads > 0 ? numThreads : ParallelExecution::getNumThreads()) - 1;
+    for (int i = 0; i < numAdditionalThreads; ++i) {
+        _threads.emplace_back(&ThreadPool::runThreadLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(_mutex);
+        _shutdown = true;
+    }
+    _jobAvailable.notify_all();
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+}
+
+int ThreadPool::getNumThreads() const
+{
+    return static_cast<int>(_threads.size()) + 1;
+}
+
+void ThreadPool::run(size_t numChunks, std::function<void(size_t)> const& chunkFunc)
+{
+    if (_threads.empty() || numChunks <= 1) {
+        for (size_t chunkIndex = 0; chunkIndex < numChunks; ++chunkIndex) {
+            chunkFunc(chunkIndex);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard lock(_mutex);
+        _chunkFunc = &chunkFunc;
+        _numChunks = numChunks;
+        _nextChunk = 0;
+        _exception = nullptr;
+        _numBusyThreads = static_cast<int>(_threads.size());
+        ++_jobId;
+    }
+    _jobAvailable.notify_all();
+
+    processChunks();
+
+    std::exception_ptr exception;
+    {
+        std::unique_lock lock(_mutex);
+        _jobFinished.wait(lock, [this] { return _numBusyThreads == 0; });
+        _chunkFunc = nullptr;
+        std::swap(exception, _exception);
+    }
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+void ThreadPool::runThreadLoop()
+{
+    uint64_t processedJobId = 0;
+    while (true) {
+        {
+            std::unique_lock lock(_mutex);
+            _jobAvailable.wait(lock, [&] { return _shutdown || _jobId != processedJobId; });
+            if (_shutdown) {
+                return;
+            }
+            processedJobId = _jobId;
+        }
+
+        processChunks();
+
+        auto isLastThread = false;
+        {
+            std::lock_guard lock(_mutex);
+            isLastThread = --_numBusyThreads == 0;
+        }
+        if (isLastThread) {
+            _jobFinished.notify_one();
+        }
+    }
+}
+
+void ThreadPool::processChunks()
+{
+    for (auto chunkIndex = _nextChunk++; chunkIndex < _numChunks; chunkIndex = _nextChunk++) {
+        try {
+            (*_chunkFunc)(chunkIndex);
+        } catch (...) {
+            std::lock_guard lock(_mutex);
+            if (!_exception) {
+                _exception = std::current_exception();
+            }
+            _nextChunk = _numChunks;
+        }
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Threads which are kept alive for a sequence of parallel loops, e.g. for the phases of every time step of a simulation.
+ * In contrast to ParallelExecution, no threads are created per loop. The calling thread takes part in each loop.
+ * The loops of one pool must not be started concurrently.
+ */
+class ThreadPool
+{
+public:
+    ThreadPool(int numThreads = 0);  //0 = number of hardware threads
+    ~ThreadPool();
+
+    ThreadPool(ThreadPool const&) = delete;
+    void operator=(ThreadPool const&) = delete;
+
+    int getNumThreads() const;
+
+    //calls func(index) for all index in [0, numItems) distributed in chunks to the threads, the first thrown exception is rethrown
+    template <typename Func>
+    void forEachInChunks(size_t numItems, size_t chunkSize, Func const& func);
+
+private:
+    void run(size_t numChunks, std::function<void(size_t)> const& chunkFunc);
+    void runThreadLoop();
+    void processChunks();
+
+    std::vector<std::thread> _threads;
+
+    std::mutex _mutex;
+    std::condition_variable _jobAvailable;
+    std::condition_variable _jobFinished;
+    uint64_t _jobId = 0;
+    int _numBusyThreads = 0;
+    bool _shutdown = false;
+
+    std::function<void(size_t)> const* _chunkFunc = nullptr;
+    size_t _numChunks = 0;
+    std::atomic<size_t> _nextChunk = 0;
+    std::exception_ptr _exception;
+};
+
+/************************************************************************/
+/* Implementation                                                       */
+/************************************************************************/
+template <typename Func>
+void ThreadPool::forEachInChunks(size_t numItems, size_t chunkSize, Func const& func)
+{
+    auto numChunks = (numItems + chunkSize - 1) / chunkSize;
+    run(numChunks, [&](size_t chunkIndex) {
+        auto endIndex = std::min(numItems, (chunkIndex + 1) * chunkSize);
+        for (auto index = chunkIndex * chunkSize; index < endIndex; ++index) {
+            func(index);
+        }
+    });
+}
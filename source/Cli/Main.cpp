@@ -1,5 +1,9 @@
 #include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 
 #include "CLI/CLI.hpp"
 
@@ -8,9 +12,15 @@
 #include "Base/Resources.h"
 #include "Base/StringHelper.h"
 #include "Base/FileLogger.h"
+#include "EngineInterface/MappedSimulationFile.h"
+#include "EngineInterface/PatternAnalysisService.h"
 #include "EngineInterface/SerializerService.h"
+#include "EngineInterface/SoftwareRenderingService.h"
+#include "EngineImpl/ControlServer.h"
 #include "EngineImpl/SimulationControllerImpl.h"
 
+#include "SweepService.h"
+
 int main(int argc, char** argv)
 {
     try {
@@ -23,21 +33,160 @@ int main(int argc, char** argv)
         std::string outputFilename;
         std::string statisticsFilename;
         int timesteps = 0;
+        std::vector<float> region;
+        std::string sweepFilename;
+        std::string analysisFilename;
+        bool cpu = false;
+        bool uncompressed = false;
+        std::string framesDirectory;
+        std::string videoFilename;
+        int frameInterval = 1000;
+        std::vector<float> viewCenter;
+        float zoom = 0;
+        std::vector<int> imageSize = {1280, 720};
+        std::string controlSocketPath;
+        std::string controlSaveDirectory = ".";
         app.add_option(
             "-i", inputFilename, "Specifies the name of the input file for the simulation to run. The corresponding *.settings.json should also be available.");
         app.add_option(
             "-o",
             outputFilename,
             "Specifies the name of the output file for the simulation. The *.settings.json and *.statistics.csv file will also be saved.");
-        app.add_option("-t", timesteps, "The number of time steps to be calculated.");
+        app.add_option("-t", timesteps, "The number of time steps to be calculated. With --control-socket, 0 means until a shutdown request.");
+        app.add_option(
+               "-r",
+               region,
+               "Prints a summary of the content inside the rectangle given by x1 y1 x2 y2 without running the simulation. Only the requested region of "
+               "the input file is decoded. If the *.settings.json is available, the rectangle wraps around the world boundaries.")
+            ->expected(4);
+        app.add_option(
+            "-s",
+            sweepFilename,
+            "Specifies a JSON file describing a parameter sweep over a base simulation. The runs are written with checkpoints to the given output "
+            "directory and interrupted sweeps are resumed from the latest checkpoints. The options -i, -o and -t are ignored in this case.");
+        app.add_option(
+            "-a",
+            analysisFilename,
+            "Searches for repetitive cell networks in the input file without running the simulation. A summary is written to the specified file and "
+            "the representative cell networks are saved in the same directory.");
+        app.add_option(
+            "--statistics",
+            statisticsFilename,
+            "Appends the statistics in full resolution to the specified CSV file while the simulation is running. In contrast to the *.statistics.csv "
+            "of the output, older data points are not downsampled.");
+        app.add_flag(
+            "--uncompressed",
+            uncompressed,
+            "Writes the simulation data of the output file without compression. The file is larger but regions can be queried with -r without "
+            "decompressing the whole file.");
+
+        //not listed in the help since the results are not comparable to GPU runs, see _CpuSimulation
+        app.add_flag("--experimental-cpu", cpu)->group("");
+
+        //internal option for the processes of parallel sweep runs
+        int sweepRunIndex = -1;
+        app.add_option("--sweep-run", sweepRunIndex)->group("");
+        app.add_option(
+            "--frames",
+            framesDirectory,
+            "Renders the simulation on the host at the start and every --frame-interval time steps and saves the images as PNG files in the specified "
+            "directory.");
+        app.add_option(
+            "--video",
+            videoFilename,
+            "Renders the simulation as with --frames and writes the images as a raw RGBA video stream (without header) to the specified file, e.g. "
+            "for encoding with ffmpeg -f rawvideo -pixel_format rgba -video_size 1280x720 -i <file>.");
+        app.add_option("--frame-interval", frameInterval, "The number of time steps between two rendered frames.")->check(CLI::PositiveNumber);
+        app.add_option("--view-center", viewCenter, "The world position x y of the image center for rendered frames. Default is the world center.")
+            ->expected(2);
+        app.add_option("--zoom", zoom, "The number of pixels per world unit for rendered frames. Default is a zoom such that the whole world is visible.");
+        app.add_option("--image-size", imageSize, "The width and height of rendered frames.")->expected(2)->check(CLI::PositiveNumber);
+        app.add_option(
+            "--control-socket",
+            controlSocketPath,
+            "Listens on a Unix domain socket at the specified path for requests to pause, resume, change parameters, save and stream statistics "
+            "while the simulation is running. The socket is only accessible by the current user. See EngineImpl/ControlServer.h for the protocol.");
+        app.add_option(
+            "--control-save-directory",
+            controlSaveDirectory,
+            "The directory in which save requests of the control socket are written. Filenames of save requests are relative to this directory.");
         CLI11_PARSE(app, argc, argv);
 
+        if (cpu) {
+            if (!sweepFilename.empty() || !controlSocketPath.empty()) {
+                std::cout << "The experimental CPU backend is not available for sweeps and the control socket." << std::endl;
+                return 1;
+            }
+            std::cout << "Warning: the experimental CPU backend only simulates a subset of the physics. The results are not comparable to GPU runs."
+                      << std::endl;
+        }
+
+        //run sweep
+        if (!sweepFilename.empty()) {
+            auto specification = SweepService::readSpecification(sweepFilename);
+            if (sweepRunIndex != -1) {
+                auto result = SweepService::runSingleVariant(specification, sweepRunIndex);
+                return result.state == SweepRunState_Failed ? 1 : 0;
+            }
+            std::cout << "Start sweep with " << specification.variants.size() << " runs" << std::endl;
+            auto executable = std::filesystem::path(argv[0]);
+            if (executable.has_parent_path()) {
+                executable = std::filesystem::absolute(executable);
+            }
+            auto results = SweepService::runSweep(specification, executable.string());
+            SweepService::printSummary(specification, results);
+            auto summaryFilename = (std::filesystem::path(specification.outputDirectory) / "summary.csv").string();
+            if (!SweepService::writeSummary(summaryFilename, specification, results)) {
+                std::cout << "Could not write summary." << std::endl;
+                return 1;
+            }
+            auto failed = std::any_of(results.begin(), results.end(), [](auto const& result) { return result.state == SweepRunState_Failed; });
+            return failed ? 1 : 0;
+        }
+
         //read input
         std::cout << "Reading input" << std::endl;
         if (inputFilename.empty()) {
             std::cout << "No input file given." << std::endl;
             return 1;
         }
+
+        //inspect region
+        if (!region.empty()) {
+            //the region wraps around the world boundaries if the world size is known from the settings file
+            std::optional<IntVector2D> worldSize;
+            AuxiliaryData auxiliaryData;
+            if (SerializerService::deserializeAuxiliaryDataFromFiles(auxiliaryData, inputFilename)) {
+                worldSize = IntVector2D{auxiliaryData.generalSettings.worldSizeX, auxiliaryData.generalSettings.worldSizeY};
+            }
+            auto file = std::make_shared<_MappedSimulationFile>(inputFilename, worldSize);
+            auto data = file->getData(RealRect{{region.at(0), region.at(1)}, {region.at(2), region.at(3)}});
+            std::cout << "Total: " << StringHelper::format(file->getNumClusters()) << " clusters, " << StringHelper::format(file->getNumCells())
+                      << " cells, " << StringHelper::format(file->getNumParticles()) << " particles" << std::endl;
+            std::cout << "Region: " << StringHelper::format(data.clusters.size()) << " clusters, "
+                      << StringHelper::format(data.getNumberOfCellAndParticles()) << " cells and particles" << std::endl;
+            return 0;
+        }
+
+        //analyze patterns
+        if (!analysisFilename.empty()) {
+            ClusteredDataDescription data;
+            if (!SerializerService::deserializeContentFromFile(data, inputFilename)) {
+                std::cout << "Could not read from input file." << std::endl;
+                return 1;
+            }
+            auto startTimepoint = std::chrono::steady_clock::now();
+            auto patterns = PatternAnalysisService::calcRepetitivePatterns(data);
+            auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint).count();
+            std::cout << "Analysis finished: " << StringHelper::format(patterns.size()) << " repetitive cell networks in "
+                      << StringHelper::format(data.clusters.size()) << " clusters found, " << StringHelper::format(ms) << " ms" << std::endl;
+            if (!PatternAnalysisService::savePatternsToFiles(analysisFilename, patterns)) {
+                std::cout << "Could not write analysis result." << std::endl;
+                return 1;
+            }
+            return 0;
+        }
+
         DeserializedSimulation simData;
         if (!SerializerService::deserializeSimulationFromFiles(simData, inputFilename)) {
             std::cout << "Could not read from input files." << std::endl;
@@ -47,7 +196,7 @@ int main(int argc, char** argv)
         //run simulation
         auto startTimepoint = std::chrono::steady_clock::now();
 
-        auto simController = std::make_shared<_SimulationControllerImpl>();
+        auto simController = std::make_shared<_SimulationControllerImpl>(cpu ? SimulationBackend_Cpu : SimulationBackend_Gpu);
         simController->newSimulation(simData.auxiliaryData.timestep, simData.auxiliaryData.generalSettings, simData.auxiliaryData.simulationParameters);
         simController->setClusteredSimulationData(simData.mainData);
         simController->setStatisticsHistory(simData.statistics);
@@ -55,11 +204,120 @@ int main(int argc, char** argv)
         std::cout << "Device: " << simController->getGpuName() << std::endl;
         std::cout << "Start simulation" << std::endl;
 
-        simController->calcTimesteps(timesteps);
+        //prepare rendering
+        auto renderFrames = !framesDirectory.empty() || !videoFilename.empty();
+        auto viewport = SoftwareRenderingService::calcViewportForWorld(simController->getWorldSize(), {imageSize.at(0), imageSize.at(1)});
+        if (!viewCenter.empty()) {
+            viewport.center = {viewCenter.at(0), viewCenter.at(1)};
+        }
+        if (zoom > 0) {
+            viewport.zoom = zoom;
+        }
+        if (!framesDirectory.empty()) {
+            std::filesystem::create_directories(framesDirectory);
+        }
+        std::ofstream videoStream;
+        if (!videoFilename.empty()) {
+            videoStream.open(videoFilename, std::ios::binary);
+            if (!videoStream) {
+                std::cout << "Could not open video file." << std::endl;
+                return 1;
+            }
+        }
+        auto writeFrame = [&] {
+            auto timestep = simController->getCurrentTimestep();
+            auto image = SoftwareRenderingService::render(
+                simController->getSimulationData(), simController->getWorldSize(), timestep, simController->getSimulationParameters(), viewport);
+            if (!framesDirectory.empty()) {
+                std::stringstream filename;
+                filename << "frame " << std::setw(10) << std::setfill('0') << timestep << ".png";
+                if (!SoftwareRenderingService::writePng((std::filesystem::path(framesDirectory) / filename.str()).string(), image)) {
+                    return false;
+                }
+            }
+            if (!videoFilename.empty()) {
+                return SoftwareRenderingService::writeRawFrame(videoStream, image);
+            }
+            return true;
+        };
+        if (renderFrames && !writeFrame()) {
+            std::cout << "Could not write frame." << std::endl;
+            return 1;
+        }
+
+        auto sequenceNumber = simController->getStatisticsHistory().getSnapshot()->getNextSequenceNumber();
+        auto appendStatistics = [&] {
+            if (statisticsFilename.empty()) {
+                return true;
+            }
+            auto snapshot = simController->getStatisticsHistory().getSnapshot();
+            if (!SerializerService::appendStatisticsToFile(statisticsFilename, snapshot->getFullResolutionData(sequenceNumber))) {
+                return false;
+            }
+            sequenceNumber = snapshot->getNextSequenceNumber();
+            return true;
+        };
+
+        auto startTimestep = simController->getCurrentTimestep();
+        if (!controlSocketPath.empty()) {
+
+            //the simulation runs on the worker thread such that it can be paused and resumed via the control socket,
+            //control requests are executed in this loop since the simulation controller is only accessed from this thread
+            auto constexpr PollInterval = std::chrono::milliseconds(20);
+            auto controlServer = std::make_shared<_ControlServer>(simController, controlSocketPath, controlSaveDirectory);
+            auto nextFrameTimestep = startTimestep + frameInterval;
+            simController->runSimulation();
+            while (!controlServer->isShutdownRequested() && (timesteps == 0 || simController->getCurrentTimestep() < startTimestep + timesteps)) {
+                controlServer->processRequests(PollInterval);
+                if (!appendStatistics()) {
+                    std::cout << "Could not write to statistics file." << std::endl;
+                    return 1;
+                }
+                if (renderFrames && simController->getCurrentTimestep() >= nextFrameTimestep) {
+                    if (!writeFrame()) {
+                        std::cout << "Could not write frame." << std::endl;
+                        return 1;
+                    }
+                    while (nextFrameTimestep <= simController->getCurrentTimestep()) {
+                        nextFrameTimestep += frameInterval;
+                    }
+                }
+            }
+            simController->pauseSimulation();
+            if (!appendStatistics()) {
+                std::cout << "Could not write to statistics file." << std::endl;
+                return 1;
+            }
+        } else {
+
+            //the batches are small enough such that no data points leave the full resolution tier of the statistics history
+            auto constexpr StatisticsBatchSize = 5000;
+            for (int timestep = 0; timestep < timesteps;) {
+                auto batchSize = timesteps - timestep;
+                if (!statisticsFilename.empty()) {
+                    batchSize = std::min(batchSize, StatisticsBatchSize);
+                }
+                if (renderFrames) {
+                    batchSize = std::min(batchSize, frameInterval - timestep % frameInterval);
+                }
+                simController->calcTimesteps(batchSize);
+                timestep += batchSize;
+
+                if (!appendStatistics()) {
+                    std::cout << "Could not write to statistics file." << std::endl;
+                    return 1;
+                }
+                if (renderFrames && timestep % frameInterval == 0 && !writeFrame()) {
+                    std::cout << "Could not write frame." << std::endl;
+                    return 1;
+                }
+            }
+        }
+        auto calculatedTimesteps = simController->getCurrentTimestep() - startTimestep;
 
         auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint).count();
-        auto tps = ms != 0 ? 1000.0f * toFloat(timesteps) / toFloat(ms) : 0.0f; 
-        std::cout << "Simulation finished: " << StringHelper::format(timesteps) << " time steps, " << StringHelper::format(ms) << " ms, "
+        auto tps = ms != 0 ? 1000.0f * toFloat(calculatedTimesteps) / toFloat(ms) : 0.0f; 
+        std::cout << "Simulation finished: " << StringHelper::format(calculatedTimesteps) << " time steps, " << StringHelper::format(ms) << " ms, "
                   << StringHelper::format(tps, 1) << " TPS" << std::endl;
         
 
@@ -74,7 +332,7 @@ int main(int argc, char** argv)
             std::cout << "No output file given." << std::endl;
             return 1;
         }
-        if (!SerializerService::serializeSimulationToFiles(outputFilename, simData)) {
+        if (!SerializerService::serializeSimulationToFiles(outputFilename, simData, uncompressed ? DataFormat::ColumnarUncompressed : DataFormat::Columnar)) {
             std::cout << "Could not write to output files." << std::endl;
             return 1;
         }
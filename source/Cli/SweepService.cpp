@@ -0,0 +1,438 @@
+#include "SweepService.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <thread>
+
+#include <boost/property_tree/json_parser.hpp>
+
+#include "Base/StringHelper.h"
+#include "EngineInterface/AuxiliaryDataParserService.h"
+#include "EngineInterface/SerializerService.h"
+
+namespace
+{
+    std::string const CheckpointPrefix = "checkpoint_";
+    std::string const ResultFilename = "result.sim";
+    std::string const RunStateFilename = "run.json";  //written last, indicates a complete result if the state is completed or resumed
+    int const NumCheckpointsToKeep = 2;  //older checkpoint is kept in case the latest one is incomplete
+
+    std::mutex outputMutex;
+
+    void printMessage(int runIndex, std::string const& message)
+    {
+        std::lock_guard lock(outputMutex);
+        std::cout << "Run " << runIndex << ": " << message << std::endl;
+    }
+
+    std::string getRunName(int runIndex)
+    {
+        std::stringstream stream;
+        stream << "run_" << std::setw(4) << std::setfill('0') << runIndex;
+        return stream.str();
+    }
+
+    std::filesystem::path getCheckpointFilename(std::filesystem::path const& runDirectory, uint64_t timestep)
+    {
+        std::stringstream stream;
+        stream << CheckpointPrefix << std::setw(12) << std::setfill('0') << timestep << ".sim";
+        return runDirectory / stream.str();
+    }
+
+    //checkpoints sorted descending by time step
+    std::vector<std::filesystem::path> getCheckpointFilenames(std::filesystem::path const& runDirectory)
+    {
+        std::vector<std::filesystem::path> result;
+        if (!std::filesystem::exists(runDirectory)) {
+            return result;
+        }
+        for (auto const& entry : std::filesystem::directory_iterator(runDirectory)) {
+            auto filename = entry.path().filename().string();
+            if (filename.starts_with(CheckpointPrefix) && entry.path().extension() == ".sim") {
+                result.emplace_back(entry.path());
+            }
+        }
+        std::sort(result.begin(), result.end(), std::greater<>());
+        return result;
+    }
+
+    void removeSimulationFiles(std::filesystem::path const& filename)
+    {
+        for (auto const& extension : {".sim", ".settings.json", ".statistics.csv"}) {
+            auto path = filename;
+            path.replace_extension(extension);
+            std::filesystem::remove(path);
+        }
+    }
+
+    std::string getVariantString(std::map<std::string, std::string> const& variant)
+    {
+        std::string result;
+        for (auto const& [key, value] : variant) {
+            if (!result.empty()) {
+                result += "; ";
+            }
+            result += key + "=" + value;
+        }
+        return result;
+    }
+
+    std::string getStateString(SweepRunState state)
+    {
+        switch (state) {
+        case SweepRunState_Completed:
+            return "completed";
+        case SweepRunState_Resumed:
+            return "resumed";
+        case SweepRunState_AlreadyCompleted:
+            return "already completed";
+        default:
+            return "failed";
+        }
+    }
+
+    std::filesystem::path getRunDirectory(SweepSpecification const& specification, int runIndex)
+    {
+        return std::filesystem::path(specification.outputDirectory) / getRunName(runIndex);
+    }
+
+    std::optional<SweepRunResult> readRunState(std::filesystem::path const& runDirectory, int runIndex)
+    {
+        try {
+            boost::property_tree::ptree tree;
+            boost::property_tree::read_json((runDirectory / RunStateFilename).string(), tree);
+
+            SweepRunResult result;
+            result.runIndex = runIndex;
+            auto state = tree.get<std::string>("state");
+            result.state = state == "completed" ? SweepRunState_Completed : state == "resumed" ? SweepRunState_Resumed : SweepRunState_Failed;
+            result.calculatedTimesteps = tree.get<uint64_t>("calculated time steps");
+            result.duration = std::chrono::milliseconds(tree.get<int64_t>("duration"));
+            result.tps = tree.get<float>("tps");
+            result.errorMessage = tree.get<std::string>("error message");
+            return result;
+        } catch (...) {
+            return std::nullopt;
+        }
+    }
+
+    //the state file is replaced atomically such that an interrupted write does not mark a run as completed
+    void writeRunState(std::filesystem::path const& runDirectory, SweepRunResult const& result)
+    {
+        boost::property_tree::ptree tree;
+        tree.put("state", getStateString(result.state));
+        tree.put("calculated time steps", result.calculatedTimesteps);
+        tree.put("duration", result.duration.count());
+        tree.put("tps", result.tps);
+        tree.put("error message", result.errorMessage);
+
+        std::filesystem::create_directories(runDirectory);
+        auto tempFilename = runDirectory / (RunStateFilename + ".tmp");
+        boost::property_tree::write_json(tempFilename.string(), tree);
+        std::filesystem::rename(tempFilename, runDirectory / RunStateFilename);
+    }
+
+    bool isRunCompleted(std::filesystem::path const& runDirectory, int runIndex)
+    {
+        auto runState = readRunState(runDirectory, runIndex);
+        return runState && (runState->state == SweepRunState_Completed || runState->state == SweepRunState_Resumed);
+    }
+
+    std::string quoteArgument(std::string const& argument)
+    {
+#if defined(_WIN32)
+        return "\"" + argument + "\"";
+#else
+        std::string result = "'";
+        for (auto const& c : argument) {
+            result += c == '\'' ? std::string("'\\''") : std::string(1, c);
+        }
+        return result + "'";
+#endif
+    }
+
+    SweepRunResult runVariant(
+        SimulationController const& simController,
+        SweepSpecification const& specification,
+        DeserializedSimulation const& baseSimulation,
+        int runIndex)
+    {
+        SweepRunResult result;
+        result.runIndex = runIndex;
+
+        auto runDirectory = getRunDirectory(specification, runIndex);
+        auto resultFilename = runDirectory / ResultFilename;
+        if (isRunCompleted(runDirectory, runIndex)) {
+            result.state = SweepRunState_AlreadyCompleted;
+            return result;
+        }
+        std::filesystem::create_directories(runDirectory);
+
+        //resume from latest readable checkpoint if available
+        DeserializedSimulation simData;
+        auto resumed = false;
+        for (auto const& checkpointFilename : getCheckpointFilenames(runDirectory)) {
+            if (SerializerService::deserializeSimulationFromFiles(simData, checkpointFilename.string())) {
+                printMessage(runIndex, "resume from " + checkpointFilename.filename().string());
+                resumed = true;
+                break;
+            }
+            printMessage(runIndex, "skip unreadable checkpoint " + checkpointFilename.filename().string());
+        }
+        if (!resumed) {
+            simData = baseSimulation;
+            simData.auxiliaryData.simulationParameters = AuxiliaryDataParserService::overrideSimulationParameters(
+                baseSimulation.auxiliaryData.simulationParameters, specification.variants.at(runIndex));
+        }
+
+        //the engine allocations of the previous run are reused since all variants have the same world size
+        simController->setCurrentTimestep(simData.auxiliaryData.timestep);
+        simController->setSimulationParameters(simData.auxiliaryData.simulationParameters);
+        simController->setOriginalSimulationParameters(simData.auxiliaryData.simulationParameters);
+        simController->setClusteredSimulationData(simData.mainData);
+        simController->setStatisticsHistory(simData.statistics);
+        simController->setRealTime(simData.auxiliaryData.realTime);
+
+        auto targetTimestep = baseSimulation.auxiliaryData.timestep + specification.timesteps;
+        auto checkpointInterval = specification.checkpointInterval != 0 ? specification.checkpointInterval : specification.timesteps;
+
+        auto getSimulation = [&] {
+            DeserializedSimulation result;
+            result.auxiliaryData = simData.auxiliaryData;
+            result.auxiliaryData.timestep = simController->getCurrentTimestep();
+            result.auxiliaryData.simulationParameters = simController->getSimulationParameters();
+            result.auxiliaryData.realTime = simController->getRealTime();
+            result.mainData = simController->getClusteredSimulationData();
+            result.statistics = simController->getStatisticsHistory().getCopiedData();
+            return result;
+        };
+
+        auto startTimepoint = std::chrono::steady_clock::now();
+        std::chrono::milliseconds calculationDuration(0);
+        while (simController->getCurrentTimestep() < targetTimestep) {
+            auto timesteps = std::min(checkpointInterval, targetTimestep - simController->getCurrentTimestep());
+
+            auto calculationStartTimepoint = std::chrono::steady_clock::now();
+            simController->calcTimesteps(timesteps);
+            calculationDuration += std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - calculationStartTimepoint);
+            result.calculatedTimesteps += timesteps;
+
+            auto currentTimestep = simController->getCurrentTimestep();
+            if (currentTimestep < targetTimestep) {
+                if (!SerializerService::serializeSimulationToFiles(getCheckpointFilename(runDirectory, currentTimestep).string(), getSimulation())) {
+                    throw std::runtime_error("Could not write checkpoint.");
+                }
+                auto checkpointFilenames = getCheckpointFilenames(runDirectory);
+                for (size_t i = NumCheckpointsToKeep; i < checkpointFilenames.size(); ++i) {
+                    removeSimulationFiles(checkpointFilenames.at(i));
+                }
+                printMessage(runIndex, "checkpoint at time step " + StringHelper::format(currentTimestep));
+            }
+        }
+
+        if (!SerializerService::serializeSimulationToFiles(resultFilename.string(), getSimulation())) {
+            throw std::runtime_error("Could not write result.");
+        }
+
+        result.state = resumed ? SweepRunState_Resumed : SweepRunState_Completed;
+        result.duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint);
+        result.tps = calculationDuration.count() != 0 ? 1000.0f * toFloat(result.calculatedTimesteps) / toFloat(calculationDuration.count()) : 0.0f;
+        writeRunState(runDirectory, result);
+
+        //checkpoints are only removed after the run has been marked as completed
+        for (auto const& checkpointFilename : getCheckpointFilenames(runDirectory)) {
+            removeSimulationFiles(checkpointFilename);
+        }
+        return result;
+    }
+
+    SweepRunResult runVariantAndWriteState(
+        SimulationController const& simController,
+        SweepSpecification const& specification,
+        DeserializedSimulation const& baseSimulation,
+        int runIndex)
+    {
+        printMessage(runIndex, "start " + getVariantString(specification.variants.at(runIndex)));
+        SweepRunResult result;
+        try {
+            result = runVariant(simController, specification, baseSimulation, runIndex);
+        } catch (std::exception const& e) {
+            result.runIndex = runIndex;
+            result.state = SweepRunState_Failed;
+            result.errorMessage = e.what();
+            try {
+                writeRunState(getRunDirectory(specification, runIndex), result);
+            } catch (...) {
+            }
+        }
+        printMessage(runIndex, getStateString(result.state));
+        return result;
+    }
+
+    DeserializedSimulation readBaseSimulation(SweepSpecification const& specification)
+    {
+        DeserializedSimulation result;
+        if (!SerializerService::deserializeSimulationFromFiles(result, specification.inputFilename)) {
+            throw std::runtime_error("Could not read from input files.");
+        }
+
+        //overrides are checked before any run is started
+        for (auto const& variant : specification.variants) {
+            AuxiliaryDataParserService::overrideSimulationParameters(result.auxiliaryData.simulationParameters, variant);
+        }
+        return result;
+    }
+
+    SimulationController createSimulationController(DeserializedSimulation const& baseSimulation)
+    {
+        auto result = std::make_shared<_SimulationControllerImpl>();
+        result->newSimulation(
+            baseSimulation.auxiliaryData.timestep, baseSimulation.auxiliaryData.generalSettings, baseSimulation.auxiliaryData.simulationParameters);
+        return result;
+    }
+}
+
+SweepSpecification SweepService::readSpecification(std::string const& filename)
+{
+    boost::property_tree::ptree tree;
+    boost::property_tree::read_json(filename, tree);
+
+    SweepSpecification result;
+    result.filename = filename;
+    result.inputFilename = tree.get<std::string>("input");
+    result.outputDirectory = tree.get<std::string>("output directory");
+    result.timesteps = tree.get<uint64_t>("time steps");
+    result.checkpointInterval = tree.get<uint64_t>("checkpoint interval", 0);
+    result.parallelRuns = std::max(1, tree.get<int>("parallel runs", 1));
+
+    result.variants.emplace_back();
+    if (auto runsTree = tree.get_child_optional("runs")) {
+        result.variants.clear();
+        for (auto const& [_, runTree] : *runsTree) {
+            std::map<std::string, std::string> variant;
+            for (auto const& [key, valueTree] : runTree) {
+                variant.emplace(key, valueTree.get_value<std::string>());
+            }
+            result.variants.emplace_back(variant);
+        }
+    }
+    if (auto gridTree = tree.get_child_optional("grid")) {
+        for (auto const& [key, valuesTree] : *gridTree) {
+            std::vector<std::map<std::string, std::string>> variants;
+            for (auto const& variant : result.variants) {
+                for (auto const& [_, valueTree] : valuesTree) {
+                    auto extendedVariant = variant;
+                    extendedVariant[key] = valueTree.get_value<std::string>();
+                    variants.emplace_back(extendedVariant);
+                }
+            }
+            result.variants = variants;
+        }
+    }
+    if (result.variants.empty()) {
+        throw std::runtime_error("Sweep specification does not contain any runs.");
+    }
+    return result;
+}
+
+std::vector<SweepRunResult> SweepService::runSweep(SweepSpecification const& specification, std::string const& executable)
+{
+    auto baseSimulation = readBaseSimulation(specification);
+    auto numVariants = toInt(specification.variants.size());
+    std::vector<SweepRunResult> results(numVariants);
+
+    //runs in one process reuse the engine allocations
+    if (specification.parallelRuns == 1) {
+        auto simController = createSimulationController(baseSimulation);
+        for (int runIndex = 0; runIndex < numVariants; ++runIndex) {
+            results.at(runIndex) = runVariantAndWriteState(simController, specification, baseSimulation, runIndex);
+        }
+        simController->closeSimulation();
+        return results;
+    }
+
+    //simulations within one process would share the simulation parameters in CUDA constant memory, hence each parallel run has its own process
+    std::atomic<int> nextRunIndex = 0;
+    auto runWorker = [&] {
+        for (auto runIndex = nextRunIndex++; runIndex < numVariants; runIndex = nextRunIndex++) {
+            auto& result = results.at(runIndex);
+            result.runIndex = runIndex;
+            auto runDirectory = getRunDirectory(specification, runIndex);
+            if (isRunCompleted(runDirectory, runIndex)) {
+                result.state = SweepRunState_AlreadyCompleted;
+                printMessage(runIndex, getStateString(result.state));
+                continue;
+            }
+
+            std::error_code errorCode;
+            std::filesystem::remove(runDirectory / RunStateFilename, errorCode);
+            auto command = quoteArgument(executable) + " -s " + quoteArgument(specification.filename) + " --sweep-run " + std::to_string(runIndex);
+            auto exitCode = std::system(command.c_str());
+            if (auto runState = readRunState(runDirectory, runIndex)) {
+                result = *runState;
+            } else {
+                result.state = SweepRunState_Failed;
+                result.errorMessage = "process exited with code " + std::to_string(exitCode);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < std::min(specification.parallelRuns, numVariants); ++i) {
+        threads.emplace_back(runWorker);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return results;
+}
+
+SweepRunResult SweepService::runSingleVariant(SweepSpecification const& specification, int runIndex)
+{
+    if (runIndex < 0 || runIndex >= toInt(specification.variants.size())) {
+        throw std::runtime_error("Invalid run index.");
+    }
+    auto baseSimulation = readBaseSimulation(specification);
+    auto simController = createSimulationController(baseSimulation);
+    auto result = runVariantAndWriteState(simController, specification, baseSimulation, runIndex);
+    simController->closeSimulation();
+    return result;
+}
+
+void SweepService::printSummary(SweepSpecification const& specification, std::vector<SweepRunResult> const& results)
+{
+    std::cout << "Summary:" << std::endl;
+    for (auto const& result : results) {
+        std::cout << "  " << getRunName(result.runIndex) << " [" << getVariantString(specification.variants.at(result.runIndex)) << "]: " << getStateString(result.state);
+        if (result.state == SweepRunState_Completed || result.state == SweepRunState_Resumed) {
+            std::cout << ", " << StringHelper::format(result.calculatedTimesteps) << " time steps, " << StringHelper::format(result.duration) << ", "
+                      << StringHelper::format(result.tps, 1) << " TPS";
+        }
+        if (!result.errorMessage.empty()) {
+            std::cout << " (" << result.errorMessage << ")";
+        }
+        std::cout << std::endl;
+    }
+}
+
+bool SweepService::writeSummary(std::string const& filename, SweepSpecification const& specification, std::vector<SweepRunResult> const& results)
+{
+    std::ofstream stream(filename, std::ios::binary);
+    if (!stream) {
+        return false;
+    }
+    stream << "run, state, calculated time steps, duration [ms], tps, overrides" << std::endl;
+    for (auto const& result : results) {
+        stream << getRunName(result.runIndex) << ", " << getStateString(result.state) << ", " << result.calculatedTimesteps << ", "
+               << result.duration.count() << ", " << result.tps << ", \"" << getVariantString(specification.variants.at(result.runIndex)) << "\""
+               << std::endl;
+    }
+    return true;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "EngineImpl/SimulationControllerImpl.h"
+
+/**
+ * A sweep runs several variants of a base simulation which differ in their simulation parameters. Overrides are given
+ * by the property names of the settings file (e.g. "simulation parameters.time step size").
+ *
+ * Example of a sweep specification:
+ * {
+ *     "input": "base.sim",
+ *     "output directory": "sweep",
+ *     "time steps": 100000,
+ *     "checkpoint interval": 10000,
+ *     "parallel runs": 2,
+ *     "runs": [{"simulation parameters.cell max velocity": 1.5}, {}],
+ *     "grid": {"simulation parameters.time step size": [0.5, 1.0]}
+ * }
+ * The variants are given by the cartesian product of "runs" and "grid" (both are optional).
+ */
+struct SweepSpecification
+{
+    std::string filename;  //of the specification itself
+    std::string inputFilename;
+    std::string outputDirectory;
+    uint64_t timesteps = 0;
+    uint64_t checkpointInterval = 0;  //0 = no checkpoints
+    int parallelRuns = 1;
+    std::vector<std::map<std::string, std::string>> variants;
+};
+
+using SweepRunState = int;
+enum SweepRunState_
+{
+    SweepRunState_Completed,
+    SweepRunState_Resumed,
+    SweepRunState_AlreadyCompleted,
+    SweepRunState_Failed
+};
+
+struct SweepRunResult
+{
+    int runIndex = 0;
+    SweepRunState state = SweepRunState_Failed;
+    uint64_t calculatedTimesteps = 0;
+    std::chrono::milliseconds duration = std::chrono::milliseconds(0);
+    float tps = 0;
+    std::string errorMessage;
+};
+
+class SweepService
+{
+public:
+    static SweepSpecification readSpecification(std::string const& filename);
+
+    //runs are resumed from their latest checkpoint and completed runs are skipped
+    //parallel runs are executed in separate processes of the given executable which call runSingleVariant (option --sweep-run)
+    static std::vector<SweepRunResult> runSweep(SweepSpecification const& specification, std::string const& executable);
+    static SweepRunResult runSingleVariant(SweepSpecification const& specification, int runIndex);
+
+    static void printSummary(SweepSpecification const& specification, std::vector<SweepRunResult> const& results);
+    static bool writeSummary(std::string const& filename, SweepSpecification const& specification, std::vector<SweepRunResult> const& results);
+};
@@ -2,10 +2,13 @@
 
 #include "cuda_runtime_api.h"
 
+#include "EngineInterface/GeneralSettings.h"
+
 #include "Base.cuh"
 #include "Object.cuh"
 #include "Math.cuh"
 #include "Array.cuh"
+#include "SparseMapLayout.cuh"
 
 class BaseMap
 {
@@ -68,30 +71,158 @@ class BasicMap : public BaseMap
 public:
 };
 
+//maps corrected positions to indices in the entry array of a map
+class MapIndex
+{
+public:
+    __host__ __inline__ void init(int2 const& size, SpatialMapType type)
+    {
+        _size = size;
+        _type = type;
+        _tileKeys = nullptr;
+        CudaMemoryManager::getInstance().acquireMemory<int>(1, _numOverflows);
+        CHECK_FOR_CUDA_ERROR(cudaMemset(_numOverflows, 0, sizeof(int)));
+    }
+
+    __host__ __inline__ SpatialMapType getType() const { return _type; }
+
+    //reserves tile slots of a sparse map for maxEntries objects, a sparse map is never shrunk (e.g. after it has been grown)
+    //returns true if the tile keys have been reallocated, may only be called if the map is empty
+    __host__ __inline__ bool reserve(uint64_t maxEntries)
+    {
+        if (_type == SpatialMapType_Dense) {
+            return false;
+        }
+        auto numTileSlots = SparseMapLayout::calcNumTileSlots(_size, maxEntries);
+        if (_tileKeys != nullptr && numTileSlots <= _layout.getNumTileSlots()) {
+            return false;
+        }
+        allocateTileKeys(numTileSlots);
+        return true;
+    }
+
+    //returns the number of positions which could not be inserted since the last call and enlarges the tile keys in this
+    //case such that they would fit, may only be called if the map is empty
+    __host__ __inline__ int growIfOverflowed_host()
+    {
+        int result;
+        CHECK_FOR_CUDA_ERROR(cudaMemcpy(&result, _numOverflows, sizeof(int), cudaMemcpyDeviceToHost));
+        if (result > 0) {
+            CHECK_FOR_CUDA_ERROR(cudaMemset(_numOverflows, 0, sizeof(int)));
+            allocateTileKeys(SparseMapLayout::calcGrownNumTileSlots(_size, _layout.getNumTileSlots(), result));
+        }
+        return result;
+    }
+
+    __host__ __inline__ uint64_t getNumEntries() const { return _layout.getNumEntries(); }
+
+    __host__ __inline__ void free()
+    {
+        CudaMemoryManager::getInstance().freeMemory(_tileKeys);
+        CudaMemoryManager::getInstance().freeMemory(_numOverflows);
+        _tileKeys = nullptr;
+        _numOverflows = nullptr;
+    }
+
+    //returns -1 if the position is not contained
+    __device__ __inline__ int find(int2 const& pos) const
+    {
+        if (_type == SpatialMapType_Dense) {
+            return pos.x + pos.y * _size.x;
+        }
+        return _layout.find(_tileKeys, pos);
+    }
+
+    //returns -1 if there is no space left
+    __device__ __inline__ int findOrInsert(int2 const& pos)
+    {
+        if (_type == SpatialMapType_Dense) {
+            return pos.x + pos.y * _size.x;
+        }
+        auto result = _layout.findOrInsert(_tileKeys, pos, [](uint64_t* address, uint64_t expected, uint64_t desired) {
+            return static_cast<uint64_t>(atomicCAS(
+                reinterpret_cast<unsigned long long int*>(address),
+                static_cast<unsigned long long int>(expected),
+                static_cast<unsigned long long int>(desired)));
+        });
+        if (result == -1) {
+            atomicAdd(_numOverflows, 1);
+        }
+        return result;
+    }
+
+    //must be called for all entries at once
+    __device__ __inline__ void remove(int entryIndex)
+    {
+        if (_type == SpatialMapType_SparseTiled) {
+            _tileKeys[SparseMapLayout::getTileSlot(entryIndex)] = SparseMapLayout::EmptyTileKey;
+        }
+    }
+
+private:
+    __host__ __inline__ void allocateTileKeys(int numTileSlots)
+    {
+        CudaMemoryManager::getInstance().freeMemory(_tileKeys);
+        _layout.init(_size, numTileSlots);
+        CudaMemoryManager::getInstance().acquireMemory<uint64_t>(numTileSlots, _tileKeys);
+        CHECK_FOR_CUDA_ERROR(cudaMemset(_tileKeys, 0xff, sizeof(uint64_t) * numTileSlots));  //all keys are SparseMapLayout::EmptyTileKey
+    }
+
+    int2 _size;
+    SpatialMapType _type;
+    SparseMapLayout _layout;
+    uint64_t* _tileKeys;
+    int* _numOverflows;
+};
+
 class CellMap : public BaseMap
 {
 public:
-    __host__ __inline__ void init(int2 const& size)
+    __host__ __inline__ void init(int2 const& size, SpatialMapType type)
     {
         BaseMap::init(size);
-        CudaMemoryManager::getInstance().acquireMemory<Cell*>(size.x * size.y, _map);
+        _index.init(size, type);
         _mapEntries.init();
-
-        std::vector<Cell*> hostMap(size.x * size.y, 0);
-        CHECK_FOR_CUDA_ERROR(cudaMemcpy(_map, hostMap.data(), sizeof(Cell*) * size.x * size.y, cudaMemcpyHostToDevice));
+        _map = nullptr;
+        if (type == SpatialMapType_Dense) {
+            CudaMemoryManager::getInstance().acquireMemory<Cell*>(size.x * size.y, _map);
+
+            std::vector<Cell*> hostMap(size.x * size.y, 0);
+            CHECK_FOR_CUDA_ERROR(cudaMemcpy(_map, hostMap.data(), sizeof(Cell*) * size.x * size.y, cudaMemcpyHostToDevice));
+        } else {
+            allocateSparseMap(0);
+        }
     }
 
-    __host__ __inline__ void resize(int maxEntries) { _mapEntries.resize(maxEntries); }
-
+    __host__ __inline__ void resize(int maxEntries)
+    {
+        _mapEntries.resize(maxEntries);
+        if (_index.getType() == SpatialMapType_SparseTiled) {
+            allocateSparseMap(maxEntries);
+        }
+    }
 
     __device__ __inline__ void reset() { _mapEntries.reset(); }
 
     __host__ __inline__ void free()
     {
         CudaMemoryManager::getInstance().freeMemory(_map);
+        _index.free();
         _mapEntries.free();
     }
 
+    //returns the number of objects which could not be mapped since the last call and enlarges the sparse map in this case
+    //may only be called if the map is empty (e.g. after the cleanup at the end of a time step)
+    __host__ __inline__ int growIfOverflowed()
+    {
+        auto result = _index.growIfOverflowed_host();
+        if (result > 0) {
+            _mapEntries.setNumEntries_host(0);
+            allocateSparseMapEntries();
+        }
+        return result;
+    }
+
     __device__ __inline__ void set_block(int numEntities, Cell** cells)
     {
         if (0 == numEntities) {
@@ -109,7 +240,11 @@ public:
             auto const& cell = cells[index];
             int2 posInt = {floorInt(cell->pos.x), floorInt(cell->pos.y)};
             correctPosition(posInt);
-            auto slot = posInt.x + posInt.y * _size.x;
+            auto slot = _index.findOrInsert(posInt);
+            entrySubarray[index] = slot;
+            if (slot == -1) {
+                continue;
+            }
             Cell* slotCell = reinterpret_cast<Cell*>(atomicCAS(
                 reinterpret_cast<unsigned long long int*>(&_map[slot]),
                 reinterpret_cast<unsigned long long int>(nullptr),
@@ -123,8 +258,6 @@ public:
                     reinterpret_cast<unsigned long long int>(nullptr),
                     reinterpret_cast<unsigned long long int>(cell)));
             }
-
-            entrySubarray[index] = slot;
         }
         __syncthreads();
     }
@@ -133,12 +266,13 @@ public:
     {
         int2 posInt = {floorInt(pos.x), floorInt(pos.y)};
         correctPosition(posInt);
-        return _map[posInt.x + posInt.y * _size.x];
+        return getFirst(posInt);
     }
 
     __device__ __inline__ Cell* getFirst(int2 const& pos) const
     {
-        return _map[pos.x + pos.y * _size.x];
+        auto slot = _index.find(pos);
+        return slot != -1 ? _map[slot] : nullptr;
     }
 
     template <typename MatchFunc>
@@ -152,8 +286,7 @@ public:
             for (int dy = -radiusInt; dy <= radiusInt; ++dy) {
                 int2 scanPos{posInt.x + dx, posInt.y + dy};
                 correctPosition(scanPos);
-                int slot = scanPos.x + scanPos.y * _size.x;
-                auto slotCell = _map[slot];
+                auto slotCell = getFirst(scanPos);
                 for (int level = 0; level < 10; ++level) {
                     if (numCells == arraySize) {
                         return;
@@ -180,8 +313,7 @@ public:
             for (int dx = -radiusInt; dx <= radiusInt; ++dx) {
                 int2 scanPos{posInt.x + dx, posInt.y + dy};
                 correctPosition(scanPos);
-                int slot = scanPos.x + scanPos.y * _size.x;
-                auto slotCell = _map[slot];
+                auto slotCell = getFirst(scanPos);
                 for (int level = 0; level < 10; ++level) {
                     if (!slotCell) {
                         break;
@@ -201,38 +333,84 @@ public:
             calcPartition(_mapEntries.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
         for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
             auto const& mapEntry = _mapEntries.at(index);
-            _map[mapEntry] = nullptr;
+            if (mapEntry != -1) {
+                _map[mapEntry] = nullptr;
+                _index.remove(mapEntry);
+            }
         }
     }
 
 private:
+    //memory of a sparse map is proportional to the number of entries, it is only reallocated if more tile slots are
+    //needed, otherwise the (empty) map is kept
+    __host__ __inline__ void allocateSparseMap(int maxEntries)
+    {
+        if (_index.reserve(maxEntries)) {
+            allocateSparseMapEntries();
+        }
+    }
+
+    __host__ __inline__ void allocateSparseMapEntries()
+    {
+        CudaMemoryManager::getInstance().freeMemory(_map);
+        auto numEntries = _index.getNumEntries();
+        CudaMemoryManager::getInstance().acquireMemory<Cell*>(numEntries, _map);
+        CHECK_FOR_CUDA_ERROR(cudaMemset(_map, 0, sizeof(Cell*) * numEntries));
+    }
+
     Cell** _map;
+    MapIndex _index;
     Array<int> _mapEntries;
 };
 
 class ParticleMap : public BaseMap
 {
 public:
-    __host__ __inline__ void init(int2 const& size)
+    __host__ __inline__ void init(int2 const& size, SpatialMapType type)
     {
         BaseMap::init(size);
-        CudaMemoryManager::getInstance().acquireMemory<Particle*>(size.x * size.y, _map);
+        _index.init(size, type);
         _mapEntries.init();
-
-        std::vector<Particle*> hostMap(size.x * size.y, 0);
-        CHECK_FOR_CUDA_ERROR(cudaMemcpy(_map, hostMap.data(), sizeof(Particle*) * size.x * size.y, cudaMemcpyHostToDevice));
+        _map = nullptr;
+        if (type == SpatialMapType_Dense) {
+            CudaMemoryManager::getInstance().acquireMemory<Particle*>(size.x * size.y, _map);
+
+            std::vector<Particle*> hostMap(size.x * size.y, 0);
+            CHECK_FOR_CUDA_ERROR(cudaMemcpy(_map, hostMap.data(), sizeof(Particle*) * size.x * size.y, cudaMemcpyHostToDevice));
+        } else {
+            allocateSparseMap(0);
+        }
     }
 
-    __host__ __inline__ void resize(int maxEntries) { _mapEntries.resize(maxEntries); }
+    __host__ __inline__ void resize(int maxEntries)
+    {
+        _mapEntries.resize(maxEntries);
+        if (_index.getType() == SpatialMapType_SparseTiled) {
+            allocateSparseMap(maxEntries);
+        }
+    }
 
     __device__ __inline__ void reset() { _mapEntries.reset(); }
 
     __host__ __inline__ void free()
     {
         CudaMemoryManager::getInstance().freeMemory(_map);
+        _index.free();
         _mapEntries.free();
     }
 
+    //returns the number of objects which could not be mapped since the last call and enlarges the sparse map in this case
+    //may only be called if the map is empty (e.g. after the cleanup at the end of a time step)
+    __host__ __inline__ int growIfOverflowed()
+    {
+        auto result = _index.growIfOverflowed_host();
+        if (result > 0) {
+            _mapEntries.setNumEntries_host(0);
+            allocateSparseMapEntries();
+        }
+        return result;
+    }
+
     __device__ __inline__ void set_block(int numEntities, Particle** entities)
     {
         if (0 == numEntities) {
@@ -250,8 +428,10 @@ public:
             auto const& entity = entities[index];
             int2 posInt = {floorInt(entity->absPos.x), floorInt(entity->absPos.y)};
             correctPosition(posInt);
-            auto mapEntry = posInt.x + posInt.y * _size.x;
-            _map[mapEntry] = entity;
+            auto mapEntry = _index.findOrInsert(posInt);
+            if (mapEntry != -1) {
+                _map[mapEntry] = entity;
+            }
             entrySubarray[index] = mapEntry;
         }
         __syncthreads();
@@ -261,8 +441,8 @@ public:
     {
         int2 posInt = {floorInt(pos.x), floorInt(pos.y)};
         correctPosition(posInt);
-        auto mapEntry = posInt.x + posInt.y * _size.x;
-        return _map[mapEntry];
+        auto mapEntry = _index.find(posInt);
+        return mapEntry != -1 ? _map[mapEntry] : nullptr;
     }
 
     __device__ __inline__ void cleanup_system()
@@ -270,11 +450,32 @@ public:
         auto partition = calcPartition(_mapEntries.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
         for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
             auto const& mapEntry = _mapEntries.at(index);
-            _map[mapEntry] = nullptr;
+            if (mapEntry != -1) {
+                _map[mapEntry] = nullptr;
+                _index.remove(mapEntry);
+            }
         }
     }
 
 private:
+    //memory of a sparse map is proportional to the number of entries, it is only reallocated if more tile slots are
+    //needed, otherwise the (empty) map is kept
+    __host__ __inline__ void allocateSparseMap(int maxEntries)
+    {
+        if (_index.reserve(maxEntries)) {
+            allocateSparseMapEntries();
+        }
+    }
+
+    __host__ __inline__ void allocateSparseMapEntries()
+    {
+        CudaMemoryManager::getInstance().freeMemory(_map);
+        auto numEntries = _index.getNumEntries();
+        CudaMemoryManager::getInstance().acquireMemory<Particle*>(numEntries, _map);
+        CHECK_FOR_CUDA_ERROR(cudaMemset(_map, 0, sizeof(Particle*) * numEntries));
+    }
+
     Particle** _map;
+    MapIndex _index;
     Array<int> _mapEntries;
 };
@@ -64,7 +64,7 @@ _SimulationCudaFacade::_SimulationCudaFacade(uint64_t timestep, Settings const&
     _cudaSimulationStatistics = std::make_shared<SimulationStatistics>();
     _statisticsService = std::make_shared<_StatisticsService>();
 
-    _cudaSimulationData->init({settings.generalSettings.worldSizeX, settings.generalSettings.worldSizeY}, timestep);
+    _cudaSimulationData->init({settings.generalSettings.worldSizeX, settings.generalSettings.worldSizeY}, timestep, settings.generalSettings.spatialMapType);
     _cudaRenderingData->init();
     _cudaSimulationStatistics->init();
     _cudaSelectionResult->init();
@@ -125,6 +125,7 @@ void _SimulationCudaFacade::calcTimestep(uint64_t timesteps, bool forceUpdateSta
         _simulationKernels->calcTimestep(_settings, simulationData, *_cudaSimulationStatistics);
         syncAndCheck();
 
+        growSpatialMapsIfOverflowed();
         automaticResizeArrays();
 
         {
@@ -436,7 +437,7 @@ StatisticsHistory const& _SimulationCudaFacade::getStatisticsHistory() const
 
 void _SimulationCudaFacade::setStatisticsHistory(StatisticsHistoryData const& data)
 {
-    _statisticsService->rewriteHistory(_statisticsHistory, data, getCurrentTimestep());
+    _statisticsService->rewriteHistory(_statisticsHistory, data);
 }
 
 void _SimulationCudaFacade::resetTimeIntervalStatistics()
@@ -591,6 +592,20 @@ void _SimulationCudaFacade::automaticResizeArrays()
     }
 }
 
+void _SimulationCudaFacade::growSpatialMapsIfOverflowed()
+{
+    if (_settings.generalSettings.spatialMapType != SpatialMapType_SparseTiled) {
+        return;
+    }
+    //maps are empty after the cleanup at the end of the time step
+    if (auto numUnmappedCells = _cudaSimulationData->cellMap.growIfOverflowed()) {
+        log(Priority::Important, "cell map full: " + std::to_string(numUnmappedCells) + " cells were not mapped, map has been enlarged");
+    }
+    if (auto numUnmappedParticles = _cudaSimulationData->particleMap.growIfOverflowed()) {
+        log(Priority::Important, "particle map full: " + std::to_string(numUnmappedParticles) + " particles were not mapped, map has been enlarged");
+    }
+}
+
 void _SimulationCudaFacade::resizeArrays(ArraySizes const& additionals)
 {
     log(Priority::Important, "resize arrays");
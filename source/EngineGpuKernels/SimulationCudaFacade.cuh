@@ -97,6 +97,7 @@ private:
     void copyDataTOtoDevice(DataTO const& dataTO);
     void copyDataTOtoHost(DataTO const& dataTO);
     void automaticResizeArrays();
+    void growSpatialMapsIfOverflowed();
     void resizeArrays(ArraySizes const& additionals = ArraySizes());
     void checkAndProcessSimulationParameterChanges();
 
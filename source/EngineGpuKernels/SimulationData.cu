@@ -3,7 +3,7 @@
 #include "ConstantMemory.cuh"
 #include "GarbageCollectorKernels.cuh"
 
-void SimulationData::init(int2 const& worldSize_, uint64_t timestep_)
+void SimulationData::init(int2 const& worldSize_, uint64_t timestep_, SpatialMapType spatialMapType)
 {
     worldSize = worldSize_;
     timestep = timestep_;
@@ -11,8 +11,8 @@ void SimulationData::init(int2 const& worldSize_, uint64_t timestep_)
     objects.init();
     tempObjects.init();
     preprocessedCellFunctionData.init(worldSize);
-    cellMap.init(worldSize);
-    particleMap.init(worldSize);
+    cellMap.init(worldSize, spatialMapType);
+    particleMap.init(worldSize, spatialMapType);
 
     CudaMemoryManager::getInstance().acquireMemory<double>(1, externalEnergy);
     CHECK_FOR_CUDA_ERROR(cudaMemset(externalEnergy, 0, sizeof(double)));
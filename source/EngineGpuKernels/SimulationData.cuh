@@ -39,7 +39,7 @@ struct SimulationData
     CudaNumberGenerator numberGen1;
     CudaNumberGenerator numberGen2;  //second random number generator used in combination with the first generator for evaluating very low probabilities
 
-    void init(int2 const& worldSize, uint64_t timestep);
+    void init(int2 const& worldSize, uint64_t timestep, SpatialMapType spatialMapType);
     bool shouldResize(ArraySizes const& additionals);
     void resizeTargetObjects(ArraySizes const& additionals);
     void resizeObjects();
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cuda_runtime.h>
+#include <stdint.h>
+
+/**
+ * Address computation for sparse maps. The world is divided into tiles of TileSize x TileSize positions and only
+ * occupied tiles are stored. Tiles are located via an open addressing hash table whose slot index also determines the
+ * location of the tile entries, i.e. no additional allocation step is needed when a tile becomes occupied.
+ *
+ * NOTE: header is also included in host code (reference implementation and tests)
+ */
+class SparseMapLayout
+{
+public:
+    static int constexpr TileSize = 4;
+    static int constexpr NumEntriesPerTile = TileSize * TileSize;
+    static uint64_t constexpr EmptyTileKey = ~0ull;
+    static int constexpr MinNumTileSlots = 64;
+
+    //number of tile slots for a map which holds at most maxEntries objects (the hash table is filled at most to 50%)
+    __host__ __device__ __inline__ static int calcNumTileSlots(int2 const& worldSize, uint64_t maxEntries)
+    {
+        auto numTiles = static_cast<uint64_t>((worldSize.x + TileSize - 1) / TileSize) * ((worldSize.y + TileSize - 1) / TileSize);
+        auto numOccupiedTiles = maxEntries < numTiles ? maxEntries : numTiles;
+        uint64_t result = MinNumTileSlots;
+        while (result < numOccupiedTiles * 2) {
+            result *= 2;
+        }
+        return static_cast<int>(result);
+    }
+
+    //number of tile slots after numOverflows positions could not be inserted into a full hash table with numTileSlots slots
+    //since each position occupies at most one additional tile, a single growth step suffices for the same objects
+    __host__ __device__ __inline__ static int calcGrownNumTileSlots(int2 const& worldSize, int numTileSlots, int numOverflows)
+    {
+        return calcNumTileSlots(worldSize, static_cast<uint64_t>(numTileSlots) + numOverflows);
+    }
+
+    __host__ __device__ __inline__ void init(int2 const& worldSize, int numTileSlots)
+    {
+        _numTilesX = (worldSize.x + TileSize - 1) / TileSize;
+        _numTileSlots = numTileSlots;
+    }
+
+    __host__ __device__ __inline__ int getNumTileSlots() const { return _numTileSlots; }
+    __host__ __device__ __inline__ uint64_t getNumEntries() const { return static_cast<uint64_t>(_numTileSlots) * NumEntriesPerTile; }
+
+    //pos must be a corrected position, returns -1 if the position lies in an unoccupied tile
+    __host__ __device__ __inline__ int find(uint64_t const* tileKeys, int2 const& pos) const
+    {
+        auto tileKey = getTileKey(pos);
+        auto tileSlot = getFirstTileSlot(tileKey);
+        for (int i = 0; i < _numTileSlots; ++i) {
+            auto slotKey = tileKeys[tileSlot];
+            if (slotKey == tileKey) {
+                return getEntryIndex(tileSlot, pos);
+            }
+            if (slotKey == EmptyTileKey) {
+                return -1;
+            }
+            tileSlot = (tileSlot + 1) & (_numTileSlots - 1);
+        }
+        return -1;
+    }
+
+    //compareAndSwap(address, expected, desired) must return the previous value, returns -1 if the hash table is full
+    template <typename CompareAndSwapFunc>
+    __host__ __device__ __inline__ int findOrInsert(uint64_t* tileKeys, int2 const& pos, CompareAndSwapFunc const& compareAndSwap) const
+    {
+        auto tileKey = getTileKey(pos);
+        auto tileSlot = getFirstTileSlot(tileKey);
+        for (int i = 0; i < _numTileSlots; ++i) {
+            auto slotKey = compareAndSwap(&tileKeys[tileSlot], EmptyTileKey, tileKey);
+            if (slotKey == EmptyTileKey || slotKey == tileKey) {
+                return getEntryIndex(tileSlot, pos);
+            }
+            tileSlot = (tileSlot + 1) & (_numTileSlots - 1);
+        }
+        return -1;
+    }
+
+    //the tile keys may only be cleared if all entries of the map are removed (otherwise probe sequences would break)
+    __host__ __device__ __inline__ static int getTileSlot(int entryIndex) { return entryIndex / NumEntriesPerTile; }
+
+private:
+    __host__ __device__ __inline__ uint64_t getTileKey(int2 const& pos) const
+    {
+        return static_cast<uint64_t>(pos.y / TileSize) * _numTilesX + pos.x / TileSize;
+    }
+
+    __host__ __device__ __inline__ int getFirstTileSlot(uint64_t tileKey) const
+    {
+        //finalizer of splitmix64
+        tileKey ^= tileKey >> 30;
+        tileKey *= 0xbf58476d1ce4e5b9ull;
+        tileKey ^= tileKey >> 27;
+        tileKey *= 0x94d049bb133111ebull;
+        tileKey ^= tileKey >> 31;
+        return static_cast<int>(tileKey & (_numTileSlots - 1));
+    }
+
+    __host__ __device__ __inline__ int getEntryIndex(int tileSlot, int2 const& pos) const
+    {
+        return tileSlot * NumEntriesPerTile + (pos.y % TileSize) * TileSize + pos.x % TileSize;
+    }
+
+    uint64_t _numTilesX = 0;
+    int _numTileSlots = 0;
+};
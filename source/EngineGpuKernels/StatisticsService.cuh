@@ -8,12 +8,10 @@ class _StatisticsService
 public:
     void addDataPoint(StatisticsHistory& history, TimelineStatistics const& newRawStatistics, uint64_t timestep);
     void resetTime(StatisticsHistory& history, uint64_t timestep);
-    void rewriteHistory(StatisticsHistory& history, StatisticsHistoryData const& newHistoryData, uint64_t timestep);
+    void rewriteHistory(StatisticsHistory& history, StatisticsHistoryData const& newHistoryData);
 
 private:
-    static auto constexpr DefaultTimeStepDelta = 10.0;
-
-    double _longtermTimestepDelta = DefaultTimeStepDelta;
+    static auto constexpr TimestepDelta = 10.0;
 
     std::optional<TimelineStatistics> _lastRawStatistics;
     std::optional<uint64_t> _lastTimestep;
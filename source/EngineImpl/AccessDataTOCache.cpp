@@ -1,63 +1,125 @@
 #include "AccessDataTOCache.h"
 
-_AccessDataTOCache::_AccessDataTOCache()
-{}
+#include <algorithm>
+
+_AccessDataTOCache::_AccessDataTOCache(AccessDataTOCacheSettings const& settings)
+    : _settings(settings)
+{
+    _buffers.resize(settings.doubleBuffered ? 2 : 1);
+}
 
 _AccessDataTOCache::~_AccessDataTOCache()
 {
-    if(_dataTO) {
-        deleteDataTO(*_dataTO);
+    for (auto const& buffer : _buffers) {
+        if (buffer) {
+            deleteBuffer(*buffer);
+        }
     }
 }
 
 DataTO _AccessDataTOCache::getDataTO(ArraySizes const& arraySizes)
 {
-    if (_dataTO) {
-        auto existingArraySizes = getArraySizes(*_dataTO);
-        if (fits(existingArraySizes, arraySizes)) {
-            *_dataTO->numCells = 0;
-            *_dataTO->numParticles = 0;
-            *_dataTO->numAuxiliaryData = 0;
-            return *_dataTO;
-        } else {
-            deleteDataTO(*_dataTO);
+    ++_statistics.numRequests;
+
+    auto& buffer = _buffers.at(_currentBufferIndex);
+    _currentBufferIndex = (_currentBufferIndex + 1) % toInt(_buffers.size());
+
+    if (buffer && fits(buffer->capacity, arraySizes)) {
+        ++_statistics.numAvoidedAllocations;
+    } else {
+        if (buffer) {
+            deleteBuffer(*buffer);
+            buffer.reset();
         }
+        buffer = createBuffer(getGrownArraySizes(arraySizes));
     }
+    *buffer->dataTO.numCells = 0;
+    *buffer->dataTO.numParticles = 0;
+    *buffer->dataTO.numAuxiliaryData = 0;
+    return buffer->dataTO;
+}
+
+AccessDataTOCacheStatistics const& _AccessDataTOCache::getStatistics() const
+{
+    return _statistics;
+}
+
+bool _AccessDataTOCache::fits(ArraySizes const& left, ArraySizes const& right) const
+{
+    return left.cellArraySize >= right.cellArraySize && left.particleArraySize >= right.particleArraySize
+        && left.auxiliaryDataSize >= right.auxiliaryDataSize;
+}
+
+auto _AccessDataTOCache::getGrownArraySizes(ArraySizes const& arraySizes) const -> ArraySizes
+{
+    auto grow = [this](uint64_t size) { return static_cast<uint64_t>(static_cast<double>(size) * std::max(1.0f, _settings.growthFactor)); };
+    return {grow(arraySizes.cellArraySize), grow(arraySizes.particleArraySize), grow(arraySizes.auxiliaryDataSize)};
+}
+
+uint64_t _AccessDataTOCache::getNumBytes(ArraySizes const& arraySizes) const
+{
+    return 3 * sizeof(uint64_t) + arraySizes.cellArraySize * sizeof(CellTO) + arraySizes.particleArraySize * sizeof(ParticleTO)
+        + arraySizes.auxiliaryDataSize;
+}
+
+auto _AccessDataTOCache::createBuffer(ArraySizes const& capacity) -> Buffer
+{
+    Buffer result;
+    result.capacity = capacity;
+    result.pageLocked = _settings.pageLockedMemory;
     try {
-        DataTO result;
-        result.numCells = new uint64_t;
-        result.numParticles = new uint64_t;
-        result.numAuxiliaryData = new uint64_t;
-        *result.numCells = 0;
-        *result.numParticles = 0;
-        *result.numAuxiliaryData = 0;
-        result.cells = new CellTO[arraySizes.cellArraySize];
-        result.particles = new ParticleTO[arraySizes.particleArraySize];
-        result.auxiliaryData = new uint8_t[arraySizes.auxiliaryDataSize];
-        _dataTO = result;
-        return result;
+        result.dataTO.numCells = allocate<uint64_t>(1, result.pageLocked);
+        result.dataTO.numParticles = allocate<uint64_t>(1, result.pageLocked);
+        result.dataTO.numAuxiliaryData = allocate<uint64_t>(1, result.pageLocked);
+        result.dataTO.cells = allocate<CellTO>(capacity.cellArraySize, result.pageLocked);
+        result.dataTO.particles = allocate<ParticleTO>(capacity.particleArraySize, result.pageLocked);
+        result.dataTO.auxiliaryData = allocate<uint8_t>(capacity.auxiliaryDataSize, result.pageLocked);
     } catch (std::bad_alloc const&) {
+        deleteBuffer(result);
+        if (result.pageLocked) {
+            _settings.pageLockedMemory = false;
+            return createBuffer(capacity);
+        }
         throw std::runtime_error("There is not sufficient CPU memory available.");
     }
+    ++_statistics.numAllocations;
+    _statistics.allocatedBytes += getNumBytes(capacity);
+    return result;
 }
 
-bool _AccessDataTOCache::fits(ArraySizes const& left, ArraySizes const& right) const
+void _AccessDataTOCache::deleteBuffer(Buffer const& buffer)
 {
-    return left.cellArraySize >= right.cellArraySize && left.particleArraySize >= right.particleArraySize
-        && left.auxiliaryDataSize >= right.auxiliaryDataSize;
+    deallocate(buffer.dataTO.numCells, buffer.pageLocked);
+    deallocate(buffer.dataTO.numParticles, buffer.pageLocked);
+    deallocate(buffer.dataTO.numAuxiliaryData, buffer.pageLocked);
+    deallocate(buffer.dataTO.cells, buffer.pageLocked);
+    deallocate(buffer.dataTO.particles, buffer.pageLocked);
+    deallocate(buffer.dataTO.auxiliaryData, buffer.pageLocked);
 }
 
-auto _AccessDataTOCache::getArraySizes(DataTO const& dataTO) const -> ArraySizes
+template <typename T>
+T* _AccessDataTOCache::allocate(uint64_t size, bool pageLocked)
 {
-    return {*dataTO.numCells, *dataTO.numParticles, *dataTO.numAuxiliaryData};
+    if (pageLocked) {
+        void* result = nullptr;
+        if (cudaHostAlloc(&result, std::max(uint64_t(1), size) * sizeof(T), cudaHostAllocDefault) != cudaSuccess) {
+            cudaGetLastError();  //reset error state
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(result);
+    }
+    return new T[size];
 }
 
-void _AccessDataTOCache::deleteDataTO(DataTO const& dataTO)
+template <typename T>
+void _AccessDataTOCache::deallocate(T* data, bool pageLocked)
 {
-    delete dataTO.numCells;
-    delete dataTO.numParticles;
-    delete dataTO.numAuxiliaryData;
-    delete[] dataTO.cells;
-    delete[] dataTO.particles;
-    delete[] dataTO.auxiliaryData;
+    if (!data) {
+        return;
+    }
+    if (pageLocked) {
+        cudaFreeHost(data);
+    } else {
+        delete[] data;
+    }
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "Base/Definitions.h"
 
 #include "EngineInterface/ArraySizes.h"
@@ -8,19 +10,56 @@
 
 #include "Definitions.h"
 
+struct AccessDataTOCacheSettings
+{
+    bool pageLockedMemory = false;  //falls back to pageable memory if page-locked memory is not available
+    bool doubleBuffered = false;    //consecutive calls of getDataTO return different buffers, only useful if a TO is still in use when the next one is requested
+    float growthFactor = 1.5f;      //capacity of reallocated arrays in relation to the requested sizes
+};
+
+struct AccessDataTOCacheStatistics
+{
+    uint64_t numRequests = 0;
+    uint64_t numAllocations = 0;
+    uint64_t numAvoidedAllocations = 0;
+    uint64_t allocatedBytes = 0;
+};
+
+/**
+ * Pool of host staging buffers for data transfers from/to the GPU.
+ * Buffers are reused as long as their capacity suffices and grow by a constant factor otherwise.
+ */
 class _AccessDataTOCache
 {
 public:
-    _AccessDataTOCache();
+    _AccessDataTOCache(AccessDataTOCacheSettings const& settings = AccessDataTOCacheSettings());
     ~_AccessDataTOCache();
 
     DataTO getDataTO(ArraySizes const& arraySizes);
 
+    AccessDataTOCacheStatistics const& getStatistics() const;
+
 private:
+    struct Buffer
+    {
+        DataTO dataTO;
+        ArraySizes capacity;
+        bool pageLocked = false;
+    };
+
     bool fits(ArraySizes const& left, ArraySizes const& right) const;
-    ArraySizes getArraySizes(DataTO const& dataTO) const;
-    void deleteDataTO(DataTO const& dataTO);
+    ArraySizes getGrownArraySizes(ArraySizes const& arraySizes) const;
+    uint64_t getNumBytes(ArraySizes const& arraySizes) const;
+    Buffer createBuffer(ArraySizes const& capacity);
+    void deleteBuffer(Buffer const& buffer);
 
-    std::optional<DataTO> _dataTO;
-};
+    template <typename T>
+    T* allocate(uint64_t size, bool pageLocked);
+    template <typename T>
+    void deallocate(T* data, bool pageLocked);
 
+    AccessDataTOCacheSettings _settings;
+    std::vector<std::optional<Buffer>> _buffers;
+    int _currentBufferIndex = 0;
+    AccessDataTOCacheStatistics _statistics;
+};
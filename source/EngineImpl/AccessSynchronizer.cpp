@@ -0,0 +1,74 @@
+#include "AccessSynchronizer.h"
+
+bool AccessSynchronizer::acquire(std::chrono::microseconds const& maxDuration)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    auto threadId = std::this_thread::get_id();
+    if (_accessOwner == threadId) {
+        ++_accessOwnerDepth;
+        return true;
+    }
+
+    ++_numAccessRequests;
+    _workerCondition.notify_one();
+    if (!_accessorCondition.wait_for(lock, maxDuration, [this] { return _isAccessGranted && !_accessOwner; })) {
+        --_numAccessRequests;
+        _workerCondition.notify_one();
+        return false;
+    }
+    _accessOwner = threadId;
+    _accessOwnerDepth = 1;
+    return true;
+}
+
+void AccessSynchronizer::release()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (--_accessOwnerDepth > 0) {
+        return;
+    }
+    _accessOwner.reset();
+    --_numAccessRequests;
+    _accessorCondition.notify_all();
+    _workerCondition.notify_one();
+}
+
+void AccessSynchronizer::allowAccess()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    grantPendingAccesses(lock);
+}
+
+void AccessSynchronizer::wait(std::chrono::steady_clock::time_point const& deadline)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+        grantPendingAccesses(lock);
+        if (_isNotified) {
+            _isNotified = false;
+            return;
+        }
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return;
+        }
+        _workerCondition.wait_until(lock, deadline);
+    }
+}
+
+void AccessSynchronizer::notify()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _isNotified = true;
+    _workerCondition.notify_one();
+}
+
+void AccessSynchronizer::grantPendingAccesses(std::unique_lock<std::mutex>& lock)
+{
+    if (_numAccessRequests == 0) {
+        return;
+    }
+    _isAccessGranted = true;
+    _accessorCondition.notify_all();
+    _workerCondition.wait(lock, [this] { return _numAccessRequests == 0; });
+    _isAccessGranted = false;
+}
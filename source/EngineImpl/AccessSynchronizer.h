@@ -0,0 +1,40 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+/**
+ * Hands over exclusive access from a worker thread to other threads (accessors) without busy waiting.
+ * The worker grants pending access requests at safe points (allowAccess, wait) and blocks until all accessors have
+ * released their access. Acquisition is reentrant for the thread holding the access.
+ */
+class AccessSynchronizer
+{
+public:
+    //accessor side
+    bool acquire(std::chrono::microseconds const& maxDuration);  //returns false on timeout
+    void release();
+
+    //worker side
+    void allowAccess();
+
+    //blocks until the deadline is reached or notify() is called while granting access requests in the meantime
+    void wait(std::chrono::steady_clock::time_point const& deadline);
+    void notify();
+
+private:
+    void grantPendingAccesses(std::unique_lock<std::mutex>& lock);
+
+    std::mutex _mutex;
+    std::condition_variable _workerCondition;
+    std::condition_variable _accessorCondition;
+
+    int _numAccessRequests = 0;  //includes the access being granted
+    bool _isAccessGranted = false;
+    std::optional<std::thread::id> _accessOwner;
+    int _accessOwnerDepth = 0;
+    bool _isNotified = false;
+};
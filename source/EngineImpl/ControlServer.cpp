@@ -0,0 +1,618 @@
+#include "ControlServer.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ranges>
+#include <stdexcept>
+#include <string_view>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include "Base/LoggingService.h"
+#include "EngineInterface/AuxiliaryDataParserService.h"
+#include "EngineInterface/RawStatisticsData.h"
+#include "EngineInterface/SerializerService.h"
+#include "EngineInterface/SimulationController.h"
+
+namespace
+{
+    auto constexpr MaxRequestSize = 1 << 20;
+    auto constexpr MaxPendingOutputSize = 64 << 20;  //clients which do not read their data are disconnected
+    auto constexpr MaxPollTimeout = std::chrono::milliseconds(100);
+
+    class PayloadReader
+    {
+    public:
+        PayloadReader(std::string_view payload)
+            : _payload(payload)
+        {}
+
+        uint32_t readUInt32()
+        {
+            auto bytes = readBytes(4);
+            uint32_t result = 0;
+            for (int i = 3; i >= 0; --i) {
+                result = (result << 8) | static_cast<uint8_t>(bytes[i]);
+            }
+            return result;
+        }
+
+        std::string readString()
+        {
+            auto size = readUInt32();
+            return std::string(readBytes(size));
+        }
+
+        void checkEnd() const
+        {
+            if (_pos != _payload.size()) {
+                throw std::runtime_error("Malformed request.");
+            }
+        }
+
+    private:
+        std::string_view readBytes(size_t size)
+        {
+            if (_payload.size() - _pos < size) {
+                throw std::runtime_error("Malformed request.");
+            }
+            auto result = _payload.substr(_pos, size);
+            _pos += size;
+            return result;
+        }
+
+        std::string_view _payload;
+        size_t _pos = 0;
+    };
+
+    template <typename T>
+    void appendInteger(std::string& data, T value)
+    {
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            data.push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+        }
+    }
+
+    void appendFloat(std::string& data, float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        appendInteger(data, bits);
+    }
+
+    void appendDouble(std::string& data, double value)
+    {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        appendInteger(data, bits);
+    }
+
+    void appendString(std::string& data, std::string const& value)
+    {
+        appendInteger(data, static_cast<uint32_t>(value.size()));
+        data.append(value);
+    }
+
+    std::string encodeStatistics(uint64_t timestep, RawStatisticsData const& statistics)
+    {
+        std::string fields;
+        uint32_t numFields = 0;
+        auto appendField = [&](std::string const& name, auto const& values) {
+            appendString(fields, name);
+            for (int i = 0; i < MAX_COLORS; ++i) {
+                appendDouble(fields, static_cast<double>(values[i]));
+            }
+            ++numFields;
+        };
+        auto const& timestepStatistics = statistics.timeline.timestep;
+        appendField("numCells", timestepStatistics.numCells);
+        appendField("numSelfReplicators", timestepStatistics.numSelfReplicators);
+        appendField("numViruses", timestepStatistics.numViruses);
+        appendField("numConnections", timestepStatistics.numConnections);
+        appendField("numParticles", timestepStatistics.numParticles);
+        appendField("numGenomeCells", timestepStatistics.numGenomeCells);
+        appendField("totalEnergy", timestepStatistics.totalEnergy);
+
+        auto const& accumulatedStatistics = statistics.timeline.accumulated;
+        appendField("numCreatedCells", accumulatedStatistics.numCreatedCells);
+        appendField("numAttacks", accumulatedStatistics.numAttacks);
+        appendField("numMuscleActivities", accumulatedStatistics.numMuscleActivities);
+        appendField("numDefenderActivities", accumulatedStatistics.numDefenderActivities);
+        appendField("numTransmitterActivities", accumulatedStatistics.numTransmitterActivities);
+        appendField("numInjectionActivities", accumulatedStatistics.numInjectionActivities);
+        appendField("numCompletedInjections", accumulatedStatistics.numCompletedInjections);
+        appendField("numNervePulses", accumulatedStatistics.numNervePulses);
+        appendField("numNeuronActivities", accumulatedStatistics.numNeuronActivities);
+        appendField("numSensorActivities", accumulatedStatistics.numSensorActivities);
+        appendField("numSensorMatches", accumulatedStatistics.numSensorMatches);
+        appendField("numReconnectorCreated", accumulatedStatistics.numReconnectorCreated);
+        appendField("numReconnectorRemoved", accumulatedStatistics.numReconnectorRemoved);
+        appendField("numDetonations", accumulatedStatistics.numDetonations);
+
+        std::string result;
+        appendInteger(result, static_cast<uint32_t>(ControlStatisticsFormatVersion));
+        appendInteger(result, timestep);
+        appendInteger(result, static_cast<uint32_t>(MAX_COLORS));
+        appendInteger(result, numFields);
+        result.append(fields);
+        appendInteger(result, static_cast<uint32_t>(statistics.histogram.maxValue));
+        appendInteger(result, static_cast<uint32_t>(MAX_HISTOGRAM_SLOTS));
+        for (int color = 0; color < MAX_COLORS; ++color) {
+            for (int slot = 0; slot < MAX_HISTOGRAM_SLOTS; ++slot) {
+                appendInteger(result, static_cast<uint32_t>(statistics.histogram.numCellsByColorBySlot[color][slot]));
+            }
+        }
+        return result;
+    }
+}
+
+#if defined(_WIN32)
+
+_ControlServer::_ControlServer(SimulationController const& simController, std::string const& socketPath, std::filesystem::path const& saveDirectory)
+{
+    throw std::runtime_error("The control socket is not supported on this platform.");
+}
+
+_ControlServer::~_ControlServer() {}
+
+void _ControlServer::processRequests(std::chrono::milliseconds const& maxWaitTime) {}
+
+bool _ControlServer::isShutdownRequested() const
+{
+    return false;
+}
+
+#else
+
+_ControlServer::_ControlServer(SimulationController const& simController, std::string const& socketPath, std::filesystem::path const& saveDirectory)
+    : _simController(simController)
+    , _socketPath(socketPath)
+    , _saveDirectory(saveDirectory)
+{
+    sockaddr_un address{};
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("The path of the control socket is too long.");
+    }
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+    _listenSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (_listenSocket == -1) {
+        throw std::runtime_error("Could not create the control socket.");
+    }
+
+    //a socket file left over from a terminated process would prevent binding, a socket of a running process is kept
+    std::error_code errorCode;
+    if (std::filesystem::is_socket(socketPath, errorCode)) {
+        auto probeSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+        auto connectResult = connect(probeSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        auto connectError = errno;
+        close(probeSocket);
+        if (connectResult == 0) {
+            close(_listenSocket);
+            throw std::runtime_error("The control socket " + socketPath + " is already in use by another process.");
+        }
+        if (connectError != ECONNREFUSED) {
+            close(_listenSocket);
+            throw std::runtime_error("The existing control socket " + socketPath + " could not be checked: " + std::strerror(connectError));
+        }
+        std::filesystem::remove(socketPath, errorCode);
+    }
+    fcntl(_listenSocket, F_SETFL, O_NONBLOCK);
+
+    //permissions are restricted before listening such that no other user can connect in between
+    if (bind(_listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1 || chmod(socketPath.c_str(), S_IRUSR | S_IWUSR) == -1
+        || listen(_listenSocket, 8) == -1) {
+        close(_listenSocket);
+        std::filesystem::remove(socketPath, errorCode);
+        throw std::runtime_error("Could not bind the control socket to " + socketPath + ".");
+    }
+    if (pipe(_wakeupPipe) == -1) {
+        close(_listenSocket);
+        std::filesystem::remove(socketPath, errorCode);
+        throw std::runtime_error("Could not create the control socket.");
+    }
+    fcntl(_wakeupPipe[0], F_SETFL, O_NONBLOCK);
+    fcntl(_wakeupPipe[1], F_SETFL, O_NONBLOCK);
+    _saveThread = std::thread(&_ControlServer::runSaveThreadLoop, this);
+    _thread = std::thread(&_ControlServer::runThreadLoop, this);
+    log(Priority::Important, "control socket listening on " + socketPath);
+}
+
+_ControlServer::~_ControlServer()
+{
+    _isShutdown = true;
+    wakeupThread();
+    _thread.join();
+
+    //pending saves are completed
+    {
+        std::lock_guard lock(_saveMutex);
+        _isSaveThreadShutdown = true;
+    }
+    _saveJobAvailable.notify_one();
+    _saveThread.join();
+
+    for (auto& client : _clients) {
+        close(client.socket);
+    }
+    close(_listenSocket);
+    close(_wakeupPipe[0]);
+    close(_wakeupPipe[1]);
+    std::error_code errorCode;
+    std::filesystem::remove(_socketPath, errorCode);
+}
+
+void _ControlServer::processRequests(std::chrono::milliseconds const& maxWaitTime)
+{
+    auto waitTime = maxWaitTime;
+    auto now = std::chrono::steady_clock::now();
+    for (auto const& subscription : _statisticsSubscriptions | std::views::values) {
+        auto timeUntilStatistics = std::chrono::duration_cast<std::chrono::milliseconds>(subscription.nextTimepoint - now);
+        waitTime = std::max(std::chrono::milliseconds(0), std::min(waitTime, timeUntilStatistics));
+    }
+
+    std::deque<Request> requests;
+    std::vector<uint64_t> closedClientIds;
+    {
+        std::unique_lock lock(_mutex);
+        _requestsChanged.wait_for(lock, waitTime, [this] { return !_requests.empty() || !_closedClientIds.empty(); });
+        requests.swap(_requests);
+        closedClientIds.swap(_closedClientIds);
+    }
+    for (auto const& clientId : closedClientIds) {
+        _statisticsSubscriptions.erase(clientId);
+    }
+    for (auto const& request : requests) {
+        processRequest(request);
+    }
+    processStatisticsSubscriptions();
+}
+
+bool _ControlServer::isShutdownRequested() const
+{
+    return _isShutdownRequested;
+}
+
+void _ControlServer::runThreadLoop()
+{
+    std::vector<pollfd> pollEntries;
+    std::vector<Request> requests;
+    while (!_isShutdown) {
+        pollEntries.clear();
+        pollEntries.emplace_back(pollfd{_wakeupPipe[0], POLLIN, 0});
+        pollEntries.emplace_back(pollfd{_listenSocket, POLLIN, 0});
+        for (auto const& client : _clients) {
+            short events = POLLIN;
+            if (!client.dataToSend.empty()) {
+                events |= POLLOUT;
+            }
+            pollEntries.emplace_back(pollfd{client.socket, events, 0});
+        }
+        if (poll(pollEntries.data(), pollEntries.size(), static_cast<int>(MaxPollTimeout.count())) == -1 && errno != EINTR) {
+            log(Priority::Important, "control socket: poll failed");
+            return;
+        }
+        if (_isShutdown) {
+            return;
+        }
+        if (pollEntries.at(0).revents & POLLIN) {
+            char buffer[64];
+            while (read(_wakeupPipe[0], buffer, sizeof(buffer)) > 0) {
+            }
+        }
+
+        //clients accepted below are polled in the next iteration
+        requests.clear();
+        auto pollEntry = pollEntries.begin() + 2;
+        for (auto& client : _clients) {
+            if (pollEntry->revents & (POLLIN | POLLHUP | POLLERR)) {
+                receiveData(client, requests);
+            }
+            if (!client.closed && (pollEntry->revents & POLLOUT)) {
+                sendData(client);
+            }
+            ++pollEntry;
+        }
+        distributeResponses();
+        if (pollEntries.at(1).revents & POLLIN) {
+            acceptClients();
+        }
+
+        std::vector<uint64_t> closedClientIds;
+        for (auto it = _clients.begin(); it != _clients.end();) {
+            if (it->closed) {
+                close(it->socket);
+                closedClientIds.emplace_back(it->id);
+                it = _clients.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        if (!requests.empty() || !closedClientIds.empty()) {
+            {
+                std::lock_guard lock(_mutex);
+                _requests.insert(_requests.end(), std::make_move_iterator(requests.begin()), std::make_move_iterator(requests.end()));
+                _closedClientIds.insert(_closedClientIds.end(), closedClientIds.begin(), closedClientIds.end());
+            }
+            _requestsChanged.notify_one();
+        }
+    }
+}
+
+void _ControlServer::acceptClients()
+{
+    while (true) {
+        auto socket = accept(_listenSocket, nullptr, nullptr);
+        if (socket == -1) {
+            return;
+        }
+        fcntl(socket, F_SETFL, O_NONBLOCK);
+        Client client;
+        client.id = _nextClientId++;
+        client.socket = socket;
+        _clients.emplace_back(std::move(client));
+    }
+}
+
+void _ControlServer::receiveData(Client& client, std::vector<Request>& requests)
+{
+    char buffer[4096];
+    while (true) {
+        auto size = recv(client.socket, buffer, sizeof(buffer), 0);
+        if (size > 0) {
+            client.receivedData.append(buffer, size);
+            continue;
+        }
+        if (size == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+            client.closed = true;
+        }
+        break;
+    }
+
+    //extract complete frames
+    size_t pos = 0;
+    while (client.receivedData.size() - pos >= 5) {
+        PayloadReader header(std::string_view(client.receivedData).substr(pos, 4));
+        auto payloadSize = header.readUInt32();
+        if (payloadSize > MaxRequestSize) {
+            client.closed = true;
+            return;
+        }
+        if (client.receivedData.size() - pos < 5 + payloadSize) {
+            break;
+        }
+        auto type = static_cast<ControlRequest>(client.receivedData[pos + 4]);
+        requests.emplace_back(Request{client.id, type, client.receivedData.substr(pos + 5, payloadSize)});
+        pos += 5 + payloadSize;
+    }
+    client.receivedData.erase(0, pos);
+}
+
+void _ControlServer::sendData(Client& client)
+{
+    while (!client.dataToSend.empty()) {
+        auto size = send(client.socket, client.dataToSend.data(), client.dataToSend.size(), MSG_NOSIGNAL);
+        if (size > 0) {
+            client.dataToSend.erase(0, size);
+            continue;
+        }
+        if (size == -1 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+            client.closed = true;
+        }
+        break;
+    }
+    if (client.dataToSend.size() > MaxPendingOutputSize) {
+        client.closed = true;
+    }
+}
+
+void _ControlServer::distributeResponses()
+{
+    std::vector<Response> responses;
+    {
+        std::lock_guard lock(_mutex);
+        responses.swap(_responses);
+    }
+    if (responses.empty()) {
+        return;
+    }
+
+    //responses to clients which are already disconnected are dropped
+    for (auto& client : _clients) {
+        auto hasNewData = false;
+        for (auto const& response : responses) {
+            if (response.clientId == client.id && !client.closed && (!response.skippable || client.dataToSend.empty())) {
+                client.dataToSend.append(response.frame);
+                hasNewData = true;
+            }
+        }
+        if (hasNewData) {
+            sendData(client);
+        }
+    }
+}
+
+void _ControlServer::processRequest(Request const& request)
+{
+    auto clientId = request.clientId;
+    try {
+        PayloadReader reader(request.payload);
+        switch (request.type) {
+        case ControlRequest_GetStatus: {
+            reader.checkEnd();
+            std::string status;
+            appendInteger(status, _simController->getCurrentTimestep());
+            appendFloat(status, _simController->getTps());
+            appendInteger(status, static_cast<uint8_t>(_simController->isSimulationRunning() ? 1 : 0));
+            sendResponse(clientId, ControlResponse_Status, status);
+        } break;
+        case ControlRequest_Pause: {
+            reader.checkEnd();
+            _simController->pauseSimulation();
+            sendResponse(clientId, ControlResponse_Ok);
+        } break;
+        case ControlRequest_Resume: {
+            reader.checkEnd();
+            _simController->runSimulation();
+            sendResponse(clientId, ControlResponse_Ok);
+        } break;
+        case ControlRequest_SetParameters: {
+            std::map<std::string, std::string> overrides;
+            auto numPairs = reader.readUInt32();
+            for (uint32_t i = 0; i < numPairs; ++i) {
+                auto key = reader.readString();
+                overrides.emplace(key, reader.readString());
+            }
+            reader.checkEnd();
+            _simController->setSimulationParameters(
+                AuxiliaryDataParserService::overrideSimulationParameters(_simController->getSimulationParameters(), overrides));
+            sendResponse(clientId, ControlResponse_Ok);
+        } break;
+        case ControlRequest_Save: {
+            auto filename = reader.readString();
+            reader.checkEnd();
+            saveSimulation(clientId, getSavePath(filename));
+        } break;
+        case ControlRequest_GetStatistics: {
+            reader.checkEnd();
+            sendStatistics(clientId);
+        } break;
+        case ControlRequest_SubscribeStatistics: {
+            auto interval = reader.readUInt32();
+            reader.checkEnd();
+            if (interval > 0) {
+                auto subscriptionInterval = std::chrono::milliseconds(interval);
+                _statisticsSubscriptions[clientId] = StatisticsSubscription{subscriptionInterval, std::chrono::steady_clock::now() + subscriptionInterval};
+            } else {
+                _statisticsSubscriptions.erase(clientId);
+            }
+            sendResponse(clientId, ControlResponse_Ok);
+        } break;
+        case ControlRequest_Shutdown: {
+            reader.checkEnd();
+            _isShutdownRequested = true;
+            sendResponse(clientId, ControlResponse_Ok);
+        } break;
+        default:
+            throw std::runtime_error("Unknown request type.");
+        }
+    } catch (std::exception const& e) {
+        sendError(clientId, e.what());
+    }
+}
+
+void _ControlServer::processStatisticsSubscriptions()
+{
+    auto now = std::chrono::steady_clock::now();
+    for (auto& [clientId, subscription] : _statisticsSubscriptions) {
+        if (now < subscription.nextTimepoint) {
+            continue;
+        }
+        //statistics which could not be sent in time are skipped instead of being queued up
+        subscription.nextTimepoint = std::max(subscription.nextTimepoint + subscription.interval, now);
+        sendStatistics(clientId, true);
+    }
+}
+
+void _ControlServer::saveSimulation(uint64_t clientId, std::filesystem::path const& path)
+{
+    //the data is copied within one access to the simulation, converting and writing take place on the save thread
+    auto simulation = std::make_unique<DeserializedSimulation>();
+    simulation->mainData = _simController->getClusteredSimulationData();
+    simulation->auxiliaryData.timestep = _simController->getCurrentTimestep();
+    simulation->auxiliaryData.realTime = _simController->getRealTime();
+    simulation->auxiliaryData.generalSettings = _simController->getGeneralSettings();
+    simulation->auxiliaryData.simulationParameters = _simController->getSimulationParameters();
+    simulation->statistics = _simController->getStatisticsHistory().getCopiedData();
+    {
+        std::lock_guard lock(_saveMutex);
+        _saveJobs.emplace_back(SaveJob{clientId, path, std::move(simulation)});
+    }
+    _saveJobAvailable.notify_one();
+}
+
+void _ControlServer::runSaveThreadLoop()
+{
+    while (true) {
+        SaveJob job;
+        {
+            std::unique_lock lock(_saveMutex);
+            _saveJobAvailable.wait(lock, [this] { return _isSaveThreadShutdown || !_saveJobs.empty(); });
+            if (_saveJobs.empty()) {
+                return;
+            }
+            job = std::move(_saveJobs.front());
+            _saveJobs.pop_front();
+        }
+
+        //the snapshot is released when the job goes out of scope
+        try {
+            if (SerializerService::serializeSimulationToFiles(job.path.string(), *job.simulation)) {
+                sendResponse(job.clientId, ControlResponse_Ok);
+            } else {
+                sendError(job.clientId, "Could not write to " + job.path.string() + ".");
+            }
+        } catch (std::exception const& e) {
+            sendError(job.clientId, e.what());
+        }
+    }
+}
+
+std::filesystem::path _ControlServer::getSavePath(std::string const& filename) const
+{
+    auto path = std::filesystem::path(filename);
+    if (filename.empty() || path.has_root_path()) {
+        throw std::runtime_error("The filename must be relative to the save directory.");
+    }
+
+    //symbolic links and ".." are resolved before checking that the file is located in the save directory
+    auto saveDirectory = std::filesystem::weakly_canonical(_saveDirectory);
+    auto result = std::filesystem::weakly_canonical(saveDirectory / path);
+    auto relativePath = result.lexically_relative(saveDirectory);
+    if (relativePath.empty() || relativePath == "." || *relativePath.begin() == "..") {
+        throw std::runtime_error("The file must be located in the save directory.");
+    }
+    return result;
+}
+
+void _ControlServer::sendStatistics(uint64_t clientId, bool skippable)
+{
+    sendResponse(clientId, ControlResponse_Statistics, encodeStatistics(_simController->getCurrentTimestep(), _simController->getRawStatistics()), skippable);
+}
+
+void _ControlServer::sendError(uint64_t clientId, std::string const& message)
+{
+    std::string payload;
+    appendString(payload, message);
+    sendResponse(clientId, ControlResponse_Error, payload);
+}
+
+void _ControlServer::sendResponse(uint64_t clientId, ControlResponse type, std::string const& payload, bool skippable)
+{
+    Response response{clientId, std::string(), skippable};
+    appendInteger(response.frame, static_cast<uint32_t>(payload.size()));
+    response.frame.push_back(static_cast<char>(type));
+    response.frame.append(payload);
+    {
+        std::lock_guard lock(_mutex);
+        _responses.emplace_back(std::move(response));
+    }
+    wakeupThread();
+}
+
+void _ControlServer::wakeupThread()
+{
+    char byte = 0;
+    [[maybe_unused]] auto result = write(_wakeupPipe[1], &byte, 1);
+}
+
+#endif
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "EngineInterface/Definitions.h"
+#include "EngineInterface/SerializerService.h"
+
+#include "Definitions.h"
+
+/**
+ * Binary protocol of the control socket. All numbers are little endian.
+ * Frame: uint32 payload size, uint8 message type, payload
+ * Strings are encoded as uint32 size followed by the characters.
+ */
+using ControlRequest = uint8_t;
+enum ControlRequest_ : uint8_t
+{
+    ControlRequest_GetStatus,
+    ControlRequest_Pause,
+    ControlRequest_Resume,
+    ControlRequest_SetParameters,  //uint32 number of pairs, pairs of strings (property name as in the settings file, value)
+    ControlRequest_Save,  //string filename relative to the save directory of the server
+    ControlRequest_GetStatistics,
+    ControlRequest_SubscribeStatistics,  //uint32 interval in milliseconds, 0 = unsubscribe
+    ControlRequest_Shutdown
+};
+
+/**
+ * Statistics payload (format version 1):
+ * uint32 format version, uint64 time step, uint32 number of colors,
+ * uint32 number of fields, per field: string name followed by one float64 value per color,
+ * int32 histogram max value, uint32 number of histogram slots, uint32 number of cells per color and slot
+ */
+auto constexpr ControlStatisticsFormatVersion = 1;
+
+using ControlResponse = uint8_t;
+enum ControlResponse_ : uint8_t
+{
+    ControlResponse_Ok,
+    ControlResponse_Error,  //string message
+    ControlResponse_Status,  //uint64 time step, float TPS, uint8 running flag
+    ControlResponse_Statistics  //see above
+};
+
+/**
+ * Serves control requests for a running simulation on a Unix domain socket which is only accessible by the owner.
+ * The clients are handled on a separate thread, while the requests are executed in processRequests such that the
+ * simulation is only accessed from the thread which owns it. Snapshots for save requests are taken with a single data
+ * access to the simulation and are written on a separate thread, such that the simulation is not stalled by the file output.
+ */
+class _ControlServer
+{
+public:
+    _ControlServer(SimulationController const& simController, std::string const& socketPath, std::filesystem::path const& saveDirectory);
+    ~_ControlServer();
+
+    //executes the received requests, waits at most maxWaitTime for new requests if there are none
+    void processRequests(std::chrono::milliseconds const& maxWaitTime);
+
+    bool isShutdownRequested() const;
+
+private:
+    struct Client
+    {
+        uint64_t id = 0;
+        int socket = -1;
+        std::string receivedData;
+        std::string dataToSend;
+        bool closed = false;
+    };
+    struct Request
+    {
+        uint64_t clientId = 0;
+        ControlRequest type = ControlRequest_GetStatus;
+        std::string payload;
+    };
+    struct Response
+    {
+        uint64_t clientId = 0;
+        std::string frame;
+        bool skippable = false;  //skipped if the client has not yet read its previous data
+    };
+    struct StatisticsSubscription
+    {
+        std::chrono::milliseconds interval;
+        std::chrono::steady_clock::time_point nextTimepoint;
+    };
+    struct SaveJob
+    {
+        uint64_t clientId = 0;
+        std::filesystem::path path;
+        std::unique_ptr<DeserializedSimulation> simulation;
+    };
+
+    //socket thread
+    void runThreadLoop();
+    void acceptClients();
+    void receiveData(Client& client, std::vector<Request>& requests);
+    void sendData(Client& client);
+    void distributeResponses();
+
+    //thread calling processRequests
+    void processRequest(Request const& request);
+    void processStatisticsSubscriptions();
+    void saveSimulation(uint64_t clientId, std::filesystem::path const& path);
+    void runSaveThreadLoop();
+    std::filesystem::path getSavePath(std::string const& filename) const;
+    void sendStatistics(uint64_t clientId, bool skippable = false);
+    void sendError(uint64_t clientId, std::string const& message);
+
+    //thread-safe
+    void sendResponse(uint64_t clientId, ControlResponse type, std::string const& payload = std::string(), bool skippable = false);
+    void wakeupThread();
+
+    SimulationController _simController;
+    std::string _socketPath;
+    std::filesystem::path _saveDirectory;
+    int _listenSocket = -1;
+    int _wakeupPipe[2] = {-1, -1};
+
+    std::list<Client> _clients;
+    uint64_t _nextClientId = 0;
+
+    //shared between both threads
+    std::mutex _mutex;
+    std::condition_variable _requestsChanged;
+    std::deque<Request> _requests;
+    std::vector<uint64_t> _closedClientIds;
+    std::vector<Response> _responses;
+
+    std::map<uint64_t, StatisticsSubscription> _statisticsSubscriptions;
+
+    //saves are written one after another on a separate thread such that the responses keep their order
+    std::mutex _saveMutex;
+    std::condition_variable _saveJobAvailable;
+    std::deque<SaveJob> _saveJobs;
+    bool _isSaveThreadShutdown = false;
+    std::thread _saveThread;
+
+    std::atomic<bool> _isShutdown{false};
+    std::atomic<bool> _isShutdownRequested{false};
+    std::thread _thread;
+};
@@ -0,0 +1,402 @@
+#include "CpuSimulation.h"
+
+#include <algorithm>
+
+#include "Base/Math.h"
+
+#include "DescriptionConverter.h"
+
+namespace
+{
+    size_t constexpr ChunkSize = 1024;  //number of objects processed by a thread at once
+
+    RealVector2D toRealVector2D(float2 const& value)
+    {
+        return {value.x, value.y};
+    }
+
+    float2 toFloat2(RealVector2D const& value)
+    {
+        return {value.x, value.y};
+    }
+
+    RealVector2D normalized(RealVector2D value)
+    {
+        Math::normalize(value);
+        return value;
+    }
+
+    void deleteConnectionOneWay(CellTO& cell, int connectedCellIndex)
+    {
+        for (int i = 0; i < cell.numConnections; ++i) {
+            if (cell.connections[i].cellIndex == connectedCellIndex) {
+                auto angleToAdd = cell.connections[i].angleFromPrevious;
+                for (int j = i; j < cell.numConnections - 1; ++j) {
+                    cell.connections[j] = cell.connections[j + 1];
+                }
+                if (i < cell.numConnections - 1) {
+                    cell.connections[i].angleFromPrevious += angleToAdd;
+                } else {
+                    cell.connections[0].angleFromPrevious += angleToAdd;
+                }
+                --cell.numConnections;
+                return;
+            }
+        }
+    }
+}
+
+_CpuSimulation::_CpuSimulation(uint64_t timestep, Settings const& settings, int maxThreads)
+    : _settings(settings)
+    , _spaceCalculator({settings.generalSettings.worldSizeX, settings.generalSettings.worldSizeY})
+    , _maxThreads(maxThreads)
+    , _threadPool(maxThreads)
+    , _timestep(timestep)
+{}
+
+void _CpuSimulation::calcTimesteps(uint64_t timesteps)
+{
+    for (uint64_t i = 0; i < timesteps; ++i) {
+        calcTimestep();
+    }
+}
+
+ClusteredDataDescription _CpuSimulation::getClusteredSimulationData()
+{
+    DescriptionConverter converter(_settings.simulationParameters, _maxThreads);
+    return converter.convertTOtoClusteredDataDescription(getDataTO());
+}
+
+DataDescription _CpuSimulation::getSimulationData()
+{
+    DescriptionConverter converter(_settings.simulationParameters, _maxThreads);
+    return converter.convertTOtoDataDescription(getDataTO());
+}
+
+void _CpuSimulation::setClusteredSimulationData(ClusteredDataDescription const& data)
+{
+    DescriptionConverter converter(_settings.simulationParameters, _maxThreads);
+    setDataIntern(data, converter.getArraySizes(data));
+}
+
+void _CpuSimulation::setSimulationData(DataDescription const& data)
+{
+    DescriptionConverter converter(_settings.simulationParameters, _maxThreads);
+    setDataIntern(data, converter.getArraySizes(data));
+}
+
+void _CpuSimulation::clear()
+{
+    _numCells = 0;
+    _numParticles = 0;
+    _numAuxiliaryData = 0;
+    _cells.clear();
+    _particles.clear();
+    _auxiliaryData.clear();
+}
+
+uint64_t _CpuSimulation::getCurrentTimestep() const
+{
+    return _timestep;
+}
+
+void _CpuSimulation::setCurrentTimestep(uint64_t value)
+{
+    _timestep = value;
+}
+
+SimulationParameters const& _CpuSimulation::getSimulationParameters() const
+{
+    return _settings.simulationParameters;
+}
+
+void _CpuSimulation::setSimulationParameters(SimulationParameters const& parameters)
+{
+    _settings.simulationParameters = parameters;
+}
+
+void _CpuSimulation::calcTimestep()
+{
+    _forces.assign(_numCells, RealVector2D());
+    _prevForces.assign(_numCells, RealVector2D());
+
+    //same order as in _SimulationKernelsLauncher::calcTimestep
+    limitVelocities();
+    moveParticles();
+    calcConnectionForces();
+    verletPositionUpdate();
+    removeOverstretchedConnections();
+    calcConnectionForces();
+    verletVelocityUpdate();
+    applyFriction();
+    livingStateTransition();
+    decay();
+
+    ++_timestep;
+}
+
+void _CpuSimulation::limitVelocities()
+{
+    auto const& parameters = _settings.simulationParameters;
+    _threadPool.forEachInChunks(_numCells, ChunkSize, [&](size_t index) {
+        auto& cell = _cells[index];
+        if (cell.barrier) {
+            return;
+        }
+        auto vel = toRealVector2D(cell.vel);
+        if (Math::length(vel) > parameters.cellMaxVelocity) {
+            cell.vel = toFloat2(normalized(vel) * parameters.cellMaxVelocity);
+        }
+    });
+}
+
+void _CpuSimulation::moveParticles()
+{
+    auto const& parameters = _settings.simulationParameters;
+    _threadPool.forEachInChunks(_numParticles, ChunkSize, [&](size_t index) {
+        auto& particle = _particles[index];
+        auto pos = toRealVector2D(particle.pos) + toRealVector2D(particle.vel) * parameters.timestepSize;
+        particle.pos = toFloat2(_spaceCalculator.getCorrectedPosition(pos));
+    });
+}
+
+void _CpuSimulation::calcConnectionForces()
+{
+    //each thread only writes the force of its own cell, angular forces would also affect connected cells and are omitted
+    _threadPool.forEachInChunks(_numCells, ChunkSize, [&](size_t index) {
+        auto const& cell = _cells[index];
+        RealVector2D force;
+        if (cell.numConnections > 0 && !cell.barrier) {
+            auto pos = toRealVector2D(cell.pos);
+            auto cellStiffnessSquared = cell.stiffness * cell.stiffness;
+            for (int i = 0; i < cell.numConnections; ++i) {
+                auto const& connection = cell.connections[i];
+                auto const& connectedCell = _cells[connection.cellIndex];
+                auto connectedCellStiffnessSquared = connectedCell.stiffness * connectedCell.stiffness;
+
+                auto displacement = _spaceCalculator.getCorrectedDirection(toRealVector2D(connectedCell.pos) - pos);
+                auto deviation = Math::length(displacement) - connection.distance;
+                force += normalized(displacement) * deviation * (cellStiffnessSquared + connectedCellStiffnessSquared) / 6;
+            }
+        }
+        _forces[index] = force;
+    });
+}
+
+void _CpuSimulation::verletPositionUpdate()
+{
+    auto const& parameters = _settings.simulationParameters;
+    _threadPool.forEachInChunks(_numCells, ChunkSize, [&](size_t index) {
+        auto& cell = _cells[index];
+        auto pos = toRealVector2D(cell.pos) + toRealVector2D(cell.vel) * parameters.timestepSize;
+        if (!cell.barrier) {
+            pos += _forces[index] * parameters.timestepSize * parameters.timestepSize / 2;
+            _prevForces[index] = _forces[index];
+        }
+        cell.pos = toFloat2(_spaceCalculator.getCorrectedPosition(pos));
+    });
+}
+
+void _CpuSimulation::verletVelocityUpdate()
+{
+    auto const& parameters = _settings.simulationParameters;
+    _threadPool.forEachInChunks(_numCells, ChunkSize, [&](size_t index) {
+        auto& cell = _cells[index];
+        if (cell.barrier) {
+            return;
+        }
+        auto acceleration = (_forces[index] + _prevForces[index]) / 2;
+        cell.vel = toFloat2(toRealVector2D(cell.vel) + acceleration * parameters.timestepSize);
+    });
+}
+
+void _CpuSimulation::removeOverstretchedConnections()
+{
+    auto const& parameters = _settings.simulationParameters;
+
+    //detection in parallel
+    std::vector<uint8_t> scheduledForDestruction(_numCells, 0);
+    _threadPool.forEachInChunks(_numCells, ChunkSize, [&](size_t index) {
+        auto const& cell = _cells[index];
+        if (cell.barrier) {
+            return;
+        }
+        for (int i = 0; i < cell.numConnections; ++i) {
+            auto const& connectedCell = _cells[cell.connections[i].cellIndex];
+            if (_spaceCalculator.distance(toRealVector2D(cell.pos), toRealVector2D(connectedCell.pos)) > parameters.cellMaxBindingDistance) {
+                scheduledForDestruction[index] = 1;
+            }
+        }
+    });
+
+    //structural operations sequentially since they affect multiple cells
+    for (uint64_t index = 0; index < _numCells; ++index) {
+        if (!scheduledForDestruction[index]) {
+            continue;
+        }
+        auto& cell = _cells[index];
+        for (int i = 0; i < cell.numConnections; ++i) {
+            auto& connectedCell = _cells[cell.connections[i].cellIndex];
+            if (parameters.clusterDecay) {
+                cell.livingState = LivingState_Dying;
+                connectedCell.livingState = LivingState_Dying;
+            }
+            deleteConnectionOneWay(connectedCell, toInt(index));
+        }
+        cell.numConnections = 0;
+    }
+}
+
+void _CpuSimulation::applyFriction()
+{
+    auto friction = _settings.simulationParameters.baseValues.friction;
+    _threadPool.forEachInChunks(_numCells, ChunkSize, [&](size_t index) {
+        auto& cell = _cells[index];
+        if (!cell.barrier) {
+            cell.vel = toFloat2(toRealVector2D(cell.vel) * (1.0f - friction));
+        }
+    });
+}
+
+void _CpuSimulation::livingStateTransition()
+{
+    //each thread only changes the state of its own cell, the new states are applied afterwards
+    std::vector<uint8_t> becomesDying(_numCells, 0);
+    _threadPool.forEachInChunks(_numCells, ChunkSize, [&](size_t index) {
+        auto const& cell = _cells[index];
+        if (cell.livingState == LivingState_Dying) {
+            return;
+        }
+        for (int i = 0; i < cell.numConnections; ++i) {
+            auto const& connectedCell = _cells[cell.connections[i].cellIndex];
+            if (connectedCell.livingState == LivingState_Dying
+                && (connectedCell.creatureId == cell.creatureId || cell.livingState == LivingState_UnderConstruction)) {
+                becomesDying[index] = 1;
+            }
+        }
+    });
+
+    for (uint64_t index = 0; index < _numCells; ++index) {
+        if (becomesDying[index]) {
+            _cells[index].livingState = LivingState_Dying;
+        }
+    }
+}
+
+void _CpuSimulation::decay()
+{
+    auto const& parameters = _settings.simulationParameters;
+
+    //sequentially such that the random numbers do not depend on the number of threads
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    std::vector<uint8_t> scheduledForDeletion(_numCells, 0);
+    auto hasDeletions = false;
+    for (uint64_t index = 0; index < _numCells; ++index) {
+        auto& cell = _cells[index];
+        if (cell.barrier) {
+            continue;
+        }
+        if (cell.livingState == LivingState_Dying && distribution(_randomGenerator) < parameters.clusterDecayProb[cell.color]) {
+            scheduledForDeletion[index] = 1;
+        }
+        if (cell.energy < parameters.baseValues.cellMinEnergy[cell.color]) {
+            if (parameters.clusterDecay) {
+                cell.livingState = LivingState_Dying;
+            } else if (distribution(_randomGenerator) < parameters.clusterDecayProb[cell.color]) {
+                scheduledForDeletion[index] = 1;
+            }
+        }
+        hasDeletions |= scheduledForDeletion[index] != 0;
+    }
+    if (hasDeletions) {
+        deleteCells(scheduledForDeletion);
+    }
+}
+
+void _CpuSimulation::deleteCells(std::vector<uint8_t> const& scheduledForDeletion)
+{
+    std::vector<int> newCellIndices(_numCells, -1);
+    uint64_t numRemainingCells = 0;
+    for (uint64_t index = 0; index < _numCells; ++index) {
+        if (scheduledForDeletion[index]) {
+            radiate(_cells[index]);
+        } else {
+            newCellIndices[index] = toInt(numRemainingCells++);
+        }
+    }
+
+    //remaining cells are moved to the front, new indices are never larger than the old ones
+    for (uint64_t index = 0; index < _numCells; ++index) {
+        if (scheduledForDeletion[index]) {
+            continue;
+        }
+        auto cell = _cells[index];
+        for (int i = cell.numConnections - 1; i >= 0; --i) {
+            if (newCellIndices[cell.connections[i].cellIndex] == -1) {
+                deleteConnectionOneWay(cell, cell.connections[i].cellIndex);
+            }
+        }
+        for (int i = 0; i < cell.numConnections; ++i) {
+            cell.connections[i].cellIndex = newCellIndices[cell.connections[i].cellIndex];
+        }
+        _cells[newCellIndices[index]] = cell;
+    }
+    _numCells = numRemainingCells;
+}
+
+void _CpuSimulation::radiate(CellTO const& cell)
+{
+    if (cell.energy <= 0) {
+        return;
+    }
+    if (_numParticles == _particles.size()) {
+        _particles.resize(std::max(_particles.size() * 2, ChunkSize));
+    }
+    auto& particle = _particles[_numParticles++];
+    particle.id = _nextObjectId++;
+    particle.energy = cell.energy;
+    particle.pos = cell.pos;
+    particle.vel = cell.vel;
+    particle.color = cell.color;
+    particle.selected = 0;
+}
+
+template <typename Data>
+void _CpuSimulation::setDataIntern(Data const& data, ArraySizes const& arraySizes)
+{
+    clear();
+    _cells.resize(arraySizes.cellArraySize);
+    _particles.resize(arraySizes.particleArraySize);
+    _auxiliaryData.resize(arraySizes.auxiliaryDataSize);
+
+    DescriptionConverter converter(_settings.simulationParameters, _maxThreads);
+    auto dataTO = getDataTO();
+    converter.convertDescriptionToTO(dataTO, data);
+
+    for (uint64_t i = 0; i < _numCells; ++i) {
+        _cells[i].pos = toFloat2(_spaceCalculator.getCorrectedPosition(toRealVector2D(_cells[i].pos)));
+    }
+    for (uint64_t i = 0; i < _numParticles; ++i) {
+        _particles[i].pos = toFloat2(_spaceCalculator.getCorrectedPosition(toRealVector2D(_particles[i].pos)));
+    }
+
+    _nextObjectId = 1;
+    for (uint64_t i = 0; i < _numCells; ++i) {
+        _nextObjectId = std::max(_nextObjectId, _cells[i].id + 1);
+    }
+    for (uint64_t i = 0; i < _numParticles; ++i) {
+        _nextObjectId = std::max(_nextObjectId, _particles[i].id + 1);
+    }
+}
+
+DataTO _CpuSimulation::getDataTO()
+{
+    DataTO result;
+    result.numCells = &_numCells;
+    result.cells = _cells.data();
+    result.numParticles = &_numParticles;
+    result.particles = _particles.data();
+    result.numAuxiliaryData = &_numAuxiliaryData;
+    result.auxiliaryData = _auxiliaryData.data();
+    return result;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <random>
+#include <vector>
+
+#include "Base/Definitions.h"
+#include "Base/ThreadPool.h"
+#include "Base/Vector2D.h"
+
+#include "EngineInterface/ArraySizes.h"
+#include "EngineInterface/Definitions.h"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/Settings.h"
+#include "EngineInterface/SpaceCalculator.h"
+#include "EngineGpuKernels/TOs.cuh"
+
+#include "Definitions.h"
+
+/**
+ * Experimental simulation on the host which runs without a GPU. It is not a replacement for the GPU backend and is only
+ * reachable via the hidden --experimental-cpu option of the CLI. Objects are stored in the same transfer objects that
+ * are used for data exchange with the GPU and processed on a thread pool.
+ *
+ * Only a subset of the GPU pipeline is ported:
+ * - physics: forces of connections (without angular forces), Verlet integration, velocity limit and friction
+ *   of the base parameters (spots are not considered), particle movement
+ * - structural operations: connections exceeding the maximum binding distance are removed
+ * - decay: dying states are passed on within creatures, dying cells and cells below the minimum energy are removed
+ *   and their energy is radiated at their position (radiation sources are not considered)
+ * Collisions, fluid dynamics, cell functions, aging and the creation of cells are not available, hence the results differ
+ * from the GPU backend.
+ */
+class _CpuSimulation
+{
+public:
+    _CpuSimulation(uint64_t timestep, Settings const& settings, int maxThreads = 0);
+
+    void calcTimesteps(uint64_t timesteps);
+
+    ClusteredDataDescription getClusteredSimulationData();
+    DataDescription getSimulationData();
+    void setClusteredSimulationData(ClusteredDataDescription const& data);
+    void setSimulationData(DataDescription const& data);
+    void clear();
+
+    uint64_t getCurrentTimestep() const;
+    void setCurrentTimestep(uint64_t value);
+
+    SimulationParameters const& getSimulationParameters() const;
+    void setSimulationParameters(SimulationParameters const& parameters);
+
+private:
+    void calcTimestep();
+
+    void limitVelocities();  //external forces of the GPU pipeline (force fields of spots) are not ported
+    void moveParticles();
+    void calcConnectionForces();
+    void verletPositionUpdate();
+    void verletVelocityUpdate();
+    void removeOverstretchedConnections();
+    void applyFriction();
+    void livingStateTransition();
+    void decay();
+    void deleteCells(std::vector<uint8_t> const& scheduledForDeletion);
+    void radiate(CellTO const& cell);
+
+    template <typename Data>
+    void setDataIntern(Data const& data, ArraySizes const& arraySizes);
+    DataTO getDataTO();
+
+    Settings _settings;
+    SpaceCalculator _spaceCalculator;
+    int _maxThreads = 0;
+    ThreadPool _threadPool;  //threads are reused for all phases of all time steps
+    uint64_t _timestep = 0;
+
+    uint64_t _numCells = 0;
+    uint64_t _numParticles = 0;
+    uint64_t _numAuxiliaryData = 0;
+    std::vector<CellTO> _cells;
+    std::vector<ParticleTO> _particles;
+    std::vector<uint8_t> _auxiliaryData;
+
+    std::vector<RealVector2D> _forces;
+    std::vector<RealVector2D> _prevForces;
+
+    uint64_t _nextObjectId = 1;  //for radiated particles
+    std::mt19937 _randomGenerator;  //default seed such that runs are reproducible
+};
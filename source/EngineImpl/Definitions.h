@@ -4,3 +4,9 @@
 
 class _AccessDataTOCache;
 using AccessDataTOCache = std::shared_ptr<_AccessDataTOCache>;
+
+class _ControlServer;
+using ControlServer = std::shared_ptr<_ControlServer>;
+
+class _CpuSimulation;
+using CpuSimulation = std::shared_ptr<_CpuSimulation>;
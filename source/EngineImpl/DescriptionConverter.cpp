@@ -1,23 +1,19 @@
 #include "DescriptionConverter.h"
 
 #include <cmath>
+#include <cstring>
 #include <algorithm>
-#include <boost/range/adaptor/map.hpp>
+#include <numeric>
 
 #include "Base/NumberGenerator.h"
 #include "Base/Exceptions.h"
+#include "Base/ParallelExecution.h"
 #include "EngineInterface/Descriptions.h"
 #include "EngineInterface/GenomeConstants.h"
 
 
 namespace
 {
-    union BytesAsFloat
-    {
-        float f;
-        uint8_t b[4];
-    };
-
     void convert(DataTO const& dataTO, uint64_t sourceSize, uint64_t sourceIndex, std::vector<uint8_t>& target)
     {
         target.resize(sourceSize);
@@ -26,83 +22,49 @@ namespace
         }
     }
 
-    void convert(DataTO const& dataTO, uint64_t sourceSize, uint64_t sourceIndex, std::vector<float>& target)
-    {
-        BytesAsFloat bytesAsFloat;
-        target.resize(sourceSize / 4);
-        for (uint64_t i = 0; i < sourceSize / 4; ++i) {
-            for (int j = 0; j < 4; ++j) {
-                bytesAsFloat.b[j] = dataTO.auxiliaryData[sourceIndex + i * 4 + j];
-            }
-            target[i] = bytesAsFloat.f;
-        }
-    }
-
+    //writes the source at auxiliaryDataIndex and advances it
     template<typename Container, typename SizeType>
-    void convert(DataTO const& dataTO, Container const& source, SizeType& targetSize, uint64_t& targetIndex)
+    void convert(DataTO const& dataTO, Container const& source, SizeType& targetSize, uint64_t& targetIndex, uint64_t& auxiliaryDataIndex)
     {
         targetSize = source.size();
         if (targetSize > 0) {
-            targetIndex = *dataTO.numAuxiliaryData;
+            targetIndex = auxiliaryDataIndex;
             uint64_t size = source.size();
             for (uint64_t i = 0; i < size; ++i) {
                 dataTO.auxiliaryData[targetIndex + i] = source.at(i);
             }
-            (*dataTO.numAuxiliaryData) += size;
+            auxiliaryDataIndex += size;
         }
     }
 
-    template <>
-    void convert(DataTO const& dataTO, std::vector<float> const& source, int& targetSize, uint64_t& targetIndex)
-    {
-        BytesAsFloat bytesAsFloat;
-        targetSize = source.size() * 4;
-        if (targetSize > 0) {
-            targetIndex = *dataTO.numAuxiliaryData;
-            uint64_t size = source.size();
-            for (uint64_t i = 0; i < size; ++i) {
-                bytesAsFloat.f = source.at(i);
-                for (int j = 0; j < 4; ++j) {
-                    dataTO.auxiliaryData[targetIndex + i * 4 + j] = bytesAsFloat.b[j];
-                }
-            }
-            (*dataTO.numAuxiliaryData) += targetSize;
-        }
-    }
+    //weights and biases are stored in the layout of the auxiliary data and copied as a whole
+    static_assert(sizeof(NeuronWeights) + sizeof(NeuronBiases) == sizeof(float) * MAX_CHANNELS * (MAX_CHANNELS + 1));
 
-    std::vector<float> unitWeightsAndBias(std::vector<std::vector<float>> const& weights, std::vector<float> const& bias)
+    void convertWeightsAndBiases(
+        DataTO const& dataTO,
+        NeuronWeights const& weights,
+        NeuronBiases const& biases,
+        uint64_t& targetIndex,
+        uint64_t& auxiliaryDataIndex)
     {
-        std::vector<float> result(MAX_CHANNELS * MAX_CHANNELS + MAX_CHANNELS, 0);
-        for (int row = 0; row < MAX_CHANNELS; ++row) {
-            for (int col = 0; col < MAX_CHANNELS; ++col) {
-                result[col + row * MAX_CHANNELS] = weights[row][col];
-            }
-        }
-        for (int col = 0; col < MAX_CHANNELS; ++col) {
-            result[col + MAX_CHANNELS * MAX_CHANNELS] = bias[col];
-        }
-
-        return result;
+        targetIndex = auxiliaryDataIndex;
+        std::memcpy(dataTO.auxiliaryData + targetIndex, weights.data(), sizeof(NeuronWeights));
+        std::memcpy(dataTO.auxiliaryData + targetIndex + sizeof(NeuronWeights), biases.data(), sizeof(NeuronBiases));
+        auxiliaryDataIndex += sizeof(NeuronWeights) + sizeof(NeuronBiases);
     }
 
-    std::pair<std::vector<std::vector<float>>, std::vector<float>> splitWeightsAndBias(std::vector<float> const& weightsAndBias)
+    void convertWeightsAndBiases(DataTO const& dataTO, uint64_t sourceIndex, NeuronWeights& weights, NeuronBiases& biases)
     {
-        std::vector<std::vector<float>> weights(MAX_CHANNELS, std::vector<float>(MAX_CHANNELS, 0));
-        for (int row = 0; row < MAX_CHANNELS; ++row) {
-            for (int col = 0; col < MAX_CHANNELS; ++col) {
-                weights[row][col] = weightsAndBias[col + row * MAX_CHANNELS];
-            }
-        }
-
-        std::vector<float> bias;
-        bias = std::vector<float>(weightsAndBias.begin() + MAX_CHANNELS * MAX_CHANNELS, weightsAndBias.end());
-
-        return std::make_pair(weights, bias);
+        std::memcpy(weights.data(), dataTO.auxiliaryData + sourceIndex, sizeof(NeuronWeights));
+        std::memcpy(biases.data(), dataTO.auxiliaryData + sourceIndex + sizeof(NeuronWeights), sizeof(NeuronBiases));
     }
+
+    size_t constexpr ChunkSize = 1024;  //number of objects processed by a thread at once
 }
 
-DescriptionConverter::DescriptionConverter(SimulationParameters const& parameters)
+DescriptionConverter::DescriptionConverter(SimulationParameters const& parameters, int maxThreads)
     : _parameters(parameters)
+    , _maxThreads(maxThreads)
 {}
 
 ArraySizes DescriptionConverter::getArraySizes(DataDescription const& data) const
@@ -133,42 +95,27 @@ ClusteredDataDescription DescriptionConverter::convertTOtoClusteredDataDescripti
 {
 	ClusteredDataDescription result;
 
-    //cells
-    std::vector<ClusterDescription> clusters;
-    std::unordered_set<int> freeCellIndices;
-    for (int i = 0; i < *dataTO.numCells; ++i) {
-        freeCellIndices.insert(i);
+    //cells: clusters are ordered by their first cell and cells keep their order inside a cluster
+    auto numCells = toInt(*dataTO.numCells);
+    int numClusters = 0;
+    auto clusterIndices = calcClusterIndices(dataTO, numClusters);
+
+    std::vector<int> cellDescIndices(numCells);
+    std::vector<int> clusterSizes(numClusters, 0);
+    for (int i = 0; i < numCells; ++i) {
+        cellDescIndices[i] = clusterSizes[clusterIndices[i]]++;
     }
-    std::unordered_map<int, int> cellTOIndexToCellDescIndex;
-    std::unordered_map<int, int> cellTOIndexToClusterDescIndex;
-    int clusterDescIndex = 0;
-    while (!freeCellIndices.empty()) {
-        auto freeCellIndex = *freeCellIndices.begin();
-        auto createClusterData = scanAndCreateClusterDescription(dataTO, freeCellIndex, freeCellIndices);
-        clusters.emplace_back(createClusterData.cluster);
-
-        //update index maps
-        cellTOIndexToCellDescIndex.insert(
-            createClusterData.cellTOIndexToCellDescIndex.begin(), createClusterData.cellTOIndexToCellDescIndex.end());
-        for (auto const& cellTOIndex : createClusterData.cellTOIndexToCellDescIndex | boost::adaptors::map_keys) {
-            cellTOIndexToClusterDescIndex.emplace(cellTOIndex, clusterDescIndex);
-        }
-        ++clusterDescIndex;
+    result.clusters.resize(numClusters);
+    for (int i = 0; i < numClusters; ++i) {
+        result.clusters[i].cells.resize(clusterSizes[i]);
     }
-    result.addClusters(clusters);
+    ParallelExecution::forEachInChunks(numCells, ChunkSize, [&](size_t index) {
+        auto cellIndex = toInt(index);
+        result.clusters[clusterIndices[cellIndex]].cells[cellDescIndices[cellIndex]] = createCellDescription(dataTO, cellIndex);
+    }, _maxThreads);
 
     //particles
-    std::vector<ParticleDescription> particles;
-    for (int i = 0; i < *dataTO.numParticles; ++i) {
-        ParticleTO const& particle = dataTO.particles[i];
-        particles.emplace_back(ParticleDescription()
-                                   .setId(particle.id)
-                                   .setPos({particle.pos.x, particle.pos.y})
-                                   .setVel({particle.vel.x, particle.vel.y})
-                                   .setEnergy(particle.energy)
-                                   .setColor(particle.color));
-    }
-    result.addParticles(particles);
+    result.particles = createParticleDescriptions(dataTO);
 
     return result;
 }
@@ -178,24 +125,12 @@ DataDescription DescriptionConverter::convertTOtoDataDescription(DataTO const& d
     DataDescription result;
 
     //cells
-    std::vector<CellDescription> cells;
-    for (int i = 0; i < *dataTO.numCells; ++i) {
-        cells.emplace_back(createCellDescription(dataTO, i));
-    }
-    result.addCells(cells);
+    result.cells.resize(*dataTO.numCells);
+    ParallelExecution::forEachInChunks(
+        *dataTO.numCells, ChunkSize, [&](size_t index) { result.cells[index] = createCellDescription(dataTO, toInt(index)); }, _maxThreads);
 
     //particles
-    std::vector<ParticleDescription> particles;
-    for (int i = 0; i < *dataTO.numParticles; ++i) {
-        ParticleTO const& particle = dataTO.particles[i];
-        particles.emplace_back(ParticleDescription()
-                                   .setId(particle.id)
-                                   .setPos({particle.pos.x, particle.pos.y})
-                                   .setVel({particle.vel.x, particle.vel.y})
-                                   .setEnergy(particle.energy)
-                                   .setColor(particle.color));
-    }
-    result.addParticles(particles);
+    result.particles = createParticleDescriptions(dataTO);
 
     return result;
 }
@@ -230,19 +165,13 @@ OverlayDescription DescriptionConverter::convertTOtoOverlayDescription(DataTO co
 
 void DescriptionConverter::convertDescriptionToTO(DataTO& result, ClusteredDataDescription const& description) const
 {
-    std::unordered_map<uint64_t, int> cellIndexByIds;
-    for (auto const& cluster: description.clusters) {
-        for (auto const& cell : cluster.cells) {
-            addCell(result, cell, cellIndexByIds);
-        }
-    }
+    std::vector<CellDescription const*> cells;
     for (auto const& cluster : description.clusters) {
         for (auto const& cell : cluster.cells) {
-            if (cell.id != 0) {
-                setConnections(result, cell, cellIndexByIds);
-            }
+            cells.emplace_back(&cell);
         }
     }
+    addCells(result, cells, true);
     for (auto const& particle : description.particles) {
         addParticle(result, particle);
     }
@@ -250,15 +179,12 @@ void DescriptionConverter::convertDescriptionToTO(DataTO& result, ClusteredDataD
 
 void DescriptionConverter::convertDescriptionToTO(DataTO& result, DataDescription const& description) const
 {
-    std::unordered_map<uint64_t, int> cellIndexByIds;
+    std::vector<CellDescription const*> cells;
+    cells.reserve(description.cells.size());
     for (auto const& cell : description.cells) {
-        addCell(result, cell, cellIndexByIds);
-    }
-    for (auto const& cell : description.cells) {
-        if (cell.id != 0) {
-            setConnections(result, cell, cellIndexByIds);
-        }
+        cells.emplace_back(&cell);
     }
+    addCells(result, cells, true);
     for (auto const& particle : description.particles) {
         addParticle(result, particle);
     }
@@ -266,8 +192,7 @@ void DescriptionConverter::convertDescriptionToTO(DataTO& result, DataDescriptio
 
 void DescriptionConverter::convertDescriptionToTO(DataTO& result, CellDescription const& cell) const
 {
-    std::unordered_map<uint64_t, int> cellIndexByIds;
-    addCell(result, cell, cellIndexByIds);
+    addCells(result, {&cell}, false);
 }
 
 void DescriptionConverter::convertDescriptionToTO(DataTO& result, ParticleDescription const& particle) const
@@ -307,56 +232,40 @@ void DescriptionConverter::addAdditionalDataSizeForCell(CellDescription const& c
     }
 }    
 
-namespace
+std::vector<int> DescriptionConverter::calcClusterIndices(DataTO const& dataTO, int& numClusters) const
 {
-    template <typename T>
-    void setInplaceDifference(std::unordered_set<T>& a, std::unordered_set<T> const& b)
-    {
-        for (auto const& element : b) {
-            a.erase(element);
+    auto numCells = toInt(*dataTO.numCells);
+
+    //union-find over the connections where the root is always the smallest cell index of a component
+    std::vector<int> parents(numCells);
+    std::iota(parents.begin(), parents.end(), 0);
+    auto findRoot = [&](int index) {
+        while (parents[index] != index) {
+            parents[index] = parents[parents[index]];
+            index = parents[index];
         }
-    }
-}
-
-auto DescriptionConverter::scanAndCreateClusterDescription(
-    DataTO const& dataTO,
-    int startCellIndex,
-    std::unordered_set<int>& freeCellIndices) const
-    -> CreateClusterReturnData
-{
-    CreateClusterReturnData result; 
-
-    std::unordered_set<int> currentCellIndices;
-    currentCellIndices.insert(startCellIndex);
-    std::unordered_set<int> scannedCellIndices = currentCellIndices;
-
-    std::vector<CellDescription> cells;
-    std::unordered_set<int> nextCellIndices;
-    int cellDescIndex = 0;
-    do {
-        for (auto const& currentCellIndex : currentCellIndices) {
-            cells.emplace_back(createCellDescription(dataTO, currentCellIndex));
-            result.cellTOIndexToCellDescIndex.emplace(currentCellIndex, cellDescIndex);
-            auto const& cellTO = dataTO.cells[currentCellIndex];
-            for (int i = 0; i < cellTO.numConnections; ++i) {
-                auto connectionTO = cellTO.connections[i];
-                if (connectionTO.cellIndex != -1) {
-                    if (scannedCellIndices.find(connectionTO.cellIndex) == scannedCellIndices.end()) {
-                        nextCellIndices.insert(connectionTO.cellIndex);
-                        scannedCellIndices.insert(connectionTO.cellIndex);
-                    }
+        return index;
+    };
+    for (int i = 0; i < numCells; ++i) {
+        auto const& cellTO = dataTO.cells[i];
+        for (int j = 0; j < cellTO.numConnections; ++j) {
+            auto connectedCellIndex = cellTO.connections[j].cellIndex;
+            if (connectedCellIndex != -1) {
+                auto root1 = findRoot(i);
+                auto root2 = findRoot(connectedCellIndex);
+                if (root1 != root2) {
+                    parents[std::max(root1, root2)] = std::min(root1, root2);
                 }
             }
-            ++cellDescIndex;
         }
-        currentCellIndices = nextCellIndices;
-        nextCellIndices.clear();
-    } while (!currentCellIndices.empty());
-
-    setInplaceDifference(freeCellIndices, scannedCellIndices);
-
-    result.cluster.addCells(cells);
+    }
 
+    std::vector<int> result(numCells);
+    numClusters = 0;
+    for (int i = 0; i < numCells; ++i) {
+        auto root = findRoot(i);
+        result[i] = root == i ? numClusters++ : result[root];
+    }
     return result;
 }
 
@@ -412,9 +321,7 @@ CellDescription DescriptionConverter::createCellDescription(DataTO const& dataTO
     switch (cellTO.cellFunction) {
     case CellFunction_Neuron: {
         NeuronDescription neuron;
-        std::vector<float> weigthsAndBias;
-        convert(dataTO, sizeof(float) * MAX_CHANNELS * (MAX_CHANNELS + 1), cellTO.cellFunctionData.neuron.weightsAndBiasesDataIndex, weigthsAndBias);
-        std::tie(neuron.weights, neuron.biases) = splitWeightsAndBias(weigthsAndBias);
+        convertWeightsAndBiases(dataTO, cellTO.cellFunctionData.neuron.weightsAndBiasesDataIndex, neuron.weights, neuron.biases);
         for (int i = 0; i < MAX_CHANNELS; ++i) {
             neuron.activationFunctions[i] = cellTO.cellFunctionData.neuron.activationFunctions[i];
         }
@@ -507,6 +414,21 @@ CellDescription DescriptionConverter::createCellDescription(DataTO const& dataTO
     return result;
 }
 
+std::vector<ParticleDescription> DescriptionConverter::createParticleDescriptions(DataTO const& dataTO) const
+{
+    std::vector<ParticleDescription> result(*dataTO.numParticles);
+    ParallelExecution::forEachInChunks(*dataTO.numParticles, ChunkSize, [&](size_t index) {
+        ParticleTO const& particle = dataTO.particles[index];
+        result[index] = ParticleDescription()
+                            .setId(particle.id)
+                            .setPos({particle.pos.x, particle.pos.y})
+                            .setVel({particle.vel.x, particle.vel.y})
+                            .setEnergy(particle.energy)
+                            .setColor(particle.color);
+    }, _maxThreads);
+    return result;
+}
+
 namespace
 {
     void checkAndCorrectInvalidEnergy(float& energy)
@@ -530,12 +452,50 @@ void DescriptionConverter::addParticle(DataTO const& dataTO, ParticleDescription
     particleTO.color = particleDesc.color;
 }
 
+void DescriptionConverter::addCells(DataTO const& dataTO, std::vector<CellDescription const*> const& cells, bool withConnections) const
+{
+    auto firstCellIndex = toInt(*dataTO.numCells);
+    auto numCells = cells.size();
+
+    //ids are assigned sequentially since the id generator is not thread-safe
+    std::vector<uint64_t> cellIds(numCells);
+    std::unordered_map<uint64_t, int> cellIndexByIds;
+    cellIndexByIds.reserve(numCells);
+    for (size_t i = 0; i < numCells; ++i) {
+        cellIds[i] = cells[i]->id == 0 ? NumberGenerator::getInstance().getId() : cells[i]->id;
+        cellIndexByIds.insert_or_assign(cellIds[i], firstCellIndex + toInt(i));
+    }
+
+    //each cell gets its own range in the auxiliary data
+    std::vector<uint64_t> auxiliaryDataIndices(numCells + 1, 0);
+    ParallelExecution::forEachInChunks(
+        numCells, ChunkSize, [&](size_t index) { addAdditionalDataSizeForCell(*cells[index], auxiliaryDataIndices[index + 1]); }, _maxThreads);
+    auxiliaryDataIndices[0] = *dataTO.numAuxiliaryData;
+    std::partial_sum(auxiliaryDataIndices.begin(), auxiliaryDataIndices.end(), auxiliaryDataIndices.begin());
+
+    ParallelExecution::forEachInChunks(numCells, ChunkSize, [&](size_t index) {
+        addCell(dataTO, *cells[index], cellIds[index], firstCellIndex + toInt(index), auxiliaryDataIndices[index]);
+    }, _maxThreads);
+    if (withConnections) {
+        ParallelExecution::forEachInChunks(numCells, ChunkSize, [&](size_t index) {
+            if (cells[index]->id != 0) {
+                setConnections(dataTO, *cells[index], firstCellIndex + toInt(index), cellIndexByIds);
+            }
+        }, _maxThreads);
+    }
+    *dataTO.numCells += numCells;
+    *dataTO.numAuxiliaryData = auxiliaryDataIndices.back();
+}
+
 void DescriptionConverter::addCell(
-    DataTO const& dataTO, CellDescription const& cellDesc, std::unordered_map<uint64_t, int>& cellIndexTOByIds) const
+    DataTO const& dataTO,
+    CellDescription const& cellDesc,
+    uint64_t cellId,
+    int cellIndex,
+    uint64_t auxiliaryDataIndex) const
 {
-    int cellIndex = (*dataTO.numCells)++;
     CellTO& cellTO = dataTO.cells[cellIndex];
-    cellTO.id = cellDesc.id == 0 ? NumberGenerator::getInstance().getId() : cellDesc.id;
+    cellTO.id = cellId;
 	cellTO.pos= { cellDesc.pos.x, cellDesc.pos.y };
     cellTO.vel = {cellDesc.vel.x, cellDesc.vel.y};
     cellTO.energy = cellDesc.energy;
@@ -553,10 +513,7 @@ void DescriptionConverter::addCell(
     case CellFunction_Neuron: {
         NeuronTO neuronTO;
         auto const& neuronDesc = std::get<NeuronDescription>(*cellDesc.cellFunction);
-        std::vector<float> weigthsAndBias = unitWeightsAndBias(neuronDesc.weights, neuronDesc.biases);
-        int targetSize;
-        convert(dataTO, weigthsAndBias, targetSize, neuronTO.weightsAndBiasesDataIndex);
-        CHECK(targetSize == sizeof(float) * MAX_CHANNELS * (MAX_CHANNELS + 1));
+        convertWeightsAndBiases(dataTO, neuronDesc.weights, neuronDesc.biases, neuronTO.weightsAndBiasesDataIndex, auxiliaryDataIndex);
         for (int i = 0; i < MAX_CHANNELS; ++i) {
             neuronTO.activationFunctions[i] = neuronDesc.activationFunctions[i];
         }
@@ -574,7 +531,7 @@ void DescriptionConverter::addCell(
         constructorTO.activationMode = constructorDesc.activationMode;
         constructorTO.constructionActivationTime = constructorDesc.constructionActivationTime;
         CHECK(constructorDesc.genome.size() >= Const::GenomeHeaderSize)
-        convert(dataTO, constructorDesc.genome, constructorTO.genomeSize, constructorTO.genomeDataIndex);
+        convert(dataTO, constructorDesc.genome, constructorTO.genomeSize, constructorTO.genomeDataIndex, auxiliaryDataIndex);
         constructorTO.numInheritedGenomeNodes = static_cast<uint16_t>(constructorDesc.numInheritedGenomeNodes);
         constructorTO.lastConstructedCellId = constructorDesc.lastConstructedCellId;
         constructorTO.genomeCurrentNodeIndex = static_cast<uint16_t>(constructorDesc.genomeCurrentNodeIndex);
@@ -619,7 +576,7 @@ void DescriptionConverter::addCell(
         injectorTO.mode = injectorDesc.mode;
         injectorTO.counter = injectorDesc.counter;
         CHECK(injectorDesc.genome.size() >= Const::GenomeHeaderSize)
-        convert(dataTO, injectorDesc.genome, injectorTO.genomeSize, injectorTO.genomeDataIndex);
+        convert(dataTO, injectorDesc.genome, injectorTO.genomeSize, injectorTO.genomeDataIndex, auxiliaryDataIndex);
         injectorTO.genomeGeneration = injectorDesc.genomeGeneration;
         cellTO.cellFunctionData.injector = injectorTO;
     } break;
@@ -661,15 +618,18 @@ void DescriptionConverter::addCell(
     cellTO.age = cellDesc.age;
     cellTO.color = cellDesc.color;
     cellTO.genomeComplexity = cellDesc.genomeComplexity;
-    convert(dataTO, cellDesc.metadata.name, cellTO.metadata.nameSize, cellTO.metadata.nameDataIndex);
-    convert(dataTO, cellDesc.metadata.description, cellTO.metadata.descriptionSize, cellTO.metadata.descriptionDataIndex);
-	cellIndexTOByIds.insert_or_assign(cellTO.id, cellIndex);
+    convert(dataTO, cellDesc.metadata.name, cellTO.metadata.nameSize, cellTO.metadata.nameDataIndex, auxiliaryDataIndex);
+    convert(dataTO, cellDesc.metadata.description, cellTO.metadata.descriptionSize, cellTO.metadata.descriptionDataIndex, auxiliaryDataIndex);
 }
 
-void DescriptionConverter::setConnections(DataTO const& dataTO, CellDescription const& cellToAdd, std::unordered_map<uint64_t, int> const& cellIndexByIds) const
+void DescriptionConverter::setConnections(
+    DataTO const& dataTO,
+    CellDescription const& cellToAdd,
+    int cellIndex,
+    std::unordered_map<uint64_t, int> const& cellIndexByIds) const
 {
     int index = 0;
-    auto& cellTO = dataTO.cells[cellIndexByIds.at(cellToAdd.id)];
+    auto& cellTO = dataTO.cells[cellIndex];
     float angleOffset = 0;
     for (ConnectionDescription const& connection : cellToAdd.connections) {
         if (connection.cellId != 0) {
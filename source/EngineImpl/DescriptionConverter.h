@@ -10,10 +10,14 @@
 #include "EngineGpuKernels/TOs.cuh"
 #include "Definitions.h"
 
+/**
+ * Converts between transfer objects and descriptions. Cells are converted in parallel, where the result does not
+ * depend on the number of threads.
+ */
 class DescriptionConverter
 {
 public:
-    DescriptionConverter(SimulationParameters const& parameters);
+    DescriptionConverter(SimulationParameters const& parameters, int maxThreads = 0);
 
     ArraySizes getArraySizes(DataDescription const& data) const;
     ArraySizes getArraySizes(ClusteredDataDescription const& data) const;
@@ -29,24 +33,18 @@ public:
 private:
     void addAdditionalDataSizeForCell(CellDescription const& cell, uint64_t& additionalDataSize) const;
 
-	struct CreateClusterReturnData
-    {
-        ClusterDescription cluster;
-        std::unordered_map<int, int> cellTOIndexToCellDescIndex;
-	};
-    CreateClusterReturnData scanAndCreateClusterDescription(
-        DataTO const& dataTO,
-        int startCellIndex,
-        std::unordered_set<int>& freeCellIndices) const;
+    std::vector<int> calcClusterIndices(DataTO const& dataTO, int& numClusters) const;  //connected components
     CellDescription createCellDescription(DataTO const& dataTO, int cellIndex) const;
+    std::vector<ParticleDescription> createParticleDescriptions(DataTO const& dataTO) const;
 
-	void addCell(
-        DataTO const& dataTO, CellDescription const& cellToAdd, std::unordered_map<uint64_t, int>& cellIndexTOByIds) const;
+    void addCells(DataTO const& dataTO, std::vector<CellDescription const*> const& cells, bool withConnections) const;
+    void addCell(DataTO const& dataTO, CellDescription const& cellToAdd, uint64_t cellId, int cellIndex, uint64_t auxiliaryDataIndex) const;
     void addParticle(DataTO const& dataTO, ParticleDescription const& particleDesc) const;
 
-	void setConnections(
-        DataTO const& dataTO, CellDescription const& cellToAdd, std::unordered_map<uint64_t, int> const& cellIndexByIds) const;
+    void setConnections(
+        DataTO const& dataTO, CellDescription const& cellToAdd, int cellIndex, std::unordered_map<uint64_t, int> const& cellIndexByIds) const;
 
 private:
 	SimulationParameters _parameters;
+    int _maxThreads = 0;  //0 = all available cores
 };
@@ -0,0 +1,115 @@
+#include "EngineCommandQueue.h"
+
+#include <algorithm>
+
+void EngineCommandQueue::add(EngineCommand const& command)
+{
+    std::unique_lock<std::mutex> uniqueLock(_mutex);
+    if (tryMerge(command)) {
+        ++_numMergedCommands;
+    } else {
+        _commands.emplace_back(command);
+    }
+}
+
+std::vector<EngineCommand> EngineCommandQueue::takeAll()
+{
+    std::unique_lock<std::mutex> uniqueLock(_mutex);
+    std::vector<EngineCommand> result;
+    result.swap(_commands);
+    return result;
+}
+
+bool EngineCommandQueue::isEmpty() const
+{
+    std::unique_lock<std::mutex> uniqueLock(_mutex);
+    return _commands.empty();
+}
+
+uint64_t EngineCommandQueue::getNumMergedCommands() const
+{
+    std::unique_lock<std::mutex> uniqueLock(_mutex);
+    return _numMergedCommands;
+}
+
+bool EngineCommandQueue::tryMerge(EngineCommand const& command)
+{
+    //settings are replaced as a whole: a pending settings change is obsolete and the new one is appended to keep the order to the commands in between
+    if (std::holds_alternative<SetGpuSettingsCommand>(command)) {
+        auto removeResult = std::remove_if(_commands.begin(), _commands.end(), [](auto const& pendingCommand) {
+            return std::holds_alternative<SetGpuSettingsCommand>(pendingCommand);
+        });
+        _numMergedCommands += std::distance(removeResult, _commands.end());
+        _commands.erase(removeResult, _commands.end());
+        return false;
+    }
+
+    //a cell/particle change overwrites all properties, hence a pending change of the same object (and effects of commands in between) is obsolete
+    if (auto changeCellCommand = std::get_if<ChangeCellCommand>(&command)) {
+        auto removeResult = std::remove_if(_commands.begin(), _commands.end(), [&](auto const& pendingCommand) {
+            auto pendingChangeCellCommand = std::get_if<ChangeCellCommand>(&pendingCommand);
+            return pendingChangeCellCommand && pendingChangeCellCommand->cell.id == changeCellCommand->cell.id;
+        });
+        _numMergedCommands += std::distance(removeResult, _commands.end());
+        _commands.erase(removeResult, _commands.end());
+        return false;
+    }
+    if (auto changeParticleCommand = std::get_if<ChangeParticleCommand>(&command)) {
+        auto removeResult = std::remove_if(_commands.begin(), _commands.end(), [&](auto const& pendingCommand) {
+            auto pendingChangeParticleCommand = std::get_if<ChangeParticleCommand>(&pendingCommand);
+            return pendingChangeParticleCommand && pendingChangeParticleCommand->particle.id == changeParticleCommand->particle.id;
+        });
+        _numMergedCommands += std::distance(removeResult, _commands.end());
+        _commands.erase(removeResult, _commands.end());
+        return false;
+    }
+
+    //remaining merges only apply to directly consecutive commands
+    if (_commands.empty()) {
+        return false;
+    }
+    auto& lastCommand = _commands.back();
+
+    //translations and rotations around the selection center commute, hence the deltas can be summed up
+    if (auto updateCommand = std::get_if<ShallowUpdateSelectedObjectsCommand>(&command)) {
+        auto lastUpdateCommand = std::get_if<ShallowUpdateSelectedObjectsCommand>(&lastCommand);
+        if (!lastUpdateCommand || lastUpdateCommand->updateData.considerClusters != updateCommand->updateData.considerClusters) {
+            return false;
+        }
+        auto& data = lastUpdateCommand->updateData;
+        auto const& newData = updateCommand->updateData;
+        data.posDeltaX += newData.posDeltaX;
+        data.posDeltaY += newData.posDeltaY;
+        data.velDeltaX += newData.velDeltaX;
+        data.velDeltaY += newData.velDeltaY;
+        data.angleDelta += newData.angleDelta;
+        data.angularVelDelta += newData.angularVelDelta;
+        return true;
+    }
+
+    //consecutive assignments of the same property to the same selection
+    if (auto colorCommand = std::get_if<ColorSelectedObjectsCommand>(&command)) {
+        auto lastColorCommand = std::get_if<ColorSelectedObjectsCommand>(&lastCommand);
+        if (lastColorCommand && lastColorCommand->includeClusters == colorCommand->includeClusters) {
+            *lastColorCommand = *colorCommand;
+            return true;
+        }
+        return false;
+    }
+    if (auto barrierCommand = std::get_if<SetBarrierCommand>(&command)) {
+        auto lastBarrierCommand = std::get_if<SetBarrierCommand>(&lastCommand);
+        if (lastBarrierCommand && lastBarrierCommand->includeClusters == barrierCommand->includeClusters) {
+            *lastBarrierCommand = *barrierCommand;
+            return true;
+        }
+        return false;
+    }
+    if (auto detachedCommand = std::get_if<SetDetachedCommand>(&command)) {
+        if (auto lastDetachedCommand = std::get_if<SetDetachedCommand>(&lastCommand)) {
+            *lastDetachedCommand = *detachedCommand;
+            return true;
+        }
+        return false;
+    }
+    return false;
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <mutex>
+#include <variant>
+#include <vector>
+
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/GpuSettings.h"
+#include "EngineInterface/ShallowUpdateSelectionData.h"
+
+struct SetGpuSettingsCommand
+{
+    GpuSettings gpuSettings;
+};
+
+struct ApplyForceCommand
+{
+    RealVector2D start;
+    RealVector2D end;
+    RealVector2D force;
+    float radius;
+};
+
+struct ChangeCellCommand
+{
+    CellDescription cell;
+};
+
+struct ChangeParticleCommand
+{
+    ParticleDescription particle;
+};
+
+struct ShallowUpdateSelectedObjectsCommand
+{
+    ShallowUpdateSelectionData updateData;
+};
+
+struct ColorSelectedObjectsCommand
+{
+    unsigned char color;
+    bool includeClusters;
+};
+
+struct SetBarrierCommand
+{
+    bool value;
+    bool includeClusters;
+};
+
+struct MakeStickyCommand
+{
+    bool includeClusters;
+};
+
+struct RemoveStickinessCommand
+{
+    bool includeClusters;
+};
+
+struct RelaxSelectedObjectsCommand
+{
+    bool includeClusters;
+};
+
+struct UniformVelocitiesForSelectedObjectsCommand
+{
+    bool includeClusters;
+};
+
+struct ReconnectSelectedObjectsCommand
+{};
+
+struct SetDetachedCommand
+{
+    bool value;
+};
+
+using EngineCommand = std::variant<
+    SetGpuSettingsCommand,
+    ApplyForceCommand,
+    ChangeCellCommand,
+    ChangeParticleCommand,
+    ShallowUpdateSelectedObjectsCommand,
+    ColorSelectedObjectsCommand,
+    SetBarrierCommand,
+    MakeStickyCommand,
+    RemoveStickinessCommand,
+    RelaxSelectedObjectsCommand,
+    UniformVelocitiesForSelectedObjectsCommand,
+    ReconnectSelectedObjectsCommand,
+    SetDetachedCommand>;
+
+/**
+ * Thread-safe queue of commands which are executed by the engine worker between time steps.
+ * Commands whose effect is superseded by a later command are merged on insertion, e.g. consecutive shallow updates
+ * are combined and a cell change replaces a pending change of the same cell.
+ */
+class EngineCommandQueue
+{
+public:
+    void add(EngineCommand const& command);
+    std::vector<EngineCommand> takeAll();
+
+    bool isEmpty() const;
+    uint64_t getNumMergedCommands() const;
+
+private:
+    bool tryMerge(EngineCommand const& command);
+
+    mutable std::mutex _mutex;
+    std::vector<EngineCommand> _commands;
+    uint64_t _numMergedCommands = 0;
+};
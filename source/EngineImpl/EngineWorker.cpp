@@ -5,19 +5,25 @@
 #include "EngineGpuKernels/TOs.cuh"
 #include "EngineGpuKernels/SimulationCudaFacade.cuh"
 #include "AccessDataTOCache.h"
+#include "EngineCommandQueue.h"
 #include "DescriptionConverter.h"
 
 namespace
 {
     std::chrono::milliseconds const FrameTimeout(500);
+    std::chrono::milliseconds const IdleTimeout(100);
 }
 
 void EngineWorker::newSimulation(uint64_t timestep, GeneralSettings const& generalSettings, SimulationParameters const& parameters)
 {
-    _accessState = 0;
     _settings.generalSettings = generalSettings;
     _settings.simulationParameters = parameters;
-    _dataTOCache = std::make_shared<_AccessDataTOCache>();
+    //no double buffering: the overlay and data paths are serialized by EngineWorkerGuard and each TO is consumed before the next one is
+    //requested, hence a second buffer would never be in use at the same time but would double the page-locked memory
+    AccessDataTOCacheSettings dataTOCacheSettings;
+    dataTOCacheSettings.pageLockedMemory = true;
+    dataTOCacheSettings.doubleBuffered = false;
+    _dataTOCache = std::make_shared<_AccessDataTOCache>(dataTOCacheSettings);
     _simulationCudaFacade = std::make_shared<_SimulationCudaFacade>(timestep, _settings);
 
     if (_imageResource) {
@@ -106,6 +112,7 @@ bool EngineWorker::isSyncSimulationWithRendering() const
 void EngineWorker::setSyncSimulationWithRendering(bool value)
 {
     _syncSimulationWithRendering = value;
+    _accessSynchronizer.notify();
 }
 
 int EngineWorker::getSyncSimulationWithRenderingRatio() const
@@ -260,61 +267,37 @@ void EngineWorker::removeSelectedObjects(bool includeClusters)
 
 void EngineWorker::relaxSelectedObjects(bool includeClusters)
 {
-    EngineWorkerGuard access(this);
-
-    _simulationCudaFacade->relaxSelectedObjects(includeClusters);
+    addCommand(RelaxSelectedObjectsCommand{includeClusters});
 }
 
 void EngineWorker::uniformVelocitiesForSelectedObjects(bool includeClusters)
 {
-    EngineWorkerGuard access(this);
-
-    _simulationCudaFacade->uniformVelocitiesForSelectedObjects(includeClusters);
+    addCommand(UniformVelocitiesForSelectedObjectsCommand{includeClusters});
 }
 
 void EngineWorker::makeSticky(bool includeClusters)
 {
-    EngineWorkerGuard access(this);
-
-    _simulationCudaFacade->makeSticky(includeClusters);
+    addCommand(MakeStickyCommand{includeClusters});
 }
 
 void EngineWorker::removeStickiness(bool includeClusters)
 {
-    EngineWorkerGuard access(this);
-
-    _simulationCudaFacade->removeStickiness(includeClusters);
+    addCommand(RemoveStickinessCommand{includeClusters});
 }
 
 void EngineWorker::setBarrier(bool value, bool includeClusters)
 {
-    EngineWorkerGuard access(this);
-
-    _simulationCudaFacade->setBarrier(value, includeClusters);
+    addCommand(SetBarrierCommand{value, includeClusters});
 }
 
 void EngineWorker::changeCell(CellDescription const& changedCell)
 {
-    EngineWorkerGuard access(this);
-
-    auto dataTO = provideTO();
-
-    DescriptionConverter converter(_settings.simulationParameters);
-    converter.convertDescriptionToTO(dataTO, changedCell);
-
-    _simulationCudaFacade->changeInspectedSimulationData(dataTO);
+    addCommand(ChangeCellCommand{changedCell});
 }
 
 void EngineWorker::changeParticle(ParticleDescription const& changedParticle)
 {
-    EngineWorkerGuard access(this);
-
-    auto dataTO = provideTO();
-
-    DescriptionConverter converter(_settings.simulationParameters);
-    converter.convertDescriptionToTO(dataTO, changedParticle);
-
-    _simulationCudaFacade->changeInspectedSimulationData(dataTO);
+    addCommand(ChangeParticleCommand{changedParticle});
 }
 
 void EngineWorker::calcTimesteps(uint64_t timesteps)
@@ -333,6 +316,7 @@ void EngineWorker::applyCataclysm(int power)
 void EngineWorker::beginShutdown()
 {
     _isShutdown.store(true);
+    _accessSynchronizer.notify();
 }
 
 void EngineWorker::endShutdown()
@@ -382,8 +366,7 @@ void EngineWorker::setSimulationParameters(SimulationParameters const& parameter
 
 void EngineWorker::setGpuSettings_async(GpuSettings const& gpuSettings)
 {
-    std::unique_lock<std::mutex> uniqueLock(_mutexForAsyncJobs);
-    _updateGpuSettingsJob = gpuSettings;
+    addCommand(SetGpuSettingsCommand{gpuSettings});
 }
 
 void EngineWorker::applyForce_async(
@@ -392,8 +375,7 @@ void EngineWorker::applyForce_async(
     RealVector2D const& force,
     float radius)
 {
-    std::unique_lock<std::mutex> uniqueLock(_mutexForAsyncJobs);
-    _applyForceJobs.emplace_back(ApplyForceJob{start, end, force, radius});
+    addCommand(ApplyForceCommand{start, end, force, radius});
 }
 
 void EngineWorker::switchSelection(RealVector2D const& pos, float radius)
@@ -434,38 +416,34 @@ void EngineWorker::updateSelection()
 
 void EngineWorker::shallowUpdateSelectedObjects(ShallowUpdateSelectionData const& updateData)
 {
-    EngineWorkerGuard access(this);
-    _simulationCudaFacade->shallowUpdateSelectedObjects(updateData);
+    addCommand(ShallowUpdateSelectedObjectsCommand{updateData});
 }
 
 void EngineWorker::colorSelectedObjects(unsigned char color, bool includeClusters)
 {
-    EngineWorkerGuard access(this);
-    _simulationCudaFacade->colorSelectedObjects(color, includeClusters);
+    addCommand(ColorSelectedObjectsCommand{color, includeClusters});
 }
 
 void EngineWorker::reconnectSelectedObjects()
 {
-    EngineWorkerGuard access(this);
-    _simulationCudaFacade->reconnectSelectedObjects();
+    addCommand(ReconnectSelectedObjectsCommand());
 }
 
 void EngineWorker::setDetached(bool value)
 {
-    EngineWorkerGuard access(this);
-    _simulationCudaFacade->setDetached(value);
+    addCommand(SetDetachedCommand{value});
 }
 
 void EngineWorker::runThreadLoop()
 {
     try {
-        std::mutex mutexForLoop;
-        std::unique_lock<std::mutex> lockForLoop(mutexForLoop);
+        _workerThreadId = std::this_thread::get_id();
 
         while (!_isShutdown.load()) {
 
-            if (!_syncSimulationWithRendering && _accessState == 0) {
-                if (_isSimulationRunning.load()) {
+            auto isCalculating = !_syncSimulationWithRendering && _isSimulationRunning.load();
+            if (!_syncSimulationWithRendering) {
+                if (isCalculating) {
                     _simulationCudaFacade->calcTimestep(1, false);
                 }
                 measureTPS();
@@ -474,8 +452,11 @@ void EngineWorker::runThreadLoop()
             
             processJobs();
 
-            if (_accessState == 1) {
-                _accessState = 2;
+            if (isCalculating) {
+                _accessSynchronizer.allowAccess();
+            } else {
+                //sleep until the simulation is started, a job arrives or access is requested
+                _accessSynchronizer.wait(std::chrono::steady_clock::now() + IdleTimeout);
             }
         }
     } catch (std::exception const& e) {
@@ -487,6 +468,7 @@ void EngineWorker::runThreadLoop()
 void EngineWorker::runSimulation()
 {
     _isSimulationRunning.store(true);
+    _accessSynchronizer.notify();
 }
 
 void EngineWorker::pauseSimulation()
@@ -516,23 +498,54 @@ void EngineWorker::resetTimeIntervalStatistics()
     _simulationCudaFacade->resetTimeIntervalStatistics();
 }
 
+void EngineWorker::addCommand(EngineCommand const& command)
+{
+    _commandQueue.add(command);
+    _accessSynchronizer.notify();
+}
+
 void EngineWorker::processJobs()
 {
-    std::unique_lock<std::mutex> asyncJobsLock(_mutexForAsyncJobs);
-    if (_updateGpuSettingsJob) {
-        _simulationCudaFacade->setGpuConstants(*_updateGpuSettingsJob);
-        _updateGpuSettingsJob = std::nullopt;
-    }
-    if (!_applyForceJobs.empty()) {
-        for (auto const& applyForceJob : _applyForceJobs) {
+    //all pending commands are executed in one access window
+    for (auto const& command : _commandQueue.takeAll()) {
+        if (auto setGpuSettingsCommand = std::get_if<SetGpuSettingsCommand>(&command)) {
+            _simulationCudaFacade->setGpuConstants(setGpuSettingsCommand->gpuSettings);
+        } else if (auto applyForceCommand = std::get_if<ApplyForceCommand>(&command)) {
             _simulationCudaFacade->applyForce(
-                {{applyForceJob.start.x, applyForceJob.start.y},
-                 {applyForceJob.end.x, applyForceJob.end.y},
-                 {applyForceJob.force.x, applyForceJob.force.y},
-                 applyForceJob.radius,
+                {{applyForceCommand->start.x, applyForceCommand->start.y},
+                 {applyForceCommand->end.x, applyForceCommand->end.y},
+                 {applyForceCommand->force.x, applyForceCommand->force.y},
+                 applyForceCommand->radius,
                  false});
+        } else if (auto changeCellCommand = std::get_if<ChangeCellCommand>(&command)) {
+            auto dataTO = provideTO();
+            DescriptionConverter converter(_settings.simulationParameters);
+            converter.convertDescriptionToTO(dataTO, changeCellCommand->cell);
+            _simulationCudaFacade->changeInspectedSimulationData(dataTO);
+        } else if (auto changeParticleCommand = std::get_if<ChangeParticleCommand>(&command)) {
+            auto dataTO = provideTO();
+            DescriptionConverter converter(_settings.simulationParameters);
+            converter.convertDescriptionToTO(dataTO, changeParticleCommand->particle);
+            _simulationCudaFacade->changeInspectedSimulationData(dataTO);
+        } else if (auto shallowUpdateCommand = std::get_if<ShallowUpdateSelectedObjectsCommand>(&command)) {
+            _simulationCudaFacade->shallowUpdateSelectedObjects(shallowUpdateCommand->updateData);
+        } else if (auto colorCommand = std::get_if<ColorSelectedObjectsCommand>(&command)) {
+            _simulationCudaFacade->colorSelectedObjects(colorCommand->color, colorCommand->includeClusters);
+        } else if (auto setBarrierCommand = std::get_if<SetBarrierCommand>(&command)) {
+            _simulationCudaFacade->setBarrier(setBarrierCommand->value, setBarrierCommand->includeClusters);
+        } else if (auto makeStickyCommand = std::get_if<MakeStickyCommand>(&command)) {
+            _simulationCudaFacade->makeSticky(makeStickyCommand->includeClusters);
+        } else if (auto removeStickinessCommand = std::get_if<RemoveStickinessCommand>(&command)) {
+            _simulationCudaFacade->removeStickiness(removeStickinessCommand->includeClusters);
+        } else if (auto relaxCommand = std::get_if<RelaxSelectedObjectsCommand>(&command)) {
+            _simulationCudaFacade->relaxSelectedObjects(relaxCommand->includeClusters);
+        } else if (auto uniformVelocitiesCommand = std::get_if<UniformVelocitiesForSelectedObjectsCommand>(&command)) {
+            _simulationCudaFacade->uniformVelocitiesForSelectedObjects(uniformVelocitiesCommand->includeClusters);
+        } else if (std::holds_alternative<ReconnectSelectedObjectsCommand>(command)) {
+            _simulationCudaFacade->reconnectSelectedObjects();
+        } else if (auto setDetachedCommand = std::get_if<SetDetachedCommand>(&command)) {
+            _simulationCudaFacade->setDetached(setDetachedCommand->value);
         }
-        _applyForceJobs.clear();
     }
 }
 
@@ -549,11 +562,14 @@ void EngineWorker::syncSimulationWithRenderingIfDesired()
 
 void EngineWorker::waitAndAllowAccess(std::chrono::microseconds const& duration)
 {
-    auto startTimepoint = std::chrono::steady_clock::now();
-    while (std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimepoint) < duration) {
-        if (_accessState == 1) {
-            _accessState = 2;
-        }
+    //in case of synchronization with rendering the calling thread already has access
+    if (std::this_thread::get_id() != _workerThreadId.load()) {
+        std::this_thread::sleep_for(duration);
+        return;
+    }
+    auto deadline = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < deadline && !_isShutdown.load()) {
+        _accessSynchronizer.wait(deadline);
     }
 }
 
@@ -606,29 +622,29 @@ EngineWorkerGuard::EngineWorkerGuard(EngineWorker* worker, std::optional<std::ch
 {
     checkForException(worker->_exceptionData);
 
-    worker->_accessState = 1;
-
-    auto startTimepoint = std::chrono::steady_clock::now();
-    while (worker->_accessState == 1) {
-        auto timePassed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimepoint);
-        if (maxDuration) {
-            if (timePassed > *maxDuration) {
-                _isTimeout = true;
-                break;
-            }
-        } else {
-            if (timePassed > std::chrono::seconds(7)) {
-                _isTimeout = true;
-                throw std::runtime_error("GPU worker thread is not reachable.");
-            }
+    _isAccessAcquired = worker->_accessSynchronizer.acquire(maxDuration.value_or(std::chrono::seconds(7)));
+    if (!_isAccessAcquired) {
+        _isTimeout = true;
+        if (!maxDuration) {
+            throw std::runtime_error("GPU worker thread is not reachable.");
         }
+        return;
     }
 
+    //queued commands are executed first to preserve the order of operations
+    try {
+        worker->processJobs();
+    } catch (...) {
+        worker->_accessSynchronizer.release();
+        throw;
+    }
 }
 
 EngineWorkerGuard::~EngineWorkerGuard()
 {
-    _worker->_accessState = 0;
+    if (_isAccessAcquired) {
+        _worker->_accessSynchronizer.release();
+    }
 }
 
 bool EngineWorkerGuard::isTimeout() const
@@ -3,6 +3,7 @@
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
+#include <thread>
 
 #if defined(_WIN32)
 #include <windows.h>
@@ -24,6 +25,8 @@
 
 #include "EngineGpuKernels/Definitions.h"
 
+#include "AccessSynchronizer.h"
+#include "EngineCommandQueue.h"
 #include "Definitions.h"
 
 struct ExceptionData
@@ -66,6 +69,8 @@ public:
     void setClusteredSimulationData(ClusteredDataDescription const& dataToUpdate);
     void setSimulationData(DataDescription const& dataToUpdate);
     void removeSelectedObjects(bool includeClusters);
+
+    //the following editing operations are queued and executed between time steps (or before the next synchronous access)
     void relaxSelectedObjects(bool includeClusters);
     void uniformVelocitiesForSelectedObjects(bool includeClusters);
     void makeSticky(bool includeClusters);
@@ -99,6 +104,8 @@ public:
     void setSelection(RealVector2D const& startPos, RealVector2D const& endPos);
     void removeSelection();
     void updateSelection();
+
+    //queued as well
     void shallowUpdateSelectedObjects(ShallowUpdateSelectionData const& updateData);
     void colorSelectedObjects(unsigned char color, bool includeClusters);
     void reconnectSelectedObjects();
@@ -116,6 +123,7 @@ private:
     DataTO provideTO(); 
     void resetTimeIntervalStatistics();
     void updateStatistics(bool afterMinDuration = false);
+    void addCommand(EngineCommand const& command);
     void processJobs();
 
     void syncSimulationWithRenderingIfDesired();
@@ -131,25 +139,16 @@ private:
     //sync
     std::atomic<bool> _syncSimulationWithRendering{false};
     std::atomic<int> _syncSimulationWithRenderingRatio{2};
-    std::atomic<int> _accessState{0};  //0 = worker thread has access, 1 = require access from other thread, 2 = access granted to other thread
+    AccessSynchronizer _accessSynchronizer;
+    std::atomic<std::thread::id> _workerThreadId;
     std::atomic<bool> _isSimulationRunning{false};
     std::atomic<bool> _isShutdown{false};
     ExceptionData _exceptionData;
 
     //async jobs
-    mutable std::mutex _mutexForAsyncJobs;
-    std::optional<GpuSettings> _updateGpuSettingsJob;
+    EngineCommandQueue _commandQueue;
     std::optional<GLuint> _imageResource;
 
-    struct ApplyForceJob
-    {
-        RealVector2D start;
-        RealVector2D end;
-        RealVector2D force;
-        float radius;
-    };
-    std::vector<ApplyForceJob> _applyForceJobs;
-
     //time step measurements
     std::atomic<int> _tpsRestriction{0};  //0 = no restriction
     std::atomic<float> _tps;
@@ -177,4 +176,5 @@ private:
     EngineWorker* _worker;
 
     bool _isTimeout = false;
+    bool _isAccessAcquired = false;
 };
@@ -1,15 +1,26 @@
 #include "SimulationControllerImpl.h"
 
+#include "Base/LoggingService.h"
 #include "EngineInterface/Descriptions.h"
 
+#include "CpuSimulation.h"
+
+_SimulationControllerImpl::_SimulationControllerImpl(SimulationBackend backend)
+    : _backend(backend)
+{}
+
 void _SimulationControllerImpl::newSimulation(uint64_t timestep, GeneralSettings const& generalSettings, SimulationParameters const& parameters)
 {
     _generalSettings = generalSettings;
     _origSettings.generalSettings = generalSettings;
     _origSettings.simulationParameters = parameters;
-    _worker.newSimulation(timestep, generalSettings, parameters);
-
-    _thread = new std::thread(&EngineWorker::runThreadLoop, &_worker);
+    if (_backend == SimulationBackend_Cpu) {
+        _cpuSimulation = std::make_shared<_CpuSimulation>(timestep, _origSettings);
+        log(Priority::Important, "simulation runs on the experimental CPU backend: cell functions, collisions, fluid dynamics, spots and aging are not simulated");
+    } else {
+        _worker.newSimulation(timestep, generalSettings, parameters);
+        _thread = new std::thread(&EngineWorker::runThreadLoop, &_worker);
+    }
 
     _selectionNeedsUpdate = true;
     _realTime = std::chrono::milliseconds(0);
@@ -25,18 +36,26 @@ int _SimulationControllerImpl::getSessionId() const
 
 void _SimulationControllerImpl::clear()
 {
-    _worker.clear();
+    if (_cpuSimulation) {
+        _cpuSimulation->clear();
+    } else {
+        _worker.clear();
+    }
 
     _selectionNeedsUpdate = true;
 }
 
 void _SimulationControllerImpl::setImageResource(void* image)
 {
+    checkGpuBackend();
     _worker.setImageResource(image);
 }
 
 std::string _SimulationControllerImpl::getGpuName() const
 {
+    if (_backend == SimulationBackend_Cpu) {
+        return "none (CPU backend)";
+    }
     return _worker.getGpuName();
 }
 
@@ -46,6 +65,7 @@ void _SimulationControllerImpl::tryDrawVectorGraphics(
     IntVector2D const& imageSize,
     double zoom)
 {
+    checkGpuBackend();
     _worker.tryDrawVectorGraphics(rectUpperLeft, rectLowerRight, imageSize, zoom);
 }
 
@@ -55,145 +75,185 @@ std::optional<OverlayDescription> _SimulationControllerImpl::tryDrawVectorGraphi
     IntVector2D const& imageSize,
     double zoom)
 {
+    checkGpuBackend();
     return _worker.tryDrawVectorGraphicsAndReturnOverlay(rectUpperLeft, rectLowerRight, imageSize, zoom);
 }
 
 bool _SimulationControllerImpl::isSyncSimulationWithRendering() const
 {
+    checkGpuBackend();
     return _worker.isSyncSimulationWithRendering();
 }
 
 void _SimulationControllerImpl::setSyncSimulationWithRendering(bool value)
 {
+    checkGpuBackend();
     _worker.setSyncSimulationWithRendering(value);
 }
 
 int _SimulationControllerImpl::getSyncSimulationWithRenderingRatio() const
 {
+    checkGpuBackend();
     return _worker.getSyncSimulationWithRenderingRatio();
 }
 
 void _SimulationControllerImpl::setSyncSimulationWithRenderingRatio(int value)
 {
+    checkGpuBackend();
     _worker.setSyncSimulationWithRenderingRatio(value);
 }
 
 ClusteredDataDescription _SimulationControllerImpl::getClusteredSimulationData()
 {
+    if (_cpuSimulation) {
+        return _cpuSimulation->getClusteredSimulationData();
+    }
     auto size = getWorldSize();
     return _worker.getClusteredSimulationData({-10, -10}, {size.x + 10, size.y + 10});
 }
 
 DataDescription _SimulationControllerImpl::getSimulationData()
 {
+    if (_cpuSimulation) {
+        return _cpuSimulation->getSimulationData();
+    }
     auto size = getWorldSize();
     return _worker.getSimulationData({-10, -10}, {size.x + 10, size.y + 10});
 }
 
 ClusteredDataDescription _SimulationControllerImpl::getSelectedClusteredSimulationData(bool includeClusters)
 {
+    checkGpuBackend();
     _worker.updateSelection();
     return _worker.getSelectedClusteredSimulationData(includeClusters);
 }
 
 DataDescription _SimulationControllerImpl::getSelectedSimulationData(bool includeClusters)
 {
+    checkGpuBackend();
     _worker.updateSelection();
     return _worker.getSelectedSimulationData(includeClusters);
 }
 
 DataDescription _SimulationControllerImpl::getInspectedSimulationData(std::vector<uint64_t> objectIds)
 {
+    checkGpuBackend();
     return _worker.getInspectedSimulationData(objectIds);
 }
 
 void _SimulationControllerImpl::addAndSelectSimulationData(DataDescription const& dataToAdd)
 {
+    checkGpuBackend();
     _worker.addAndSelectSimulationData(dataToAdd);
 }
 
 void _SimulationControllerImpl::setClusteredSimulationData(ClusteredDataDescription const& dataToUpdate)
 {
-    _worker.setClusteredSimulationData(dataToUpdate);
+    if (_cpuSimulation) {
+        _cpuSimulation->setClusteredSimulationData(dataToUpdate);
+    } else {
+        _worker.setClusteredSimulationData(dataToUpdate);
+    }
     _selectionNeedsUpdate = true;
 }
 
 void _SimulationControllerImpl::setSimulationData(DataDescription const& dataToUpdate)
 {
-    _worker.setSimulationData(dataToUpdate);
+    if (_cpuSimulation) {
+        _cpuSimulation->setSimulationData(dataToUpdate);
+    } else {
+        _worker.setSimulationData(dataToUpdate);
+    }
     _selectionNeedsUpdate = true;
 }
 
 void _SimulationControllerImpl::removeSelectedObjects(bool includeClusters)
 {
+    checkGpuBackend();
     _worker.removeSelectedObjects(includeClusters);
     _selectionNeedsUpdate = true;
 }
 
 void _SimulationControllerImpl::relaxSelectedObjects(bool includeClusters)
 {
+    checkGpuBackend();
     _worker.relaxSelectedObjects(includeClusters);
 }
 
 void _SimulationControllerImpl::uniformVelocitiesForSelectedObjects(bool includeClusters)
 {
+    checkGpuBackend();
     _worker.uniformVelocitiesForSelectedObjects(includeClusters);
 }
 
 void _SimulationControllerImpl::makeSticky(bool includeClusters)
 {
+    checkGpuBackend();
     _worker.makeSticky(includeClusters);
 }
 
 void _SimulationControllerImpl::removeStickiness(bool includeClusters)
 {
+    checkGpuBackend();
     _worker.removeStickiness(includeClusters);
 }
 
 void _SimulationControllerImpl::setBarrier(bool value, bool includeClusters)
 {
+    checkGpuBackend();
     _worker.setBarrier(value, includeClusters);
 }
 
 void _SimulationControllerImpl::colorSelectedObjects(unsigned char color, bool includeClusters)
 {
+    checkGpuBackend();
     _worker.colorSelectedObjects(color, includeClusters);
 }
 
 void _SimulationControllerImpl::reconnectSelectedObjects()
 {
+    checkGpuBackend();
     _worker.reconnectSelectedObjects();
 }
 
 void _SimulationControllerImpl::setDetached(bool value)
 {
+    checkGpuBackend();
     _worker.setDetached(value);
 }
 
 void _SimulationControllerImpl::changeCell(CellDescription const& changedCell)
 {
+    checkGpuBackend();
     _worker.changeCell(changedCell);
 }
 
 void _SimulationControllerImpl::changeParticle(ParticleDescription const& changedParticle)
 {
+    checkGpuBackend();
     _worker.changeParticle(changedParticle);
 }
 
 void _SimulationControllerImpl::calcTimesteps(uint64_t timesteps)
 {
-    _worker.calcTimesteps(timesteps);
+    if (_cpuSimulation) {
+        _cpuSimulation->calcTimesteps(timesteps);
+    } else {
+        _worker.calcTimesteps(timesteps);
+    }
     _selectionNeedsUpdate = true;
 }
 
 void _SimulationControllerImpl::runSimulation()
 {
+    checkGpuBackend();
     _simRunTimePoint = std::chrono::system_clock::now();
     _worker.runSimulation();
 }
 
 void _SimulationControllerImpl::pauseSimulation()
 {
+    checkGpuBackend();
     _worker.pauseSimulation();
     _selectionNeedsUpdate = true;
 
@@ -203,16 +263,25 @@ void _SimulationControllerImpl::pauseSimulation()
 
 void _SimulationControllerImpl::applyCataclysm(int power)
 {
+    checkGpuBackend();
     _worker.applyCataclysm(power);
 }
 
 bool _SimulationControllerImpl::isSimulationRunning() const
 {
+    if (_backend == SimulationBackend_Cpu) {
+        return false;
+    }
     return _worker.isSimulationRunning();
 }
 
 void _SimulationControllerImpl::closeSimulation()
 {
+    if (_backend == SimulationBackend_Cpu) {
+        _cpuSimulation.reset();
+        _selectionNeedsUpdate = true;
+        return;
+    }
     _worker.beginShutdown();
     _thread->join();
     delete _thread;
@@ -222,12 +291,19 @@ void _SimulationControllerImpl::closeSimulation()
 
 uint64_t _SimulationControllerImpl::getCurrentTimestep() const
 {
+    if (_cpuSimulation) {
+        return _cpuSimulation->getCurrentTimestep();
+    }
     return _worker.getCurrentTimestep();
 }
 
 void _SimulationControllerImpl::setCurrentTimestep(uint64_t value)
 {
-    _worker.setCurrentTimestep(value);
+    if (_cpuSimulation) {
+        _cpuSimulation->setCurrentTimestep(value);
+    } else {
+        _worker.setCurrentTimestep(value);
+    }
 }
 
 std::chrono::milliseconds _SimulationControllerImpl::getRealTime() const
@@ -249,6 +325,9 @@ void _SimulationControllerImpl::setRealTime(std::chrono::milliseconds const& val
 
 SimulationParameters _SimulationControllerImpl::getSimulationParameters() const
 {
+    if (_cpuSimulation) {
+        return _cpuSimulation->getSimulationParameters();
+    }
     return _worker.getSimulationParameters();
 }
 
@@ -259,7 +338,11 @@ SimulationParameters const& _SimulationControllerImpl::getOriginalSimulationPara
 
 void _SimulationControllerImpl::setSimulationParameters(SimulationParameters const& parameters)
 {
-    _worker.setSimulationParameters(parameters);
+    if (_cpuSimulation) {
+        _cpuSimulation->setSimulationParameters(parameters);
+    } else {
+        _worker.setSimulationParameters(parameters);
+    }
 }
 
 void _SimulationControllerImpl::setOriginalSimulationParameters(SimulationParameters const& parameters)
@@ -279,6 +362,7 @@ GpuSettings _SimulationControllerImpl::getOriginalGpuSettings() const
 
 void _SimulationControllerImpl::setGpuSettings_async(GpuSettings const& gpuSettings)
 {
+    checkGpuBackend();
     _gpuSettings = gpuSettings;
     _worker.setGpuSettings_async(gpuSettings);
 }
@@ -289,36 +373,43 @@ void _SimulationControllerImpl::applyForce_async(
     RealVector2D const& force,
     float radius)
 {
+    checkGpuBackend();
     _worker.applyForce_async(start, end, force, radius);
 }
 
 void _SimulationControllerImpl::switchSelection(RealVector2D const& pos, float radius)
 {
+    checkGpuBackend();
     _worker.switchSelection(pos, radius);
 }
 
 void _SimulationControllerImpl::swapSelection(RealVector2D const& pos, float radius)
 {
+    checkGpuBackend();
     _worker.swapSelection(pos, radius);
 }
 
 SelectionShallowData _SimulationControllerImpl::getSelectionShallowData(RealVector2D const& refPos)
 {
+    checkGpuBackend();
     return _worker.getSelectionShallowData(refPos);
 }
 
 void _SimulationControllerImpl::shallowUpdateSelectedObjects(ShallowUpdateSelectionData const& updateData)
 {
+    checkGpuBackend();
     _worker.shallowUpdateSelectedObjects(updateData);
 }
 
 void _SimulationControllerImpl::setSelection(RealVector2D const& startPos, RealVector2D const& endPos)
 {
+    checkGpuBackend();
     _worker.setSelection(startPos, endPos);
 }
 
 void _SimulationControllerImpl::removeSelection()
 {
+    checkGpuBackend();
     _worker.removeSelection();
 }
 
@@ -326,7 +417,7 @@ bool _SimulationControllerImpl::updateSelectionIfNecessary()
 {
     auto result = _selectionNeedsUpdate;
     _selectionNeedsUpdate = false;
-    if (result) {
+    if (result && _backend == SimulationBackend_Gpu) {
         _worker.updateSelection();
     }
     return result;
@@ -344,36 +435,55 @@ IntVector2D _SimulationControllerImpl::getWorldSize() const
 
 RawStatisticsData _SimulationControllerImpl::getRawStatistics() const
 {
+    checkGpuBackend();
     return _worker.getRawStatistics();
 }
 
 StatisticsHistory const& _SimulationControllerImpl::getStatisticsHistory() const
 {
+    if (_backend == SimulationBackend_Cpu) {
+        return _cpuStatisticsHistory;
+    }
     return _worker.getStatisticsHistory();
 }
 
 void _SimulationControllerImpl::setStatisticsHistory(StatisticsHistoryData const& data)
 {
+    if (_backend == SimulationBackend_Cpu) {
+        _cpuStatisticsHistory.setData(data);
+        return;
+    }
     _worker.setStatisticsHistory(data);
 }
 
 std::optional<int> _SimulationControllerImpl::getTpsRestriction() const
 {
+    checkGpuBackend();
     auto result = _worker.getTpsRestriction();
     return 0 != result ? std::optional<int>(result) : std::optional<int>();
 }
 
 void _SimulationControllerImpl::setTpsRestriction(std::optional<int> const& value)
 {
+    checkGpuBackend();
     _worker.setTpsRestriction(value ? *value : 0);
 }
 
 float _SimulationControllerImpl::getTps() const
 {
+    checkGpuBackend();
     return _worker.getTps();
 }
 
 void _SimulationControllerImpl::testOnly_mutate(uint64_t cellId, MutationType mutationType)
 {
+    checkGpuBackend();
     _worker.testOnly_mutate(cellId, mutationType);
-}
\ No newline at end of file
+}
+
+void _SimulationControllerImpl::checkGpuBackend() const
+{
+    if (_backend != SimulationBackend_Gpu) {
+        throw std::runtime_error("Operation is not supported by the experimental CPU backend.");
+    }
+}
@@ -13,9 +13,18 @@
 
 #include "Definitions.h"
 
+using SimulationBackend = int;
+enum SimulationBackend_
+{
+    SimulationBackend_Gpu,
+    SimulationBackend_Cpu   //experimental host-only backend with a subset of the physics, see _CpuSimulation for supported features
+};
+
 class _SimulationControllerImpl : public _SimulationController
 {
 public:
+    _SimulationControllerImpl(SimulationBackend backend = SimulationBackend_Gpu);
+
     void newSimulation(uint64_t timestep, GeneralSettings const& generalSettings, SimulationParameters const& parameters) override;
     int getSessionId() const override;
 
@@ -115,6 +124,9 @@ public:
     void testOnly_mutate(uint64_t cellId, MutationType mutationType) override;
 
 private:
+    void checkGpuBackend() const;
+
+    SimulationBackend _backend = SimulationBackend_Gpu;
     bool _selectionNeedsUpdate = false;
     int _sessionId = 0;
 
@@ -126,4 +138,7 @@ private:
 
     EngineWorker _worker;
     std::thread* _thread = nullptr;
+
+    CpuSimulation _cpuSimulation;
+    StatisticsHistory _cpuStatisticsHistory;
 };
@@ -0,0 +1,94 @@
+#include "SparseMapReference.h"
+
+SparseMapReference::SparseMapReference(IntVector2D const& worldSize, uint64_t maxEntries)
+    : _worldSize(worldSize)
+{
+    allocate(SparseMapLayout::calcNumTileSlots({worldSize.x, worldSize.y}, maxEntries));
+}
+
+bool SparseMapReference::set(IntVector2D const& pos, uint64_t value, uint64_t& previousValue)
+{
+    auto entryIndex = _layout.findOrInsert(_tileKeys.data(), correctPosition(pos), [](uint64_t* address, uint64_t expected, uint64_t desired) {
+        auto result = *address;
+        if (result == expected) {
+            *address = desired;
+        }
+        return result;
+    });
+    if (entryIndex == -1) {
+        ++_numOverflows;
+        return false;
+    }
+    previousValue = _values.at(entryIndex);
+    _values.at(entryIndex) = value;
+    _mapEntries.emplace_back(entryIndex);
+    return true;
+}
+
+uint64_t SparseMapReference::get(IntVector2D const& pos) const
+{
+    auto entryIndex = _layout.find(_tileKeys.data(), correctPosition(pos));
+    return entryIndex != -1 ? _values.at(entryIndex) : 0;
+}
+
+void SparseMapReference::clear()
+{
+    for (auto const& entryIndex : _mapEntries) {
+        _values.at(entryIndex) = 0;
+        _tileKeys.at(SparseMapLayout::getTileSlot(entryIndex)) = SparseMapLayout::EmptyTileKey;
+    }
+    _mapEntries.clear();
+}
+
+bool SparseMapReference::reserve(uint64_t maxEntries)
+{
+    auto numTileSlots = SparseMapLayout::calcNumTileSlots({_worldSize.x, _worldSize.y}, maxEntries);
+    if (numTileSlots <= _layout.getNumTileSlots()) {
+        return false;
+    }
+    allocate(numTileSlots);
+    return true;
+}
+
+int SparseMapReference::growIfOverflowed()
+{
+    auto result = _numOverflows;
+    if (result > 0) {
+        _numOverflows = 0;
+        allocate(SparseMapLayout::calcGrownNumTileSlots({_worldSize.x, _worldSize.y}, _layout.getNumTileSlots(), result));
+    }
+    return result;
+}
+
+int SparseMapReference::getNumOccupiedTiles() const
+{
+    int result = 0;
+    for (auto const& tileKey : _tileKeys) {
+        if (tileKey != SparseMapLayout::EmptyTileKey) {
+            ++result;
+        }
+    }
+    return result;
+}
+
+uint64_t SparseMapReference::getMemorySize() const
+{
+    return _tileKeys.size() * sizeof(uint64_t) + _values.size() * sizeof(void*);
+}
+
+uint64_t SparseMapReference::getDenseMemorySize(IntVector2D const& worldSize)
+{
+    return static_cast<uint64_t>(worldSize.x) * worldSize.y * sizeof(void*);
+}
+
+void SparseMapReference::allocate(int numTileSlots)
+{
+    _layout.init({_worldSize.x, _worldSize.y}, numTileSlots);
+    _tileKeys.assign(numTileSlots, SparseMapLayout::EmptyTileKey);
+    _values.assign(_layout.getNumEntries(), 0);
+}
+
+int2 SparseMapReference::correctPosition(IntVector2D const& pos) const
+{
+    return {((pos.x % _worldSize.x) + _worldSize.x) % _worldSize.x, ((pos.y % _worldSize.y) + _worldSize.y) % _worldSize.y};
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <vector>
+
+#include "Base/Definitions.h"
+#include "Base/Vector2D.h"
+#include "EngineGpuKernels/SparseMapLayout.cuh"
+
+/**
+ * Host implementation of the sparse tiled map used by CellMap and ParticleMap on the GPU. It shares the address
+ * computation with the GPU version and allows to check correctness and memory footprint without a GPU.
+ * Values are object handles where 0 denotes an empty entry.
+ */
+class SparseMapReference
+{
+public:
+    SparseMapReference(IntVector2D const& worldSize, uint64_t maxEntries);
+
+    //returns false if there is no tile slot left, previousValue contains the value which was stored before
+    bool set(IntVector2D const& pos, uint64_t value, uint64_t& previousValue);
+    uint64_t get(IntVector2D const& pos) const;
+
+    //removes all entries as the cleanup kernels do
+    void clear();
+
+    //enlarges the tile slots for maxEntries objects but never shrinks them as CellMap/ParticleMap do on array resizes,
+    //returns true if the map has been reallocated, may only be called after clear
+    bool reserve(uint64_t maxEntries);
+
+    //returns the number of failed set calls since the last call and enlarges the tile slots in this case such that the
+    //same objects would fit as CellMap/ParticleMap do after a time step, may only be called after clear
+    int growIfOverflowed();
+
+    int getNumOccupiedTiles() const;
+    uint64_t getMemorySize() const;  //in bytes, as it would be allocated on the GPU for pointer values
+
+    static uint64_t getDenseMemorySize(IntVector2D const& worldSize);
+
+private:
+    void allocate(int numTileSlots);
+    int2 correctPosition(IntVector2D const& pos) const;
+
+    IntVector2D _worldSize;
+    SparseMapLayout _layout;
+    std::vector<uint64_t> _tileKeys;
+    std::vector<uint64_t> _values;
+    std::vector<int> _mapEntries;
+    int _numOverflows = 0;
+};
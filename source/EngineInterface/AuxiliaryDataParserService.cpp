@@ -1,1073 +1,591 @@
 #include "AuxiliaryDataParserService.h"
 
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Base/JsonStream.h"
+
 #include "GeneralSettings.h"
+#include "ParametersFieldTable.h"
 #include "Settings.h"
 #include "SimulationParametersService.h"
 
 namespace
 {
-    //return true if value does not exist in tree
-    template <typename T>
-    bool encodeDecodeProperty(boost::property_tree::ptree& tree, T& parameter, T const& defaultValue, std::string const& node, ParserTask task)
+    int toInt(size_t value)
     {
-        return JsonParser::encodeDecode(tree, parameter, defaultValue, node, task);
+        return static_cast<int>(value);
     }
 
-    template <>
-    bool encodeDecodeProperty(
-        boost::property_tree::ptree& tree,
-        ColorVector<float>& parameter,
-        ColorVector<float> const& defaultValue,
-        std::string const& node,
-        ParserTask task)
+    using LeafOwner = int;
+    enum LeafOwner_
     {
-        auto result = false;
-        for (int i = 0; i < MAX_COLORS; ++i) {
-            result |= encodeDecodeProperty(tree, parameter[i], defaultValue[i], node + "[" + std::to_string(i) + "]", task);
-        }
-        return result;
-    }
+        LeafOwner_AuxiliaryData,
+        LeafOwner_SimulationParameters,
+        LeafOwner_Spot,
+        LeafOwner_ParticleSource
+    };
+
+    //single property in the settings files
+    struct Leaf
+    {
+        std::string path;
+        int node = 0;
+        LeafOwner owner = LeafOwner_AuxiliaryData;
+        int ownerIndex = 0;  //spot or particle source index
+        int fieldIndex = 0;  //index in the field table of the owner
+        int element = 0;  //index in color vector or matrix
+        bool activation = false;  //activation flag of a spot value
+        ParameterFieldType valueType = ParameterFieldType_Bool;  //scalar type
+    };
+
+    struct SchemaNode
+    {
+        std::string key;
+        int parent = -1;
+        int leaf = -1;  //-1 for inner nodes
+    };
 
-    template <>
-    bool encodeDecodeProperty(
-        boost::property_tree::ptree& tree,
-        ColorVector<int>& parameter,
-        ColorVector<int> const& defaultValue,
-        std::string const& node,
-        ParserTask task)
+    //all properties in the order of the field tables, built once from the tables
+    struct Schema
     {
-        auto result = false;
-        for (int i = 0; i < MAX_COLORS; ++i) {
-            result |= encodeDecodeProperty(tree, parameter[i], defaultValue[i], node + "[" + std::to_string(i) + "]", task);
+        std::vector<Leaf> leaves;  //leaves of the auxiliary data fields come first
+        int numAuxiliaryDataLeaves = 0;
+        std::vector<SchemaNode> nodes;  //nodes[0] is the root
+        std::unordered_map<std::string_view, int> leafIndexByPath;
+        std::unordered_map<std::string_view, std::vector<int>> leafIndicesBySimulationParametersKey;  //key as in SimulationParametersFields
+    };
+
+    class SchemaBuilder
+    {
+    public:
+        Schema build()
+        {
+            _schema.nodes.emplace_back();
+            addFields(AuxiliaryDataFields, LeafOwner_AuxiliaryData, 0, "");
+            _schema.numAuxiliaryDataLeaves = toInt(_schema.leaves.size());
+            addFields(SimulationParametersFields, LeafOwner_SimulationParameters, 0, "");
+
+            for (int i = 0; i < toInt(_schema.leaves.size()); ++i) {
+                auto const& leaf = _schema.leaves.at(i);
+                _schema.leafIndexByPath.emplace(leaf.path, i);
+                if (leaf.owner == LeafOwner_SimulationParameters) {
+                    _schema.leafIndicesBySimulationParametersKey[SimulationParametersFields[leaf.fieldIndex].key].emplace_back(i);
+                }
+            }
+            return std::move(_schema);
         }
-        return result;
-    }
 
-    template <>
-    bool encodeDecodeProperty<ColorMatrix<float>>(
-        boost::property_tree::ptree& tree,
-        ColorMatrix<float>& parameter,
-        ColorMatrix<float> const& defaultValue,
-        std::string const& node,
-        ParserTask task)
-    {
-        auto result = false;
-        for (int i = 0; i < MAX_COLORS; ++i) {
-            for (int j = 0; j < MAX_COLORS; ++j) {
-                result |= encodeDecodeProperty(tree, parameter[i][j], defaultValue[i][j], node + "[" + std::to_string(i) + ", " + std::to_string(j) + "]", task);
+    private:
+        template <typename Object, size_t N>
+        void addFields(ParameterField<Object> const (&fields)[N], LeafOwner owner, int ownerIndex, std::string const& prefix)
+        {
+            for (int fieldIndex = 0; fieldIndex < toInt(N); ++fieldIndex) {
+                auto const& field = fields[fieldIndex];
+                auto key = prefix + field.key;
+                if (field.type == ParameterFieldType_ParticleSources) {
+                    for (int i = 0; i < MAX_PARTICLE_SOURCES; ++i) {
+                        addFields(RadiationSourceFields, LeafOwner_ParticleSource, i, key + "." + std::to_string(i) + ".");
+                    }
+                    continue;
+                }
+                if (field.type == ParameterFieldType_Spots) {
+                    for (int i = 0; i < MAX_SPOTS; ++i) {
+                        addFields(SimulationParametersSpotFields, LeafOwner_Spot, i, key + "." + std::to_string(i) + ".");
+                    }
+                    continue;
+                }
+
+                Leaf leaf{.owner = owner, .ownerIndex = ownerIndex, .fieldIndex = fieldIndex};
+                if (field.getActivated) {
+                    leaf.activation = true;
+                    addLeaf(leaf, key + ".activated", ParameterFieldType_Bool);
+                    leaf.activation = false;
+
+                    //color vectors of spots are stored without ".value"
+                    if (field.type != ParameterFieldType_ColorVectorInt && field.type != ParameterFieldType_ColorVectorFloat) {
+                        key += ".value";
+                    }
+                }
+                switch (field.type) {
+                case ParameterFieldType_ColorVectorInt:
+                case ParameterFieldType_ColorVectorFloat: {
+                    auto valueType = field.type == ParameterFieldType_ColorVectorInt ? ParameterFieldType_Int : ParameterFieldType_Float;
+                    for (int i = 0; i < MAX_COLORS; ++i) {
+                        leaf.element = i;
+                        addLeaf(leaf, key + "[" + std::to_string(i) + "]", valueType);
+                    }
+                } break;
+                case ParameterFieldType_ColorMatrixInt:
+                case ParameterFieldType_ColorMatrixFloat:
+                case ParameterFieldType_ColorMatrixBool: {
+                    auto valueType = field.type == ParameterFieldType_ColorMatrixInt
+                        ? ParameterFieldType_Int
+                        : (field.type == ParameterFieldType_ColorMatrixFloat ? ParameterFieldType_Float : ParameterFieldType_Bool);
+                    for (int i = 0; i < MAX_COLORS; ++i) {
+                        for (int j = 0; j < MAX_COLORS; ++j) {
+                            leaf.element = i * MAX_COLORS + j;
+                            addLeaf(leaf, key + "[" + std::to_string(i) + ", " + std::to_string(j) + "]", valueType);
+                        }
+                    }
+                } break;
+                default:
+                    addLeaf(leaf, key, field.type);
+                }
             }
         }
-        return result;
-    }
 
-    template <>
-    bool encodeDecodeProperty<ColorMatrix<int>>(
-        boost::property_tree::ptree& tree,
-        ColorMatrix<int>& parameter,
-        ColorMatrix<int> const& defaultValue,
-        std::string const& node,
-        ParserTask task)
-    {
-        auto result = false;
-        for (int i = 0; i < MAX_COLORS; ++i) {
-            for (int j = 0; j < MAX_COLORS; ++j) {
-                result |= encodeDecodeProperty(tree, parameter[i][j], defaultValue[i][j], node + "[" + std::to_string(i) + ", " + std::to_string(j) + "]", task);
+        void addLeaf(Leaf leaf, std::string const& path, ParameterFieldType valueType)
+        {
+            leaf.path = path;
+            leaf.valueType = valueType;
+            leaf.node = getNode(path);
+            auto& node = _schema.nodes.at(leaf.node);
+            if (node.leaf != -1 || _hasChildren.contains(leaf.node)) {
+                throw std::runtime_error("Duplicate property '" + path + "' in the parameter field tables.");
             }
+            node.leaf = toInt(_schema.leaves.size());
+            _schema.leaves.emplace_back(std::move(leaf));
         }
-        return result;
+
+        int getNode(std::string const& path)
+        {
+            auto result = 0;
+            for (size_t pos = 0; pos <= path.size();) {
+                auto separatorPos = std::min(path.find('.', pos), path.size());
+                auto nodePath = path.substr(0, separatorPos);
+                auto findResult = _nodeIndexByPath.find(nodePath);
+                if (findResult != _nodeIndexByPath.end()) {
+                    result = findResult->second;
+                } else {
+                    if (_schema.nodes.at(result).leaf != -1) {
+                        throw std::runtime_error("Property '" + nodePath + "' in the parameter field tables has children.");
+                    }
+                    _hasChildren.insert(result);
+                    _schema.nodes.emplace_back(SchemaNode{.key = path.substr(pos, separatorPos - pos), .parent = result});
+                    result = toInt(_schema.nodes.size()) - 1;
+                    _nodeIndexByPath.emplace(nodePath, result);
+                }
+                pos = separatorPos + 1;
+            }
+            return result;
+        }
+
+        Schema _schema;
+        std::unordered_map<std::string, int> _nodeIndexByPath;
+        std::unordered_set<int> _hasChildren;
+    };
+
+    Schema const& getSchema()
+    {
+        static Schema const schema = SchemaBuilder().build();
+        return schema;
     }
 
-    template <>
-    bool encodeDecodeProperty<ColorMatrix<bool>>(
-        boost::property_tree::ptree& tree,
-        ColorMatrix<bool>& parameter,
-        ColorMatrix<bool> const& defaultValue,
-        std::string const& node,
-        ParserTask task)
+    size_t getValueSize(ParameterFieldType valueType)
     {
-        auto result = false;
-        for (int i = 0; i < MAX_COLORS; ++i) {
-            for (int j = 0; j < MAX_COLORS; ++j) {
-                result |=
-                    encodeDecodeProperty(tree, parameter[i][j], defaultValue[i][j], node + "[" + std::to_string(i) + ", " + std::to_string(j) + "]", task);
-            }
+        switch (valueType) {
+        case ParameterFieldType_Bool:
+            return sizeof(bool);
+        case ParameterFieldType_Int:
+            return sizeof(int);
+        case ParameterFieldType_UInt32:
+            return sizeof(uint32_t);
+        case ParameterFieldType_UInt64:
+            return sizeof(uint64_t);
+        case ParameterFieldType_Float:
+            return sizeof(float);
+        default:
+            return sizeof(std::chrono::milliseconds);
         }
-        return result;
     }
 
-    template <>
-    bool encodeDecodeProperty(
-        boost::property_tree::ptree& tree,
-        std::chrono::milliseconds& parameter,
-        std::chrono::milliseconds const& defaultValue,
-        std::string const& node,
-        ParserTask task)
+    template <typename Object>
+    void* getValue(ParameterField<Object> const& field, Object& object, Leaf const& leaf)
     {
-        if (ParserTask::Encode == task) {
-            auto parameterAsString = std::to_string(parameter.count());
-            return encodeDecodeProperty(tree, parameterAsString, std::string(), node, task);
-        } else {
-            std::string parameterAsString;
-            auto defaultAsString = std::to_string(defaultValue.count());
-            auto result = encodeDecodeProperty(tree, parameterAsString, defaultAsString, node, task);
-            parameter = std::chrono::milliseconds(std::stoi(parameterAsString));
-            return result;
+        if (field.isActive && !field.isActive(object)) {
+            return nullptr;
+        }
+        if (leaf.activation) {
+            return field.getActivated(object);
         }
+        return static_cast<char*>(field.getValue(object)) + leaf.element * getValueSize(leaf.valueType);
     }
 
-    template <typename T>
-    void encodeDecodeSpotProperty(
-        boost::property_tree::ptree& tree,
-        T& parameter,
-        bool& isActivated,
-        T const& defaultValue,
-        std::string const& node,
-        ParserTask task)
+    template <typename Object>
+    void const* getValue(ParameterField<Object> const& field, Object const& object, Leaf const& leaf)
     {
-        encodeDecodeProperty(tree, isActivated, false, node + ".activated", task);
-        encodeDecodeProperty(tree, parameter, defaultValue, node + ".value", task);
+        if (field.isActive && !field.isActive(object)) {
+            return nullptr;
+        }
+        if (leaf.activation) {
+            return field.getConstActivated(object);
+        }
+        return static_cast<char const*>(field.getConstValue(object)) + leaf.element * getValueSize(leaf.valueType);
     }
 
-    template <>
-    void encodeDecodeSpotProperty(
-        boost::property_tree::ptree& tree,
-        ColorVector<float>& parameter,
-        bool& isActivated,
-        ColorVector<float> const& defaultValue,
-        std::string const& node,
-        ParserTask task)
+    //returns nullptr if the property is not encoded/decoded for the current values
+    //Data and Parameters are both const for encoding and both mutable for decoding
+    template <typename Data, typename Parameters>
+    auto getValue(Leaf const& leaf, Data* data, Parameters& parameters) -> std::conditional_t<std::is_const_v<Parameters>, void const*, void*>
     {
-        encodeDecodeProperty(tree, isActivated, false, node + ".activated", task);
-        encodeDecodeProperty(tree, parameter, defaultValue, node, task);
+        switch (leaf.owner) {
+        case LeafOwner_AuxiliaryData:
+            return getValue(AuxiliaryDataFields[leaf.fieldIndex], *data, leaf);
+        case LeafOwner_SimulationParameters:
+            return getValue(SimulationParametersFields[leaf.fieldIndex], parameters, leaf);
+        case LeafOwner_Spot:
+            if (leaf.ownerIndex >= parameters.numSpots) {
+                return nullptr;
+            }
+            return getValue(SimulationParametersSpotFields[leaf.fieldIndex], parameters.spots[leaf.ownerIndex], leaf);
+        default:
+            if (leaf.ownerIndex >= parameters.numParticleSources) {
+                return nullptr;
+            }
+            return getValue(RadiationSourceFields[leaf.fieldIndex], parameters.particleSources[leaf.ownerIndex], leaf);
+        }
     }
 
-    template <>
-    void encodeDecodeSpotProperty(
-        boost::property_tree::ptree& tree,
-        ColorVector<int>& parameter,
-        bool& isActivated,
-        ColorVector<int> const& defaultValue,
-        std::string const& node,
-        ParserTask task)
+    //same representation as JsonParser::encodeDecode
+    std::string_view formatValue(void const* value, ParameterFieldType valueType, char (&buffer)[64])
     {
-        encodeDecodeProperty(tree, isActivated, false, node + ".activated", task);
-        encodeDecodeProperty(tree, parameter, defaultValue, node, task);
+        std::to_chars_result result;
+        switch (valueType) {
+        case ParameterFieldType_Bool:
+            return *static_cast<bool const*>(value) ? "true" : "false";
+        case ParameterFieldType_Int:
+            result = std::to_chars(buffer, buffer + sizeof(buffer), *static_cast<int const*>(value));
+            break;
+        case ParameterFieldType_UInt32:
+            result = std::to_chars(buffer, buffer + sizeof(buffer), *static_cast<uint32_t const*>(value));
+            break;
+        case ParameterFieldType_UInt64:
+            result = std::to_chars(buffer, buffer + sizeof(buffer), *static_cast<uint64_t const*>(value));
+            break;
+        case ParameterFieldType_Float:
+            result = std::to_chars(buffer, buffer + sizeof(buffer), *static_cast<float const*>(value), std::chars_format::fixed, 8);
+            break;
+        default:
+            result = std::to_chars(buffer, buffer + sizeof(buffer), static_cast<std::chrono::milliseconds const*>(value)->count());
+        }
+        if (result.ec != std::errc()) {
+            return std::string_view(buffer, 0);
+        }
+        return std::string_view(buffer, result.ptr - buffer);
     }
 
     template <typename T>
-    void encodeDecodeSpotProperty(
-        boost::property_tree::ptree& tree,
-        ColorMatrix<T>& parameter,
-        bool& isActivated,
-        ColorMatrix<bool> const& defaultValue,
-        std::string const& node,
-        ParserTask task)
+    bool parseNumber(std::string_view text, T& result, bool allowSuffix = false)
     {
-        encodeDecodeProperty(tree, isActivated, false, node + ".activated", task);
-        encodeDecodeProperty(tree, parameter, defaultValue, node, task);
+        if (text.starts_with('+') && !text.substr(1).starts_with('-')) {
+            text.remove_prefix(1);
+        }
+        //negative values are wrapped for unsigned types as by stream extraction
+        auto negate = false;
+        if constexpr (std::is_unsigned_v<T>) {
+            if (text.starts_with('-') && !text.substr(1).starts_with('+') && !text.substr(1).starts_with('-')) {
+                text.remove_prefix(1);
+                negate = true;
+            }
+        }
+        auto parseResult = std::from_chars(text.data(), text.data() + text.size(), result);
+        if (negate) {
+            result = T(0) - result;
+        }
+        return parseResult.ec == std::errc() && (allowSuffix || parseResult.ptr == text.data() + text.size());
     }
 
-    void encodeDecode(boost::property_tree::ptree& tree, SimulationParameters& parameters, ParserTask parserTask)
+    //same semantics as boost::property_tree::ptree::get: the value is kept if the text cannot be fully converted
+    void parseValue(std::string_view text, void* value, ParameterFieldType valueType)
     {
-        SimulationParameters defaultParameters;
-        MissingParameters missingParameters;
-
-        encodeDecodeProperty(tree, parameters.backgroundColor, defaultParameters.backgroundColor, "simulation parameters.background color", parserTask);
-        encodeDecodeProperty(tree, parameters.cellColoring, defaultParameters.cellColoring, "simulation parameters.cell colorization", parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.highlightedCellFunction,
-            defaultParameters.highlightedCellFunction,
-            "simulation parameters.highlighted cell function",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.zoomLevelNeuronalActivity,
-            defaultParameters.zoomLevelNeuronalActivity,
-            "simulation parameters.zoom level.neural activity",
-            parserTask);
-        encodeDecodeProperty(
-            tree, parameters.borderlessRendering, defaultParameters.borderlessRendering, "simulation parameters.borderless rendering", parserTask);
-        encodeDecodeProperty(
-            tree, parameters.markReferenceDomain, defaultParameters.markReferenceDomain, "simulation parameters.mark reference domain", parserTask);
-        encodeDecodeProperty(tree, parameters.gridLines, defaultParameters.gridLines, "simulation parameters.grid lines", parserTask);
-        encodeDecodeProperty(tree, parameters.timestepSize, defaultParameters.timestepSize, "simulation parameters.time step size", parserTask);
-
-        encodeDecodeProperty(tree, parameters.motionType, defaultParameters.motionType, "simulation parameters.motion.type", parserTask);
-        if (parameters.motionType == MotionType_Fluid) {
-            encodeDecodeProperty(
-                tree,
-                parameters.motionData.fluidMotion.smoothingLength,
-                defaultParameters.motionData.fluidMotion.smoothingLength,
-                "simulation parameters.fluid.smoothing length",
-                parserTask);
-            encodeDecodeProperty(
-                tree,
-                parameters.motionData.fluidMotion.pressureStrength,
-                defaultParameters.motionData.fluidMotion.pressureStrength,
-                "simulation parameters.fluid.pressure strength",
-                parserTask);
-            encodeDecodeProperty(
-                tree,
-                parameters.motionData.fluidMotion.viscosityStrength,
-                defaultParameters.motionData.fluidMotion.viscosityStrength,
-                "simulation parameters.fluid.viscosity strength",
-                parserTask);
-        } else {
-            encodeDecodeProperty(
-                tree,
-                parameters.motionData.collisionMotion.cellMaxCollisionDistance,
-                defaultParameters.motionData.collisionMotion.cellMaxCollisionDistance,
-                "simulation parameters.motion.collision.max distance",
-                parserTask);
-            encodeDecodeProperty(
-                tree,
-                parameters.motionData.collisionMotion.cellRepulsionStrength,
-                defaultParameters.motionData.collisionMotion.cellRepulsionStrength,
-                "simulation parameters.motion.collision.repulsion strength",
-                parserTask);
+        auto start = text.find_first_not_of(" \t\n\r\f\v");
+        if (start == std::string_view::npos) {
+            return;
         }
-
-        encodeDecodeProperty(tree, parameters.baseValues.friction, defaultParameters.baseValues.friction, "simulation parameters.friction", parserTask);
-        encodeDecodeProperty(tree, parameters.baseValues.rigidity, defaultParameters.baseValues.rigidity, "simulation parameters.rigidity", parserTask);
-        encodeDecodeProperty(tree, parameters.cellMaxVelocity, defaultParameters.cellMaxVelocity, "simulation parameters.cell.max velocity", parserTask);
-        encodeDecodeProperty(
-            tree, parameters.cellMaxBindingDistance, defaultParameters.cellMaxBindingDistance, "simulation parameters.cell.max binding distance", parserTask);
-        encodeDecodeProperty(tree, parameters.cellNormalEnergy, defaultParameters.cellNormalEnergy, "simulation parameters.cell.normal energy", parserTask);
-
-        encodeDecodeProperty(tree, parameters.cellMinDistance, defaultParameters.cellMinDistance, "simulation parameters.cell.min distance", parserTask);
-        encodeDecodeProperty(
-            tree, parameters.baseValues.cellMaxForce, defaultParameters.baseValues.cellMaxForce, "simulation parameters.cell.max force", parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.cellMaxForceDecayProb,
-            defaultParameters.cellMaxForceDecayProb,
-            "simulation parameters.cell.max force decay probability",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.cellNumExecutionOrderNumbers,
-            defaultParameters.cellNumExecutionOrderNumbers,
-            "simulation parameters.cell.max execution order number",
-            parserTask);
-        encodeDecodeProperty(
-            tree, parameters.baseValues.cellMinEnergy, defaultParameters.baseValues.cellMinEnergy, "simulation parameters.cell.min energy", parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.baseValues.cellFusionVelocity,
-            defaultParameters.baseValues.cellFusionVelocity,
-            "simulation parameters.cell.fusion velocity",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.baseValues.cellMaxBindingEnergy,
-            parameters.baseValues.cellMaxBindingEnergy,
-            "simulation parameters.cell.max binding energy",
-            parserTask);
-        encodeDecodeProperty(tree, parameters.cellMaxAge, defaultParameters.cellMaxAge, "simulation parameters.cell.max age", parserTask);
-        encodeDecodeProperty(
-            tree, parameters.cellMaxAgeBalancer, defaultParameters.cellMaxAgeBalancer, "simulation parameters.cell.max age.balance.enabled", parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.cellMaxAgeBalancerInterval,
-            defaultParameters.cellMaxAgeBalancerInterval,
-            "simulation parameters.cell.max age.balance.interval",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.baseValues.cellColorTransitionDuration,
-            defaultParameters.baseValues.cellColorTransitionDuration,
-            "simulation parameters.cell.color transition rules.duration",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.baseValues.cellColorTransitionTargetColor,
-            defaultParameters.baseValues.cellColorTransitionTargetColor,
-            "simulation parameters.cell.color transition rules.target color",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.genomeComplexityRamificationFactor,
-            defaultParameters.genomeComplexityRamificationFactor,
-            "simulation parameters.genome complexity.genome complexity ramification factor",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.genomeComplexitySizeFactor,
-            defaultParameters.genomeComplexitySizeFactor,
-            "simulation parameters.genome complexity.genome complexity size factor",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.baseValues.radiationCellAgeStrength,
-            defaultParameters.baseValues.radiationCellAgeStrength,
-            "simulation parameters.radiation.factor",
-            parserTask);
-        encodeDecodeProperty(tree, parameters.radiationProb, defaultParameters.radiationProb, "simulation parameters.radiation.probability", parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.radiationVelocityMultiplier,
-            defaultParameters.radiationVelocityMultiplier,
-            "simulation parameters.radiation.velocity multiplier",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.radiationVelocityPerturbation,
-            defaultParameters.radiationVelocityPerturbation,
-            "simulation parameters.radiation.velocity perturbation",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.baseValues.radiationAbsorption,
-            defaultParameters.baseValues.radiationAbsorption,
-            "simulation parameters.radiation.absorption",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.radiationAbsorptionHighVelocityPenalty,
-            defaultParameters.radiationAbsorptionHighVelocityPenalty,
-            "simulation parameters.radiation.absorption velocity penalty",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.baseValues.radiationAbsorptionLowVelocityPenalty,
-            defaultParameters.baseValues.radiationAbsorptionLowVelocityPenalty,
-            "simulation parameters.radiation.absorption low velocity penalty",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.radiationAbsorptionLowConnectionPenalty,
-            defaultParameters.radiationAbsorptionLowConnectionPenalty,
-            "simulation parameters.radiation.absorption low connection penalty",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.baseValues.radiationAbsorptionLowGenomeComplexityPenalty,
-            defaultParameters.baseValues.radiationAbsorptionLowGenomeComplexityPenalty,
-            "simulation parameters.radiation.absorption low genome complexity penalty",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.highRadiationMinCellEnergy,
-            defaultParameters.highRadiationMinCellEnergy,
-            "simulation parameters.high radiation.min cell energy",
-            parserTask);
-        encodeDecodeProperty(
-            tree, parameters.highRadiationFactor, defaultParameters.highRadiationFactor, "simulation parameters.high radiation.factor", parserTask);
-        encodeDecodeProperty(
-            tree, parameters.radiationMinCellAge, defaultParameters.radiationMinCellAge, "simulation parameters.radiation.min cell age", parserTask);
-
-        encodeDecodeProperty(
-            tree, parameters.externalEnergy, defaultParameters.externalEnergy, "simulation parameters.cell.function.constructor.external energy", parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.externalEnergyInflowFactor,
-            defaultParameters.externalEnergyInflowFactor,
-            "simulation parameters.cell.function.constructor.external energy supply rate",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.externalEnergyConditionalInflowFactor,
-            defaultParameters.externalEnergyConditionalInflowFactor,
-            "simulation parameters.cell.function.constructor.pump energy factor",
-            parserTask);
-        missingParameters.externalEnergyBackflowFactor = encodeDecodeProperty(
-            tree,
-            parameters.externalEnergyBackflowFactor,
-            defaultParameters.externalEnergyBackflowFactor,
-            "simulation parameters.cell.function.constructor.external energy backflow",
-            parserTask);
-
-        encodeDecodeProperty(tree, parameters.clusterDecay, defaultParameters.clusterDecay, "simulation parameters.cluster.decay", parserTask);
-        encodeDecodeProperty(
-            tree, parameters.clusterDecayProb, defaultParameters.clusterDecayProb, "simulation parameters.cluster.decay probability", parserTask);
-
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionConstructorOffspringDistance,
-            defaultParameters.cellFunctionConstructorOffspringDistance,
-            "simulation parameters.cell.function.constructor.offspring distance",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionConstructorConnectingCellMaxDistance,
-            defaultParameters.cellFunctionConstructorConnectingCellMaxDistance,
-            "simulation parameters.cell.function.constructor.connecting cell max distance",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionConstructorActivityThreshold,
-            defaultParameters.cellFunctionConstructorActivityThreshold,
-            "simulation parameters.cell.function.constructor.activity threshold",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.baseValues.cellFunctionConstructorMutationNeuronDataProbability,
-            defaultParameters.baseValues.cellFunctionConstructorMutationNeuronDataProbability,
-            "simulation parameters.cell.function.constructor.mutation probability.neuron data",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.baseValues.cellFunctionConstructorMutationPropertiesProbability,
-            defaultParameters.baseValues.cellFunctionConstructorMutationPropertiesProbability,
-            "simulation parameters.cell.function.constructor.mutation probability.data",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.baseValues.cellFunctionConstructorMutationGeometryProbability,
-            defaultParameters.baseValues.cellFunctionConstructorMutationGeometryProbability,
-            "simulation parameters.cell.function.constructor.mutation probability.geometry",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.baseValues.cellFunctionConstructorMutationCustomGeometryProbability,
-            defaultParameters.baseValues.cellFunctionConstructorMutationCustomGeometryProbability,
-            "simulation parameters.cell.function.constructor.mutation probability.custom geometry",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.baseValues.cellFunctionConstructorMutationCellFunctionProbability,
-            defaultParameters.baseValues.cellFunctionConstructorMutationCellFunctionProbability,
-            "simulation parameters.cell.function.constructor.mutation probability.cell function",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.baseValues.cellFunctionConstructorMutationInsertionProbability,
-            defaultParameters.baseValues.cellFunctionConstructorMutationInsertionProbability,
-            "simulation parameters.cell.function.constructor.mutation probability.insertion",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.baseValues.cellFunctionConstructorMutationDeletionProbability,
-            defaultParameters.baseValues.cellFunctionConstructorMutationDeletionProbability,
-            "simulation parameters.cell.function.constructor.mutation probability.deletion",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.baseValues.cellFunctionConstructorMutationTranslationProbability,
-            defaultParameters.baseValues.cellFunctionConstructorMutationTranslationProbability,
-            "simulation parameters.cell.function.constructor.mutation probability.translation",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.baseValues.cellFunctionConstructorMutationDuplicationProbability,
-            defaultParameters.baseValues.cellFunctionConstructorMutationDuplicationProbability,
-            "simulation parameters.cell.function.constructor.mutation probability.duplication",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.baseValues.cellFunctionConstructorMutationCellColorProbability,
-            defaultParameters.baseValues.cellFunctionConstructorMutationCellColorProbability,
-            "simulation parameters.cell.function.constructor.mutation probability.cell color",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.baseValues.cellFunctionConstructorMutationSubgenomeColorProbability,
-            defaultParameters.baseValues.cellFunctionConstructorMutationSubgenomeColorProbability,
-            "simulation parameters.cell.function.constructor.mutation probability.color",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.baseValues.cellFunctionConstructorMutationGenomeColorProbability,
-            defaultParameters.baseValues.cellFunctionConstructorMutationGenomeColorProbability,
-            "simulation parameters.cell.function.constructor.mutation probability.uniform color",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionConstructorMutationColorTransitions,
-            defaultParameters.cellFunctionConstructorMutationColorTransitions,
-            "simulation parameters.cell.function.constructor.mutation color transition",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionConstructorMutationSelfReplication,
-            defaultParameters.cellFunctionConstructorMutationSelfReplication,
-            "simulation parameters.cell.function.constructor.mutation self replication",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionConstructorMutationPreventDepthIncrease,
-            defaultParameters.cellFunctionConstructorMutationPreventDepthIncrease,
-            "simulation parameters.cell.function.constructor.mutation prevent depth increase",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionConstructorCheckCompletenessForSelfReplication,
-            defaultParameters.cellFunctionConstructorCheckCompletenessForSelfReplication,
-            "simulation parameters.cell.function.constructor.completeness check for self-replication",
-            parserTask);
-
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionInjectorRadius,
-            defaultParameters.cellFunctionInjectorRadius,
-            "simulation parameters.cell.function.injector.radius",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionInjectorDurationColorMatrix,
-            defaultParameters.cellFunctionInjectorDurationColorMatrix,
-            "simulation parameters.cell.function.injector.duration",
-            parserTask);
-
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionAttackerRadius,
-            defaultParameters.cellFunctionAttackerRadius,
-            "simulation parameters.cell.function.attacker.radius",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionAttackerStrength,
-            defaultParameters.cellFunctionAttackerStrength,
-            "simulation parameters.cell.function.attacker.strength",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionAttackerEnergyDistributionRadius,
-            defaultParameters.cellFunctionAttackerEnergyDistributionRadius,
-            "simulation parameters.cell.function.attacker.energy distribution radius",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionAttackerEnergyDistributionValue,
-            defaultParameters.cellFunctionAttackerEnergyDistributionValue,
-            "simulation parameters.cell.function.attacker.energy distribution value",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionAttackerColorInhomogeneityFactor,
-            defaultParameters.cellFunctionAttackerColorInhomogeneityFactor,
-            "simulation parameters.cell.function.attacker.color inhomogeneity factor",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionAttackerActivityThreshold,
-            defaultParameters.cellFunctionAttackerActivityThreshold,
-            "simulation parameters.cell.function.attacker.activity threshold",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.baseValues.cellFunctionAttackerEnergyCost,
-            defaultParameters.baseValues.cellFunctionAttackerEnergyCost,
-            "simulation parameters.cell.function.attacker.energy cost",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.baseValues.cellFunctionAttackerGeometryDeviationExponent,
-            defaultParameters.baseValues.cellFunctionAttackerGeometryDeviationExponent,
-            "simulation parameters.cell.function.attacker.geometry deviation exponent",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.baseValues.cellFunctionAttackerFoodChainColorMatrix,
-            defaultParameters.baseValues.cellFunctionAttackerFoodChainColorMatrix,
-            "simulation parameters.cell.function.attacker.food chain color matrix",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.baseValues.cellFunctionAttackerConnectionsMismatchPenalty,
-            defaultParameters.baseValues.cellFunctionAttackerConnectionsMismatchPenalty,
-            "simulation parameters.cell.function.attacker.connections mismatch penalty",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.baseValues.cellFunctionAttackerGenomeComplexityBonus,
-            defaultParameters.baseValues.cellFunctionAttackerGenomeComplexityBonus,
-            "simulation parameters.cell.function.attacker.genome size bonus",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionAttackerSameMutantPenalty,
-            defaultParameters.cellFunctionAttackerSameMutantPenalty,
-            "simulation parameters.cell.function.attacker.same mutant penalty",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionAttackerSensorDetectionFactor,
-            defaultParameters.cellFunctionAttackerSensorDetectionFactor,
-            "simulation parameters.cell.function.attacker.sensor detection factor",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionAttackerDestroyCells,
-            defaultParameters.cellFunctionAttackerDestroyCells,
-            "simulation parameters.cell.function.attacker.destroy cells",
-            parserTask);
-
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionDefenderAgainstAttackerStrength,
-            defaultParameters.cellFunctionDefenderAgainstAttackerStrength,
-            "simulation parameters.cell.function.defender.against attacker strength",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionDefenderAgainstInjectorStrength,
-            defaultParameters.cellFunctionDefenderAgainstInjectorStrength,
-            "simulation parameters.cell.function.defender.against injector strength",
-            parserTask);
-
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionTransmitterEnergyDistributionSameCreature,
-            defaultParameters.cellFunctionTransmitterEnergyDistributionSameCreature,
-            "simulation parameters.cell.function.transmitter.energy distribution same creature",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionTransmitterEnergyDistributionRadius,
-            defaultParameters.cellFunctionTransmitterEnergyDistributionRadius,
-            "simulation parameters.cell.function.transmitter.energy distribution radius",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionTransmitterEnergyDistributionValue,
-            defaultParameters.cellFunctionTransmitterEnergyDistributionValue,
-            "simulation parameters.cell.function.transmitter.energy distribution value",
-            parserTask);
-
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionMuscleContractionExpansionDelta,
-            defaultParameters.cellFunctionMuscleContractionExpansionDelta,
-            "simulation parameters.cell.function.muscle.contraction expansion delta",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionMuscleMovementAcceleration,
-            defaultParameters.cellFunctionMuscleMovementAcceleration,
-            "simulation parameters.cell.function.muscle.movement acceleration",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionMuscleBendingAngle,
-            defaultParameters.cellFunctionMuscleBendingAngle,
-            "simulation parameters.cell.function.muscle.bending angle",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionMuscleBendingAcceleration,
-            defaultParameters.cellFunctionMuscleBendingAcceleration,
-            "simulation parameters.cell.function.muscle.bending acceleration",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionMuscleBendingAccelerationThreshold,
-            defaultParameters.cellFunctionMuscleBendingAccelerationThreshold,
-            "simulation parameters.cell.function.muscle.bending acceleration threshold",
-            parserTask);
-
-        encodeDecodeProperty(
-            tree,
-            parameters.particleTransformationAllowed,
-            defaultParameters.particleTransformationAllowed,
-            "simulation parameters.particle.transformation allowed",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.particleTransformationRandomCellFunction,
-            defaultParameters.particleTransformationRandomCellFunction,
-            "simulation parameters.particle.transformation.random cell function",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.particleTransformationMaxGenomeSize,
-            defaultParameters.particleTransformationMaxGenomeSize,
-            "simulation parameters.particle.transformation.max genome size",
-            parserTask);
-        encodeDecodeProperty(
-            tree, parameters.particleSplitEnergy, defaultParameters.particleSplitEnergy, "simulation parameters.particle.split energy", parserTask);
-
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionSensorRange,
-            defaultParameters.cellFunctionSensorRange,
-            "simulation parameters.cell.function.sensor.range",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionSensorActivityThreshold,
-            defaultParameters.cellFunctionSensorActivityThreshold,
-            "simulation parameters.cell.function.sensor.activity threshold",
-            parserTask);
-
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionReconnectorRadius,
-            defaultParameters.cellFunctionReconnectorRadius,
-            "simulation parameters.cell.function.reconnector.radius",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionReconnectorActivityThreshold,
-            defaultParameters.cellFunctionReconnectorActivityThreshold,
-            "simulation parameters.cell.function.reconnector.activity threshold",
-            parserTask);
-
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionDetonatorRadius,
-            defaultParameters.cellFunctionDetonatorRadius,
-            "simulation parameters.cell.function.detonator.radius",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionDetonatorChainExplosionProbability,
-            defaultParameters.cellFunctionDetonatorChainExplosionProbability,
-            "simulation parameters.cell.function.detonator.chain explosion probability",
-            parserTask);
-        encodeDecodeProperty(
-            tree,
-            parameters.cellFunctionDetonatorActivityThreshold,
-            defaultParameters.cellFunctionDetonatorActivityThreshold,
-            "simulation parameters.cell.function.detonator.activity threshold",
-            parserTask);
-
-        //particle sources
-        encodeDecodeProperty(
-            tree, parameters.numParticleSources, defaultParameters.numParticleSources, "simulation parameters.particle sources.num sources", parserTask);
-        for (int index = 0; index < parameters.numParticleSources; ++index) {
-            std::string base = "simulation parameters.particle sources." + std::to_string(index) + ".";
-            auto& source = parameters.particleSources[index];
-            auto& defaultSource = defaultParameters.particleSources[index];
-            encodeDecodeProperty(tree, source.posX, defaultSource.posX, base + "pos.x", parserTask);
-            encodeDecodeProperty(tree, source.posY, defaultSource.posY, base + "pos.y", parserTask);
-            encodeDecodeProperty(tree, source.velX, defaultSource.velX, base + "vel.x", parserTask);
-            encodeDecodeProperty(tree, source.velY, defaultSource.velY, base + "vel.y", parserTask);
-            encodeDecodeProperty(tree, source.useAngle, defaultSource.useAngle, base + "use angle", parserTask);
-            encodeDecodeProperty(tree, source.angle, defaultSource.angle, base + "angle", parserTask);
-            encodeDecodeProperty(tree, source.shapeType, defaultSource.shapeType, base + "shape.type", parserTask);
-            if (source.shapeType == SpotShapeType_Circular) {
-                encodeDecodeProperty(
-                    tree,
-                    source.shapeData.circularRadiationSource.radius,
-                    defaultSource.shapeData.circularRadiationSource.radius,
-                    base + "shape.circular.radius",
-                    parserTask);
+        text = text.substr(start, text.find_last_not_of(" \t\n\r\f\v") - start + 1);
+
+        switch (valueType) {
+        case ParameterFieldType_Bool: {
+            int intValue;
+            if (text == "true" || text == "false") {
+                *static_cast<bool*>(value) = text == "true";
+            } else if (parseNumber(text, intValue) && (intValue == 0 || intValue == 1)) {
+                *static_cast<bool*>(value) = intValue == 1;
             }
-            if (source.shapeType == SpotShapeType_Rectangular) {
-                encodeDecodeProperty(
-                    tree,
-                    source.shapeData.rectangularRadiationSource.width,
-                    defaultSource.shapeData.rectangularRadiationSource.width,
-                    base + "shape.rectangular.width",
-                    parserTask);
-                encodeDecodeProperty(
-                    tree,
-                    source.shapeData.rectangularRadiationSource.height,
-                    defaultSource.shapeData.rectangularRadiationSource.height,
-                    base + "shape.rectangular.height",
-                    parserTask);
+        } break;
+        case ParameterFieldType_Int: {
+            int intValue;
+            if (parseNumber(text, intValue)) {
+                *static_cast<int*>(value) = intValue;
             }
-        }
-
-        //spots
-        encodeDecodeProperty(tree, parameters.numSpots, defaultParameters.numSpots, "simulation parameters.spots.num spots", parserTask);
-        for (int index = 0; index < parameters.numSpots; ++index) {
-            std::string base = "simulation parameters.spots." + std::to_string(index) + ".";
-            auto& spot = parameters.spots[index];
-            auto& defaultSpot = defaultParameters.spots[index];
-            encodeDecodeProperty(tree, spot.color, defaultSpot.color, base + "color", parserTask);
-            encodeDecodeProperty(tree, spot.posX, defaultSpot.posX, base + "pos.x", parserTask);
-            encodeDecodeProperty(tree, spot.posY, defaultSpot.posY, base + "pos.y", parserTask);
-            encodeDecodeProperty(tree, spot.velX, defaultSpot.velX, base + "vel.x", parserTask);
-            encodeDecodeProperty(tree, spot.velY, defaultSpot.velY, base + "vel.y", parserTask);
-
-            encodeDecodeProperty(tree, spot.shapeType, defaultSpot.shapeType, base + "shape.type", parserTask);
-            if (spot.shapeType == SpotShapeType_Circular) {
-                encodeDecodeProperty(
-                    tree,
-                    spot.shapeData.circularSpot.coreRadius,
-                    defaultSpot.shapeData.circularSpot.coreRadius,
-                    base + "shape.circular.core radius",
-                    parserTask);
+        } break;
+        case ParameterFieldType_UInt32: {
+            uint32_t intValue;
+            if (parseNumber(text, intValue)) {
+                *static_cast<uint32_t*>(value) = intValue;
             }
-            if (spot.shapeType == SpotShapeType_Rectangular) {
-                encodeDecodeProperty(
-                    tree, spot.shapeData.rectangularSpot.width, defaultSpot.shapeData.rectangularSpot.width, base + "shape.rectangular.core width", parserTask);
-                encodeDecodeProperty(
-                    tree,
-                    spot.shapeData.rectangularSpot.height,
-                    defaultSpot.shapeData.rectangularSpot.height,
-                    base + "shape.rectangular.core height",
-                    parserTask);
+        } break;
+        case ParameterFieldType_UInt64: {
+            uint64_t intValue;
+            if (parseNumber(text, intValue)) {
+                *static_cast<uint64_t*>(value) = intValue;
             }
-            encodeDecodeProperty(tree, spot.flowType, defaultSpot.flowType, base + "flow.type", parserTask);
-            if (spot.flowType == FlowType_Radial) {
-                encodeDecodeProperty(
-                    tree, spot.flowData.radialFlow.orientation, defaultSpot.flowData.radialFlow.orientation, base + "flow.radial.orientation", parserTask);
-                encodeDecodeProperty(
-                    tree, spot.flowData.radialFlow.strength, defaultSpot.flowData.radialFlow.strength, base + "flow.radial.strength", parserTask);
-                encodeDecodeProperty(
-                    tree, spot.flowData.radialFlow.driftAngle, defaultSpot.flowData.radialFlow.driftAngle, base + "flow.radial.drift angle", parserTask);
+        } break;
+        case ParameterFieldType_Float: {
+            float floatValue;
+            if (parseNumber(text, floatValue) && std::isfinite(floatValue)) {
+                *static_cast<float*>(value) = floatValue;
             }
-            if (spot.flowType == FlowType_Central) {
-                encodeDecodeProperty(
-                    tree, spot.flowData.centralFlow.strength, defaultSpot.flowData.centralFlow.strength, base + "flow.central.strength", parserTask);
+        } break;
+        default: {
+            //integer prefix as with std::stoi used in earlier versions
+            int64_t intValue;
+            if (parseNumber(text, intValue, true)) {
+                *static_cast<std::chrono::milliseconds*>(value) = std::chrono::milliseconds(intValue);
             }
-            if (spot.flowType == FlowType_Linear) {
-                encodeDecodeProperty(tree, spot.flowData.linearFlow.angle, defaultSpot.flowData.linearFlow.angle, base + "flow.linear.angle", parserTask);
-                encodeDecodeProperty(
-                    tree, spot.flowData.linearFlow.strength, defaultSpot.flowData.linearFlow.strength, base + "flow.linear.strength", parserTask);
+        }
+        }
+    }
+
+    //getValueText(leafIndex) returns the text of the property in the file or std::nullopt if it is missing
+    template <typename GetValueText>
+    void decode(GetValueText const& getValueText, AuxiliaryData* data, SimulationParameters& parameters)
+    {
+        auto const& schema = getSchema();
+        auto const& leaves = schema.leaves;
+
+        //the leaves are decoded in table order such that conditions only depend on decoded values
+        for (int i = data ? 0 : schema.numAuxiliaryDataLeaves; i < toInt(leaves.size()); ++i) {
+            auto const& leaf = leaves[i];
+            if (auto value = getValue(leaf, data, parameters)) {
+                if (auto text = getValueText(i)) {
+                    parseValue(*text, value, leaf.valueType);
+                }
             }
-            encodeDecodeProperty(tree, spot.fadeoutRadius, defaultSpot.fadeoutRadius, base + "fadeout radius", parserTask);
+        }
 
-            encodeDecodeSpotProperty(tree, spot.values.friction, spot.activatedValues.friction, defaultSpot.values.friction, base + "friction", parserTask);
-            encodeDecodeSpotProperty(tree, spot.values.rigidity, spot.activatedValues.rigidity, defaultSpot.values.rigidity, base + "rigidity", parserTask);
-            encodeDecodeSpotProperty(
-                tree,
-                spot.values.radiationAbsorption,
-                spot.activatedValues.radiationAbsorption,
-                defaultSpot.values.radiationAbsorption,
-                base + "radiation.absorption",
-                parserTask);
-            encodeDecodeSpotProperty(
-                tree,
-                spot.values.radiationAbsorptionLowVelocityPenalty,
-                spot.activatedValues.radiationAbsorptionLowVelocityPenalty,
-                defaultSpot.values.radiationAbsorptionLowVelocityPenalty,
-                base + "radiation.absorption low velocity penalty",
-                parserTask);
-            encodeDecodeSpotProperty(
-                tree,
-                spot.values.radiationAbsorptionLowGenomeComplexityPenalty,
-                spot.activatedValues.radiationAbsorptionLowGenomeComplexityPenalty,
-                defaultSpot.values.radiationAbsorptionLowGenomeComplexityPenalty,
-                base +"radiation.absorption low genome complexity penalty",
-                parserTask);
-            encodeDecodeSpotProperty(
-                tree,
-                spot.values.radiationCellAgeStrength,
-                spot.activatedValues.radiationCellAgeStrength,
-                defaultSpot.values.radiationCellAgeStrength,
-                base + "radiation.factor",
-                parserTask);
-            encodeDecodeSpotProperty(
-                tree, spot.values.cellMaxForce, spot.activatedValues.cellMaxForce, defaultSpot.values.cellMaxForce, base + "cell.max force", parserTask);
-            encodeDecodeSpotProperty(
-                tree, spot.values.cellMinEnergy, spot.activatedValues.cellMinEnergy, defaultSpot.values.cellMinEnergy, base + "cell.min energy", parserTask);
+        //color vectors are regarded as missing if one of their elements is missing
+        auto isMissing = [&](char const* key) {
+            auto const& leafIndices = schema.leafIndicesBySimulationParametersKey.at(key);
+            return std::any_of(leafIndices.begin(), leafIndices.end(), [&](int leafIndex) { return !getValueText(leafIndex); });
+        };
+        MissingParameters missingParameters;
+        missingParameters.externalEnergyBackflowFactor = isMissing("simulation parameters.cell.function.constructor.external energy backflow");
+
+        Features missingFeatures;
+        missingFeatures.genomeComplexityMeasurement = isMissing("simulation parameters.features.genome complexity measurement");
+        missingFeatures.advancedAbsorptionControl = isMissing("simulation parameters.features.additional absorption control");
+        missingFeatures.advancedAttackerControl = isMissing("simulation parameters.features.additional attacker control");
+        missingFeatures.externalEnergyControl = isMissing("simulation parameters.features.external energy");
+        missingFeatures.cellColorTransitionRules = isMissing("simulation parameters.features.cell color transition rules");
+
+        SimulationParametersService::activateFeaturesForLegacyFiles(missingFeatures, parameters);
+        SimulationParametersService::activateParametersForLegacyFiles(missingParameters, parameters);
+    }
 
-            encodeDecodeSpotProperty(
-                tree,
-                spot.values.cellFusionVelocity,
-                spot.activatedValues.cellFusionVelocity,
-                defaultSpot.values.cellFusionVelocity,
-                base + "cell.fusion velocity",
-                parserTask);
-            encodeDecodeSpotProperty(
-                tree,
-                spot.values.cellMaxBindingEnergy,
-                spot.activatedValues.cellMaxBindingEnergy,
-                defaultSpot.values.cellMaxBindingEnergy,
-                base + "cell.max binding energy",
-                parserTask);
+    AuxiliaryData createDefaultAuxiliaryData()
+    {
+        AuxiliaryData result{};
+        result.zoom = 4.0f;
+        return result;
+    }
 
-            encodeDecodeProperty(tree, spot.activatedValues.cellColorTransition, false, base + "cell.color transition rules.activated", parserTask);
-            encodeDecodeProperty(
-                tree,
-                spot.values.cellColorTransitionDuration,
-                defaultSpot.values.cellColorTransitionDuration,
-                base + "cell.color transition rules.duration",
-                parserTask);
-            encodeDecodeProperty(
-                tree,
-                spot.values.cellColorTransitionTargetColor,
-                defaultSpot.values.cellColorTransitionTargetColor,
-                base + "cell.color transition rules.target color",
-                parserTask);
+    void encodeToTree(boost::property_tree::ptree& tree, AuxiliaryData const* data, SimulationParameters const& parameters)
+    {
+        auto const& schema = getSchema();
+        char buffer[64];
+        for (int i = data ? 0 : schema.numAuxiliaryDataLeaves; i < toInt(schema.leaves.size()); ++i) {
+            auto const& leaf = schema.leaves[i];
+            if (auto value = getValue(leaf, data, parameters)) {
+                tree.put(leaf.path, std::string(formatValue(value, leaf.valueType, buffer)));
+            }
+        }
+    }
 
-            encodeDecodeSpotProperty(
-                tree,
-                spot.values.cellFunctionAttackerEnergyCost,
-                spot.activatedValues.cellFunctionAttackerEnergyCost,
-                defaultSpot.values.cellFunctionAttackerEnergyCost,
-                base + "cell.function.attacker.energy cost",
-                parserTask);
+    void decodeFromTree(boost::property_tree::ptree const& tree, AuxiliaryData* data, SimulationParameters& parameters)
+    {
+        auto const& leaves = getSchema().leaves;
+        decode(
+            [&](int leafIndex) -> std::optional<std::string_view> {
+                if (auto child = tree.get_child_optional(leaves[leafIndex].path)) {
+                    return std::string_view(child->data());
+                }
+                return std::nullopt;
+            },
+            data,
+            parameters);
+    }
 
-            encodeDecodeSpotProperty(
-                tree,
-                spot.values.cellFunctionAttackerFoodChainColorMatrix,
-                spot.activatedValues.cellFunctionAttackerFoodChainColorMatrix,
-                defaultSpot.values.cellFunctionAttackerFoodChainColorMatrix,
-                base + "cell.function.attacker.food chain color matrix",
-                parserTask);
-            encodeDecodeSpotProperty(
-                tree,
-                spot.values.cellFunctionAttackerGenomeComplexityBonus,
-                spot.activatedValues.cellFunctionAttackerGenomeComplexityBonus,
-                defaultSpot.values.cellFunctionAttackerGenomeComplexityBonus,
-                base + "cell.function.attacker.genome size bonus",
-                parserTask);
-            encodeDecodeSpotProperty(
-                tree,
-                spot.values.cellFunctionAttackerGeometryDeviationExponent,
-                spot.activatedValues.cellFunctionAttackerGeometryDeviationExponent,
-                defaultSpot.values.cellFunctionAttackerGeometryDeviationExponent,
-                base + "cell.function.attacker.geometry deviation exponent",
-                parserTask);
-            encodeDecodeSpotProperty(
-                tree,
-                spot.values.cellFunctionAttackerConnectionsMismatchPenalty,
-                spot.activatedValues.cellFunctionAttackerConnectionsMismatchPenalty,
-                defaultSpot.values.cellFunctionAttackerConnectionsMismatchPenalty,
-                base + "cell.function.attacker.connections mismatch penalty",
-                parserTask);
+    /**
+     * The nodes are written in the order of their first active leaf, which is the order in which
+     * boost::property_tree::ptree::put would have created them.
+     */
+    class JsonEncoder
+    {
+    public:
+        std::string encode(AuxiliaryData const* data, SimulationParameters const& parameters)
+        {
+            auto const& schema = getSchema();
+            auto numNodes = schema.nodes.size();
+            _firstChild.assign(numNodes, -1);
+            _lastChild.assign(numNodes, -1);
+            _nextSibling.assign(numNodes, -1);
+            _values.assign(numNodes, nullptr);
+
+            for (int i = data ? 0 : schema.numAuxiliaryDataLeaves; i < toInt(schema.leaves.size()); ++i) {
+                auto const& leaf = schema.leaves[i];
+                if (auto value = getValue(leaf, data, parameters)) {
+                    _values[leaf.node] = value;
+                    insertNode(leaf.node);
+                }
+            }
 
-            encodeDecodeSpotProperty(
-                tree,
-                spot.values.cellFunctionConstructorMutationNeuronDataProbability,
-                spot.activatedValues.cellFunctionConstructorMutationNeuronDataProbability,
-                defaultSpot.values.cellFunctionConstructorMutationNeuronDataProbability,
-                base + "cell.function.constructor.mutation probability.neuron data",
-                parserTask);
-            encodeDecodeSpotProperty(
-                tree,
-                spot.values.cellFunctionConstructorMutationPropertiesProbability,
-                spot.activatedValues.cellFunctionConstructorMutationPropertiesProbability,
-                defaultSpot.values.cellFunctionConstructorMutationPropertiesProbability,
-                base + "cell.function.constructor.mutation probability.data ",
-                parserTask);
-            encodeDecodeSpotProperty(
-                tree,
-                spot.values.cellFunctionConstructorMutationGeometryProbability,
-                spot.activatedValues.cellFunctionConstructorMutationGeometryProbability,
-                defaultSpot.values.cellFunctionConstructorMutationGeometryProbability,
-                base + "cell.function.constructor.mutation probability.geometry",
-                parserTask);
-            encodeDecodeSpotProperty(
-                tree,
-                spot.values.cellFunctionConstructorMutationCustomGeometryProbability,
-                spot.activatedValues.cellFunctionConstructorMutationCustomGeometryProbability,
-                defaultSpot.values.cellFunctionConstructorMutationCustomGeometryProbability,
-                base + "cell.function.constructor.mutation probability.custom geometry",
-                parserTask);
-            encodeDecodeSpotProperty(
-                tree,
-                spot.values.cellFunctionConstructorMutationCellFunctionProbability,
-                spot.activatedValues.cellFunctionConstructorMutationCellFunctionProbability,
-                defaultSpot.values.cellFunctionConstructorMutationCellFunctionProbability,
-                base + "cell.function.constructor.mutation probability.cell function",
-                parserTask);
-            encodeDecodeSpotProperty(
-                tree,
-                spot.values.cellFunctionConstructorMutationInsertionProbability,
-                spot.activatedValues.cellFunctionConstructorMutationInsertionProbability,
-                defaultSpot.values.cellFunctionConstructorMutationInsertionProbability,
-                base + "cell.function.constructor.mutation probability.insertion",
-                parserTask);
-            encodeDecodeSpotProperty(
-                tree,
-                spot.values.cellFunctionConstructorMutationDeletionProbability,
-                spot.activatedValues.cellFunctionConstructorMutationDeletionProbability,
-                defaultSpot.values.cellFunctionConstructorMutationDeletionProbability,
-                base + "cell.function.constructor.mutation probability.deletion",
-                parserTask);
-            encodeDecodeSpotProperty(
-                tree,
-                spot.values.cellFunctionConstructorMutationTranslationProbability,
-                spot.activatedValues.cellFunctionConstructorMutationTranslationProbability,
-                defaultSpot.values.cellFunctionConstructorMutationTranslationProbability,
-                base + "cell.function.constructor.mutation probability.translation",
-                parserTask);
-            encodeDecodeSpotProperty(
-                tree,
-                spot.values.cellFunctionConstructorMutationDuplicationProbability,
-                spot.activatedValues.cellFunctionConstructorMutationDuplicationProbability,
-                defaultSpot.values.cellFunctionConstructorMutationDuplicationProbability,
-                base + "cell.function.constructor.mutation probability.duplication",
-                parserTask);
-            encodeDecodeSpotProperty(
-                tree,
-                spot.values.cellFunctionConstructorMutationSubgenomeColorProbability,
-                spot.activatedValues.cellFunctionConstructorMutationSubgenomeColorProbability,
-                defaultSpot.values.cellFunctionConstructorMutationSubgenomeColorProbability,
-                base + "cell.function.constructor.mutation probability.color",
-                parserTask);
-            encodeDecodeSpotProperty(
-                tree,
-                spot.values.cellFunctionConstructorMutationGenomeColorProbability,
-                spot.activatedValues.cellFunctionConstructorMutationGenomeColorProbability,
-                defaultSpot.values.cellFunctionConstructorMutationGenomeColorProbability,
-                base + "cell.function.constructor.mutation probability.uniform color",
-                parserTask);
+            std::string result;
+            JsonWriter writer(result);
+            writer.beginObject();
+            writeChildren(writer, 0);
+            writer.endObject();
+            return result;
         }
 
-        //features
-        Features missingFeatures;
-        missingFeatures.genomeComplexityMeasurement = encodeDecodeProperty(
-            tree,
-            parameters.features.genomeComplexityMeasurement,
-            defaultParameters.features.genomeComplexityMeasurement,
-            "simulation parameters.features.genome complexity measurement",
-            parserTask);
-        missingFeatures.advancedAbsorptionControl = encodeDecodeProperty(
-            tree,
-            parameters.features.advancedAbsorptionControl,
-            defaultParameters.features.advancedAbsorptionControl,
-            "simulation parameters.features.additional absorption control",
-            parserTask);
-        missingFeatures.advancedAttackerControl = encodeDecodeProperty(
-            tree,
-            parameters.features.advancedAttackerControl,
-            defaultParameters.features.advancedAttackerControl,
-            "simulation parameters.features.additional attacker control",
-            parserTask);
-        missingFeatures.externalEnergyControl = encodeDecodeProperty(
-            tree, parameters.features.externalEnergyControl, defaultParameters.features.externalEnergyControl, "simulation parameters.features.external energy", parserTask);
-        missingFeatures.cellColorTransitionRules = encodeDecodeProperty(
-            tree,
-            parameters.features.cellColorTransitionRules,
-            defaultParameters.features.cellColorTransitionRules,
-            "simulation parameters.features.cell color transition rules",
-            parserTask);
-        if (parserTask == ParserTask::Decode) {
-            SimulationParametersService::activateFeaturesForLegacyFiles(missingFeatures, parameters);
-            SimulationParametersService::activateParametersForLegacyFiles(missingParameters, parameters);
+    private:
+        void insertNode(int node)
+        {
+            auto const& nodes = getSchema().nodes;
+            while (node != 0) {
+                auto parent = nodes[node].parent;
+                auto isParentInserted = _firstChild[parent] != -1 || parent == 0;
+                if (_lastChild[parent] == -1) {
+                    _firstChild[parent] = node;
+                } else {
+                    _nextSibling[_lastChild[parent]] = node;
+                }
+                _lastChild[parent] = node;
+                if (isParentInserted) {
+                    return;
+                }
+                node = parent;
+            }
         }
-    }
 
-    void encodeDecode(boost::property_tree::ptree& tree, AuxiliaryData& data, ParserTask parserTask)
-    {
-        AuxiliaryData defaultSettings;
+        void writeChildren(JsonWriter& writer, int node)
+        {
+            auto const& schema = getSchema();
+            char buffer[64];
+            for (auto child = _firstChild[node]; child != -1; child = _nextSibling[child]) {
+                auto const& schemaNode = schema.nodes[child];
+                if (schemaNode.leaf != -1) {
+                    writer.writeValue(schemaNode.key, formatValue(_values[child], schema.leaves[schemaNode.leaf].valueType, buffer));
+                } else {
+                    writer.beginObject(schemaNode.key);
+                    writeChildren(writer, child);
+                    writer.endObject();
+                }
+            }
+        }
 
-        //general settings
-        encodeDecodeProperty(tree, data.timestep, uint64_t(0), "general.time step", parserTask);
-        encodeDecodeProperty(tree, data.realTime, std::chrono::milliseconds(0), "general.real time", parserTask);
-        encodeDecodeProperty(tree, data.zoom, 4.0f, "general.zoom", parserTask);
-        encodeDecodeProperty(tree, data.center.x, 0.0f, "general.center.x", parserTask);
-        encodeDecodeProperty(tree, data.center.y, 0.0f, "general.center.y", parserTask);
-        encodeDecodeProperty(tree, data.generalSettings.worldSizeX, defaultSettings.generalSettings.worldSizeX, "general.world size.x", parserTask);
-        encodeDecodeProperty(tree, data.generalSettings.worldSizeY, defaultSettings.generalSettings.worldSizeY, "general.world size.y", parserTask);
+        std::vector<int> _firstChild;
+        std::vector<int> _lastChild;
+        std::vector<int> _nextSibling;
+        std::vector<void const*> _values;
+    };
 
-        encodeDecode(tree, data.simulationParameters, parserTask);
+    void decodeFromJson(std::string_view json, AuxiliaryData* data, SimulationParameters& parameters)
+    {
+        auto const& schema = getSchema();
+        std::vector<int> valueIndexByLeaf(schema.leaves.size(), -1);
+        std::vector<std::string> values;
+        values.reserve(schema.leaves.size());
+        JsonReader::parse(json, [&](std::string_view path, std::string_view value) {
+            auto findResult = schema.leafIndexByPath.find(path);
+            if (findResult != schema.leafIndexByPath.end() && valueIndexByLeaf[findResult->second] == -1) {
+                valueIndexByLeaf[findResult->second] = toInt(values.size());
+                values.emplace_back(value);
+            }
+        });
+        decode(
+            [&](int leafIndex) -> std::optional<std::string_view> {
+                auto valueIndex = valueIndexByLeaf[leafIndex];
+                if (valueIndex == -1) {
+                    return std::nullopt;
+                }
+                return std::string_view(values[valueIndex]);
+            },
+            data,
+            parameters);
     }
 }
 
 boost::property_tree::ptree AuxiliaryDataParserService::encodeAuxiliaryData(AuxiliaryData const& data)
 {
     boost::property_tree::ptree tree;
-    encodeDecode(tree, const_cast<AuxiliaryData&>(data), ParserTask::Encode);
+    encodeToTree(tree, &data, data.simulationParameters);
     return tree;
 }
 
 AuxiliaryData AuxiliaryDataParserService::decodeAuxiliaryData(boost::property_tree::ptree tree)
 {
-    AuxiliaryData result;
-    encodeDecode(tree, result, ParserTask::Decode);
+    auto result = createDefaultAuxiliaryData();
+    decodeFromTree(tree, &result, result.simulationParameters);
     return result;
 }
 
 boost::property_tree::ptree AuxiliaryDataParserService::encodeSimulationParameters(SimulationParameters const& data)
 {
     boost::property_tree::ptree tree;
-    encodeDecode(tree, const_cast<SimulationParameters&>(data), ParserTask::Encode);
+    encodeToTree(tree, nullptr, data);
     return tree;
 }
 
 SimulationParameters AuxiliaryDataParserService::decodeSimulationParameters(boost::property_tree::ptree tree)
 {
     SimulationParameters result;
-    encodeDecode(tree, result, ParserTask::Decode);
+    decodeFromTree(tree, nullptr, result);
+    return result;
+}
+
+std::string AuxiliaryDataParserService::encodeAuxiliaryDataToJson(AuxiliaryData const& data)
+{
+    return JsonEncoder().encode(&data, data.simulationParameters);
+}
+
+AuxiliaryData AuxiliaryDataParserService::decodeAuxiliaryDataFromJson(std::string_view json)
+{
+    auto result = createDefaultAuxiliaryData();
+    decodeFromJson(json, &result, result.simulationParameters);
     return result;
 }
+
+std::string AuxiliaryDataParserService::encodeSimulationParametersToJson(SimulationParameters const& parameters)
+{
+    return JsonEncoder().encode(nullptr, parameters);
+}
+
+SimulationParameters AuxiliaryDataParserService::decodeSimulationParametersFromJson(std::string_view json)
+{
+    SimulationParameters result;
+    decodeFromJson(json, nullptr, result);
+    return result;
+}
+
+SimulationParameters AuxiliaryDataParserService::overrideSimulationParameters(
+    SimulationParameters const& parameters,
+    std::map<std::string, std::string> const& overrides)
+{
+    auto tree = encodeSimulationParameters(parameters);
+    for (auto const& [key, value] : overrides) {
+        if (!tree.get_optional<std::string>(key)) {
+            throw std::runtime_error("Unknown simulation parameter '" + key + "'.");
+        }
+        tree.put(key, value);
+    }
+    return decodeSimulationParameters(tree);
+}
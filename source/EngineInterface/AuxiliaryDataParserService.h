@@ -1,5 +1,9 @@
 #pragma once
 
+#include <map>
+#include <string>
+#include <string_view>
+
 #include <boost/property_tree/ptree.hpp>
 
 #include "Base/JsonParser.h"
@@ -16,4 +20,16 @@ public:
 
     static boost::property_tree::ptree encodeSimulationParameters(SimulationParameters const& data);
     static SimulationParameters decodeSimulationParameters(boost::property_tree::ptree tree);
+
+    //produce and accept the same JSON as boost::property_tree::write_json/read_json with the property trees above
+    static std::string encodeAuxiliaryDataToJson(AuxiliaryData const& data);
+    static AuxiliaryData decodeAuxiliaryDataFromJson(std::string_view json);
+
+    static std::string encodeSimulationParametersToJson(SimulationParameters const& parameters);
+    static SimulationParameters decodeSimulationParametersFromJson(std::string_view json);
+
+    //overrides are given as pairs of property name (as in the settings file) and value
+    static SimulationParameters overrideSimulationParameters(
+        SimulationParameters const& parameters,
+        std::map<std::string, std::string> const& overrides);
 };
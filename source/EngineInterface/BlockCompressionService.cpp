@@ -0,0 +1,227 @@
+#include "BlockCompressionService.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include <zlib.h>
+
+#include "Base/Definitions.h"
+#include "Base/ParallelExecution.h"
+
+namespace
+{
+    char const Magic[] = {'A', 'L', 'I', 'E', 'N', 'B', 'L', 'K'};
+    uint32_t constexpr Version = 1;
+
+    struct BlockIndexEntry
+    {
+        uint64_t compressedSize = 0;
+        uint64_t uncompressedSize = 0;
+    };
+
+    void throwCorruptedData()
+    {
+        throw std::runtime_error("Corrupted compressed data.");
+    }
+
+    template <typename T>
+    void writeValue(std::string& target, T const& value)
+    {
+        target.append(reinterpret_cast<char const*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    T readValue(std::string_view data, uint64_t& pos)
+    {
+        if (pos + sizeof(T) > data.size()) {
+            throwCorruptedData();
+        }
+        T result;
+        std::memcpy(&result, data.data() + pos, sizeof(T));
+        pos += sizeof(T);
+        return result;
+    }
+
+    //offsets of the blocks in the compressed and uncompressed data, each with the end offset as last entry
+    struct BlockOffsets
+    {
+        std::vector<uint64_t> compressed;
+        std::vector<uint64_t> uncompressed;
+    };
+
+    BlockOffsets readBlockOffsets(std::string_view data)
+    {
+        if (!BlockCompressionService::isBlockCompressed(data)) {
+            throwCorruptedData();
+        }
+        uint64_t pos = sizeof(Magic);
+        if (readValue<uint32_t>(data, pos) > Version) {
+            throw std::runtime_error("Version not supported.");
+        }
+        auto numBlocks = readValue<uint64_t>(data, pos);
+        auto uncompressedSize = readValue<uint64_t>(data, pos);
+
+        //the header is validated before any allocation depending on it
+        if (numBlocks > (data.size() - pos) / sizeof(BlockIndexEntry) || uncompressedSize > numBlocks * BlockCompressionService::MaxBlockSize) {
+            throwCorruptedData();
+        }
+
+        std::vector<BlockIndexEntry> index(numBlocks);
+        for (auto& entry : index) {
+            entry.compressedSize = readValue<uint64_t>(data, pos);
+            entry.uncompressedSize = readValue<uint64_t>(data, pos);
+        }
+        BlockOffsets result;
+        result.compressed.resize(numBlocks + 1);
+        result.uncompressed.resize(numBlocks + 1);
+        result.compressed.front() = pos;
+        for (size_t i = 0; i < numBlocks; ++i) {
+            auto const& entry = index.at(i);
+            if (entry.uncompressedSize > BlockCompressionService::MaxBlockSize || entry.compressedSize > data.size() - result.compressed.at(i)) {
+                throwCorruptedData();
+            }
+            result.compressed.at(i + 1) = result.compressed.at(i) + entry.compressedSize;
+            result.uncompressed.at(i + 1) = result.uncompressed.at(i) + entry.uncompressedSize;
+        }
+        if (result.uncompressed.back() != uncompressedSize) {
+            throwCorruptedData();
+        }
+        return result;
+    }
+
+    void decompressBlock(
+        std::string_view data,
+        std::vector<uint64_t> const& compressedOffsets,
+        std::vector<uint64_t> const& uncompressedOffsets,
+        size_t blockIndex,
+        char* target)
+    {
+        auto uncompressedSize = uncompressedOffsets.at(blockIndex + 1) - uncompressedOffsets.at(blockIndex);
+        auto size = static_cast<uLongf>(uncompressedSize);
+        auto success = uncompress(
+            reinterpret_cast<Bytef*>(target + uncompressedOffsets.at(blockIndex)),
+            &size,
+            reinterpret_cast<Bytef const*>(data.data() + compressedOffsets.at(blockIndex)),
+            static_cast<uLong>(compressedOffsets.at(blockIndex + 1) - compressedOffsets.at(blockIndex)));
+        if (success != Z_OK || size != uncompressedSize) {
+            throwCorruptedData();
+        }
+    }
+}
+
+bool BlockCompressionService::isBlockCompressed(std::string_view data)
+{
+    return data.size() >= sizeof(Magic) && std::memcmp(data.data(), Magic, sizeof(Magic)) == 0;
+}
+
+std::string BlockCompressionService::compress(std::string_view data, uint64_t blockSize)
+{
+    CHECK(blockSize > 0 && blockSize <= MaxBlockSize);
+    auto numBlocks = (data.size() + blockSize - 1) / blockSize;
+    std::vector<std::string> compressedBlocks(numBlocks);
+    ParallelExecution::forEach(numBlocks, [&](size_t index) {
+        auto block = data.substr(index * blockSize, blockSize);
+        auto& compressedBlock = compressedBlocks.at(index);
+        auto compressedSize = compressBound(static_cast<uLong>(block.size()));
+        compressedBlock.resize(compressedSize);
+        auto result = compress2(
+            reinterpret_cast<Bytef*>(compressedBlock.data()),
+            &compressedSize,
+            reinterpret_cast<Bytef const*>(block.data()),
+            static_cast<uLong>(block.size()),
+            Z_DEFAULT_COMPRESSION);
+        if (result != Z_OK) {
+            throw std::runtime_error("Compression failed.");
+        }
+        compressedBlock.resize(compressedSize);
+    });
+
+    std::string result;
+    auto totalSize = sizeof(Magic) + sizeof(uint32_t) + sizeof(uint64_t) * 2 + numBlocks * sizeof(BlockIndexEntry);
+    for (auto const& compressedBlock : compressedBlocks) {
+        totalSize += compressedBlock.size();
+    }
+    result.reserve(totalSize);
+    result.append(Magic, sizeof(Magic));
+    writeValue(result, Version);
+    writeValue(result, static_cast<uint64_t>(numBlocks));
+    writeValue(result, static_cast<uint64_t>(data.size()));
+    for (size_t i = 0; i < numBlocks; ++i) {
+        writeValue(result, static_cast<uint64_t>(compressedBlocks.at(i).size()));
+        writeValue(result, static_cast<uint64_t>(std::min(blockSize, data.size() - i * blockSize)));
+    }
+    for (auto const& compressedBlock : compressedBlocks) {
+        result.append(compressedBlock);
+    }
+    return result;
+}
+
+std::string BlockCompressionService::decompress(std::string_view data)
+{
+    auto offsets = readBlockOffsets(data);
+    auto numBlocks = offsets.compressed.size() - 1;
+    std::string result(offsets.uncompressed.back(), '\0');
+    ParallelExecution::forEach(numBlocks, [&](size_t i) { decompressBlock(data, offsets.compressed, offsets.uncompressed, i, result.data()); });
+    return result;
+}
+
+_LazyDecompressedData::_LazyDecompressedData(std::string_view compressedData)
+    : _compressedData(compressedData)
+{
+    auto offsets = readBlockOffsets(compressedData);
+    _compressedOffsets = std::move(offsets.compressed);
+    _uncompressedOffsets = std::move(offsets.uncompressed);
+    _data = std::make_unique_for_overwrite<char[]>(_uncompressedOffsets.back());
+    _isBlockDecompressed = std::vector<std::atomic<bool>>(getNumBlocks());
+}
+
+_LazyDecompressedData::~_LazyDecompressedData() = default;
+
+std::string_view _LazyDecompressedData::getData() const
+{
+    return std::string_view(_data.get(), _uncompressedOffsets.back());
+}
+
+void _LazyDecompressedData::requestRange(uint64_t offset, uint64_t size)
+{
+    if (size == 0) {
+        return;
+    }
+    if (offset >= _uncompressedOffsets.back() || size > _uncompressedOffsets.back() - offset) {
+        throw std::out_of_range("Requested range exceeds the uncompressed data.");
+    }
+    auto firstBlock = std::upper_bound(_uncompressedOffsets.begin(), _uncompressedOffsets.end(), offset) - _uncompressedOffsets.begin() - 1;
+    auto lastBlock = std::upper_bound(_uncompressedOffsets.begin(), _uncompressedOffsets.end(), offset + size - 1) - _uncompressedOffsets.begin() - 1;
+
+    //fast path for already decompressed blocks without locking
+    std::vector<size_t> missingBlocks;
+    for (auto i = firstBlock; i <= lastBlock; ++i) {
+        if (!_isBlockDecompressed.at(i).load(std::memory_order_acquire)) {
+            missingBlocks.emplace_back(i);
+        }
+    }
+    if (missingBlocks.empty()) {
+        return;
+    }
+
+    std::lock_guard lock(_mutex);
+    std::erase_if(missingBlocks, [&](auto const& i) { return _isBlockDecompressed.at(i).load(std::memory_order_relaxed); });
+    ParallelExecution::forEach(missingBlocks.size(), [&](size_t i) {
+        decompressBlock(_compressedData, _compressedOffsets, _uncompressedOffsets, missingBlocks.at(i), _data.get());
+    });
+    for (auto const& i : missingBlocks) {
+        _isBlockDecompressed.at(i).store(true, std::memory_order_release);
+    }
+    _numDecompressedBlocks += missingBlocks.size();
+}
+
+uint64_t _LazyDecompressedData::getNumBlocks() const
+{
+    return _compressedOffsets.size() - 1;
+}
+
+uint64_t _LazyDecompressedData::getNumDecompressedBlocks() const
+{
+    return _numDecompressedBlocks;
+}
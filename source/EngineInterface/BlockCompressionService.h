@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Definitions.h"
+
+/**
+ * Container for compressed data which consists of independently zlib-compressed blocks plus an index.
+ * Blocks are compressed and decompressed in parallel.
+ */
+class BlockCompressionService
+{
+public:
+    static uint64_t constexpr MaxBlockSize = 4 * 1024 * 1024;
+
+    static bool isBlockCompressed(std::string_view data);
+
+    static std::string compress(std::string_view data, uint64_t blockSize = MaxBlockSize);
+    static std::string decompress(std::string_view data);
+};
+
+/**
+ * Random access to block-compressed data where blocks are decompressed on their first request.
+ * The memory for the uncompressed data is allocated at once without initialization, hence the operating system
+ * provides physical memory only for the pages of decompressed blocks. The compressed data is referenced and must
+ * outlive the object. Requests are thread-safe.
+ */
+class _LazyDecompressedData
+{
+public:
+    _LazyDecompressedData(std::string_view compressedData);
+    ~_LazyDecompressedData();
+
+    //the content outside of requested ranges is undefined
+    std::string_view getData() const;
+
+    void requestRange(uint64_t offset, uint64_t size);
+
+    uint64_t getNumBlocks() const;
+    uint64_t getNumDecompressedBlocks() const;
+
+private:
+    std::string_view _compressedData;
+    std::vector<uint64_t> _compressedOffsets;  //size: number of blocks + 1
+    std::vector<uint64_t> _uncompressedOffsets;  //size: number of blocks + 1
+    std::unique_ptr<char[]> _data;
+
+    std::mutex _mutex;
+    std::vector<std::atomic<bool>> _isBlockDecompressed;
+    std::atomic<uint64_t> _numDecompressedBlocks = 0;
+};
@@ -0,0 +1,1155 @@
+#include "ColumnarSerializerService.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Base/Resources.h"
+#include "Base/VersionChecker.h"
+
+static_assert(std::endian::native == std::endian::little, "columnar format is stored in little endian byte order");
+
+namespace
+{
+    char const Magic[] = {'A', 'L', 'I', 'E', 'N', 'S', 'O', 'A'};
+
+    //SchemaVersion: version written by this implementation
+    //MinReaderSchemaVersion: oldest reader which is able to read files written by this implementation
+    //schema history:
+    //1: genomes stored per cell in the heap of the cell function tables
+    //2: genomes stored deduplicated in a separate genome table
+    uint32_t constexpr SchemaVersion = 2;
+    uint32_t constexpr MinReaderSchemaVersion = 2;
+
+    uint32_t constexpr Section_End = 0;
+    uint32_t constexpr Section_Clusters = 1;
+    uint32_t constexpr Section_Cells = 2;
+    uint32_t constexpr Section_Connections = 3;
+    uint32_t constexpr Section_Particles = 4;
+    uint32_t constexpr Section_Genomes = 5;
+    uint32_t constexpr Section_CellFunctionBase = 16;  //+ CellFunction
+
+    auto constexpr Id_Cluster_NumCells = 0;
+
+    auto constexpr Id_Cell_Id = 0;
+    auto constexpr Id_Cell_Pos = 1;
+    auto constexpr Id_Cell_Vel = 2;
+    auto constexpr Id_Cell_Energy = 3;
+    auto constexpr Id_Cell_Stiffness = 4;
+    auto constexpr Id_Cell_Color = 5;
+    auto constexpr Id_Cell_MaxConnections = 6;
+    auto constexpr Id_Cell_Barrier = 7;
+    auto constexpr Id_Cell_Age = 8;
+    auto constexpr Id_Cell_LivingState = 9;
+    auto constexpr Id_Cell_CreatureId = 10;
+    auto constexpr Id_Cell_MutationId = 11;
+    auto constexpr Id_Cell_ExecutionOrderNumber = 12;
+    auto constexpr Id_Cell_InputExecutionOrderNumber = 13;
+    auto constexpr Id_Cell_OutputBlocked = 14;
+    auto constexpr Id_Cell_ActivationTime = 15;
+    auto constexpr Id_Cell_GenomeComplexity = 16;
+    auto constexpr Id_Cell_CellFunction = 17;
+    auto constexpr Id_Cell_NumConnections = 18;
+    auto constexpr Id_Cell_Activity = 19;
+    auto constexpr Id_Cell_MetadataName = 20;
+    auto constexpr Id_Cell_MetadataDescription = 21;
+
+    auto constexpr Id_Connection_CellId = 0;
+    auto constexpr Id_Connection_Distance = 1;
+    auto constexpr Id_Connection_AngleFromPrevious = 2;
+
+    auto constexpr Id_Particle_Id = 0;
+    auto constexpr Id_Particle_Pos = 1;
+    auto constexpr Id_Particle_Vel = 2;
+    auto constexpr Id_Particle_Energy = 3;
+    auto constexpr Id_Particle_Color = 4;
+
+    auto constexpr Id_Genome_Bytes = 0;
+
+    auto constexpr Id_Neuron_Weights = 0;
+    auto constexpr Id_Neuron_Biases = 1;
+    auto constexpr Id_Neuron_ActivationFunctions = 2;
+
+    auto constexpr Id_Transmitter_Mode = 0;
+
+    auto constexpr Id_Constructor_ActivationMode = 0;
+    auto constexpr Id_Constructor_ConstructionActivationTime = 1;
+    auto constexpr Id_Constructor_Genome = 2;  //schema version 1
+    auto constexpr Id_Constructor_NumInheritedGenomeNodes = 3;
+    auto constexpr Id_Constructor_GenomeGeneration = 4;
+    auto constexpr Id_Constructor_ConstructionAngle1 = 5;
+    auto constexpr Id_Constructor_ConstructionAngle2 = 6;
+    auto constexpr Id_Constructor_LastConstructedCellId = 7;
+    auto constexpr Id_Constructor_GenomeCurrentNodeIndex = 8;
+    auto constexpr Id_Constructor_GenomeCurrentRepetition = 9;
+    auto constexpr Id_Constructor_CurrentBranch = 10;
+    auto constexpr Id_Constructor_OffspringCreatureId = 11;
+    auto constexpr Id_Constructor_OffspringMutationId = 12;
+    auto constexpr Id_Constructor_GenomeIndex = 13;
+
+    auto constexpr Id_Sensor_FixedAngle = 0;
+    auto constexpr Id_Sensor_MinDensity = 1;
+    auto constexpr Id_Sensor_Color = 2;
+    auto constexpr Id_Sensor_TargetedCreatureId = 3;
+    auto constexpr Id_Sensor_MemoryChannel1 = 4;
+    auto constexpr Id_Sensor_MemoryChannel2 = 5;
+    auto constexpr Id_Sensor_MemoryChannel3 = 6;
+
+    auto constexpr Id_Nerve_PulseMode = 0;
+    auto constexpr Id_Nerve_AlternationMode = 1;
+
+    auto constexpr Id_Attacker_Mode = 0;
+
+    auto constexpr Id_Injector_Mode = 0;
+    auto constexpr Id_Injector_Counter = 1;
+    auto constexpr Id_Injector_Genome = 2;  //schema version 1
+    auto constexpr Id_Injector_GenomeGeneration = 3;
+    auto constexpr Id_Injector_GenomeIndex = 4;
+
+    auto constexpr Id_Muscle_Mode = 0;
+    auto constexpr Id_Muscle_LastBendingDirection = 1;
+    auto constexpr Id_Muscle_LastBendingSourceIndex = 2;
+    auto constexpr Id_Muscle_ConsecutiveBendingAngle = 3;
+
+    auto constexpr Id_Defender_Mode = 0;
+
+    auto constexpr Id_Reconnector_Color = 0;
+
+    auto constexpr Id_Detonator_State = 0;
+    auto constexpr Id_Detonator_Countdown = 1;
+
+    enum class SerializationTask
+    {
+        Load,
+        Save
+    };
+
+    void throwCorruptedData()
+    {
+        throw std::runtime_error("Corrupted simulation data.");
+    }
+
+    //checks whether the range [pos, pos + size) lies within data of size dataSize without overflowing
+    bool isRangeValid(uint64_t pos, uint64_t size, uint64_t dataSize)
+    {
+        return pos <= dataSize && size <= dataSize - pos;
+    }
+
+    template <typename T>
+    void writeValue(std::ostream& stream, T const& value)
+    {
+        stream.write(reinterpret_cast<char const*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    T readValue(std::istream& stream)
+    {
+        T result;
+        stream.read(reinterpret_cast<char*>(&result), sizeof(T));
+        if (!stream) {
+            throwCorruptedData();
+        }
+        return result;
+    }
+
+    template <typename T>
+    T readValue(std::string_view data, uint64_t& pos)
+    {
+        if (!isRangeValid(pos, sizeof(T), data.size())) {
+            throwCorruptedData();
+        }
+        T result;
+        std::memcpy(&result, data.data() + pos, sizeof(T));
+        pos += sizeof(T);
+        return result;
+    }
+
+    //serialized data which is possibly provided on demand, i.e. its ranges have to be requested before they are read
+    struct SerializedData
+    {
+        std::string_view data;
+        std::function<void(uint64_t offset, uint64_t size)> requestRange;
+
+        void request(void const* begin, uint64_t size) const
+        {
+            if (requestRange && size > 0) {
+                requestRange(static_cast<char const*>(begin) - data.data(), size);
+            }
+        }
+    };
+
+    //data is a part of the serialized data
+    template <typename T>
+    T readValue(SerializedData const& serializedData, std::string_view data, uint64_t& pos)
+    {
+        if (isRangeValid(pos, sizeof(T), data.size())) {
+            serializedData.request(data.data() + pos, sizeof(T));
+        }
+        return readValue<T>(data, pos);
+    }
+
+    //reference to a byte range in the heap of a table
+    struct HeapRef
+    {
+        uint64_t offset = 0;
+        uint64_t size = 0;
+    };
+
+    /**
+     * Fixed-width encoding of field types.
+     * The element size of a column is determined on save and stored in the column header. decode(...) returns false
+     * if the stored element size is not compatible with the field type (the field is then set to its default value).
+     */
+    template <typename T>
+    struct ColumnCodec
+    {
+        static_assert(std::is_arithmetic_v<T> || std::is_same_v<T, HeapRef>);
+
+        static uint32_t getElementSize(T const&) { return sizeof(T); }
+        static void encode(uint8_t* target, T const& value) { std::memcpy(target, &value, sizeof(T)); }
+        static bool decode(T& value, uint8_t const* source, uint32_t elementSize)
+        {
+            if (elementSize != sizeof(T)) {
+                return false;
+            }
+            std::memcpy(&value, source, sizeof(T));
+            return true;
+        }
+    };
+
+    template <>
+    struct ColumnCodec<bool>
+    {
+        static uint32_t getElementSize(bool) { return 1; }
+        static void encode(uint8_t* target, bool value) { *target = value ? 1 : 0; }
+        static bool decode(bool& value, uint8_t const* source, uint32_t elementSize)
+        {
+            if (elementSize != 1) {
+                return false;
+            }
+            value = *source != 0;
+            return true;
+        }
+    };
+
+    template <>
+    struct ColumnCodec<RealVector2D>
+    {
+        static uint32_t getElementSize(RealVector2D const&) { return 2 * sizeof(float); }
+        static void encode(uint8_t* target, RealVector2D const& value)
+        {
+            std::memcpy(target, &value.x, sizeof(float));
+            std::memcpy(target + sizeof(float), &value.y, sizeof(float));
+        }
+        static bool decode(RealVector2D& value, uint8_t const* source, uint32_t elementSize)
+        {
+            if (elementSize != 2 * sizeof(float)) {
+                return false;
+            }
+            std::memcpy(&value.x, source, sizeof(float));
+            std::memcpy(&value.y, source + sizeof(float), sizeof(float));
+            return true;
+        }
+    };
+
+    template <typename T>
+    struct ColumnCodec<std::optional<T>>
+    {
+        static uint32_t getElementSize(std::optional<T> const&) { return 1 + ColumnCodec<T>::getElementSize(T()); }
+        static void encode(uint8_t* target, std::optional<T> const& value)
+        {
+            ColumnCodec<bool>::encode(target, value.has_value());
+            ColumnCodec<T>::encode(target + 1, value.value_or(T()));
+        }
+        static bool decode(std::optional<T>& value, uint8_t const* source, uint32_t elementSize)
+        {
+            bool hasValue;
+            T content;
+            if (elementSize < 1 || !ColumnCodec<bool>::decode(hasValue, source, 1) || !ColumnCodec<T>::decode(content, source + 1, elementSize - 1)) {
+                return false;
+            }
+            value = hasValue ? std::make_optional(content) : std::nullopt;
+            return true;
+        }
+    };
+
+    //vectors with a fixed number of elements per row (e.g. MAX_CHANNELS)
+    template <typename T>
+    struct ColumnCodec<std::vector<T>>
+    {
+        static_assert(std::is_arithmetic_v<T>);
+
+        static uint32_t getElementSize(std::vector<T> const& value) { return toInt(value.size() * sizeof(T)); }
+        static void encode(uint8_t* target, std::vector<T> const& value) { std::memcpy(target, value.data(), value.size() * sizeof(T)); }
+        static bool decode(std::vector<T>& value, uint8_t const* source, uint32_t elementSize)
+        {
+            if (elementSize % sizeof(T) != 0) {
+                return false;
+            }
+            value.resize(elementSize / sizeof(T));
+            std::memcpy(value.data(), source, elementSize);
+            return true;
+        }
+    };
+
+    //fixed-size arrays (e.g. neuron weights and biases) are stored in their memory layout
+    template <typename T, size_t N>
+    struct ColumnCodec<std::array<T, N>>
+    {
+        static_assert(std::is_trivially_copyable_v<std::array<T, N>>);
+
+        static uint32_t getElementSize(std::array<T, N> const&) { return sizeof(std::array<T, N>); }
+        static void encode(uint8_t* target, std::array<T, N> const& value) { std::memcpy(target, value.data(), sizeof(std::array<T, N>)); }
+        static bool decode(std::array<T, N>& value, uint8_t const* source, uint32_t elementSize)
+        {
+            if (elementSize != sizeof(std::array<T, N>)) {
+                return false;
+            }
+            std::memcpy(value.data(), source, elementSize);
+            return true;
+        }
+    };
+
+    struct Column
+    {
+        uint32_t id = 0;
+        uint32_t elementSize = 0;
+        std::vector<uint8_t> data;      //used for writing
+        uint8_t const* view = nullptr;  //used for reading, points into the serialized data
+
+        uint8_t const* getData() const { return view ? view : data.data(); }
+    };
+
+    struct ColumnTable
+    {
+        uint64_t numRows = 0;
+        std::vector<Column> columns;
+        std::vector<uint8_t> heap;     //used for writing
+        std::string_view heapView;  //used for reading
+        SerializedData const* serializedData = nullptr;  //used for reading
+
+        //rows to be read (all rows if not set)
+        std::vector<uint64_t> const* selectedRows = nullptr;
+
+        uint64_t getNumSelectedRows() const { return selectedRows ? selectedRows->size() : numRows; }
+        uint64_t getRowIndex(uint64_t index) const
+        {
+            auto result = selectedRows ? selectedRows->at(index) : index;
+            if (result >= numRows) {
+                throwCorruptedData();
+            }
+            return result;
+        }
+
+        void request(void const* begin, uint64_t size) const
+        {
+            if (serializedData) {
+                serializedData->request(begin, size);
+            }
+        }
+
+        //requests the column data of the rows to be read, consecutive rows are requested at once
+        void requestRows(Column const& column) const
+        {
+            if (!serializedData || !serializedData->requestRange) {
+                return;
+            }
+            uint64_t rangeBegin = 0;
+            uint64_t rangeEnd = 0;
+            for (uint64_t i = 0; i < getNumSelectedRows(); ++i) {
+                auto rowIndex = getRowIndex(i);
+                if (rowIndex != rangeEnd) {
+                    request(column.getData() + rangeBegin * column.elementSize, (rangeEnd - rangeBegin) * column.elementSize);
+                    rangeBegin = rowIndex;
+                }
+                rangeEnd = rowIndex + 1;
+            }
+            request(column.getData() + rangeBegin * column.elementSize, (rangeEnd - rangeBegin) * column.elementSize);
+        }
+
+        Column const* findColumn(uint32_t id) const
+        {
+            for (auto const& column : columns) {
+                if (column.id == id) {
+                    return &column;
+                }
+            }
+            return nullptr;
+        }
+
+        void write(std::ostream& stream, uint32_t sectionId) const
+        {
+            uint64_t payloadSize = sizeof(uint64_t) + sizeof(uint32_t) + columns.size() * 2 * sizeof(uint32_t) + sizeof(uint64_t) + heap.size();
+            for (auto const& column : columns) {
+                payloadSize += column.data.size();
+            }
+            writeValue(stream, sectionId);
+            writeValue(stream, payloadSize);
+
+            writeValue(stream, numRows);
+            writeValue(stream, static_cast<uint32_t>(columns.size()));
+            for (auto const& column : columns) {
+                writeValue(stream, column.id);
+                writeValue(stream, column.elementSize);
+            }
+            for (auto const& column : columns) {
+                stream.write(reinterpret_cast<char const*>(column.data.data()), column.data.size());
+            }
+            writeValue(stream, static_cast<uint64_t>(heap.size()));
+            stream.write(reinterpret_cast<char const*>(heap.data()), heap.size());
+        }
+
+        static ColumnTable read(SerializedData const& serializedData, std::string_view payload)
+        {
+            ColumnTable result;
+            result.serializedData = &serializedData;
+            uint64_t pos = 0;
+            result.numRows = readValue<uint64_t>(serializedData, payload, pos);
+            auto numColumns = readValue<uint32_t>(serializedData, payload, pos);
+            if (numColumns > (payload.size() - pos) / (2 * sizeof(uint32_t))) {
+                throwCorruptedData();
+            }
+            result.columns.resize(numColumns);
+            for (auto& column : result.columns) {
+                column.id = readValue<uint32_t>(serializedData, payload, pos);
+                column.elementSize = readValue<uint32_t>(serializedData, payload, pos);
+            }
+            for (auto& column : result.columns) {
+                if (column.elementSize > 0 && result.numRows > (payload.size() - pos) / column.elementSize) {
+                    throwCorruptedData();
+                }
+                auto columnSize = result.numRows * column.elementSize;
+                column.view = reinterpret_cast<uint8_t const*>(payload.data() + pos);
+                pos += columnSize;
+            }
+            auto heapSize = readValue<uint64_t>(serializedData, payload, pos);
+            if (!isRangeValid(pos, heapSize, payload.size())) {
+                throwCorruptedData();
+            }
+            result.heapView = payload.substr(pos, heapSize);
+            return result;
+        }
+    };
+
+    template <typename T>
+    std::vector<T*> getPointers(std::vector<T>& values)
+    {
+        std::vector<T*> result;
+        result.reserve(values.size());
+        for (auto& value : values) {
+            result.emplace_back(&value);
+        }
+        return result;
+    }
+
+    template <typename Row, typename Accessor, typename T = std::remove_cvref_t<std::invoke_result_t<Accessor const&, Row&>>>
+    void loadSaveColumn(
+        SerializationTask task,
+        ColumnTable& table,
+        uint32_t id,
+        std::vector<Row*> const& rows,
+        Accessor const& accessor,
+        std::type_identity_t<T> const& defaultValue)
+    {
+        using Codec = ColumnCodec<T>;
+        if (task == SerializationTask::Save) {
+            table.numRows = rows.size();
+            auto& column = table.columns.emplace_back();
+            column.id = id;
+            column.elementSize = rows.empty() ? Codec::getElementSize(defaultValue) : Codec::getElementSize(std::invoke(accessor, *rows.front()));
+            column.data.resize(rows.size() * column.elementSize);
+            auto target = column.data.data();
+            for (auto const& row : rows) {
+                T const& value = std::invoke(accessor, *row);
+                CHECK(Codec::getElementSize(value) == column.elementSize);
+                Codec::encode(target, value);
+                target += column.elementSize;
+            }
+        } else {
+            if (table.getNumSelectedRows() != rows.size()) {
+                throwCorruptedData();
+            }
+            auto column = table.findColumn(id);
+            if (column) {
+                table.requestRows(*column);
+            }
+            for (size_t i = 0; i < rows.size(); ++i) {
+                T& value = std::invoke(accessor, *rows[i]);
+                if (!column || !Codec::decode(value, column->getData() + table.getRowIndex(i) * column->elementSize, column->elementSize)) {
+                    value = defaultValue;
+                }
+            }
+        }
+    }
+
+    //stores variable sized data (strings, byte vectors) in the heap of the table
+    template <typename Row, typename Accessor>
+    void loadSaveHeapColumn(SerializationTask task, ColumnTable& table, uint32_t id, std::vector<Row*> const& rows, Accessor const& accessor)
+    {
+        std::vector<HeapRef> refs(rows.size());
+        if (task == SerializationTask::Save) {
+            for (size_t i = 0; i < rows.size(); ++i) {
+                auto const& content = std::invoke(accessor, *rows.at(i));
+                refs.at(i) = HeapRef{table.heap.size(), content.size()};
+                table.heap.insert(table.heap.end(), content.begin(), content.end());
+            }
+        }
+        loadSaveColumn(task, table, id, getPointers(refs), [](HeapRef& ref) -> HeapRef& { return ref; }, HeapRef());
+        if (task == SerializationTask::Load) {
+            for (size_t i = 0; i < rows.size(); ++i) {
+                auto const& ref = refs.at(i);
+                if (!isRangeValid(ref.offset, ref.size, table.heapView.size())) {
+                    throwCorruptedData();
+                }
+                auto& content = std::invoke(accessor, *rows.at(i));
+                auto begin = table.heapView.data() + ref.offset;
+                table.request(begin, ref.size);
+                content.assign(begin, begin + ref.size);
+            }
+        }
+    }
+
+    //genomes are stored only once per content since offspring usually share identical genomes
+    class GenomeTable
+    {
+    public:
+        uint32_t insert(std::vector<uint8_t> const& genome)
+        {
+            auto hash = std::hash<std::string_view>()(std::string_view(reinterpret_cast<char const*>(genome.data()), genome.size()));
+            auto& candidates = _indicesByHash[hash];
+            for (auto const& index : candidates) {
+                if (_genomes.at(index) == genome) {
+                    return index;
+                }
+            }
+            auto index = toInt(_genomes.size());
+            _genomes.emplace_back(genome);
+            candidates.emplace_back(index);
+            return index;
+        }
+
+        void save(ColumnTable& table)
+        {
+            loadSaveHeapColumn(SerializationTask::Save, table, Id_Genome_Bytes, getPointers(_genomes), [](std::vector<uint8_t>& genome) -> std::vector<uint8_t>& {
+                return genome;
+            });
+        }
+
+        //genomes are read on demand from the serialized data
+        void setSerializedTable(ColumnTable const& table) { _serializedTable = table; }
+
+        std::vector<uint8_t> at(uint32_t index) const
+        {
+            auto column = _serializedTable.findColumn(Id_Genome_Bytes);
+            if (!column || index >= _serializedTable.numRows) {
+                throwCorruptedData();
+            }
+            auto element = column->getData() + index * column->elementSize;
+            _serializedTable.request(element, column->elementSize);
+            HeapRef ref;
+            if (!ColumnCodec<HeapRef>::decode(ref, element, column->elementSize) || !isRangeValid(ref.offset, ref.size, _serializedTable.heapView.size())) {
+                throwCorruptedData();
+            }
+            auto begin = _serializedTable.heapView.data() + ref.offset;
+            _serializedTable.request(begin, ref.size);
+            return std::vector<uint8_t>(begin, begin + ref.size);
+        }
+
+    private:
+        std::vector<std::vector<uint8_t>> _genomes;
+        std::unordered_map<size_t, std::vector<uint32_t>> _indicesByHash;
+        ColumnTable _serializedTable;
+    };
+
+    template <typename Row, typename Accessor>
+    void loadSaveGenomeColumn(
+        SerializationTask task,
+        ColumnTable& table,
+        GenomeTable& genomeTable,
+        uint32_t id,
+        uint32_t legacyId,
+        std::vector<Row*> const& rows,
+        Accessor const& accessor)
+    {
+        std::vector<uint32_t> indices(rows.size());
+        if (task == SerializationTask::Save) {
+            for (size_t i = 0; i < rows.size(); ++i) {
+                indices.at(i) = genomeTable.insert(std::invoke(accessor, *rows.at(i)));
+            }
+        }
+        if (task == SerializationTask::Load && !table.findColumn(id)) {
+            loadSaveHeapColumn(task, table, legacyId, rows, accessor);
+            return;
+        }
+        loadSaveColumn(task, table, id, getPointers(indices), [](uint32_t& index) -> uint32_t& { return index; }, 0u);
+        if (task == SerializationTask::Load) {
+            for (size_t i = 0; i < rows.size(); ++i) {
+                std::invoke(accessor, *rows.at(i)) = genomeTable.at(indices.at(i));
+            }
+        }
+    }
+
+    void loadSave(SerializationTask task, ColumnTable& table, std::vector<NeuronDescription*> const& rows)
+    {
+        NeuronDescription defaultObject;
+        loadSaveColumn(task, table, Id_Neuron_Weights, rows, &NeuronDescription::weights, defaultObject.weights);
+        loadSaveColumn(task, table, Id_Neuron_Biases, rows, &NeuronDescription::biases, defaultObject.biases);
+        loadSaveColumn(task, table, Id_Neuron_ActivationFunctions, rows, &NeuronDescription::activationFunctions, defaultObject.activationFunctions);
+    }
+
+    void loadSave(SerializationTask task, ColumnTable& table, std::vector<TransmitterDescription*> const& rows)
+    {
+        TransmitterDescription defaultObject;
+        loadSaveColumn(task, table, Id_Transmitter_Mode, rows, &TransmitterDescription::mode, defaultObject.mode);
+    }
+
+    void loadSave(SerializationTask task, ColumnTable& table, GenomeTable& genomeTable, std::vector<ConstructorDescription*> const& rows)
+    {
+        ConstructorDescription defaultObject;
+        loadSaveColumn(task, table, Id_Constructor_ActivationMode, rows, &ConstructorDescription::activationMode, defaultObject.activationMode);
+        loadSaveColumn(
+            task,
+            table,
+            Id_Constructor_ConstructionActivationTime,
+            rows,
+            &ConstructorDescription::constructionActivationTime,
+            defaultObject.constructionActivationTime);
+        loadSaveGenomeColumn(task, table, genomeTable, Id_Constructor_GenomeIndex, Id_Constructor_Genome, rows, &ConstructorDescription::genome);
+        loadSaveColumn(
+            task, table, Id_Constructor_NumInheritedGenomeNodes, rows, &ConstructorDescription::numInheritedGenomeNodes, defaultObject.numInheritedGenomeNodes);
+        loadSaveColumn(task, table, Id_Constructor_GenomeGeneration, rows, &ConstructorDescription::genomeGeneration, defaultObject.genomeGeneration);
+        loadSaveColumn(task, table, Id_Constructor_ConstructionAngle1, rows, &ConstructorDescription::constructionAngle1, defaultObject.constructionAngle1);
+        loadSaveColumn(task, table, Id_Constructor_ConstructionAngle2, rows, &ConstructorDescription::constructionAngle2, defaultObject.constructionAngle2);
+        loadSaveColumn(
+            task, table, Id_Constructor_LastConstructedCellId, rows, &ConstructorDescription::lastConstructedCellId, defaultObject.lastConstructedCellId);
+        loadSaveColumn(
+            task, table, Id_Constructor_GenomeCurrentNodeIndex, rows, &ConstructorDescription::genomeCurrentNodeIndex, defaultObject.genomeCurrentNodeIndex);
+        loadSaveColumn(
+            task,
+            table,
+            Id_Constructor_GenomeCurrentRepetition,
+            rows,
+            &ConstructorDescription::genomeCurrentRepetition,
+            defaultObject.genomeCurrentRepetition);
+        loadSaveColumn(task, table, Id_Constructor_CurrentBranch, rows, &ConstructorDescription::currentBranch, defaultObject.currentBranch);
+        loadSaveColumn(task, table, Id_Constructor_OffspringCreatureId, rows, &ConstructorDescription::offspringCreatureId, defaultObject.offspringCreatureId);
+        loadSaveColumn(task, table, Id_Constructor_OffspringMutationId, rows, &ConstructorDescription::offspringMutationId, defaultObject.offspringMutationId);
+    }
+
+    void loadSave(SerializationTask task, ColumnTable& table, std::vector<SensorDescription*> const& rows)
+    {
+        SensorDescription defaultObject;
+        loadSaveColumn(task, table, Id_Sensor_FixedAngle, rows, &SensorDescription::fixedAngle, defaultObject.fixedAngle);
+        loadSaveColumn(task, table, Id_Sensor_MinDensity, rows, &SensorDescription::minDensity, defaultObject.minDensity);
+        loadSaveColumn(task, table, Id_Sensor_Color, rows, &SensorDescription::color, defaultObject.color);
+        loadSaveColumn(task, table, Id_Sensor_TargetedCreatureId, rows, &SensorDescription::targetedCreatureId, defaultObject.targetedCreatureId);
+        loadSaveColumn(task, table, Id_Sensor_MemoryChannel1, rows, &SensorDescription::memoryChannel1, defaultObject.memoryChannel1);
+        loadSaveColumn(task, table, Id_Sensor_MemoryChannel2, rows, &SensorDescription::memoryChannel2, defaultObject.memoryChannel2);
+        loadSaveColumn(task, table, Id_Sensor_MemoryChannel3, rows, &SensorDescription::memoryChannel3, defaultObject.memoryChannel3);
+    }
+
+    void loadSave(SerializationTask task, ColumnTable& table, std::vector<NerveDescription*> const& rows)
+    {
+        NerveDescription defaultObject;
+        loadSaveColumn(task, table, Id_Nerve_PulseMode, rows, &NerveDescription::pulseMode, defaultObject.pulseMode);
+        loadSaveColumn(task, table, Id_Nerve_AlternationMode, rows, &NerveDescription::alternationMode, defaultObject.alternationMode);
+    }
+
+    void loadSave(SerializationTask task, ColumnTable& table, std::vector<AttackerDescription*> const& rows)
+    {
+        AttackerDescription defaultObject;
+        loadSaveColumn(task, table, Id_Attacker_Mode, rows, &AttackerDescription::mode, defaultObject.mode);
+    }
+
+    void loadSave(SerializationTask task, ColumnTable& table, GenomeTable& genomeTable, std::vector<InjectorDescription*> const& rows)
+    {
+        InjectorDescription defaultObject;
+        loadSaveColumn(task, table, Id_Injector_Mode, rows, &InjectorDescription::mode, defaultObject.mode);
+        loadSaveColumn(task, table, Id_Injector_Counter, rows, &InjectorDescription::counter, defaultObject.counter);
+        loadSaveGenomeColumn(task, table, genomeTable, Id_Injector_GenomeIndex, Id_Injector_Genome, rows, &InjectorDescription::genome);
+        loadSaveColumn(task, table, Id_Injector_GenomeGeneration, rows, &InjectorDescription::genomeGeneration, defaultObject.genomeGeneration);
+    }
+
+    void loadSave(SerializationTask task, ColumnTable& table, std::vector<MuscleDescription*> const& rows)
+    {
+        MuscleDescription defaultObject;
+        loadSaveColumn(task, table, Id_Muscle_Mode, rows, &MuscleDescription::mode, defaultObject.mode);
+        loadSaveColumn(task, table, Id_Muscle_LastBendingDirection, rows, &MuscleDescription::lastBendingDirection, defaultObject.lastBendingDirection);
+        loadSaveColumn(task, table, Id_Muscle_LastBendingSourceIndex, rows, &MuscleDescription::lastBendingSourceIndex, defaultObject.lastBendingSourceIndex);
+        loadSaveColumn(
+            task, table, Id_Muscle_ConsecutiveBendingAngle, rows, &MuscleDescription::consecutiveBendingAngle, defaultObject.consecutiveBendingAngle);
+    }
+
+    void loadSave(SerializationTask task, ColumnTable& table, std::vector<DefenderDescription*> const& rows)
+    {
+        DefenderDescription defaultObject;
+        loadSaveColumn(task, table, Id_Defender_Mode, rows, &DefenderDescription::mode, defaultObject.mode);
+    }
+
+    void loadSave(SerializationTask task, ColumnTable& table, std::vector<ReconnectorDescription*> const& rows)
+    {
+        ReconnectorDescription defaultObject;
+        loadSaveColumn(task, table, Id_Reconnector_Color, rows, &ReconnectorDescription::color, defaultObject.color);
+    }
+
+    void loadSave(SerializationTask task, ColumnTable& table, std::vector<DetonatorDescription*> const& rows)
+    {
+        DetonatorDescription defaultObject;
+        loadSaveColumn(task, table, Id_Detonator_State, rows, &DetonatorDescription::state, defaultObject.state);
+        loadSaveColumn(task, table, Id_Detonator_Countdown, rows, &DetonatorDescription::countdown, defaultObject.countdown);
+    }
+
+    void loadSave(SerializationTask task, ColumnTable& table, std::vector<CellDescription*> const& rows)
+    {
+        CellDescription defaultObject;
+        loadSaveColumn(task, table, Id_Cell_Id, rows, &CellDescription::id, defaultObject.id);
+        loadSaveColumn(task, table, Id_Cell_Pos, rows, &CellDescription::pos, defaultObject.pos);
+        loadSaveColumn(task, table, Id_Cell_Vel, rows, &CellDescription::vel, defaultObject.vel);
+        loadSaveColumn(task, table, Id_Cell_Energy, rows, &CellDescription::energy, defaultObject.energy);
+        loadSaveColumn(task, table, Id_Cell_Stiffness, rows, &CellDescription::stiffness, defaultObject.stiffness);
+        loadSaveColumn(task, table, Id_Cell_Color, rows, &CellDescription::color, defaultObject.color);
+        loadSaveColumn(task, table, Id_Cell_MaxConnections, rows, &CellDescription::maxConnections, defaultObject.maxConnections);
+        loadSaveColumn(task, table, Id_Cell_Barrier, rows, &CellDescription::barrier, defaultObject.barrier);
+        loadSaveColumn(task, table, Id_Cell_Age, rows, &CellDescription::age, defaultObject.age);
+        loadSaveColumn(task, table, Id_Cell_LivingState, rows, &CellDescription::livingState, defaultObject.livingState);
+        loadSaveColumn(task, table, Id_Cell_CreatureId, rows, &CellDescription::creatureId, defaultObject.creatureId);
+        loadSaveColumn(task, table, Id_Cell_MutationId, rows, &CellDescription::mutationId, defaultObject.mutationId);
+        loadSaveColumn(task, table, Id_Cell_ExecutionOrderNumber, rows, &CellDescription::executionOrderNumber, defaultObject.executionOrderNumber);
+        loadSaveColumn(
+            task, table, Id_Cell_InputExecutionOrderNumber, rows, &CellDescription::inputExecutionOrderNumber, defaultObject.inputExecutionOrderNumber);
+        loadSaveColumn(task, table, Id_Cell_OutputBlocked, rows, &CellDescription::outputBlocked, defaultObject.outputBlocked);
+        loadSaveColumn(task, table, Id_Cell_ActivationTime, rows, &CellDescription::activationTime, defaultObject.activationTime);
+        loadSaveColumn(task, table, Id_Cell_GenomeComplexity, rows, &CellDescription::genomeComplexity, defaultObject.genomeComplexity);
+        loadSaveColumn(
+            task, table, Id_Cell_Activity, rows, [](CellDescription& cell) -> std::vector<float>& { return cell.activity.channels; }, defaultObject.activity.channels);
+        loadSaveHeapColumn(task, table, Id_Cell_MetadataName, rows, [](CellDescription& cell) -> std::string& { return cell.metadata.name; });
+        loadSaveHeapColumn(task, table, Id_Cell_MetadataDescription, rows, [](CellDescription& cell) -> std::string& { return cell.metadata.description; });
+    }
+
+    void loadSave(SerializationTask task, ColumnTable& table, std::vector<ConnectionDescription*> const& rows)
+    {
+        ConnectionDescription defaultObject;
+        loadSaveColumn(task, table, Id_Connection_CellId, rows, &ConnectionDescription::cellId, defaultObject.cellId);
+        loadSaveColumn(task, table, Id_Connection_Distance, rows, &ConnectionDescription::distance, defaultObject.distance);
+        loadSaveColumn(task, table, Id_Connection_AngleFromPrevious, rows, &ConnectionDescription::angleFromPrevious, defaultObject.angleFromPrevious);
+    }
+
+    void loadSave(SerializationTask task, ColumnTable& table, std::vector<ParticleDescription*> const& rows)
+    {
+        ParticleDescription defaultObject;
+        loadSaveColumn(task, table, Id_Particle_Id, rows, &ParticleDescription::id, defaultObject.id);
+        loadSaveColumn(task, table, Id_Particle_Pos, rows, &ParticleDescription::pos, defaultObject.pos);
+        loadSaveColumn(task, table, Id_Particle_Vel, rows, &ParticleDescription::vel, defaultObject.vel);
+        loadSaveColumn(task, table, Id_Particle_Energy, rows, &ParticleDescription::energy, defaultObject.energy);
+        loadSaveColumn(task, table, Id_Particle_Color, rows, &ParticleDescription::color, defaultObject.color);
+    }
+
+    using Tables = std::map<uint32_t, ColumnTable>;
+
+    //row indices in the cell function tables (indexed by CellFunction) which should be loaded
+    using CellFunctionRows = std::array<std::vector<uint64_t>, CellFunction_Count>;
+
+    template <typename CellFunctionDesc>
+    void loadSaveCellFunctionTable(
+        SerializationTask task,
+        Tables& tables,
+        GenomeTable& genomeTable,
+        CellFunction cellFunction,
+        std::vector<CellDescription*> const& cells,
+        CellFunctionRows const* selectedRows)
+    {
+        std::vector<CellFunctionDesc*> rows;
+        for (auto const& cell : cells) {
+            if (cell->cellFunction && std::holds_alternative<CellFunctionDesc>(*cell->cellFunction)) {
+                rows.emplace_back(&std::get<CellFunctionDesc>(*cell->cellFunction));
+            }
+        }
+        auto sectionId = Section_CellFunctionBase + cellFunction;
+        if (task == SerializationTask::Load && !tables.contains(sectionId)) {
+            return;
+        }
+        auto& table = tables[sectionId];
+        if (selectedRows) {
+            table.selectedRows = &selectedRows->at(cellFunction);
+        }
+        if constexpr (std::is_same_v<CellFunctionDesc, ConstructorDescription> || std::is_same_v<CellFunctionDesc, InjectorDescription>) {
+            loadSave(task, table, genomeTable, rows);
+        } else {
+            loadSave(task, table, rows);
+        }
+    }
+
+    void loadSaveCellFunctions(SerializationTask task, Tables& tables, std::vector<CellDescription*> const& cells, CellFunctionRows const* selectedRows = nullptr)
+    {
+        GenomeTable genomeTable;
+        if (task == SerializationTask::Load && tables.contains(Section_Genomes)) {
+            genomeTable.setSerializedTable(tables.at(Section_Genomes));
+        }
+        loadSaveCellFunctionTable<NeuronDescription>(task, tables, genomeTable, CellFunction_Neuron, cells, selectedRows);
+        loadSaveCellFunctionTable<TransmitterDescription>(task, tables, genomeTable, CellFunction_Transmitter, cells, selectedRows);
+        loadSaveCellFunctionTable<ConstructorDescription>(task, tables, genomeTable, CellFunction_Constructor, cells, selectedRows);
+        loadSaveCellFunctionTable<SensorDescription>(task, tables, genomeTable, CellFunction_Sensor, cells, selectedRows);
+        loadSaveCellFunctionTable<NerveDescription>(task, tables, genomeTable, CellFunction_Nerve, cells, selectedRows);
+        loadSaveCellFunctionTable<AttackerDescription>(task, tables, genomeTable, CellFunction_Attacker, cells, selectedRows);
+        loadSaveCellFunctionTable<InjectorDescription>(task, tables, genomeTable, CellFunction_Injector, cells, selectedRows);
+        loadSaveCellFunctionTable<MuscleDescription>(task, tables, genomeTable, CellFunction_Muscle, cells, selectedRows);
+        loadSaveCellFunctionTable<DefenderDescription>(task, tables, genomeTable, CellFunction_Defender, cells, selectedRows);
+        loadSaveCellFunctionTable<ReconnectorDescription>(task, tables, genomeTable, CellFunction_Reconnector, cells, selectedRows);
+        loadSaveCellFunctionTable<DetonatorDescription>(task, tables, genomeTable, CellFunction_Detonator, cells, selectedRows);
+
+        if (task == SerializationTask::Save) {
+            genomeTable.save(tables[Section_Genomes]);
+        }
+    }
+
+    void createCellFunction(CellDescription& cell, CellFunction cellFunction)
+    {
+        switch (cellFunction) {
+        case CellFunction_Neuron:
+            cell.cellFunction = NeuronDescription();
+            break;
+        case CellFunction_Transmitter:
+            cell.cellFunction = TransmitterDescription();
+            break;
+        case CellFunction_Constructor:
+            cell.cellFunction = ConstructorDescription();
+            break;
+        case CellFunction_Sensor:
+            cell.cellFunction = SensorDescription();
+            break;
+        case CellFunction_Nerve:
+            cell.cellFunction = NerveDescription();
+            break;
+        case CellFunction_Attacker:
+            cell.cellFunction = AttackerDescription();
+            break;
+        case CellFunction_Injector:
+            cell.cellFunction = InjectorDescription();
+            break;
+        case CellFunction_Muscle:
+            cell.cellFunction = MuscleDescription();
+            break;
+        case CellFunction_Defender:
+            cell.cellFunction = DefenderDescription();
+            break;
+        case CellFunction_Reconnector:
+            cell.cellFunction = ReconnectorDescription();
+            break;
+        case CellFunction_Detonator:
+            cell.cellFunction = DetonatorDescription();
+            break;
+        default:
+            cell.cellFunction.reset();
+        }
+    }
+
+    auto const IdentityUInt32 = [](uint32_t& value) -> uint32_t& { return value; };
+    auto const IdentityInt = [](int& value) -> int& { return value; };
+
+    //displacement from pos1 to pos2 in a world with periodic boundaries
+    RealVector2D getShortestDisplacement(RealVector2D const& pos1, RealVector2D const& pos2, IntVector2D const& worldSize)
+    {
+        auto result = pos2 - pos1;
+        auto worldSizeX = toFloat(worldSize.x);
+        auto worldSizeY = toFloat(worldSize.y);
+        result.x -= std::round(result.x / worldSizeX) * worldSizeX;
+        result.y -= std::round(result.y / worldSizeY) * worldSizeY;
+        return result;
+    }
+}
+
+bool ColumnarSerializerService::isColumnarFormat(std::string_view data)
+{
+    return data.size() >= sizeof(Magic) && std::memcmp(data.data(), Magic, sizeof(Magic)) == 0;
+}
+
+void ColumnarSerializerService::serializeDataDescription(ClusteredDataDescription const& data, std::ostream& stream)
+{
+    auto task = SerializationTask::Save;
+    auto& mutableData = const_cast<ClusteredDataDescription&>(data);
+
+    stream.write(Magic, sizeof(Magic));
+    writeValue(stream, SchemaVersion);
+    writeValue(stream, MinReaderSchemaVersion);
+    writeValue(stream, static_cast<uint32_t>(Const::ProgramVersion.size()));
+    stream.write(Const::ProgramVersion.data(), Const::ProgramVersion.size());
+
+    Tables tables;
+
+    std::vector<uint32_t> numCellsPerCluster;
+    numCellsPerCluster.reserve(data.clusters.size());
+    std::vector<CellDescription*> cells;
+    for (auto& cluster : mutableData.clusters) {
+        numCellsPerCluster.emplace_back(toInt(cluster.cells.size()));
+        for (auto& cell : cluster.cells) {
+            cells.emplace_back(&cell);
+        }
+    }
+    loadSaveColumn(task, tables[Section_Clusters], Id_Cluster_NumCells, getPointers(numCellsPerCluster), IdentityUInt32, 0u);
+
+    std::vector<uint32_t> numConnections;
+    std::vector<CellFunction> cellFunctions;
+    std::vector<ConnectionDescription*> connections;
+    numConnections.reserve(cells.size());
+    cellFunctions.reserve(cells.size());
+    for (auto const& cell : cells) {
+        numConnections.emplace_back(toInt(cell->connections.size()));
+        cellFunctions.emplace_back(cell->getCellFunctionType());
+        for (auto& connection : cell->connections) {
+            connections.emplace_back(&connection);
+        }
+    }
+    auto& cellTable = tables[Section_Cells];
+    loadSave(task, cellTable, cells);
+    loadSaveColumn(task, cellTable, Id_Cell_NumConnections, getPointers(numConnections), IdentityUInt32, 0u);
+    loadSaveColumn(task, cellTable, Id_Cell_CellFunction, getPointers(cellFunctions), IdentityInt, CellFunction_None);
+    loadSave(task, tables[Section_Connections], connections);
+    loadSaveCellFunctions(task, tables, cells);
+
+    loadSave(task, tables[Section_Particles], getPointers(mutableData.particles));
+
+    for (auto const& [sectionId, table] : tables) {
+        table.write(stream, sectionId);
+    }
+    writeValue(stream, Section_End);
+}
+
+void ColumnarSerializerService::deserializeDataDescription(ClusteredDataDescription& data, std::istream& stream)
+{
+    std::string serializedData{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+    deserializeDataDescription(data, serializedData);
+}
+
+void ColumnarSerializerService::deserializeDataDescription(ClusteredDataDescription& data, std::string_view serializedData)
+{
+    data = _ColumnarDataReader(serializedData).getData();
+}
+
+struct _ColumnarDataReader::SerializedTables
+{
+    SerializedData serializedData;
+    Tables tables;
+};
+
+_ColumnarDataReader::_ColumnarDataReader(std::string_view serializedData, std::function<void(uint64_t offset, uint64_t size)> const& requestRange)
+    : _tables(std::make_unique<SerializedTables>())
+{
+    auto task = SerializationTask::Load;
+    _tables->serializedData = SerializedData{serializedData, requestRange};
+    auto const& source = _tables->serializedData;
+
+    source.request(serializedData.data(), std::min(sizeof(Magic), serializedData.size()));
+    if (!ColumnarSerializerService::isColumnarFormat(serializedData)) {
+        throw std::runtime_error("No columnar simulation data detected.");
+    }
+    uint64_t pos = sizeof(Magic);
+    readValue<uint32_t>(source, serializedData, pos);  //schema version of the writer
+    auto minReaderSchemaVersion = readValue<uint32_t>(source, serializedData, pos);
+    if (minReaderSchemaVersion > SchemaVersion) {
+        throw std::runtime_error("Version not supported.");
+    }
+    auto versionSize = readValue<uint32_t>(source, serializedData, pos);
+    if (!isRangeValid(pos, versionSize, serializedData.size())) {
+        throwCorruptedData();
+    }
+    source.request(serializedData.data() + pos, versionSize);
+    std::string version(serializedData.substr(pos, versionSize));
+    pos += versionSize;
+    if (!VersionChecker::isVersionValid(version)) {
+        throw std::runtime_error("No version detected.");
+    }
+    if (VersionChecker::isVersionOutdated(version)) {
+        throw std::runtime_error("Version not supported.");
+    }
+
+    //unknown sections are ignored for forward compatibility
+    auto& tables = _tables->tables;
+    while (true) {
+        auto sectionId = readValue<uint32_t>(source, serializedData, pos);
+        if (sectionId == Section_End) {
+            break;
+        }
+        auto payloadSize = readValue<uint64_t>(source, serializedData, pos);
+        if (!isRangeValid(pos, payloadSize, serializedData.size())) {
+            throwCorruptedData();
+        }
+        tables.emplace(sectionId, ColumnTable::read(source, serializedData.substr(pos, payloadSize)));
+        pos += payloadSize;
+    }
+
+    //decode structure
+    auto& clusterTable = tables[Section_Clusters];
+    std::vector<uint32_t> numCellsPerCluster(clusterTable.numRows);
+    loadSaveColumn(task, clusterTable, Id_Cluster_NumCells, getPointers(numCellsPerCluster), IdentityUInt32, 0u);
+    _cellOffsetByCluster.resize(numCellsPerCluster.size() + 1);
+    for (size_t i = 0; i < numCellsPerCluster.size(); ++i) {
+        _cellOffsetByCluster.at(i + 1) = _cellOffsetByCluster.at(i) + numCellsPerCluster.at(i);
+    }
+
+    auto& cellTable = tables[Section_Cells];
+    if (_cellOffsetByCluster.back() != cellTable.numRows) {
+        throwCorruptedData();
+    }
+    std::vector<uint32_t> numConnections(cellTable.numRows);
+    _cellFunctions.resize(cellTable.numRows);
+    loadSaveColumn(task, cellTable, Id_Cell_NumConnections, getPointers(numConnections), IdentityUInt32, 0u);
+    loadSaveColumn(task, cellTable, Id_Cell_CellFunction, getPointers(_cellFunctions), IdentityInt, CellFunction_None);
+
+    _connectionOffsetByCell.resize(numConnections.size() + 1);
+    _cellFunctionRowByCell.resize(numConnections.size());
+    std::array<uint64_t, CellFunction_Count> numCellFunctionRows{};
+    for (size_t i = 0; i < numConnections.size(); ++i) {
+        _connectionOffsetByCell.at(i + 1) = _connectionOffsetByCell.at(i) + numConnections.at(i);
+        auto& cellFunction = _cellFunctions.at(i);
+        if (cellFunction < 0 || cellFunction >= CellFunction_Count) {
+            cellFunction = CellFunction_None;
+        }
+        _cellFunctionRowByCell.at(i) = numCellFunctionRows.at(cellFunction)++;
+    }
+    if (_connectionOffsetByCell.back() != tables[Section_Connections].numRows) {
+        throwCorruptedData();
+    }
+}
+
+_ColumnarDataReader::~_ColumnarDataReader() = default;
+
+uint64_t _ColumnarDataReader::getNumClusters() const
+{
+    return _cellOffsetByCluster.size() - 1;
+}
+
+uint64_t _ColumnarDataReader::getNumCells() const
+{
+    return _cellFunctions.size();
+}
+
+uint64_t _ColumnarDataReader::getNumParticles() const
+{
+    auto const& tables = _tables->tables;
+    return tables.contains(Section_Particles) ? tables.at(Section_Particles).numRows : 0;
+}
+
+std::vector<RealRect> _ColumnarDataReader::getClusterBoundingBoxes(std::optional<IntVector2D> const& worldSize) const
+{
+    auto cellTable = _tables->tables.at(Section_Cells);
+    std::vector<RealVector2D> positions(cellTable.numRows);
+    loadSaveColumn(SerializationTask::Load, cellTable, Id_Cell_Pos, getPointers(positions), [](RealVector2D& pos) -> RealVector2D& { return pos; }, RealVector2D());
+
+    std::vector<RealRect> result(getNumClusters());
+    for (size_t i = 0; i < result.size(); ++i) {
+        auto& rect = result.at(i);
+        auto begin = _cellOffsetByCluster.at(i);
+        auto end = _cellOffsetByCluster.at(i + 1);
+        if (begin == end) {
+            continue;
+        }
+        auto const& referencePos = positions.at(begin);
+        rect.topLeft = rect.bottomRight = referencePos;
+        for (auto cellIndex = begin + 1; cellIndex < end; ++cellIndex) {
+            auto pos = positions.at(cellIndex);
+            if (worldSize) {
+                pos = referencePos + getShortestDisplacement(referencePos, pos, *worldSize);
+            }
+            rect.topLeft = {std::min(rect.topLeft.x, pos.x), std::min(rect.topLeft.y, pos.y)};
+            rect.bottomRight = {std::max(rect.bottomRight.x, pos.x), std::max(rect.bottomRight.y, pos.y)};
+        }
+    }
+    return result;
+}
+
+std::vector<RealVector2D> _ColumnarDataReader::getParticlePositions() const
+{
+    auto const& tables = _tables->tables;
+    if (!tables.contains(Section_Particles)) {
+        return {};
+    }
+    auto particleTable = tables.at(Section_Particles);
+    std::vector<RealVector2D> result(particleTable.numRows);
+    loadSaveColumn(SerializationTask::Load, particleTable, Id_Particle_Pos, getPointers(result), [](RealVector2D& pos) -> RealVector2D& { return pos; }, RealVector2D());
+    return result;
+}
+
+ClusteredDataDescription _ColumnarDataReader::getData() const
+{
+    return readData(nullptr, nullptr);
+}
+
+ClusteredDataDescription _ColumnarDataReader::getData(std::vector<uint64_t> const& clusterIndices, std::vector<uint64_t> const& particleIndices) const
+{
+    return readData(&clusterIndices, &particleIndices);
+}
+
+ClusteredDataDescription _ColumnarDataReader::readData(std::vector<uint64_t> const* clusterIndices, std::vector<uint64_t> const* particleIndices) const
+{
+    auto task = SerializationTask::Load;
+
+    //the tables are copied since the row selection is stored in them (the serialized data is not copied)
+    auto tables = _tables->tables;
+    auto isSelection = clusterIndices != nullptr;
+
+    ClusteredDataDescription result;
+    result.clusters.resize(isSelection ? clusterIndices->size() : getNumClusters());
+
+    std::vector<uint64_t> cellRows;
+    std::vector<uint64_t> connectionRows;
+    CellFunctionRows cellFunctionRows;
+    std::vector<CellDescription*> cells;
+    std::vector<ConnectionDescription*> connections;
+    cells.reserve(isSelection ? 0 : getNumCells());
+    for (size_t i = 0; i < result.clusters.size(); ++i) {
+        auto clusterIndex = isSelection ? clusterIndices->at(i) : i;
+        if (clusterIndex >= getNumClusters()) {
+            throw std::out_of_range("Cluster index out of range.");
+        }
+        auto& cluster = result.clusters.at(i);
+        auto cellBegin = _cellOffsetByCluster.at(clusterIndex);
+        cluster.cells.resize(_cellOffsetByCluster.at(clusterIndex + 1) - cellBegin);
+        for (size_t j = 0; j < cluster.cells.size(); ++j) {
+            auto cellRow = cellBegin + j;
+            auto& cell = cluster.cells.at(j);
+            auto connectionBegin = _connectionOffsetByCell.at(cellRow);
+            cell.connections.resize(_connectionOffsetByCell.at(cellRow + 1) - connectionBegin);
+            for (size_t k = 0; k < cell.connections.size(); ++k) {
+                connections.emplace_back(&cell.connections.at(k));
+                if (isSelection) {
+                    connectionRows.emplace_back(connectionBegin + k);
+                }
+            }
+            auto cellFunction = _cellFunctions.at(cellRow);
+            createCellFunction(cell, cellFunction);
+            cells.emplace_back(&cell);
+            if (isSelection) {
+                cellRows.emplace_back(cellRow);
+                cellFunctionRows.at(cellFunction).emplace_back(_cellFunctionRowByCell.at(cellRow));
+            }
+        }
+    }
+    auto& cellTable = tables[Section_Cells];
+    auto& connectionTable = tables[Section_Connections];
+    if (isSelection) {
+        cellTable.selectedRows = &cellRows;
+        connectionTable.selectedRows = &connectionRows;
+    }
+    loadSave(task, cellTable, cells);
+    loadSave(task, connectionTable, connections);
+    loadSaveCellFunctions(task, tables, cells, isSelection ? &cellFunctionRows : nullptr);
+
+    auto& particleTable = tables[Section_Particles];
+    if (particleIndices) {
+        for (auto const& index : *particleIndices) {
+            if (index >= particleTable.numRows) {
+                throw std::out_of_range("Particle index out of range.");
+            }
+        }
+        particleTable.selectedRows = particleIndices;
+    }
+    result.particles.resize(particleTable.getNumSelectedRows());
+    loadSave(task, particleTable, getPointers(result.particles));
+    return result;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+#include "Definitions.h"
+#include "Descriptions.h"
+
+/**
+ * Binary simulation format with a structure-of-arrays layout.
+ *
+ * The stream consists of a header (magic, schema version, program version) followed by sections. Each section
+ * is a table of fixed-width columns (one entry per cell, connection, particle, etc.) plus a byte heap for variable
+ * sized data like genomes or metadata strings. Columns and sections are addressed by ids, so that unknown ones are
+ * skipped and missing ones are filled with default values.
+ */
+class ColumnarSerializerService
+{
+public:
+    static bool isColumnarFormat(std::string_view data);
+
+    static void serializeDataDescription(ClusteredDataDescription const& data, std::ostream& stream);
+    static void deserializeDataDescription(ClusteredDataDescription& data, std::istream& stream);
+    static void deserializeDataDescription(ClusteredDataDescription& data, std::string_view serializedData);
+};
+
+/**
+ * Reads parts of serialized columnar data without decoding the remaining data.
+ * Only the cluster/cell/connection structure is decoded on construction. The serialized data is referenced and
+ * must outlive the reader. If requestRange is given, it is called for each range of the serialized data before the
+ * range is read, e.g. for data which is decompressed on demand.
+ */
+class _ColumnarDataReader
+{
+public:
+    _ColumnarDataReader(std::string_view serializedData, std::function<void(uint64_t offset, uint64_t size)> const& requestRange = nullptr);
+    ~_ColumnarDataReader();
+
+    uint64_t getNumClusters() const;
+    uint64_t getNumCells() const;
+    uint64_t getNumParticles() const;
+
+    //for a given world size, clusters crossing the world boundaries get bounding boxes which exceed the world instead of spanning it
+    std::vector<RealRect> getClusterBoundingBoxes(std::optional<IntVector2D> const& worldSize = std::nullopt) const;
+    std::vector<RealVector2D> getParticlePositions() const;
+
+    ClusteredDataDescription getData() const;
+    ClusteredDataDescription getData(std::vector<uint64_t> const& clusterIndices, std::vector<uint64_t> const& particleIndices) const;
+
+private:
+    ClusteredDataDescription readData(std::vector<uint64_t> const* clusterIndices, std::vector<uint64_t> const* particleIndices) const;
+
+    struct SerializedTables;
+    std::unique_ptr<SerializedTables> _tables;
+
+    std::vector<uint64_t> _cellOffsetByCluster;  //size: number of clusters + 1
+    std::vector<uint64_t> _connectionOffsetByCell;  //size: number of cells + 1
+    std::vector<CellFunction> _cellFunctions;
+    std::vector<uint64_t> _cellFunctionRowByCell;  //row index in the table of the cell function
+};
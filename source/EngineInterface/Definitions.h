@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <map>
 #include <string>
@@ -7,6 +8,11 @@
 #include <vector>
 
 #include "CellFunctionConstants.h"
+#include "EngineConstants.h"
+
+//neuron weights (row: output channel, column: input channel) and biases are stored contiguously in the layout of the TOs
+using NeuronWeights = std::array<std::array<float, MAX_CHANNELS>, MAX_CHANNELS>;
+using NeuronBiases = std::array<float, MAX_CHANNELS>;
 
 struct SimulationParameters;
 
@@ -36,3 +42,15 @@ using ShapeGenerator = std::shared_ptr<_ShapeGenerator>;
 class ShapeGeneratorResult;
 
 class StatisticsHistory;
+
+class _StatisticsHistorySnapshot;
+using StatisticsHistorySnapshot = std::shared_ptr<_StatisticsHistorySnapshot const>;
+
+class _ColumnarDataReader;
+using ColumnarDataReader = std::shared_ptr<_ColumnarDataReader>;
+
+class _LazyDecompressedData;
+using LazyDecompressedData = std::shared_ptr<_LazyDecompressedData>;
+
+class _MappedSimulationFile;
+using MappedSimulationFile = std::shared_ptr<_MappedSimulationFile>;
@@ -7,7 +7,7 @@
 #include "Base/NumberGenerator.h"
 #include "Base/Math.h"
 #include "GenomeDescriptions.h"
-#include "SpaceCalculator.h"
+#include "SpatialGrid.h"
 #include "GenomeDescriptionService.h"
 
 DataDescription DescriptionEditService::createRect(CreateRectParameters const& parameters)
@@ -198,40 +198,6 @@ void DescriptionEditService::duplicate(ClusteredDataDescription& data, IntVector
     data = result;
 }
 
-namespace
-{
-    std::vector<int> getCellIndicesWithinRadius(
-        DataDescription const& data,
-        std::unordered_map<int, std::unordered_map<int, std::vector<int>>> const& cellIndicesBySlot,
-        RealVector2D const& pos,
-        float radius)
-    {
-        std::vector<int> result;
-        IntVector2D upperLeftIntPos{toInt(pos.x - radius - 0.5f), toInt(pos.y - radius - 0.5f)};
-        IntVector2D lowerRightIntPos{toInt(pos.x + radius + 0.5f), toInt(pos.y + radius + 0.5f)};
-        for (int x = upperLeftIntPos.x; x <= lowerRightIntPos.x; ++x) {
-            for (int y = upperLeftIntPos.y; y <= lowerRightIntPos.y; ++y) {
-                if (cellIndicesBySlot.find(x) != cellIndicesBySlot.end()) {
-                    if (cellIndicesBySlot.at(x).find(y) != cellIndicesBySlot.at(x).end()) {
-                        for (auto const& cellIndex : cellIndicesBySlot.at(x).at(y)) {
-                            auto const& cell = data.cells.at(cellIndex);
-                            if (Math::length(cell.pos - pos) <= radius) {
-                                result.emplace_back(cellIndex);
-                            }
-                        }
-                    }
-                }
-            }
-        }
-        std::sort(result.begin(), result.end(), [&](int index1, int index2) {
-            auto const& cell1 = data.cells.at(index1);
-            auto const& cell2 = data.cells.at(index2);
-            return Math::length(cell1.pos - pos) < Math::length(cell2.pos - pos);
-        });
-        return result;
-    }
-}
-
 DataDescription DescriptionEditService::gridMultiply(DataDescription const& input, GridMultiplyParameters const& parameters)
 {
     DataDescription result;
@@ -269,17 +235,16 @@ DataDescription DescriptionEditService::randomMultiply(
     bool& overlappingCheckSuccessful)
 {
     overlappingCheckSuccessful = true;
-    SpaceCalculator spaceCalculator(worldSize);
-    std::unordered_map<IntVector2D, std::vector<RealVector2D>> cellPosBySlot;
 
-    //create map for overlapping check
+    //create grid for overlapping check
+    std::optional<SpatialGrid> cellPositions;
     if (parameters._overlappingCheck) {
-        int index = 0;
+        std::vector<RealVector2D> existentCellPositions;
+        existentCellPositions.reserve(existentData.cells.size());
         for (auto const& cell : existentData.cells) {
-            auto intPos = toIntVector2D(spaceCalculator.getCorrectedPosition(cell.pos));
-            cellPosBySlot[intPos].emplace_back(cell.pos);
-            ++index;
+            existentCellPositions.emplace_back(cell.pos);
         }
+        cellPositions.emplace(existentCellPositions, 2.0f, worldSize);
     }
 
     //do multiplication
@@ -303,12 +268,7 @@ DataDescription DescriptionEditService::randomMultiply(
             //overlapping check
             overlapping = false;
             if (parameters._overlappingCheck) {
-                for (auto const& cell : copy.cells) {
-                    auto pos = spaceCalculator.getCorrectedPosition(cell.pos);
-                    if (isCellPresent(cellPosBySlot, spaceCalculator, pos, 2.0f)) {
-                        overlapping = true;
-                    }
-                }
+                overlapping = std::any_of(copy.cells.begin(), copy.cells.end(), [&](auto const& cell) { return cellPositions->isOccupied(cell.pos, 2.0f); });
             }
             ++attempts;
         } while (overlapping && attempts < 200 && overlappingCheckSuccessful);
@@ -318,17 +278,14 @@ DataDescription DescriptionEditService::randomMultiply(
 
         generateNewIds(copy);
         generateNewCreatureIds(copy);
-        result.add(copy);
 
-        //add copy to existentData for overlapping check
+        //add copy to grid for overlapping check
         if (parameters._overlappingCheck) {
             for (auto const& cell : copy.cells) {
-                auto index = toInt(existentData.cells.size());
-                existentData.cells.emplace_back(cell);
-                auto intPos = toIntVector2D(spaceCalculator.getCorrectedPosition(cell.pos));
-                cellPosBySlot[intPos].emplace_back(cell.pos);
+                cellPositions->insert(cell.pos);
             }
         }
+        result.add(copy);
     }
 
     return result;
@@ -341,33 +298,38 @@ void DescriptionEditService::addIfSpaceAvailable(
     float distance,
     IntVector2D const& worldSize)
 {
-    SpaceCalculator space(worldSize);
-
+    if (cellOccupancy.getNumEntries() == 0) {
+        cellOccupancy = Occupancy(distance, worldSize);
+    }
     for (auto const& cell : toAdd.cells) {
-        if (!isCellPresent(cellOccupancy, space, cell.pos, distance)) {
+        if (!cellOccupancy.isOccupied(cell.pos, distance)) {
             result.addCell(cell);
-            cellOccupancy[toIntVector2D(cell.pos)].emplace_back(cell.pos);
+            cellOccupancy.insert(cell.pos);
         }
     }
 }
 
 void DescriptionEditService::reconnectCells(DataDescription& data, float maxDistance)
 {
-    std::unordered_map<int, std::unordered_map<int, std::vector<int>>> cellIndicesBySlot;
-
-    int index = 0;
+    std::vector<RealVector2D> cellPositions;
+    cellPositions.reserve(data.cells.size());
     for (auto& cell : data.cells) {
         cell.connections.clear();
-        cellIndicesBySlot[toInt(cell.pos.x)][toInt(cell.pos.y)].emplace_back(toInt(index));
-        ++index;
+        cellPositions.emplace_back(cell.pos);
     }
+    SpatialGrid grid(cellPositions, maxDistance);
 
     std::unordered_map<uint64_t, int> cache;
     for (auto const& [index, cell] : data.cells | boost::adaptors::indexed(0)) {
         cache.emplace(cell.id, static_cast<int>(index));
     }
     for (auto& cell : data.cells) {
-        auto nearbyCellIndices = getCellIndicesWithinRadius(data, cellIndicesBySlot, cell.pos, maxDistance);
+        auto nearbyCellIndices = grid.getEntriesWithinRadius(cell.pos, maxDistance);
+        std::sort(nearbyCellIndices.begin(), nearbyCellIndices.end(), [&](int index1, int index2) {
+            auto distance1 = Math::length(data.cells[index1].pos - cell.pos);
+            auto distance2 = Math::length(data.cells[index2].pos - cell.pos);
+            return distance1 < distance2 || (distance1 == distance2 && index1 < index2);
+        });
         for (auto const& nearbyCellIndex : nearbyCellIndices) {
             auto const& nearbyCell = data.cells.at(nearbyCellIndex);
             if (cell.id != nearbyCell.id && cell.connections.size() < cell.maxConnections && nearbyCell.connections.size() < nearbyCell.maxConnections
@@ -599,39 +561,6 @@ void DescriptionEditService::removeMetadata(CellDescription& cell)
     cell.metadata.name.clear();
 }
 
-bool DescriptionEditService::isCellPresent(Occupancy const& cellPosBySlot, SpaceCalculator const& spaceCalculator, RealVector2D const& posToCheck, float distance)
-{
-    auto intPos = toIntVector2D(posToCheck);
-
-    auto getMatchingSlots = [&cellPosBySlot](IntVector2D const& intPos) {
-        auto findResult = cellPosBySlot.find(intPos);
-        if (findResult != cellPosBySlot.end()) {
-            return findResult->second;
-        }
-        return std::vector<RealVector2D>{};
-    };
-
-    auto isOccupied = [&](std::vector<RealVector2D> const& cellPositions) {
-        for (auto const& cellPos : cellPositions) {
-            auto otherPos = spaceCalculator.getCorrectedPosition(cellPos);
-            if (Math::length(posToCheck - otherPos) < distance) {
-                return true;
-            }
-        }
-        return false;
-    };
-
-    auto distanceInt = toInt(ceilf(distance));
-    for (int dx = -distanceInt; dx <= distanceInt; ++dx) {
-        for (int dy = -distanceInt; dy <= distanceInt; ++dy) {
-            if (isOccupied(getMatchingSlots({intPos.x + dx, intPos.y + dy}))) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
 uint64_t DescriptionEditService::getId(CellOrParticleDescription const& entity)
 {
     if (std::holds_alternative<CellDescription>(entity)) {
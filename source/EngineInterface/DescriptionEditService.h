@@ -2,6 +2,7 @@
 
 #include "Base/Definitions.h"
 #include "Descriptions.h"
+#include "SpatialGrid.h"
 
 class DescriptionEditService
 {
@@ -90,7 +91,7 @@ public:
         DataDescription&& existentData,
         bool& overlappingCheckSuccessful);
 
-    using Occupancy = std::unordered_map<IntVector2D, std::vector<RealVector2D>>;
+    using Occupancy = SpatialGrid;
     static void
     addIfSpaceAvailable(DataDescription& result, Occupancy& cellOccupancy, DataDescription const& toAdd, float distance, IntVector2D const& worldSize);
 
@@ -117,9 +118,4 @@ public:
 
 private:
     static void removeMetadata(CellDescription& cell);
-    static bool isCellPresent(
-        Occupancy const& cellPosBySlot,
-        SpaceCalculator const& spaceCalculator,
-        RealVector2D const& posToCheck,
-        float distance);
 };
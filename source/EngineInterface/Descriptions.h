@@ -69,14 +69,12 @@ struct ActivityDescription
 
 struct NeuronDescription
 {
-    std::vector<std::vector<float>> weights;
-    std::vector<float> biases;
+    NeuronWeights weights = {};
+    NeuronBiases biases = {};
     std::vector<NeuronActivationFunction> activationFunctions;
 
     NeuronDescription()
     {
-        weights.resize(MAX_CHANNELS, std::vector<float>(MAX_CHANNELS, 0));
-        biases.resize(MAX_CHANNELS, 0);
         activationFunctions.resize(MAX_CHANNELS, 0);
     }
     auto operator<=>(NeuronDescription const&) const = default;
@@ -1,7 +1,15 @@
 #pragma once
 
+using SpatialMapType = int;
+enum SpatialMapType_
+{
+    SpatialMapType_Dense,   //one entry per world position
+    SpatialMapType_SparseTiled  //memory proportional to the number of occupied tiles, suited for huge sparsely populated worlds
+};
+
 struct GeneralSettings
 {
     int worldSizeX;
     int worldSizeY;
+    SpatialMapType spatialMapType = SpatialMapType_Dense;
 };
@@ -5,6 +5,7 @@
 #include "Base/Definitions.h"
 
 #include "GenomeConstants.h"
+#include "GenomeView.h"
 
 namespace
 {
@@ -392,28 +393,17 @@ GenomeDescription GenomeDescriptionService::convertBytesToDescription(std::vecto
 
 int GenomeDescriptionService::convertNodeAddressToNodeIndex(std::vector<uint8_t> const& data, int nodeAddress, GenomeEncodingSpecification const& spec)
 {
-    //wasteful approach but sufficient for GUI
-    return convertBytesToDescriptionIntern(data, nodeAddress, data.size(), spec).genome.cells.size();
+    return GenomeView(data, spec).convertNodeAddressToNodeIndex(nodeAddress);
 }
 
 int GenomeDescriptionService::convertNodeIndexToNodeAddress(std::vector<uint8_t> const& data, int nodeIndex, GenomeEncodingSpecification const& spec)
 {
-    //wasteful approach but sufficient for GUI
-    return convertBytesToDescriptionIntern(data, data.size(), nodeIndex, spec).lastBytePosition;
+    return GenomeView(data, spec).convertNodeIndexToNodeAddress(nodeIndex);
 }
 
 int GenomeDescriptionService::getNumNodesRecursively(std::vector<uint8_t> const& data, bool includeRepetitions, GenomeEncodingSpecification const& spec)
 {
-    auto genome = convertBytesToDescriptionIntern(data, data.size(), data.size(), spec).genome;
-    auto result = toInt(genome.cells.size());
-    for (auto const& node : genome.cells) {
-        if (auto subgenome = node.getGenome()) {
-            result += getNumNodesRecursively(*subgenome, includeRepetitions, spec);
-        }
-    }
-
-    auto numRepetitions = genome.header.numRepetitions == std::numeric_limits<int>::max() ? 1 : genome.header.numRepetitions;
-    return includeRepetitions ? result * numRepetitions * genome.header.getNumBranches() : result;
+    return GenomeView(data, spec).getNumNodesRecursively(includeRepetitions);
 }
 
 int GenomeDescriptionService::getNumRepetitions(std::vector<uint8_t> const& data)
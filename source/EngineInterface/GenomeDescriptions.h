@@ -9,6 +9,7 @@
 #include "Base/Definitions.h"
 #include "EngineConstants.h"
 #include "CellFunctionConstants.h"
+#include "Definitions.h"
 
 struct MakeGenomeCopy
 {
@@ -17,14 +18,12 @@ struct MakeGenomeCopy
 
 struct NeuronGenomeDescription
 {
-    std::vector<std::vector<float>> weights;
-    std::vector<float> biases;
+    NeuronWeights weights = {};
+    NeuronBiases biases = {};
     std::vector<NeuronActivationFunction> activationFunctions;
 
     NeuronGenomeDescription()
     {
-        weights.resize(MAX_CHANNELS, std::vector<float>(MAX_CHANNELS, 0));
-        biases.resize(MAX_CHANNELS, 0);
         activationFunctions.resize(MAX_CHANNELS, 0);
     }
     auto operator<=>(NeuronGenomeDescription const&) const = default;
@@ -0,0 +1,202 @@
+#include "GenomeView.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "Base/Definitions.h"
+
+#include "GenomeConstants.h"
+
+GenomeView::GenomeView(std::vector<uint8_t> const& data, GenomeEncodingSpecification const& spec)
+    : GenomeView(data.data(), toInt(data.size()), spec)
+{}
+
+GenomeView::GenomeView(uint8_t const* data, int size, GenomeEncodingSpecification const& spec)
+    : _data(data)
+    , _size(size)
+    , _spec(spec)
+{}
+
+void GenomeView::buildNodeIndex()
+{
+    _nodeAddresses.clear();
+    for (auto nodeAddress = getHeaderSize(); nodeAddress < _size; nodeAddress = getNextNodeAddress(nodeAddress)) {
+        _nodeAddresses.emplace_back(nodeAddress);
+    }
+    _hasNodeIndex = true;
+}
+
+int GenomeView::getSize() const
+{
+    return _size;
+}
+
+int GenomeView::getHeaderSize() const
+{
+    auto result = Const::GenomeHeaderNumRepetitionsPos;
+    if (_spec._numRepetitions) {
+        ++result;
+    }
+    if (_spec._concatenationAngle1) {
+        ++result;
+    }
+    if (_spec._concatenationAngle2) {
+        ++result;
+    }
+    return std::min(result, _size);
+}
+
+int GenomeView::getNumRepetitions() const
+{
+    if (!_spec._numRepetitions) {
+        return 1;
+    }
+    auto result = getByte(Const::GenomeHeaderNumRepetitionsPos);
+    return result == 255 ? std::numeric_limits<int>::max() : result;
+}
+
+int GenomeView::getNumBranches() const
+{
+    auto separateConstruction = static_cast<int8_t>(getByte(Const::GenomeHeaderSeparationPos)) > 0;
+    return separateConstruction ? 1 : (getByte(Const::GenomeHeaderNumBranchesPos) + 5) % 6 + 1;
+}
+
+int GenomeView::getNumNodes() const
+{
+    if (_hasNodeIndex) {
+        return toInt(_nodeAddresses.size());
+    }
+    auto result = 0;
+    for (auto nodeAddress = getHeaderSize(); nodeAddress < _size; nodeAddress = getNextNodeAddress(nodeAddress)) {
+        ++result;
+    }
+    return result;
+}
+
+int GenomeView::getNumNodesRecursively(bool includeRepetitions) const
+{
+    auto result = 0;
+    for (auto nodeAddress = getHeaderSize(); nodeAddress < _size; nodeAddress = getNextNodeAddress(nodeAddress)) {
+        ++result;
+        if (auto subgenome = getSubgenome(nodeAddress)) {
+            result += subgenome->getNumNodesRecursively(includeRepetitions);
+        }
+    }
+
+    auto numRepetitions = getNumRepetitions();
+    if (numRepetitions == std::numeric_limits<int>::max()) {
+        numRepetitions = 1;
+    }
+    return includeRepetitions ? result * numRepetitions * getNumBranches() : result;
+}
+
+int GenomeView::convertNodeAddressToNodeIndex(int nodeAddress) const
+{
+    if (_hasNodeIndex) {
+        return toInt(std::lower_bound(_nodeAddresses.begin(), _nodeAddresses.end(), nodeAddress) - _nodeAddresses.begin());
+    }
+    auto result = 0;
+    for (auto address = getHeaderSize(); address < _size && address < nodeAddress; address = getNextNodeAddress(address)) {
+        ++result;
+    }
+    return result;
+}
+
+int GenomeView::convertNodeIndexToNodeAddress(int nodeIndex) const
+{
+    if (_hasNodeIndex) {
+        if (nodeIndex >= toInt(_nodeAddresses.size())) {
+            return _size;
+        }
+        return nodeIndex <= 0 ? getHeaderSize() : _nodeAddresses[nodeIndex];
+    }
+    auto result = getHeaderSize();
+    for (int index = 0; result < _size && index < nodeIndex; ++index) {
+        result = getNextNodeAddress(result);
+    }
+    return result;
+}
+
+CellFunction GenomeView::getCellFunction(int nodeAddress) const
+{
+    return getByte(nodeAddress) % CellFunction_Count;
+}
+
+int GenomeView::getNextNodeAddress(int nodeAddress) const
+{
+    auto cellFunction = getCellFunction(nodeAddress);
+    auto pos = skip(nodeAddress, Const::CellBasicBytes);
+    switch (cellFunction) {
+    case CellFunction_Neuron:
+        return skip(pos, Const::NeuronBytes);
+    case CellFunction_Transmitter:
+        return skip(pos, Const::TransmitterBytes);
+    case CellFunction_Constructor:
+        return readEmbeddedGenome(skip(pos, Const::ConstructorFixedBytes)).endPos;
+    case CellFunction_Sensor:
+        return skip(pos, Const::SensorBytes);
+    case CellFunction_Nerve:
+        return skip(pos, Const::NerveBytes);
+    case CellFunction_Attacker:
+        return skip(pos, Const::AttackerBytes);
+    case CellFunction_Injector:
+        return readEmbeddedGenome(skip(pos, Const::InjectorFixedBytes)).endPos;
+    case CellFunction_Muscle:
+        return skip(pos, Const::MuscleBytes);
+    case CellFunction_Defender:
+        return skip(pos, Const::DefenderBytes);
+    case CellFunction_Reconnector:
+        return skip(pos, Const::ReconnectorBytes);
+    case CellFunction_Detonator:
+        return skip(pos, Const::DetonatorBytes);
+    }
+    return pos;
+}
+
+std::optional<GenomeView> GenomeView::getSubgenome(int nodeAddress) const
+{
+    auto cellFunction = getCellFunction(nodeAddress);
+    if (cellFunction != CellFunction_Constructor && cellFunction != CellFunction_Injector) {
+        return std::nullopt;
+    }
+    auto fixedBytes = cellFunction == CellFunction_Constructor ? Const::ConstructorFixedBytes : Const::InjectorFixedBytes;
+    auto embeddedGenome = readEmbeddedGenome(skip(skip(nodeAddress, Const::CellBasicBytes), fixedBytes));
+    if (!embeddedGenome.dataPos) {
+        return std::nullopt;
+    }
+    return GenomeView(_data + *embeddedGenome.dataPos, embeddedGenome.dataSize, _spec);
+}
+
+uint8_t GenomeView::getByte(int pos) const
+{
+    return pos < _size ? _data[pos] : 0;
+}
+
+//reading behind the data does not advance the position as in GenomeDescriptionService
+int GenomeView::skip(int pos, int numBytes) const
+{
+    return std::min(pos + numBytes, _size);
+}
+
+int GenomeView::readWord(int pos) const
+{
+    return static_cast<int>(getByte(pos)) | (static_cast<int>(getByte(pos + 1)) << 8);
+}
+
+auto GenomeView::readEmbeddedGenome(int pos) const -> EmbeddedGenome
+{
+    EmbeddedGenome result;
+    auto makeGenomeCopy = static_cast<int8_t>(getByte(pos)) > 0;
+    pos = skip(pos, 1);
+    if (makeGenomeCopy) {
+        result.endPos = pos;
+        return result;
+    }
+    auto size = readWord(pos);
+    pos = skip(pos, 2);
+    size = std::min(size, _size - pos);
+    result.dataPos = pos;
+    result.dataSize = size;
+    result.endPos = pos + size;
+    return result;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "GenomeDescriptionService.h"
+
+/**
+ * Non-owning view on the byte encoding of a genome. Queries walk the encoding in place without decoding nodes into
+ * GenomeDescription objects. Optionally, an index of the node addresses can be built once to answer index and address
+ * queries in constant or logarithmic time.
+ * The referenced data must outlive the view.
+ */
+class GenomeView
+{
+public:
+    GenomeView(std::vector<uint8_t> const& data, GenomeEncodingSpecification const& spec = GenomeEncodingSpecification());
+    GenomeView(uint8_t const* data, int size, GenomeEncodingSpecification const& spec = GenomeEncodingSpecification());
+
+    void buildNodeIndex();  //only allocation of the view
+
+    int getSize() const;
+    int getHeaderSize() const;
+    int getNumRepetitions() const;  //returns std::numeric_limits<int>::max() for infinite repetitions
+    int getNumBranches() const;
+
+    int getNumNodes() const;
+    int getNumNodesRecursively(bool includeRepetitions) const;
+
+    //a node address is the byte position of a node, addresses behind the data refer to the end of the genome
+    int convertNodeAddressToNodeIndex(int nodeAddress) const;
+    int convertNodeIndexToNodeAddress(int nodeIndex) const;
+
+    CellFunction getCellFunction(int nodeAddress) const;
+    int getNextNodeAddress(int nodeAddress) const;
+
+    //subgenome of a constructor or injector node, std::nullopt if there is none or if it is a genome copy
+    std::optional<GenomeView> getSubgenome(int nodeAddress) const;
+
+private:
+    uint8_t getByte(int pos) const;
+    int skip(int pos, int numBytes) const;
+    int readWord(int pos) const;
+
+    //position after the embedded genome and the position and size of its data
+    struct EmbeddedGenome
+    {
+        int endPos = 0;
+        std::optional<int> dataPos;
+        int dataSize = 0;
+    };
+    EmbeddedGenome readEmbeddedGenome(int pos) const;
+
+    uint8_t const* _data = nullptr;
+    int _size = 0;
+    GenomeEncodingSpecification _spec;
+    std::vector<int> _nodeAddresses;  //filled by buildNodeIndex
+    bool _hasNodeIndex = false;
+};
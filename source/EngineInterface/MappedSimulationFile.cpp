@@ -0,0 +1,259 @@
+#include "MappedSimulationFile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "BlockCompressionService.h"
+#include "ColumnarSerializerService.h"
+
+struct _MappedSimulationFile::Mapping
+{
+    boost::interprocess::file_mapping file;
+    boost::interprocess::mapped_region region;
+};
+
+//uniform grid where each entry is stored in all grid cells which are overlapped by its bounding box
+//for a given world size, bounding boxes and query regions are split at the world boundaries into parts inside the world
+class _MappedSimulationFile::SpatialIndex
+{
+public:
+    SpatialIndex(std::vector<RealRect> const& boundingBoxes, std::optional<IntVector2D> const& worldSize)
+        : _worldSize(worldSize)
+    {
+        for (uint64_t index = 0; index < boundingBoxes.size(); ++index) {
+            for (auto const& rect : splitAtWorldBoundaries(boundingBoxes.at(index))) {
+                _parts.emplace_back(Part{rect, index});
+            }
+        }
+        if (_parts.empty()) {
+            return;
+        }
+        _bounds = _parts.front().rect;
+        for (auto const& part : _parts) {
+            _bounds.topLeft = {std::min(_bounds.topLeft.x, part.rect.topLeft.x), std::min(_bounds.topLeft.y, part.rect.topLeft.y)};
+            _bounds.bottomRight = {std::max(_bounds.bottomRight.x, part.rect.bottomRight.x), std::max(_bounds.bottomRight.y, part.rect.bottomRight.y)};
+        }
+
+        //approx. 4 entries per grid cell
+        _gridSize = std::clamp(toInt(std::sqrt(toFloat(_parts.size()) / 4.0f)), 1, 4096);
+        _gridCellSize = {
+            std::max((_bounds.bottomRight.x - _bounds.topLeft.x) / toFloat(_gridSize), NEAR_ZERO),
+            std::max((_bounds.bottomRight.y - _bounds.topLeft.y) / toFloat(_gridSize), NEAR_ZERO)};
+
+        //compressed sparse row layout: count, prefix sum, fill
+        _offsets.resize(_gridSize * _gridSize + 1, 0);
+        for (auto const& part : _parts) {
+            forEachGridCell(part.rect, [&](int gridIndex) { ++_offsets.at(gridIndex + 1); });
+        }
+        for (size_t i = 1; i < _offsets.size(); ++i) {
+            _offsets.at(i) += _offsets.at(i - 1);
+        }
+        _entries.resize(_offsets.back());
+        auto insertPositions = _offsets;
+        for (uint64_t partIndex = 0; partIndex < _parts.size(); ++partIndex) {
+            forEachGridCell(_parts.at(partIndex).rect, [&](int gridIndex) { _entries.at(insertPositions.at(gridIndex)++) = partIndex; });
+        }
+    }
+
+    std::vector<uint64_t> query(RealRect const& region) const
+    {
+        std::vector<uint64_t> result;
+        if (_parts.empty()) {
+            return result;
+        }
+        for (auto const& regionPart : splitAtWorldBoundaries(region)) {
+            if (!intersects(regionPart, _bounds)) {
+                continue;
+            }
+            forEachGridCell(regionPart, [&](int gridIndex) {
+                for (auto i = _offsets.at(gridIndex); i < _offsets.at(gridIndex + 1); ++i) {
+                    auto const& part = _parts.at(_entries.at(i));
+                    if (intersects(regionPart, part.rect)) {
+                        result.emplace_back(part.index);
+                    }
+                }
+            });
+        }
+
+        //entries spanning several grid cells or consisting of several parts are found multiple times
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+        return result;
+    }
+
+private:
+    struct Part
+    {
+        RealRect rect;
+        uint64_t index = 0;
+    };
+
+    static bool intersects(RealRect const& rect1, RealRect const& rect2)
+    {
+        return rect1.topLeft.x <= rect2.bottomRight.x && rect2.topLeft.x <= rect1.bottomRight.x && rect1.topLeft.y <= rect2.bottomRight.y
+            && rect2.topLeft.y <= rect1.bottomRight.y;
+    }
+
+    //maps the interval [begin, end] to at most two intervals inside [0, worldSize]
+    static std::vector<std::pair<float, float>> splitAtWorldBoundaries(float begin, float end, float worldSize)
+    {
+        if (end - begin >= worldSize) {
+            return {{0.0f, worldSize}};
+        }
+        auto shift = std::floor(begin / worldSize) * worldSize;
+        begin -= shift;
+        end -= shift;
+        if (end <= worldSize) {
+            return {{begin, end}};
+        }
+        return {{begin, worldSize}, {0.0f, end - worldSize}};
+    }
+
+    std::vector<RealRect> splitAtWorldBoundaries(RealRect const& rect) const
+    {
+        if (!_worldSize) {
+            return {rect};
+        }
+        std::vector<RealRect> result;
+        for (auto const& [beginX, endX] : splitAtWorldBoundaries(rect.topLeft.x, rect.bottomRight.x, toFloat(_worldSize->x))) {
+            for (auto const& [beginY, endY] : splitAtWorldBoundaries(rect.topLeft.y, rect.bottomRight.y, toFloat(_worldSize->y))) {
+                result.emplace_back(RealRect{{beginX, beginY}, {endX, endY}});
+            }
+        }
+        return result;
+    }
+
+    int toGridCoordinate(float value, float origin, float cellSize) const
+    {
+        return std::clamp(toInt(std::floor((value - origin) / cellSize)), 0, _gridSize - 1);
+    }
+
+    template <typename Func>
+    void forEachGridCell(RealRect const& rect, Func const& func) const
+    {
+        auto x1 = toGridCoordinate(rect.topLeft.x, _bounds.topLeft.x, _gridCellSize.x);
+        auto x2 = toGridCoordinate(rect.bottomRight.x, _bounds.topLeft.x, _gridCellSize.x);
+        auto y1 = toGridCoordinate(rect.topLeft.y, _bounds.topLeft.y, _gridCellSize.y);
+        auto y2 = toGridCoordinate(rect.bottomRight.y, _bounds.topLeft.y, _gridCellSize.y);
+        for (int y = y1; y <= y2; ++y) {
+            for (int x = x1; x <= x2; ++x) {
+                func(x + y * _gridSize);
+            }
+        }
+    }
+
+    std::optional<IntVector2D> _worldSize;
+    std::vector<Part> _parts;
+    RealRect _bounds;
+    int _gridSize = 1;
+    RealVector2D _gridCellSize;
+    std::vector<uint64_t> _offsets;
+    std::vector<uint64_t> _entries;  //indices of parts
+};
+
+_MappedSimulationFile::_MappedSimulationFile(std::string const& filename, std::optional<IntVector2D> const& worldSize)
+{
+    try {
+        _mapping = std::make_unique<Mapping>();
+        _mapping->file = boost::interprocess::file_mapping(filename.c_str(), boost::interprocess::read_only);
+        _mapping->region = boost::interprocess::mapped_region(_mapping->file, boost::interprocess::read_only);
+    } catch (boost::interprocess::interprocess_exception const&) {
+        throw std::runtime_error("Could not open file " + filename + ".");
+    }
+
+    //block-compressed data is decompressed on demand, the mapped file contains the compressed data
+    std::string_view data(static_cast<char const*>(_mapping->region.get_address()), _mapping->region.get_size());
+    std::function<void(uint64_t, uint64_t)> requestRange;
+    if (BlockCompressionService::isBlockCompressed(data)) {
+        _decompressedData = std::make_shared<_LazyDecompressedData>(data);
+        data = _decompressedData->getData();
+        requestRange = [decompressedData = _decompressedData.get()](uint64_t offset, uint64_t size) { decompressedData->requestRange(offset, size); };
+    }
+    try {
+        _reader = std::make_shared<_ColumnarDataReader>(data, requestRange);
+    } catch (std::runtime_error const& exception) {
+        throw std::runtime_error("The file " + filename + " could not be read: " + exception.what());
+    }
+
+    _clusterIndex = std::make_unique<SpatialIndex>(_reader->getClusterBoundingBoxes(worldSize), worldSize);
+
+    std::vector<RealRect> particleBoundingBoxes;
+    auto particlePositions = _reader->getParticlePositions();
+    particleBoundingBoxes.reserve(particlePositions.size());
+    for (auto const& pos : particlePositions) {
+        particleBoundingBoxes.emplace_back(RealRect{pos, pos});
+    }
+    _particleIndex = std::make_unique<SpatialIndex>(particleBoundingBoxes, worldSize);
+}
+
+_MappedSimulationFile::~_MappedSimulationFile() = default;
+
+uint64_t _MappedSimulationFile::getNumClusters() const
+{
+    return _reader->getNumClusters();
+}
+
+uint64_t _MappedSimulationFile::getNumCells() const
+{
+    return _reader->getNumCells();
+}
+
+uint64_t _MappedSimulationFile::getNumParticles() const
+{
+    return _reader->getNumParticles();
+}
+
+bool _MappedSimulationFile::isAccessedInPlace() const
+{
+    return !_decompressedData;
+}
+
+uint64_t _MappedSimulationFile::getNumBlocks() const
+{
+    return _decompressedData ? _decompressedData->getNumBlocks() : 0;
+}
+
+uint64_t _MappedSimulationFile::getNumDecompressedBlocks() const
+{
+    return _decompressedData ? _decompressedData->getNumDecompressedBlocks() : 0;
+}
+
+ClusteredDataDescription _MappedSimulationFile::getData(RealRect const& region) const
+{
+    return _reader->getData(getClusterIndices(region), getParticleIndices(region));
+}
+
+std::vector<uint64_t> _MappedSimulationFile::getClusterIndices(RealRect const& region) const
+{
+    return _clusterIndex->query(region);
+}
+
+std::vector<uint64_t> _MappedSimulationFile::getParticleIndices(RealRect const& region) const
+{
+    return _particleIndex->query(region);
+}
+
+void _MappedSimulationFile::forEachBatch(uint64_t maxObjectsPerBatch, std::function<void(ClusteredDataDescription const&)> const& func) const
+{
+    maxObjectsPerBatch = std::max(uint64_t(1), maxObjectsPerBatch);
+    auto numClusters = getNumClusters();
+    auto numParticles = getNumParticles();
+    std::vector<uint64_t> clusterIndices;
+    std::vector<uint64_t> particleIndices;
+    for (uint64_t begin = 0; begin < numClusters + numParticles; begin += maxObjectsPerBatch) {
+        clusterIndices.clear();
+        particleIndices.clear();
+        for (auto index = begin; index < std::min(begin + maxObjectsPerBatch, numClusters + numParticles); ++index) {
+            if (index < numClusters) {
+                clusterIndices.emplace_back(index);
+            } else {
+                particleIndices.emplace_back(index - numClusters);
+            }
+        }
+        func(_reader->getData(clusterIndices, particleIndices));
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "Definitions.h"
+#include "Descriptions.h"
+
+/**
+ * Read-only access to a simulation file (main data only) without decoding it completely.
+ * The file is memory-mapped. Files written with DataFormat::ColumnarUncompressed are accessed in place, i.e. only the
+ * pages touched by a query are read. For block-compressed files (the default format), only the blocks touched by a
+ * query are decompressed. A spatial index over the bounding boxes of the clusters and the particle positions allows to
+ * fetch the content of rectangular regions. If the world size is given, bounding boxes and regions wrap around the
+ * world boundaries.
+ */
+class _MappedSimulationFile
+{
+public:
+    _MappedSimulationFile(std::string const& filename, std::optional<IntVector2D> const& worldSize = std::nullopt);
+    ~_MappedSimulationFile();
+
+    uint64_t getNumClusters() const;
+    uint64_t getNumCells() const;
+    uint64_t getNumParticles() const;
+    bool isAccessedInPlace() const;  //false if the file is block-compressed
+    uint64_t getNumBlocks() const;  //0 if the file is not block-compressed
+    uint64_t getNumDecompressedBlocks() const;
+
+    //returns all clusters whose bounding box intersects the region and all particles inside the region
+    ClusteredDataDescription getData(RealRect const& region) const;
+    std::vector<uint64_t> getClusterIndices(RealRect const& region) const;
+    std::vector<uint64_t> getParticleIndices(RealRect const& region) const;
+
+    //calls func for consecutive parts of the data (each part contains at most maxObjectsPerBatch clusters and particles)
+    void forEachBatch(uint64_t maxObjectsPerBatch, std::function<void(ClusteredDataDescription const&)> const& func) const;
+
+private:
+    struct Mapping;
+    class SpatialIndex;
+
+    std::unique_ptr<Mapping> _mapping;
+    LazyDecompressedData _decompressedData;
+    ColumnarDataReader _reader;
+    std::unique_ptr<SpatialIndex> _clusterIndex;
+    std::unique_ptr<SpatialIndex> _particleIndex;
+};
@@ -0,0 +1,389 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "AuxiliaryData.h"
+#include "SimulationParameters.h"
+
+/**
+ * Compile-time description of the properties in the settings files. The order of the fields determines the order in
+ * the files and the order of decoding, i.e. conditions may only depend on preceding fields.
+ */
+using ParameterFieldType = int;
+enum ParameterFieldType_
+{
+    ParameterFieldType_Bool,
+    ParameterFieldType_Int,
+    ParameterFieldType_UInt32,
+    ParameterFieldType_UInt64,
+    ParameterFieldType_Float,
+    ParameterFieldType_Milliseconds,
+    ParameterFieldType_ColorVectorInt,  //properties "<key>[i]"
+    ParameterFieldType_ColorVectorFloat,
+    ParameterFieldType_ColorMatrixInt,  //properties "<key>[i, j]"
+    ParameterFieldType_ColorMatrixFloat,
+    ParameterFieldType_ColorMatrixBool,
+    ParameterFieldType_ParticleSources,  //RadiationSourceFields for each particle source below "<key>.<index>"
+    ParameterFieldType_Spots  //SimulationParametersSpotFields for each spot below "<key>.<index>"
+};
+
+template <typename T>
+constexpr ParameterFieldType getParameterFieldType()
+{
+    if constexpr (std::is_same_v<T, bool>) {
+        return ParameterFieldType_Bool;
+    } else if constexpr (std::is_same_v<T, int>) {
+        return ParameterFieldType_Int;
+    } else if constexpr (std::is_same_v<T, uint32_t>) {
+        return ParameterFieldType_UInt32;
+    } else if constexpr (std::is_same_v<T, uint64_t>) {
+        return ParameterFieldType_UInt64;
+    } else if constexpr (std::is_same_v<T, float>) {
+        return ParameterFieldType_Float;
+    } else if constexpr (std::is_same_v<T, std::chrono::milliseconds>) {
+        return ParameterFieldType_Milliseconds;
+    } else if constexpr (std::is_same_v<T, ColorVector<int>>) {
+        return ParameterFieldType_ColorVectorInt;
+    } else if constexpr (std::is_same_v<T, ColorVector<float>>) {
+        return ParameterFieldType_ColorVectorFloat;
+    } else if constexpr (std::is_same_v<T, ColorMatrix<int>>) {
+        return ParameterFieldType_ColorMatrixInt;
+    } else if constexpr (std::is_same_v<T, ColorMatrix<float>>) {
+        return ParameterFieldType_ColorMatrixFloat;
+    } else if constexpr (std::is_same_v<T, ColorMatrix<bool>>) {
+        return ParameterFieldType_ColorMatrixBool;
+    } else {
+        static_assert(!std::is_same_v<T, T>, "Unsupported parameter type.");
+    }
+}
+
+template <typename Object>
+struct ParameterField
+{
+    char const* key;  //nodes are separated by '.'
+    ParameterFieldType type;
+    void* (*getValue)(Object& object);  //for decoding
+    void const* (*getConstValue)(Object const& object);  //for encoding
+    bool* (*getActivated)(Object& object) = nullptr;  //spot values are preceded by the property "<key>.activated"
+    bool const* (*getConstActivated)(Object const& object) = nullptr;
+    bool (*isActive)(Object const& object) = nullptr;  //inactive fields are neither encoded nor decoded
+};
+
+//mutable and const accessor for the same expression
+#define PARAMETER_FIELD_ACCESSORS(Object, Pointee, expression) \
+    [](Object& object) -> Pointee* { return expression; }, [](Object const& object) -> Pointee const* { return expression; }
+
+#define PARAMETER_FIELD(Object, member, key) \
+    ParameterField<Object>{ \
+        key, \
+        getParameterFieldType<std::remove_cvref_t<decltype(std::declval<Object&>().member)>>(), \
+        PARAMETER_FIELD_ACCESSORS(Object, void, &object.member)}
+
+#define CONDITIONAL_PARAMETER_FIELD(Object, member, key, condition) \
+    ParameterField<Object>{ \
+        key, \
+        getParameterFieldType<std::remove_cvref_t<decltype(std::declval<Object&>().member)>>(), \
+        PARAMETER_FIELD_ACCESSORS(Object, void, &object.member), \
+        nullptr, \
+        nullptr, \
+        [](Object const& object) { return condition; }}
+
+#define PARAMETER_ARRAY_FIELD(member, key, type) \
+    ParameterField<SimulationParameters>{key, type, PARAMETER_FIELD_ACCESSORS(SimulationParameters, void, object.member)}
+
+#define SPOT_VALUE_FIELD(member, key) \
+    ParameterField<SimulationParametersSpot>{ \
+        key, \
+        getParameterFieldType<std::remove_cvref_t<decltype(std::declval<SimulationParametersSpotValues&>().member)>>(), \
+        PARAMETER_FIELD_ACCESSORS(SimulationParametersSpot, void, &object.values.member), \
+        PARAMETER_FIELD_ACCESSORS(SimulationParametersSpot, bool, &object.activatedValues.member)}
+
+//properties besides the simulation parameters
+inline constexpr ParameterField<AuxiliaryData> AuxiliaryDataFields[] = {
+    PARAMETER_FIELD(AuxiliaryData, timestep, "general.time step"),
+    PARAMETER_FIELD(AuxiliaryData, realTime, "general.real time"),
+    PARAMETER_FIELD(AuxiliaryData, zoom, "general.zoom"),
+    PARAMETER_FIELD(AuxiliaryData, center.x, "general.center.x"),
+    PARAMETER_FIELD(AuxiliaryData, center.y, "general.center.y"),
+    PARAMETER_FIELD(AuxiliaryData, generalSettings.worldSizeX, "general.world size.x"),
+    PARAMETER_FIELD(AuxiliaryData, generalSettings.worldSizeY, "general.world size.y"),
+    PARAMETER_FIELD(AuxiliaryData, generalSettings.spatialMapType, "general.spatial map type"),
+};
+
+inline constexpr ParameterField<RadiationSource> RadiationSourceFields[] = {
+    PARAMETER_FIELD(RadiationSource, posX, "pos.x"),
+    PARAMETER_FIELD(RadiationSource, posY, "pos.y"),
+    PARAMETER_FIELD(RadiationSource, velX, "vel.x"),
+    PARAMETER_FIELD(RadiationSource, velY, "vel.y"),
+    PARAMETER_FIELD(RadiationSource, useAngle, "use angle"),
+    PARAMETER_FIELD(RadiationSource, angle, "angle"),
+    PARAMETER_FIELD(RadiationSource, shapeType, "shape.type"),
+    CONDITIONAL_PARAMETER_FIELD(
+        RadiationSource, shapeData.circularRadiationSource.radius, "shape.circular.radius", object.shapeType == RadiationSourceShapeType_Circular),
+    CONDITIONAL_PARAMETER_FIELD(
+        RadiationSource, shapeData.rectangularRadiationSource.width, "shape.rectangular.width", object.shapeType == RadiationSourceShapeType_Rectangular),
+    CONDITIONAL_PARAMETER_FIELD(
+        RadiationSource, shapeData.rectangularRadiationSource.height, "shape.rectangular.height", object.shapeType == RadiationSourceShapeType_Rectangular),
+};
+
+inline constexpr ParameterField<SimulationParametersSpot> SimulationParametersSpotFields[] = {
+    PARAMETER_FIELD(SimulationParametersSpot, color, "color"),
+    PARAMETER_FIELD(SimulationParametersSpot, posX, "pos.x"),
+    PARAMETER_FIELD(SimulationParametersSpot, posY, "pos.y"),
+    PARAMETER_FIELD(SimulationParametersSpot, velX, "vel.x"),
+    PARAMETER_FIELD(SimulationParametersSpot, velY, "vel.y"),
+    PARAMETER_FIELD(SimulationParametersSpot, shapeType, "shape.type"),
+    CONDITIONAL_PARAMETER_FIELD(
+        SimulationParametersSpot, shapeData.circularSpot.coreRadius, "shape.circular.core radius", object.shapeType == SpotShapeType_Circular),
+    CONDITIONAL_PARAMETER_FIELD(
+        SimulationParametersSpot, shapeData.rectangularSpot.width, "shape.rectangular.core width", object.shapeType == SpotShapeType_Rectangular),
+    CONDITIONAL_PARAMETER_FIELD(
+        SimulationParametersSpot, shapeData.rectangularSpot.height, "shape.rectangular.core height", object.shapeType == SpotShapeType_Rectangular),
+    PARAMETER_FIELD(SimulationParametersSpot, flowType, "flow.type"),
+    CONDITIONAL_PARAMETER_FIELD(SimulationParametersSpot, flowData.radialFlow.orientation, "flow.radial.orientation", object.flowType == FlowType_Radial),
+    CONDITIONAL_PARAMETER_FIELD(SimulationParametersSpot, flowData.radialFlow.strength, "flow.radial.strength", object.flowType == FlowType_Radial),
+    CONDITIONAL_PARAMETER_FIELD(SimulationParametersSpot, flowData.radialFlow.driftAngle, "flow.radial.drift angle", object.flowType == FlowType_Radial),
+    CONDITIONAL_PARAMETER_FIELD(SimulationParametersSpot, flowData.centralFlow.strength, "flow.central.strength", object.flowType == FlowType_Central),
+    CONDITIONAL_PARAMETER_FIELD(SimulationParametersSpot, flowData.linearFlow.angle, "flow.linear.angle", object.flowType == FlowType_Linear),
+    CONDITIONAL_PARAMETER_FIELD(SimulationParametersSpot, flowData.linearFlow.strength, "flow.linear.strength", object.flowType == FlowType_Linear),
+    PARAMETER_FIELD(SimulationParametersSpot, fadeoutRadius, "fadeout radius"),
+    SPOT_VALUE_FIELD(friction, "friction"),
+    SPOT_VALUE_FIELD(rigidity, "rigidity"),
+    SPOT_VALUE_FIELD(radiationAbsorption, "radiation.absorption"),
+    SPOT_VALUE_FIELD(radiationAbsorptionLowVelocityPenalty, "radiation.absorption low velocity penalty"),
+    SPOT_VALUE_FIELD(radiationAbsorptionLowGenomeComplexityPenalty, "radiation.absorption low genome complexity penalty"),
+    SPOT_VALUE_FIELD(radiationCellAgeStrength, "radiation.factor"),
+    SPOT_VALUE_FIELD(cellMaxForce, "cell.max force"),
+    SPOT_VALUE_FIELD(cellMinEnergy, "cell.min energy"),
+    SPOT_VALUE_FIELD(cellFusionVelocity, "cell.fusion velocity"),
+    SPOT_VALUE_FIELD(cellMaxBindingEnergy, "cell.max binding energy"),
+    PARAMETER_FIELD(SimulationParametersSpot, activatedValues.cellColorTransition, "cell.color transition rules.activated"),
+    PARAMETER_FIELD(SimulationParametersSpot, values.cellColorTransitionDuration, "cell.color transition rules.duration"),
+    PARAMETER_FIELD(SimulationParametersSpot, values.cellColorTransitionTargetColor, "cell.color transition rules.target color"),
+    SPOT_VALUE_FIELD(cellFunctionAttackerEnergyCost, "cell.function.attacker.energy cost"),
+    SPOT_VALUE_FIELD(cellFunctionAttackerFoodChainColorMatrix, "cell.function.attacker.food chain color matrix"),
+    SPOT_VALUE_FIELD(cellFunctionAttackerGenomeComplexityBonus, "cell.function.attacker.genome size bonus"),
+    SPOT_VALUE_FIELD(cellFunctionAttackerGeometryDeviationExponent, "cell.function.attacker.geometry deviation exponent"),
+    SPOT_VALUE_FIELD(cellFunctionAttackerConnectionsMismatchPenalty, "cell.function.attacker.connections mismatch penalty"),
+    SPOT_VALUE_FIELD(cellFunctionConstructorMutationNeuronDataProbability, "cell.function.constructor.mutation probability.neuron data"),
+    SPOT_VALUE_FIELD(cellFunctionConstructorMutationPropertiesProbability, "cell.function.constructor.mutation probability.data "),
+    SPOT_VALUE_FIELD(cellFunctionConstructorMutationGeometryProbability, "cell.function.constructor.mutation probability.geometry"),
+    SPOT_VALUE_FIELD(cellFunctionConstructorMutationCustomGeometryProbability, "cell.function.constructor.mutation probability.custom geometry"),
+    SPOT_VALUE_FIELD(cellFunctionConstructorMutationCellFunctionProbability, "cell.function.constructor.mutation probability.cell function"),
+    SPOT_VALUE_FIELD(cellFunctionConstructorMutationInsertionProbability, "cell.function.constructor.mutation probability.insertion"),
+    SPOT_VALUE_FIELD(cellFunctionConstructorMutationDeletionProbability, "cell.function.constructor.mutation probability.deletion"),
+    SPOT_VALUE_FIELD(cellFunctionConstructorMutationTranslationProbability, "cell.function.constructor.mutation probability.translation"),
+    SPOT_VALUE_FIELD(cellFunctionConstructorMutationDuplicationProbability, "cell.function.constructor.mutation probability.duplication"),
+    SPOT_VALUE_FIELD(cellFunctionConstructorMutationSubgenomeColorProbability, "cell.function.constructor.mutation probability.color"),
+    SPOT_VALUE_FIELD(cellFunctionConstructorMutationGenomeColorProbability, "cell.function.constructor.mutation probability.uniform color"),
+};
+
+inline constexpr ParameterField<SimulationParameters> SimulationParametersFields[] = {
+    PARAMETER_FIELD(SimulationParameters, backgroundColor, "simulation parameters.background color"),
+    PARAMETER_FIELD(SimulationParameters, cellColoring, "simulation parameters.cell colorization"),
+    PARAMETER_FIELD(SimulationParameters, highlightedCellFunction, "simulation parameters.highlighted cell function"),
+    PARAMETER_FIELD(SimulationParameters, zoomLevelNeuronalActivity, "simulation parameters.zoom level.neural activity"),
+    PARAMETER_FIELD(SimulationParameters, borderlessRendering, "simulation parameters.borderless rendering"),
+    PARAMETER_FIELD(SimulationParameters, markReferenceDomain, "simulation parameters.mark reference domain"),
+    PARAMETER_FIELD(SimulationParameters, gridLines, "simulation parameters.grid lines"),
+    PARAMETER_FIELD(SimulationParameters, timestepSize, "simulation parameters.time step size"),
+    PARAMETER_FIELD(SimulationParameters, motionType, "simulation parameters.motion.type"),
+    CONDITIONAL_PARAMETER_FIELD(
+        SimulationParameters, motionData.fluidMotion.smoothingLength, "simulation parameters.fluid.smoothing length", object.motionType == MotionType_Fluid),
+    CONDITIONAL_PARAMETER_FIELD(
+        SimulationParameters, motionData.fluidMotion.pressureStrength, "simulation parameters.fluid.pressure strength", object.motionType == MotionType_Fluid),
+    CONDITIONAL_PARAMETER_FIELD(
+        SimulationParameters,
+        motionData.fluidMotion.viscosityStrength,
+        "simulation parameters.fluid.viscosity strength",
+        object.motionType == MotionType_Fluid),
+    CONDITIONAL_PARAMETER_FIELD(
+        SimulationParameters,
+        motionData.collisionMotion.cellMaxCollisionDistance,
+        "simulation parameters.motion.collision.max distance",
+        object.motionType != MotionType_Fluid),
+    CONDITIONAL_PARAMETER_FIELD(
+        SimulationParameters,
+        motionData.collisionMotion.cellRepulsionStrength,
+        "simulation parameters.motion.collision.repulsion strength",
+        object.motionType != MotionType_Fluid),
+    PARAMETER_FIELD(SimulationParameters, baseValues.friction, "simulation parameters.friction"),
+    PARAMETER_FIELD(SimulationParameters, baseValues.rigidity, "simulation parameters.rigidity"),
+    PARAMETER_FIELD(SimulationParameters, cellMaxVelocity, "simulation parameters.cell.max velocity"),
+    PARAMETER_FIELD(SimulationParameters, cellMaxBindingDistance, "simulation parameters.cell.max binding distance"),
+    PARAMETER_FIELD(SimulationParameters, cellNormalEnergy, "simulation parameters.cell.normal energy"),
+    PARAMETER_FIELD(SimulationParameters, cellMinDistance, "simulation parameters.cell.min distance"),
+    PARAMETER_FIELD(SimulationParameters, baseValues.cellMaxForce, "simulation parameters.cell.max force"),
+    PARAMETER_FIELD(SimulationParameters, cellMaxForceDecayProb, "simulation parameters.cell.max force decay probability"),
+    PARAMETER_FIELD(SimulationParameters, cellNumExecutionOrderNumbers, "simulation parameters.cell.max execution order number"),
+    PARAMETER_FIELD(SimulationParameters, baseValues.cellMinEnergy, "simulation parameters.cell.min energy"),
+    PARAMETER_FIELD(SimulationParameters, baseValues.cellFusionVelocity, "simulation parameters.cell.fusion velocity"),
+    PARAMETER_FIELD(SimulationParameters, baseValues.cellMaxBindingEnergy, "simulation parameters.cell.max binding energy"),
+    PARAMETER_FIELD(SimulationParameters, cellMaxAge, "simulation parameters.cell.max age"),
+    PARAMETER_FIELD(SimulationParameters, cellMaxAgeBalancer, "simulation parameters.cell.max age.balance.enabled"),
+    PARAMETER_FIELD(SimulationParameters, cellMaxAgeBalancerInterval, "simulation parameters.cell.max age.balance.interval"),
+    PARAMETER_FIELD(SimulationParameters, baseValues.cellColorTransitionDuration, "simulation parameters.cell.color transition rules.duration"),
+    PARAMETER_FIELD(SimulationParameters, baseValues.cellColorTransitionTargetColor, "simulation parameters.cell.color transition rules.target color"),
+    PARAMETER_FIELD(SimulationParameters, genomeComplexityRamificationFactor, "simulation parameters.genome complexity.genome complexity ramification factor"),
+    PARAMETER_FIELD(SimulationParameters, genomeComplexitySizeFactor, "simulation parameters.genome complexity.genome complexity size factor"),
+    PARAMETER_FIELD(SimulationParameters, baseValues.radiationCellAgeStrength, "simulation parameters.radiation.factor"),
+    PARAMETER_FIELD(SimulationParameters, radiationProb, "simulation parameters.radiation.probability"),
+    PARAMETER_FIELD(SimulationParameters, radiationVelocityMultiplier, "simulation parameters.radiation.velocity multiplier"),
+    PARAMETER_FIELD(SimulationParameters, radiationVelocityPerturbation, "simulation parameters.radiation.velocity perturbation"),
+    PARAMETER_FIELD(SimulationParameters, baseValues.radiationAbsorption, "simulation parameters.radiation.absorption"),
+    PARAMETER_FIELD(SimulationParameters, radiationAbsorptionHighVelocityPenalty, "simulation parameters.radiation.absorption velocity penalty"),
+    PARAMETER_FIELD(SimulationParameters, baseValues.radiationAbsorptionLowVelocityPenalty, "simulation parameters.radiation.absorption low velocity penalty"),
+    PARAMETER_FIELD(SimulationParameters, radiationAbsorptionLowConnectionPenalty, "simulation parameters.radiation.absorption low connection penalty"),
+    PARAMETER_FIELD(
+        SimulationParameters,
+        baseValues.radiationAbsorptionLowGenomeComplexityPenalty,
+        "simulation parameters.radiation.absorption low genome complexity penalty"),
+    PARAMETER_FIELD(SimulationParameters, highRadiationMinCellEnergy, "simulation parameters.high radiation.min cell energy"),
+    PARAMETER_FIELD(SimulationParameters, highRadiationFactor, "simulation parameters.high radiation.factor"),
+    PARAMETER_FIELD(SimulationParameters, radiationMinCellAge, "simulation parameters.radiation.min cell age"),
+    PARAMETER_FIELD(SimulationParameters, externalEnergy, "simulation parameters.cell.function.constructor.external energy"),
+    PARAMETER_FIELD(SimulationParameters, externalEnergyInflowFactor, "simulation parameters.cell.function.constructor.external energy supply rate"),
+    PARAMETER_FIELD(SimulationParameters, externalEnergyConditionalInflowFactor, "simulation parameters.cell.function.constructor.pump energy factor"),
+    PARAMETER_FIELD(SimulationParameters, externalEnergyBackflowFactor, "simulation parameters.cell.function.constructor.external energy backflow"),
+    PARAMETER_FIELD(SimulationParameters, clusterDecay, "simulation parameters.cluster.decay"),
+    PARAMETER_FIELD(SimulationParameters, clusterDecayProb, "simulation parameters.cluster.decay probability"),
+    PARAMETER_FIELD(SimulationParameters, cellFunctionConstructorOffspringDistance, "simulation parameters.cell.function.constructor.offspring distance"),
+    PARAMETER_FIELD(
+        SimulationParameters, cellFunctionConstructorConnectingCellMaxDistance, "simulation parameters.cell.function.constructor.connecting cell max distance"),
+    PARAMETER_FIELD(SimulationParameters, cellFunctionConstructorActivityThreshold, "simulation parameters.cell.function.constructor.activity threshold"),
+    PARAMETER_FIELD(
+        SimulationParameters,
+        baseValues.cellFunctionConstructorMutationNeuronDataProbability,
+        "simulation parameters.cell.function.constructor.mutation probability.neuron data"),
+    PARAMETER_FIELD(
+        SimulationParameters,
+        baseValues.cellFunctionConstructorMutationPropertiesProbability,
+        "simulation parameters.cell.function.constructor.mutation probability.data"),
+    PARAMETER_FIELD(
+        SimulationParameters,
+        baseValues.cellFunctionConstructorMutationGeometryProbability,
+        "simulation parameters.cell.function.constructor.mutation probability.geometry"),
+    PARAMETER_FIELD(
+        SimulationParameters,
+        baseValues.cellFunctionConstructorMutationCustomGeometryProbability,
+        "simulation parameters.cell.function.constructor.mutation probability.custom geometry"),
+    PARAMETER_FIELD(
+        SimulationParameters,
+        baseValues.cellFunctionConstructorMutationCellFunctionProbability,
+        "simulation parameters.cell.function.constructor.mutation probability.cell function"),
+    PARAMETER_FIELD(
+        SimulationParameters,
+        baseValues.cellFunctionConstructorMutationInsertionProbability,
+        "simulation parameters.cell.function.constructor.mutation probability.insertion"),
+    PARAMETER_FIELD(
+        SimulationParameters,
+        baseValues.cellFunctionConstructorMutationDeletionProbability,
+        "simulation parameters.cell.function.constructor.mutation probability.deletion"),
+    PARAMETER_FIELD(
+        SimulationParameters,
+        baseValues.cellFunctionConstructorMutationTranslationProbability,
+        "simulation parameters.cell.function.constructor.mutation probability.translation"),
+    PARAMETER_FIELD(
+        SimulationParameters,
+        baseValues.cellFunctionConstructorMutationDuplicationProbability,
+        "simulation parameters.cell.function.constructor.mutation probability.duplication"),
+    PARAMETER_FIELD(
+        SimulationParameters,
+        baseValues.cellFunctionConstructorMutationCellColorProbability,
+        "simulation parameters.cell.function.constructor.mutation probability.cell color"),
+    PARAMETER_FIELD(
+        SimulationParameters,
+        baseValues.cellFunctionConstructorMutationSubgenomeColorProbability,
+        "simulation parameters.cell.function.constructor.mutation probability.color"),
+    PARAMETER_FIELD(
+        SimulationParameters,
+        baseValues.cellFunctionConstructorMutationGenomeColorProbability,
+        "simulation parameters.cell.function.constructor.mutation probability.uniform color"),
+    PARAMETER_FIELD(
+        SimulationParameters, cellFunctionConstructorMutationColorTransitions, "simulation parameters.cell.function.constructor.mutation color transition"),
+    PARAMETER_FIELD(
+        SimulationParameters, cellFunctionConstructorMutationSelfReplication, "simulation parameters.cell.function.constructor.mutation self replication"),
+    PARAMETER_FIELD(
+        SimulationParameters,
+        cellFunctionConstructorMutationPreventDepthIncrease,
+        "simulation parameters.cell.function.constructor.mutation prevent depth increase"),
+    PARAMETER_FIELD(
+        SimulationParameters,
+        cellFunctionConstructorCheckCompletenessForSelfReplication,
+        "simulation parameters.cell.function.constructor.completeness check for self-replication"),
+    PARAMETER_FIELD(SimulationParameters, cellFunctionInjectorRadius, "simulation parameters.cell.function.injector.radius"),
+    PARAMETER_FIELD(SimulationParameters, cellFunctionInjectorDurationColorMatrix, "simulation parameters.cell.function.injector.duration"),
+    PARAMETER_FIELD(SimulationParameters, cellFunctionAttackerRadius, "simulation parameters.cell.function.attacker.radius"),
+    PARAMETER_FIELD(SimulationParameters, cellFunctionAttackerStrength, "simulation parameters.cell.function.attacker.strength"),
+    PARAMETER_FIELD(
+        SimulationParameters, cellFunctionAttackerEnergyDistributionRadius, "simulation parameters.cell.function.attacker.energy distribution radius"),
+    PARAMETER_FIELD(
+        SimulationParameters, cellFunctionAttackerEnergyDistributionValue, "simulation parameters.cell.function.attacker.energy distribution value"),
+    PARAMETER_FIELD(
+        SimulationParameters, cellFunctionAttackerColorInhomogeneityFactor, "simulation parameters.cell.function.attacker.color inhomogeneity factor"),
+    PARAMETER_FIELD(SimulationParameters, cellFunctionAttackerActivityThreshold, "simulation parameters.cell.function.attacker.activity threshold"),
+    PARAMETER_FIELD(SimulationParameters, baseValues.cellFunctionAttackerEnergyCost, "simulation parameters.cell.function.attacker.energy cost"),
+    PARAMETER_FIELD(
+        SimulationParameters,
+        baseValues.cellFunctionAttackerGeometryDeviationExponent,
+        "simulation parameters.cell.function.attacker.geometry deviation exponent"),
+    PARAMETER_FIELD(
+        SimulationParameters, baseValues.cellFunctionAttackerFoodChainColorMatrix, "simulation parameters.cell.function.attacker.food chain color matrix"),
+    PARAMETER_FIELD(
+        SimulationParameters,
+        baseValues.cellFunctionAttackerConnectionsMismatchPenalty,
+        "simulation parameters.cell.function.attacker.connections mismatch penalty"),
+    PARAMETER_FIELD(
+        SimulationParameters, baseValues.cellFunctionAttackerGenomeComplexityBonus, "simulation parameters.cell.function.attacker.genome size bonus"),
+    PARAMETER_FIELD(SimulationParameters, cellFunctionAttackerSameMutantPenalty, "simulation parameters.cell.function.attacker.same mutant penalty"),
+    PARAMETER_FIELD(SimulationParameters, cellFunctionAttackerSensorDetectionFactor, "simulation parameters.cell.function.attacker.sensor detection factor"),
+    PARAMETER_FIELD(SimulationParameters, cellFunctionAttackerDestroyCells, "simulation parameters.cell.function.attacker.destroy cells"),
+    PARAMETER_FIELD(
+        SimulationParameters, cellFunctionDefenderAgainstAttackerStrength, "simulation parameters.cell.function.defender.against attacker strength"),
+    PARAMETER_FIELD(
+        SimulationParameters, cellFunctionDefenderAgainstInjectorStrength, "simulation parameters.cell.function.defender.against injector strength"),
+    PARAMETER_FIELD(
+        SimulationParameters,
+        cellFunctionTransmitterEnergyDistributionSameCreature,
+        "simulation parameters.cell.function.transmitter.energy distribution same creature"),
+    PARAMETER_FIELD(
+        SimulationParameters, cellFunctionTransmitterEnergyDistributionRadius, "simulation parameters.cell.function.transmitter.energy distribution radius"),
+    PARAMETER_FIELD(
+        SimulationParameters, cellFunctionTransmitterEnergyDistributionValue, "simulation parameters.cell.function.transmitter.energy distribution value"),
+    PARAMETER_FIELD(
+        SimulationParameters, cellFunctionMuscleContractionExpansionDelta, "simulation parameters.cell.function.muscle.contraction expansion delta"),
+    PARAMETER_FIELD(SimulationParameters, cellFunctionMuscleMovementAcceleration, "simulation parameters.cell.function.muscle.movement acceleration"),
+    PARAMETER_FIELD(SimulationParameters, cellFunctionMuscleBendingAngle, "simulation parameters.cell.function.muscle.bending angle"),
+    PARAMETER_FIELD(SimulationParameters, cellFunctionMuscleBendingAcceleration, "simulation parameters.cell.function.muscle.bending acceleration"),
+    PARAMETER_FIELD(
+        SimulationParameters, cellFunctionMuscleBendingAccelerationThreshold, "simulation parameters.cell.function.muscle.bending acceleration threshold"),
+    PARAMETER_FIELD(SimulationParameters, particleTransformationAllowed, "simulation parameters.particle.transformation allowed"),
+    PARAMETER_FIELD(SimulationParameters, particleTransformationRandomCellFunction, "simulation parameters.particle.transformation.random cell function"),
+    PARAMETER_FIELD(SimulationParameters, particleTransformationMaxGenomeSize, "simulation parameters.particle.transformation.max genome size"),
+    PARAMETER_FIELD(SimulationParameters, particleSplitEnergy, "simulation parameters.particle.split energy"),
+    PARAMETER_FIELD(SimulationParameters, cellFunctionSensorRange, "simulation parameters.cell.function.sensor.range"),
+    PARAMETER_FIELD(SimulationParameters, cellFunctionSensorActivityThreshold, "simulation parameters.cell.function.sensor.activity threshold"),
+    PARAMETER_FIELD(SimulationParameters, cellFunctionReconnectorRadius, "simulation parameters.cell.function.reconnector.radius"),
+    PARAMETER_FIELD(SimulationParameters, cellFunctionReconnectorActivityThreshold, "simulation parameters.cell.function.reconnector.activity threshold"),
+    PARAMETER_FIELD(SimulationParameters, cellFunctionDetonatorRadius, "simulation parameters.cell.function.detonator.radius"),
+    PARAMETER_FIELD(
+        SimulationParameters, cellFunctionDetonatorChainExplosionProbability, "simulation parameters.cell.function.detonator.chain explosion probability"),
+    PARAMETER_FIELD(SimulationParameters, cellFunctionDetonatorActivityThreshold, "simulation parameters.cell.function.detonator.activity threshold"),
+    PARAMETER_FIELD(SimulationParameters, numParticleSources, "simulation parameters.particle sources.num sources"),
+    PARAMETER_ARRAY_FIELD(particleSources, "simulation parameters.particle sources", ParameterFieldType_ParticleSources),
+    PARAMETER_FIELD(SimulationParameters, numSpots, "simulation parameters.spots.num spots"),
+    PARAMETER_ARRAY_FIELD(spots, "simulation parameters.spots", ParameterFieldType_Spots),
+    PARAMETER_FIELD(SimulationParameters, features.genomeComplexityMeasurement, "simulation parameters.features.genome complexity measurement"),
+    PARAMETER_FIELD(SimulationParameters, features.advancedAbsorptionControl, "simulation parameters.features.additional absorption control"),
+    PARAMETER_FIELD(SimulationParameters, features.advancedAttackerControl, "simulation parameters.features.additional attacker control"),
+    PARAMETER_FIELD(SimulationParameters, features.externalEnergyControl, "simulation parameters.features.external energy"),
+    PARAMETER_FIELD(SimulationParameters, features.cellColorTransitionRules, "simulation parameters.features.cell color transition rules"),
+};
+
+#undef PARAMETER_FIELD
+#undef CONDITIONAL_PARAMETER_FIELD
+#undef PARAMETER_ARRAY_FIELD
+#undef SPOT_VALUE_FIELD
@@ -0,0 +1,358 @@
+#include "PatternAnalysisService.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "Base/LoggingService.h"
+#include "Base/ParallelExecution.h"
+
+#include "SerializerService.h"
+
+namespace
+{
+    //invariant of a cluster under cell permutations, equal forms are necessary but not sufficient for structural equality
+    struct CanonicalForm
+    {
+        uint64_t hash = 0;
+        std::vector<uint64_t> cellLabels;  //sorted
+        std::vector<std::pair<uint64_t, uint64_t>> connectionLabels;  //sorted
+
+        std::vector<uint64_t> labelByCellIndex;  //stable labels after refinement
+        std::vector<std::vector<int>> connectedCellIndices;
+
+        bool isEquivalent(CanonicalForm const& other) const
+        {
+            return hash == other.hash && cellLabels == other.cellLabels && connectionLabels == other.connectionLabels;
+        }
+    };
+
+    //finalizer of splitmix64
+    uint64_t mix(uint64_t value)
+    {
+        value ^= value >> 30;
+        value *= 0xbf58476d1ce4e5b9ull;
+        value ^= value >> 27;
+        value *= 0x94d049bb133111ebull;
+        value ^= value >> 31;
+        return value;
+    }
+
+    uint64_t combine(uint64_t hash, uint64_t value)
+    {
+        return mix(hash ^ (value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2)));
+    }
+
+    uint64_t calcCellLabel(CellDescription const& cell)
+    {
+        uint64_t result = 0;
+        result = combine(result, cell.maxConnections);
+        result = combine(result, cell.connections.size());
+        result = combine(result, cell.livingState);
+        result = combine(result, cell.inputExecutionOrderNumber.has_value() ? *cell.inputExecutionOrderNumber + 1 : 0);
+        result = combine(result, cell.outputBlocked ? 1 : 0);
+        result = combine(result, cell.executionOrderNumber);
+        result = combine(result, cell.color);
+        result = combine(result, cell.getCellFunctionType());
+        return result;
+    }
+
+    bool hasEqualAttributes(CellDescription const& cell1, CellDescription const& cell2)
+    {
+        return cell1.maxConnections == cell2.maxConnections && cell1.connections.size() == cell2.connections.size()
+            && cell1.livingState == cell2.livingState && cell1.inputExecutionOrderNumber == cell2.inputExecutionOrderNumber
+            && cell1.outputBlocked == cell2.outputBlocked && cell1.executionOrderNumber == cell2.executionOrderNumber && cell1.color == cell2.color
+            && cell1.getCellFunctionType() == cell2.getCellFunctionType();
+    }
+
+    size_t calcNumDistinctLabels(std::vector<uint64_t> const& labels)
+    {
+        return std::unordered_set<uint64_t>(labels.begin(), labels.end()).size();
+    }
+
+    CanonicalForm calcCanonicalForm(ClusterDescription const& cluster)
+    {
+        auto numCells = cluster.cells.size();
+
+        std::unordered_map<uint64_t, int> cellIndexById;
+        cellIndexById.reserve(numCells);
+        for (size_t i = 0; i < numCells; ++i) {
+            cellIndexById.emplace(cluster.cells[i].id, toInt(i));
+        }
+        std::vector<std::vector<int>> connectedCellIndices(numCells);
+        for (size_t i = 0; i < numCells; ++i) {
+            for (auto const& connection : cluster.cells[i].connections) {
+                auto findResult = cellIndexById.find(connection.cellId);
+                if (findResult != cellIndexById.end()) {
+                    connectedCellIndices[i].emplace_back(findResult->second);
+                }
+            }
+        }
+
+        //Weisfeiler-Lehman refinement until the partition of the cells is stable: a refinement step only splits classes of equally labeled cells,
+        //hence the partition is unchanged iff the number of distinct labels is unchanged, and a partition into single cells cannot be refined further
+        std::vector<uint64_t> labels(numCells);
+        for (size_t i = 0; i < numCells; ++i) {
+            labels[i] = calcCellLabel(cluster.cells[i]);
+        }
+        auto numDistinctLabels = calcNumDistinctLabels(labels);
+        std::vector<uint64_t> newLabels(numCells);
+        std::vector<uint64_t> connectedLabels;
+        for (size_t iteration = 0; iteration < numCells && numDistinctLabels < numCells; ++iteration) {
+            for (size_t i = 0; i < numCells; ++i) {
+                connectedLabels.clear();
+                for (auto const& connectedCellIndex : connectedCellIndices[i]) {
+                    connectedLabels.emplace_back(labels[connectedCellIndex]);
+                }
+                std::sort(connectedLabels.begin(), connectedLabels.end());
+
+                auto label = combine(0, labels[i]);
+                for (auto const& connectedLabel : connectedLabels) {
+                    label = combine(label, connectedLabel);
+                }
+                newLabels[i] = label;
+            }
+            auto newNumDistinctLabels = calcNumDistinctLabels(newLabels);
+            if (newNumDistinctLabels == numDistinctLabels) {
+                break;
+            }
+            labels.swap(newLabels);
+            numDistinctLabels = newNumDistinctLabels;
+        }
+
+        CanonicalForm result;
+        for (size_t i = 0; i < numCells; ++i) {
+            for (auto const& connectedCellIndex : connectedCellIndices[i]) {
+                result.connectionLabels.emplace_back(labels[i], labels[connectedCellIndex]);
+            }
+        }
+        std::sort(result.connectionLabels.begin(), result.connectionLabels.end());
+        result.cellLabels = labels;
+        std::sort(result.cellLabels.begin(), result.cellLabels.end());
+        result.labelByCellIndex = std::move(labels);
+        result.connectedCellIndices = std::move(connectedCellIndices);
+
+        result.hash = combine(0, numCells);
+        for (auto const& label : result.cellLabels) {
+            result.hash = combine(result.hash, label);
+        }
+        result.hash = combine(result.hash, result.connectionLabels.size());
+        return result;
+    }
+
+    //searches a bijection between the cells which preserves the cell attributes and the connections (including their multiplicity)
+    //by backtracking, where candidates are restricted to cells with the same refined label and to the connected cells of mapped cells
+    //returns std::nullopt if the search has been aborted after too many steps
+    std::optional<bool> isIsomorphic(ClusterDescription const& cluster1, CanonicalForm const& form1, ClusterDescription const& cluster2, CanonicalForm const& form2)
+    {
+        if (!form1.isEquivalent(form2)) {
+            return false;
+        }
+        auto numCells = toInt(cluster1.cells.size());
+        auto const& connected1 = form1.connectedCellIndices;
+        auto const& connected2 = form2.connectedCellIndices;
+
+        std::unordered_map<uint64_t, std::vector<int>> cellIndicesByLabel2;
+        for (int i = 0; i < numCells; ++i) {
+            cellIndicesByLabel2[form2.labelByCellIndex[i]].emplace_back(i);
+        }
+
+        //cells of cluster1 in breadth-first order such that connected cells of mapped cells come next
+        std::vector<int> order;
+        std::vector<int> parent(numCells, -1);  //mapped cell connected to the cell, restricts its candidates
+        order.reserve(numCells);
+        std::vector<bool> visited(numCells, false);
+        for (int start = 0; start < numCells; ++start) {
+            if (visited[start]) {
+                continue;
+            }
+            visited[start] = true;
+            order.emplace_back(start);
+            for (size_t i = order.size() - 1; i < order.size(); ++i) {
+                for (auto const& connectedIndex : connected1[order[i]]) {
+                    if (!visited[connectedIndex]) {
+                        visited[connectedIndex] = true;
+                        parent[connectedIndex] = order[i];
+                        order.emplace_back(connectedIndex);
+                    }
+                }
+            }
+        }
+
+        std::vector<int> mapping1to2(numCells, -1);
+        std::vector<int> mapping2to1(numCells, -1);
+        std::vector<int> images1;
+        std::vector<int> images2;
+        auto isConsistent = [&](int index1, int index2) {
+            if (form1.labelByCellIndex[index1] != form2.labelByCellIndex[index2] || !hasEqualAttributes(cluster1.cells[index1], cluster2.cells[index2])) {
+                return false;
+            }
+            //the connections to mapped cells must correspond in both directions
+            images1.clear();
+            for (auto const& connectedIndex : connected1[index1]) {
+                if (mapping1to2[connectedIndex] != -1) {
+                    images1.emplace_back(mapping1to2[connectedIndex]);
+                }
+            }
+            images2.clear();
+            for (auto const& connectedIndex : connected2[index2]) {
+                if (mapping2to1[connectedIndex] != -1) {
+                    images2.emplace_back(connectedIndex);
+                }
+            }
+            std::sort(images1.begin(), images1.end());
+            std::sort(images2.begin(), images2.end());
+            return images1 == images2;
+        };
+
+        //iterative search since clusters can be large, the number of steps is bounded for pathological symmetric cases
+        std::vector<std::vector<int> const*> candidates(numCells);
+        std::vector<size_t> candidatePos(numCells, 0);
+        auto maxSteps = static_cast<uint64_t>(numCells) * 1000 + 100000;
+        uint64_t numSteps = 0;
+        int level = 0;
+        if (numCells > 0) {
+            auto index1 = order[0];
+            candidates[0] = &cellIndicesByLabel2[form1.labelByCellIndex[index1]];
+        }
+        while (level >= 0 && level < numCells) {
+            if (++numSteps > maxSteps) {
+                return std::nullopt;
+            }
+            auto index1 = order[level];
+            if (mapping1to2[index1] != -1) {
+                mapping2to1[mapping1to2[index1]] = -1;
+                mapping1to2[index1] = -1;
+            }
+            auto const& levelCandidates = *candidates[level];
+            auto& pos = candidatePos[level];
+            while (pos < levelCandidates.size() && (mapping2to1[levelCandidates[pos]] != -1 || !isConsistent(index1, levelCandidates[pos]))) {
+                ++pos;
+            }
+            if (pos == levelCandidates.size()) {
+                pos = 0;
+                --level;
+                continue;
+            }
+            auto index2 = levelCandidates[pos++];
+            mapping1to2[index1] = index2;
+            mapping2to1[index2] = index1;
+            if (++level < numCells) {
+                auto nextIndex1 = order[level];
+                candidatePos[level] = 0;
+                candidates[level] = parent[nextIndex1] != -1 ? &connected2[mapping1to2[parent[nextIndex1]]]
+                                                             : &cellIndicesByLabel2[form1.labelByCellIndex[nextIndex1]];
+            }
+        }
+        return level == numCells;
+    }
+
+    //clusters with an aborted isomorphism search are compared by their canonical forms, i.e. by the refined cell labels and connection labels
+    bool isIsomorphicOrEquivalent(
+        ClusterDescription const& cluster1,
+        CanonicalForm const& form1,
+        ClusterDescription const& cluster2,
+        CanonicalForm const& form2,
+        int& numAbortedComparisons)
+    {
+        auto result = isIsomorphic(cluster1, form1, cluster2, form2);
+        if (!result.has_value()) {
+            ++numAbortedComparisons;
+            return form1.isEquivalent(form2);
+        }
+        return *result;
+    }
+
+    void logAbortedComparisons(int numAbortedComparisons)
+    {
+        if (numAbortedComparisons > 0) {
+            log(Priority::Important,
+                "pattern analysis: isomorphism check aborted for " + std::to_string(numAbortedComparisons)
+                    + " pair(s) of clusters, they are compared by their canonical forms instead");
+        }
+    }
+}
+
+std::vector<PatternClass> PatternAnalysisService::calcRepetitivePatterns(ClusteredDataDescription const& data, int maxThreads)
+{
+    auto numClusters = data.clusters.size();
+    std::vector<CanonicalForm> canonicalForms(numClusters);
+    ParallelExecution::forEach(numClusters, [&](size_t index) { canonicalForms[index] = calcCanonicalForm(data.clusters[index]); }, maxThreads);
+
+    //classes are identified by the index of their first cluster, clusters with equal hash are checked for isomorphism
+    struct ClassData
+    {
+        size_t representantIndex = 0;
+        int numberOfElements = 0;
+    };
+    std::vector<ClassData> classes;
+    std::unordered_map<uint64_t, std::vector<size_t>> classIndicesByHash;
+    auto numAbortedComparisons = 0;
+    for (size_t index = 0; index < numClusters; ++index) {
+        auto& classIndices = classIndicesByHash[canonicalForms[index].hash];
+        auto findResult = std::find_if(classIndices.begin(), classIndices.end(), [&](auto const& classIndex) {
+            auto representantIndex = classes[classIndex].representantIndex;
+            return isIsomorphicOrEquivalent(
+                data.clusters[representantIndex], canonicalForms[representantIndex], data.clusters[index], canonicalForms[index], numAbortedComparisons);
+        });
+        if (findResult != classIndices.end()) {
+            ++classes[*findResult].numberOfElements;
+        } else {
+            classIndices.emplace_back(classes.size());
+            classes.emplace_back(ClassData{index, 1});
+        }
+    }
+    logAbortedComparisons(numAbortedComparisons);
+
+    std::erase_if(classes, [](auto const& classData) { return classData.numberOfElements <= 1; });
+    std::stable_sort(classes.begin(), classes.end(), [](auto const& left, auto const& right) { return left.numberOfElements > right.numberOfElements; });
+
+    std::vector<PatternClass> result;
+    result.reserve(classes.size());
+    for (auto const& classData : classes) {
+        result.emplace_back(PatternClass{classData.numberOfElements, data.clusters[classData.representantIndex]});
+    }
+    return result;
+}
+
+bool PatternAnalysisService::isStructurallyEqual(ClusterDescription const& cluster1, ClusterDescription const& cluster2)
+{
+    auto numAbortedComparisons = 0;
+    auto result = isIsomorphicOrEquivalent(cluster1, calcCanonicalForm(cluster1), cluster2, calcCanonicalForm(cluster2), numAbortedComparisons);
+    logAbortedComparisons(numAbortedComparisons);
+    return result;
+}
+
+bool PatternAnalysisService::savePatternsToFiles(std::string const& summaryFilename, std::vector<PatternClass> const& patterns)
+{
+    std::ofstream file;
+    file.open(summaryFilename, std::ios_base::out);
+    if (!file) {
+        return false;
+    }
+
+    file << "number of repetitive active cell networks: " << patterns.size() << std::endl << std::endl;
+    for (size_t i = 0; i < patterns.size(); ++i) {
+        auto const& pattern = patterns[i];
+        auto index = i + 1;
+        file << "cell network " << index << ": " << pattern.numberOfElements << " exemplars" << std::endl;
+
+        std::stringstream clusterNameStream;
+        clusterNameStream << "cell network" << std::setfill('0') << std::setw(6) << index << ".sim";
+
+        std::filesystem::path clusterFilename(summaryFilename);
+        clusterFilename.remove_filename();
+        clusterFilename /= clusterNameStream.str();
+
+        ClusteredDataDescription patternData;
+        patternData.clusters = std::vector<ClusterDescription>{pattern.representant};
+        if (!SerializerService::serializeContentToFile(clusterFilename.string(), patternData)) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Base/Definitions.h"
+#include "Descriptions.h"
+
+struct PatternClass
+{
+    int numberOfElements = 0;
+    ClusterDescription representant;
+};
+
+/**
+ * Detects structurally identical cell networks. Each cluster is mapped to a canonical form which is obtained by
+ * Weisfeiler-Lehman refinement of cell labels (cell attributes) along the connections. Clusters are bucketed by the
+ * hash of their canonical form and clusters within the same bucket are checked for isomorphism, i.e. for a bijection
+ * between their cells which preserves the cell attributes and the connections. The isomorphism search is bounded; if it is
+ * aborted (only for highly symmetric clusters), the clusters are regarded as equal iff their canonical forms are equal and a
+ * message is logged.
+ */
+class PatternAnalysisService
+{
+public:
+    //returns the pattern classes with more than one element in descending order of the number of elements
+    static std::vector<PatternClass> calcRepetitivePatterns(ClusteredDataDescription const& data, int maxThreads = 0);
+
+    static bool isStructurallyEqual(ClusterDescription const& cluster1, ClusterDescription const& cluster2);
+
+    //writes a summary and the representants of the pattern classes into the directory of summaryFilename
+    static bool savePatternsToFiles(std::string const& summaryFilename, std::vector<PatternClass> const& patterns);
+};
@@ -1,10 +1,15 @@
 #include "PreviewDescriptionService.h"
 
+#include <mutex>
+#include <ranges>
+#include <unordered_map>
+
 #include <boost/range/combine.hpp>
 #include <boost/range/adaptor/indexed.hpp>
 
 #include "GenomeConstants.h"
 #include "ShapeGenerator.h"
+#include "Base/Hashes.h"
 #include "Base/Math.h"
 #include "EngineInterface/GenomeDescriptionService.h"
 
@@ -34,18 +39,13 @@ namespace
         std::vector<SymbolPreviewDescription> symbols;
     };
 
-    void insert(PreviewDescriptionIntern& target, PreviewDescriptionIntern const& source)
+    std::set<int> shiftIndices(std::set<int> const& indices, int offset)
     {
-        auto offset = toInt(source.cells.size());
-        for (auto& cell : target.cells) {
-            std::set<int> newConnectionIndices;
-            for (auto const& connectionIndex : cell.connectionIndices) {
-                newConnectionIndices.insert(connectionIndex + offset);
-            }
-            cell.connectionIndices = newConnectionIndices;
+        std::set<int> result;
+        for (auto const& index : indices) {
+            result.insert(result.end(), index + offset);
         }
-        target.cells.insert(target.cells.begin(), source.cells.begin(), source.cells.end());
-        target.symbols.insert(target.symbols.begin(), source.symbols.begin(), source.symbols.end());
+        return result;
     }
 
     void rotate(PreviewDescriptionIntern& previewIntern, RealVector2D const& center, float angle)
@@ -112,9 +112,7 @@ namespace
     };
     ProcessedGenomeDescriptionResult processPrincipalPartOfGenomeDescription(
         GenomeDescription const& genome,
-        std::optional<int> const& uniformNodeIndex,
-        std::optional<float> const& lastReferenceAngle,
-        SimulationParameters const& parameters)
+        std::optional<float> const& lastReferenceAngle)
     {
         auto constexpr uniformConnectingCellMaxyDistance = 1.6f;
 
@@ -178,7 +176,7 @@ namespace
                 cellIntern.inputExecutionOrderNumber = node.inputExecutionOrderNumber;
                 cellIntern.outputBlocked = node.outputBlocked;
                 cellIntern.executionOrderNumber = node.executionOrderNumber;
-                cellIntern.nodeIndex = uniformNodeIndex ? *uniformNodeIndex : partIndex;
+                cellIntern.nodeIndex = partIndex;
                 cellIntern.pos = pos;
                 if (index > 0) {
                     cellIntern.connectionIndices.insert(index - 1);
@@ -243,49 +241,188 @@ namespace
         return result;
     }
 
-    PreviewDescriptionIntern convertToPreviewDescriptionIntern(
-        GenomeDescription const& genome,
-        std::optional<int> const& uniformNodeIndex,
-        std::optional<float> const& lastReferenceAngle,
-        std::optional<RealVector2D> const& desiredEndPos,
-        std::optional<float> const& desiredEndAngle,
-        SimulationParameters const& parameters)
+    //untransformed layout of a genome including the layouts of its subgenomes
+    struct PreviewLayout
     {
-        if (genome.cells.empty()) {
-            return {};
+        PreviewDescriptionIntern previewDescription;
+        RealVector2D direction;
+        bool separateConstruction = true;
+        int numBranches = 1;
+    };
+    using PreviewLayoutPtr = std::shared_ptr<PreviewLayout const>;
+
+    //layouts of subgenomes are cached by their byte encoding and last reference angle, whole previews by their genome
+    struct PreviewCache
+    {
+        static auto constexpr MaxCachedCells = 200000;
+        static auto constexpr MaxCachedPreviews = 8;
+
+        struct CachedLayout
+        {
+            PreviewLayoutPtr layout;
+            uint64_t lastUsed = 0;
+        };
+        std::unordered_map<std::pair<std::string, float>, CachedLayout> layouts;
+        int numCachedCells = 0;
+
+        struct CachedPreview
+        {
+            GenomeDescription genome;
+            PreviewDescription preview;
+            uint64_t lastUsed = 0;
+        };
+        std::vector<CachedPreview> previews;
+
+        uint64_t pass = 0;
+        std::mutex mutex;
+    };
+
+    PreviewCache& getCache()
+    {
+        static PreviewCache cache;
+        return cache;
+    }
+
+    //removes the least recently used layouts which are not needed for the current pass
+    void evictLayouts(PreviewCache& cache)
+    {
+        if (cache.numCachedCells <= PreviewCache::MaxCachedCells) {
+            return;
+        }
+        std::vector<std::pair<uint64_t, std::pair<std::string, float>>> lastUsedAndKeys;
+        for (auto const& [key, cachedLayout] : cache.layouts) {
+            if (cachedLayout.lastUsed != cache.pass) {
+                lastUsedAndKeys.emplace_back(cachedLayout.lastUsed, key);
+            }
+        }
+        std::ranges::sort(lastUsedAndKeys, [](auto const& element1, auto const& element2) { return element1.first < element2.first; });
+        for (auto const& [lastUsed, key] : lastUsedAndKeys) {
+            if (cache.numCachedCells <= PreviewCache::MaxCachedCells / 2) {
+                break;
+            }
+            auto findResult = cache.layouts.find(key);
+            cache.numCachedCells -= toInt(findResult->second.layout->previewDescription.cells.size());
+            cache.layouts.erase(findResult);
+        }
+    }
+
+    PreviewLayout createLayout(GenomeDescription const& genome, std::optional<float> const& lastReferenceAngle, PreviewCache& cache);
+
+    PreviewLayoutPtr getOrCreateLayout(std::vector<uint8_t> const& data, float lastReferenceAngle, PreviewCache& cache)
+    {
+        auto key = std::make_pair(std::string(data.begin(), data.end()), lastReferenceAngle);
+        auto findResult = cache.layouts.find(key);
+        if (findResult != cache.layouts.end()) {
+            findResult->second.lastUsed = cache.pass;
+            return findResult->second.layout;
+        }
+        auto layout = std::make_shared<PreviewLayout const>(createLayout(GenomeDescriptionService::convertBytesToDescription(data), lastReferenceAngle, cache));
+        cache.numCachedCells += toInt(layout->previewDescription.cells.size());
+        cache.layouts.emplace(std::move(key), PreviewCache::CachedLayout{layout, cache.pass});
+        return layout;
+    }
+
+    //moves the layout such that its last cell is placed at endPos with the given end angle
+    PreviewDescriptionIntern transformLayout(PreviewLayout const& layout, int nodeIndex, RealVector2D const& endPos, float endAngle)
+    {
+        auto result = layout.previewDescription;
+        for (auto& cell : result.cells) {
+            cell.nodeIndex = nodeIndex;
+        }
+        auto actualEndAngle = Math::angleOfVector(layout.direction);
+        auto angleDiff = Math::subtractAngle(endAngle, actualEndAngle);
+        rotate(result, result.cells.back().pos, angleDiff + 180.0f);
+        translate(result, endPos - result.cells.back().pos);
+        return result;
+    }
+
+    struct SubPreview
+    {
+        PreviewDescriptionIntern previewDescription;
+        int constructorIndex = 0;
+        bool connectedToConstructor = false;
+    };
+
+    //places the sub previews in reverse order in front of the cells of the principal part
+    PreviewDescriptionIntern assemble(PreviewDescriptionIntern& principalPart, std::vector<SubPreview>& subPreviews)
+    {
+        auto numSubPreviewCells = 0;
+        for (auto const& subPreview : subPreviews) {
+            numSubPreviewCells += toInt(subPreview.previewDescription.cells.size());
+        }
+
+        PreviewDescriptionIntern result;
+        result.cells.reserve(numSubPreviewCells + principalPart.cells.size());
+        std::vector<std::pair<int, int>> connectionsToConstructors;
+        for (auto& subPreview : subPreviews | std::views::reverse) {
+            auto offset = toInt(result.cells.size());
+            for (auto& cell : subPreview.previewDescription.cells) {
+                cell.connectionIndices = shiftIndices(cell.connectionIndices, offset);
+                result.cells.emplace_back(std::move(cell));
+            }
+            result.symbols.insert(result.symbols.end(), subPreview.previewDescription.symbols.begin(), subPreview.previewDescription.symbols.end());
+            if (subPreview.connectedToConstructor) {
+                auto constructorIndex = numSubPreviewCells + subPreview.constructorIndex;
+                result.cells.back().connectionIndices.insert(constructorIndex);
+                connectionsToConstructors.emplace_back(constructorIndex, toInt(result.cells.size()) - 1);
+            }
+        }
+        for (auto& cell : principalPart.cells) {
+            cell.connectionIndices = shiftIndices(cell.connectionIndices, numSubPreviewCells);
+            result.cells.emplace_back(std::move(cell));
         }
+        result.symbols.insert(result.symbols.end(), principalPart.symbols.begin(), principalPart.symbols.end());
+        for (auto const& [constructorIndex, cellIndex] : connectionsToConstructors) {
+            result.cells.at(constructorIndex).connectionIndices.insert(cellIndex);
+        }
+        return result;
+    }
 
-        ProcessedGenomeDescriptionResult processedGenome = processPrincipalPartOfGenomeDescription(genome, uniformNodeIndex, lastReferenceAngle, parameters);
+    PreviewLayout createLayout(GenomeDescription const& genome, std::optional<float> const& lastReferenceAngle, PreviewCache& cache)
+    {
+        PreviewLayout result;
+        result.separateConstruction = genome.header.separateConstruction;
+        result.numBranches = genome.header.numBranches;
+        if (genome.cells.empty()) {
+            return result;
+        }
 
-        PreviewDescriptionIntern result = processedGenome.previewDescription;
+        ProcessedGenomeDescriptionResult processedGenome = processPrincipalPartOfGenomeDescription(genome, lastReferenceAngle);
+        result.direction = processedGenome.direction;
+        auto& principalPart = processedGenome.previewDescription;
 
         //process sub genomes
-        size_t indexOffset = 0;
+        std::vector<SubPreview> subPreviews;
         int index = 0;
         auto hasInfiniteRepetitions = genome.header.numRepetitions == std::numeric_limits<int>::max();
         auto numRepetitionsTruncated = hasInfiniteRepetitions ? 1 : std::min(MaxRepetitions, genome.header.numRepetitions);
         for (auto repetition = 0; repetition < numRepetitionsTruncated; ++repetition) {
             for (auto const& node : genome.cells) {
-                auto cellIntern = processedGenome.previewDescription.cells.at(index);
+                auto& cellIntern = principalPart.cells.at(index);
 
                 if (node.getCellFunctionType() == CellFunction_Constructor) {
                     auto const& constructor = std::get<ConstructorGenomeDescription>(*node.cellFunction);
                     if (constructor.isMakeGenomeCopy()) {
-                        result.cells.at(index + indexOffset).selfReplicator = true;
+                        cellIntern.selfReplicator = true;
                         ++index;
                         continue;
                     }
-                    auto data = constructor.getGenomeData();
+                    auto const& data = std::get<std::vector<uint8_t>>(constructor.genome);
                     if (data.size() <= Const::GenomeHeaderSize) {
                         ++index;
                         continue;
                     }
+                    auto subLayout = getOrCreateLayout(data, constructor.constructionAngle2, cache);
+                    if (subLayout->previewDescription.cells.empty()) {
+                        ++index;
+                        continue;
+                    }
 
                     //angles of connected cells
                     std::vector<float> angles;
                     auto epsilon = 0.0f;
                     for (auto const& connectedCellIndex : cellIntern.connectionIndices) {
-                        auto connectedCellIntern = processedGenome.previewDescription.cells.at(connectedCellIndex);
+                        auto const& connectedCellIntern = principalPart.cells.at(connectedCellIndex);
                         angles.emplace_back(Math::angleOfVector(connectedCellIntern.pos - cellIntern.pos) + epsilon);
                         epsilon += NEAR_ZERO;   //workaround to obtain deterministic results if two angles are the same
                     }
@@ -313,35 +450,18 @@ namespace
                     }
                     targetAngle += constructor.constructionAngle1;
                     auto direction = Math::unitVectorOfAngle(targetAngle);
-                    auto subGenome = GenomeDescriptionService::convertBytesToDescription(data);
-                    auto previewPart = convertToPreviewDescriptionIntern(
-                        subGenome, cellIntern.nodeIndex, constructor.constructionAngle2, cellIntern.pos + direction, targetAngle, parameters);
-                    insert(result, previewPart);
-                    indexOffset += previewPart.cells.size();
-
-                    auto cellIndex1 = previewPart.cells.size() - 1;
-                    auto cellIndex2 = index + indexOffset;
-                    if (!subGenome.header.separateConstruction) {
-                        result.cells.at(cellIndex1).connectionIndices.insert(toInt(cellIndex2));
-                        result.cells.at(cellIndex2).connectionIndices.insert(toInt(cellIndex1));
-                    }
-                    if (subGenome.header.numBranches != 1) {
-                        result.cells.at(cellIndex2).multipleConstructor = true;
+                    subPreviews.emplace_back(SubPreview{
+                        .previewDescription = transformLayout(*subLayout, cellIntern.nodeIndex, cellIntern.pos + direction, targetAngle),
+                        .constructorIndex = index,
+                        .connectedToConstructor = !subLayout->separateConstruction});
+                    if (subLayout->numBranches != 1) {
+                        cellIntern.multipleConstructor = true;
                     }
                 }
                 ++index;
             }
         }
-
-        //transform to desired position and angle
-        if (desiredEndAngle) {
-            auto actualEndAngle = Math::angleOfVector(processedGenome.direction);
-            auto angleDiff = Math::subtractAngle(*desiredEndAngle, actualEndAngle);
-            rotate(result, result.cells.back().pos, angleDiff + 180.0f);
-        }
-        if (desiredEndPos) {
-            translate(result, *desiredEndPos - result.cells.back().pos);
-        }
+        result.previewDescription = assemble(principalPart, subPreviews);
         return result;
     }
 
@@ -387,9 +507,35 @@ namespace
     }
 }
 
-PreviewDescription
-PreviewDescriptionService::convert(GenomeDescription const& genome, std::optional<int> selectedNode, SimulationParameters const& parameters)
+PreviewDescription PreviewDescriptionService::convert(GenomeDescription const& genome, SimulationParameters const& parameters)
+{
+    auto& cache = getCache();
+    std::lock_guard lock(cache.mutex);
+    ++cache.pass;
+
+    auto findResult = std::ranges::find_if(cache.previews, [&](auto const& cachedPreview) { return cachedPreview.genome == genome; });
+    if (findResult != cache.previews.end()) {
+        findResult->lastUsed = cache.pass;
+        return findResult->preview;
+    }
+
+    auto layout = createLayout(genome, std::nullopt, cache);
+    auto preview = createPreviewDescription(layout.previewDescription, parameters);
+    evictLayouts(cache);
+
+    if (toInt(cache.previews.size()) >= PreviewCache::MaxCachedPreviews) {
+        auto leastRecentlyUsed = std::ranges::min_element(cache.previews, {}, [](auto const& cachedPreview) { return cachedPreview.lastUsed; });
+        cache.previews.erase(leastRecentlyUsed);
+    }
+    cache.previews.emplace_back(PreviewCache::CachedPreview{genome, preview, cache.pass});
+    return preview;
+}
+
+void PreviewDescriptionService::clearCache()
 {
-    auto cellInternDescriptions = convertToPreviewDescriptionIntern(genome, std::nullopt, std::nullopt, std::nullopt, std::nullopt, parameters);
-    return createPreviewDescription(cellInternDescriptions, parameters);
+    auto& cache = getCache();
+    std::lock_guard lock(cache.mutex);
+    cache.layouts.clear();
+    cache.numCachedCells = 0;
+    cache.previews.clear();
 }
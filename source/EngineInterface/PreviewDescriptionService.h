@@ -8,6 +8,8 @@
 class PreviewDescriptionService
 {
 public:
-    static PreviewDescription convert(GenomeDescription const& genome, std::optional<int> selectedNode, SimulationParameters const& parameters);
+    //results and layouts of subgenomes are cached such that only changed parts of a genome are laid out again
+    static PreviewDescription convert(GenomeDescription const& genome, SimulationParameters const& parameters);
+    static void clearCache();
 };
 
@@ -1,6 +1,8 @@
 #include "SerializerService.h"
 
+#include <algorithm>
 #include <sstream>
+#include <iterator>
 #include <stdexcept>
 #include <filesystem>
 
@@ -14,7 +16,7 @@
 #include <cereal/types/vector.hpp>
 #include <cereal/types/variant.hpp>
 #include <boost/algorithm/string/split.hpp>
-#include <boost/property_tree/json_parser.hpp>
+#include <boost/interprocess/streams/bufferstream.hpp>
 #include <boost/range/adaptors.hpp>
 #include <zstr.hpp>
 
@@ -25,6 +27,8 @@
 #include "Descriptions.h"
 #include "SimulationParameters.h"
 #include "AuxiliaryDataParserService.h"
+#include "BlockCompressionService.h"
+#include "ColumnarSerializerService.h"
 #include "GenomeConstants.h"
 #include "GenomeDescriptions.h"
 #include "GenomeDescriptionService.h"
@@ -206,6 +210,30 @@ namespace cereal
         }
     }
 
+    //stored as nested vectors for compatibility with files of older versions
+    template <class Archive>
+    void loadSaveWeightsAndBiases(SerializationTask task, Archive& ar, NeuronWeights& weights, NeuronBiases& biases)
+    {
+        std::vector<std::vector<float>> weightsVector;
+        std::vector<float> biasesVector;
+        if (task == SerializationTask::Save) {
+            for (auto const& row : weights) {
+                weightsVector.emplace_back(row.begin(), row.end());
+            }
+            biasesVector.assign(biases.begin(), biases.end());
+        }
+        ar(weightsVector, biasesVector);
+        if (task == SerializationTask::Load) {
+            weights = {};
+            biases = {};
+            for (size_t row = 0; row < std::min(weights.size(), weightsVector.size()); ++row) {
+                auto const& rowVector = weightsVector.at(row);
+                std::copy_n(rowVector.begin(), std::min(weights[row].size(), rowVector.size()), weights[row].begin());
+            }
+            std::copy_n(biasesVector.begin(), std::min(biases.size(), biasesVector.size()), biases.begin());
+        }
+    }
+
     template <class Archive>
     void serialize(Archive& ar, IntVector2D& data)
     {
@@ -225,7 +253,7 @@ namespace cereal
         loadSave<std::vector<int>>(task, auxiliaries, Id_NeuronGenome_ActivationFunctions, data.activationFunctions, defaultObject.activationFunctions);
         processLoadSaveMap(task, ar, auxiliaries);
 
-        ar(data.weights, data.biases);
+        loadSaveWeightsAndBiases(task, ar, data.weights, data.biases);
     }
     SPLIT_SERIALIZATION(NeuronGenomeDescription)
 
@@ -497,7 +525,7 @@ namespace cereal
         loadSave<std::vector<int>>(task, auxiliaries, Id_Neuron_ActivationFunctions, data.activationFunctions, defaultObject.activationFunctions);
         processLoadSaveMap(task, ar, auxiliaries);
 
-        ar(data.weights, data.biases);
+        loadSaveWeightsAndBiases(task, ar, data.weights, data.biases);
     }
     SPLIT_SERIALIZATION(NeuronDescription)
 
@@ -748,7 +776,7 @@ namespace cereal
     }
 }
 
-bool SerializerService::serializeSimulationToFiles(std::string const& filename, DeserializedSimulation const& data)
+bool SerializerService::serializeSimulationToFiles(std::string const& filename, DeserializedSimulation const& data, DataFormat format)
 {
     try {
         log(Priority::Important, "save simulation to " + filename);
@@ -758,11 +786,11 @@ bool SerializerService::serializeSimulationToFiles(std::string const& filename,
         statisticsFilename.replace_extension(std::filesystem::path(".statistics.csv"));
 
         {
-            zstr::ofstream stream(filename, std::ios::binary);
+            std::ofstream stream(filename, std::ios::binary);
             if (!stream) {
                 return false;
             }
-            serializeDataDescription(data.mainData, stream);
+            serializeDataDescription(data.mainData, stream, format);
         }
         {
             std::ofstream stream(settingsFilename.string(), std::ios::binary);
@@ -816,18 +844,29 @@ bool SerializerService::deserializeSimulationFromFiles(DeserializedSimulation& d
     }
 }
 
+bool SerializerService::deserializeAuxiliaryDataFromFiles(AuxiliaryData& data, std::string const& filename)
+{
+    try {
+        std::filesystem::path settingsFilename(filename);
+        settingsFilename.replace_extension(std::filesystem::path(".settings.json"));
+        std::ifstream stream(settingsFilename.string(), std::ios::binary);
+        if (!stream) {
+            return false;
+        }
+        deserializeAuxiliaryData(data, stream);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
 bool SerializerService::serializeSimulationToStrings(SerializedSimulation& output, DeserializedSimulation const& input)
 {
     try {
         {
-            std::stringstream stdStream;
-            zstr::ostream stream(stdStream, std::ios::binary);
-            if (!stream) {
-                return false;
-            }
-            serializeDataDescription(input.mainData, stream);
-            stream.flush();
-            output.mainData = stdStream.str();
+            std::stringstream stream;
+            serializeSharedDataDescription(input.mainData, stream);
+            output.mainData = stream.str();
         }
         {
             std::stringstream stream;
@@ -846,22 +885,18 @@ bool SerializerService::serializeSimulationToStrings(SerializedSimulation& outpu
 }
 
 bool SerializerService::deserializeSimulationFromStrings(DeserializedSimulation& output, SerializedSimulation const& input)
+{
+    return deserializeSimulationFromStrings(output, SerializedSimulationView{input.mainData, input.auxiliaryData, input.statistics});
+}
+
+bool SerializerService::deserializeSimulationFromStrings(DeserializedSimulation& output, SerializedSimulationView const& input)
 {
     try {
+        //the input is read in place without copying it
+        deserializeCompressedDataDescription(output.mainData, input.mainData);
+        output.auxiliaryData = AuxiliaryDataParserService::decodeAuxiliaryDataFromJson(input.auxiliaryData);
         {
-            std::stringstream stdStream(input.mainData);
-            zstr::istream stream(stdStream, std::ios::binary);
-            if (!stream) {
-                return false;
-            }
-            deserializeDataDescription(output.mainData, stream);
-        }
-        {
-            std::stringstream stream(input.auxiliaryData);
-            deserializeAuxiliaryData(output.auxiliaryData, stream);
-        }
-        {
-            std::stringstream stream(input.statistics);
+            boost::interprocess::ibufferstream stream(input.statistics.data(), input.statistics.size());
             deserializeStatistics(output.statistics, stream);
         }
         return true;
@@ -880,11 +915,11 @@ bool SerializerService::serializeGenomeToFile(std::string const& filename, std::
             return false;
         }
 
-        zstr::ofstream stream(filename, std::ios::binary);
+        std::ofstream stream(filename, std::ios::binary);
         if (!stream) {
             return false;
         }
-        serializeDataDescription(data, stream);
+        serializeSharedDataDescription(data, stream);
 
         return true;
     } catch (...) {
@@ -912,37 +947,25 @@ bool SerializerService::deserializeGenomeFromFile(std::vector<uint8_t>& genome,
 bool SerializerService::serializeGenomeToString(std::string& output, std::vector<uint8_t> const& input)
 {
     try {
-        std::stringstream stdStream;
-        zstr::ostream stream(stdStream, std::ios::binary);
-        if (!stream) {
-            return false;
-        }
-
         ClusteredDataDescription data;
         if (!wrapGenome(data, input)) {
             return false;
         }
 
-        serializeDataDescription(data, stream);
-        stream.flush();
-        output = stdStream.str();
+        std::stringstream stream;
+        serializeSharedDataDescription(data, stream);
+        output = stream.str();
         return true;
     } catch (...) {
         return false;
     }
 }
 
-bool SerializerService::deserializeGenomeFromString(std::vector<uint8_t>& output, std::string const& input)
+bool SerializerService::deserializeGenomeFromString(std::vector<uint8_t>& output, std::string_view const& input)
 {
     try {
-        std::stringstream stdStream(input);
-        zstr::istream stream(stdStream, std::ios::binary);
-        if (!stream) {
-            return false;
-        }
-
         ClusteredDataDescription data;
-        deserializeDataDescription(data, stream);
+        deserializeCompressedDataDescription(data, input);
 
         if (!unwrapGenome(output, data)) {
             return false;
@@ -1001,14 +1024,33 @@ bool SerializerService::serializeStatisticsToFile(std::string const& filename, S
     }
 }
 
-bool SerializerService::serializeContentToFile(std::string const& filename, ClusteredDataDescription const& content)
+bool SerializerService::appendStatisticsToFile(std::string const& filename, StatisticsHistoryData const& statistics)
 {
     try {
-        zstr::ofstream fileStream(filename, std::ios::binary);
+        auto writeHeader = !std::filesystem::exists(filename) || std::filesystem::file_size(filename) == 0;
+        std::ofstream stream(filename, std::ios::binary | std::ios::app);
+        if (!stream) {
+            return false;
+        }
+        if (writeHeader) {
+            serializeStatisticsHeader(stream);
+        }
+        serializeStatisticsContent(statistics, stream);
+        stream.close();
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+bool SerializerService::serializeContentToFile(std::string const& filename, ClusteredDataDescription const& content, DataFormat format)
+{
+    try {
+        std::ofstream fileStream(filename, std::ios::binary);
         if (!fileStream) {
             return false;
         }
-        serializeDataDescription(content, fileStream);
+        serializeDataDescription(content, fileStream, format);
 
         return true;
     } catch (...) {
@@ -1028,16 +1070,59 @@ bool SerializerService::deserializeContentFromFile(ClusteredDataDescription& con
     }
 }
 
-void SerializerService::serializeDataDescription(ClusteredDataDescription const& data, std::ostream& stream)
+bool SerializerService::serializeContentToString(std::string& output, ClusteredDataDescription const& content, DataFormat format)
+{
+    try {
+        std::stringstream stream;
+        serializeDataDescription(content, stream, format);
+        output = stream.str();
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+bool SerializerService::deserializeContentFromString(ClusteredDataDescription& content, std::string const& input)
+{
+    try {
+        std::stringstream stream(input);
+        deserializeDataDescription(content, stream);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+void SerializerService::serializeDataDescription(ClusteredDataDescription const& data, std::ostream& stream, DataFormat format)
 {
-    cereal::PortableBinaryOutputArchive archive(stream);
+    if (format == DataFormat::ColumnarUncompressed) {
+        ColumnarSerializerService::serializeDataDescription(data, stream);
+        return;
+    }
+    std::stringstream uncompressedStream;
+    if (format == DataFormat::Columnar) {
+        ColumnarSerializerService::serializeDataDescription(data, uncompressedStream);
+    } else {
+        cereal::PortableBinaryOutputArchive archive(uncompressedStream);
+        archive(Const::ProgramVersion);
+        archive(data);
+    }
+    auto compressedData = BlockCompressionService::compress(uncompressedStream.view());
+    stream.write(compressedData.data(), compressedData.size());
+}
+
+void SerializerService::serializeSharedDataDescription(ClusteredDataDescription const& data, std::ostream& stream)
+{
+    zstr::ostream compressedStream(stream);
+    cereal::PortableBinaryOutputArchive archive(compressedStream);
     archive(Const::ProgramVersion);
     archive(data);
+    compressedStream.flush();
 }
 
 bool SerializerService::deserializeDataDescription(ClusteredDataDescription& data, std::string const& filename)
 {
-    zstr::ifstream stream(filename, std::ios::binary);
+    std::ifstream stream(filename, std::ios::binary);
     if (!stream) {
         return false;
     }
@@ -1047,7 +1132,40 @@ bool SerializerService::deserializeDataDescription(ClusteredDataDescription& dat
 
 void SerializerService::deserializeDataDescription(ClusteredDataDescription& data, std::istream& stream)
 {
-    cereal::PortableBinaryInputArchive archive(stream);
+    std::string compressedData{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+    deserializeCompressedDataDescription(data, compressedData);
+}
+
+void SerializerService::deserializeCompressedDataDescription(ClusteredDataDescription& data, std::string_view const& compressedData)
+{
+    if (BlockCompressionService::isBlockCompressed(compressedData)) {
+        deserializeUncompressedDataDescription(data, BlockCompressionService::decompress(compressedData));
+    } else if (ColumnarSerializerService::isColumnarFormat(compressedData)) {
+        deserializeUncompressedDataDescription(data, compressedData);
+    } else {
+        //files from older versions are compressed as a single zlib/gzip stream
+        boost::interprocess::ibufferstream compressedStream(compressedData.data(), compressedData.size());
+        zstr::istream uncompressedStream(compressedStream);
+        deserializeUncompressedDataDescription(data, uncompressedStream);
+    }
+}
+
+void SerializerService::deserializeUncompressedDataDescription(ClusteredDataDescription& data, std::istream& stream)
+{
+    //the stream is buffered since the format can only be detected by the complete magic
+    std::string uncompressedData{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+    deserializeUncompressedDataDescription(data, std::string_view(uncompressedData));
+}
+
+void SerializerService::deserializeUncompressedDataDescription(ClusteredDataDescription& data, std::string_view const& uncompressedData)
+{
+    if (ColumnarSerializerService::isColumnarFormat(uncompressedData)) {
+        ColumnarSerializerService::deserializeDataDescription(data, uncompressedData);
+        return;
+    }
+
+    boost::interprocess::ibufferstream uncompressedStream(uncompressedData.data(), uncompressedData.size());
+    cereal::PortableBinaryInputArchive archive(uncompressedStream);
     std::string version;
     archive(version);
 
@@ -1062,26 +1180,30 @@ void SerializerService::deserializeDataDescription(ClusteredDataDescription& dat
 
 void SerializerService::serializeAuxiliaryData(AuxiliaryData const& auxiliaryData, std::ostream& stream)
 {
-    boost::property_tree::json_parser::write_json(stream, AuxiliaryDataParserService::encodeAuxiliaryData(auxiliaryData));
+    stream << AuxiliaryDataParserService::encodeAuxiliaryDataToJson(auxiliaryData);
+    if (!stream.good()) {
+        throw std::runtime_error("Settings could not be written.");
+    }
 }
 
 void SerializerService::deserializeAuxiliaryData(AuxiliaryData& auxiliaryData, std::istream& stream)
 {
-    boost::property_tree::ptree tree;
-    boost::property_tree::read_json(stream, tree);
-    auxiliaryData = AuxiliaryDataParserService::decodeAuxiliaryData(tree);
+    std::string json{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+    auxiliaryData = AuxiliaryDataParserService::decodeAuxiliaryDataFromJson(json);
 }
 
 void SerializerService::serializeSimulationParameters(SimulationParameters const& parameters, std::ostream& stream)
 {
-    boost::property_tree::json_parser::write_json(stream, AuxiliaryDataParserService::encodeSimulationParameters(parameters));
+    stream << AuxiliaryDataParserService::encodeSimulationParametersToJson(parameters);
+    if (!stream.good()) {
+        throw std::runtime_error("Simulation parameters could not be written.");
+    }
 }
 
 void SerializerService::deserializeSimulationParameters(SimulationParameters& parameters, std::istream& stream)
 {
-    boost::property_tree::ptree tree;
-    boost::property_tree::read_json(stream, tree);
-    parameters = AuxiliaryDataParserService::decodeSimulationParameters(tree);
+    std::string json{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+    parameters = AuxiliaryDataParserService::decodeSimulationParametersFromJson(json);
 }
 
 namespace
@@ -1153,7 +1275,12 @@ namespace
 
 void SerializerService::serializeStatistics(StatisticsHistoryData const& statistics, std::ostream& stream)
 {
-    //header row
+    serializeStatisticsHeader(stream);
+    serializeStatisticsContent(statistics, stream);
+}
+
+void SerializerService::serializeStatisticsHeader(std::ostream& stream)
+{
     stream << "Time step";
     auto writeLabelAllColors = [&stream](auto const& name) {
         for (int i = 0; i < MAX_COLORS; ++i) {
@@ -1183,8 +1310,10 @@ void SerializerService::serializeStatistics(StatisticsHistoryData const& statist
     writeLabelAllColors("Reconnector deletions");
     writeLabelAllColors("Detonations");
     stream << std::endl;
+}
 
-    //content
+void SerializerService::serializeStatisticsContent(StatisticsHistoryData const& statistics, std::ostream& stream)
+{
     for (auto dataPoints : statistics) {
         std::vector<std::string> entries;
         loadSave(SerializationTask::Save, entries, dataPoints);
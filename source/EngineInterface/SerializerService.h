@@ -14,6 +14,13 @@ struct DeserializedSimulation
     StatisticsHistoryData statistics;
 };
 
+enum class DataFormat
+{
+    Cereal,  //legacy format with per-object maps, only used for compatibility and comparisons
+    Columnar,
+    ColumnarUncompressed  //larger files which can be memory-mapped and queried in place (see MappedSimulationFile)
+};
+
 struct SerializedSimulation
 {
     std::string mainData;  //binary
@@ -21,33 +28,56 @@ struct SerializedSimulation
     std::string statistics;  //CSV
 };
 
+//non-owning variant of SerializedSimulation, e.g. for memory-mapped data
+struct SerializedSimulationView
+{
+    std::string_view mainData;
+    std::string_view auxiliaryData;
+    std::string_view statistics;
+};
+
 class SerializerService
 {
 public:
-    static bool serializeSimulationToFiles(std::string const& filename, DeserializedSimulation const& data);
+    static bool serializeSimulationToFiles(std::string const& filename, DeserializedSimulation const& data, DataFormat format = DataFormat::Columnar);
     static bool deserializeSimulationFromFiles(DeserializedSimulation& data, std::string const& filename);
+    static bool deserializeAuxiliaryDataFromFiles(AuxiliaryData& data, std::string const& filename);  //reads only the settings file of the simulation
 
+    //the strings are uploaded to the server, hence the main data is encoded in the shared format of older program versions
+    //(see serializeSharedDataDescription) and not in the block compressed columnar format of local files
     static bool serializeSimulationToStrings(SerializedSimulation& output, DeserializedSimulation const& input);
     static bool deserializeSimulationFromStrings(DeserializedSimulation& output, SerializedSimulation const& input);
+    static bool deserializeSimulationFromStrings(DeserializedSimulation& output, SerializedSimulationView const& input);
 
     static bool serializeGenomeToFile(std::string const& filename, std::vector<uint8_t> const& genome);
     static bool deserializeGenomeFromFile(std::vector<uint8_t>& genome, std::string const& filename);
 
+    //uploaded as well, see serializeSimulationToStrings
     static bool serializeGenomeToString(std::string& output, std::vector<uint8_t> const& input);
-    static bool deserializeGenomeFromString(std::vector<uint8_t>& output, std::string const& input);
+    static bool deserializeGenomeFromString(std::vector<uint8_t>& output, std::string_view const& input);
 
     static bool serializeSimulationParametersToFile(std::string const& filename, SimulationParameters const& parameters);
     static bool deserializeSimulationParametersFromFile(SimulationParameters& parameters, std::string const& filename);
 
     static bool serializeStatisticsToFile(std::string const& filename, StatisticsHistoryData const& statistics);
+    static bool appendStatisticsToFile(std::string const& filename, StatisticsHistoryData const& statistics);  //writes the header row for new files
 
-    static bool serializeContentToFile(std::string const& filename, ClusteredDataDescription const& content);
+    static bool serializeContentToFile(std::string const& filename, ClusteredDataDescription const& content, DataFormat format = DataFormat::Columnar);
     static bool deserializeContentFromFile(ClusteredDataDescription& content, std::string const& filename);
 
+    static bool serializeContentToString(std::string& output, ClusteredDataDescription const& content, DataFormat format = DataFormat::Columnar);
+    static bool deserializeContentFromString(ClusteredDataDescription& content, std::string const& input);
+
 private:
-    static void serializeDataDescription(ClusteredDataDescription const& data, std::ostream& stream);
+    static void serializeDataDescription(ClusteredDataDescription const& data, std::ostream& stream, DataFormat format = DataFormat::Columnar);
+
+    //encoding of older program versions (cereal archive in a single zlib stream) for uploaded and shared data which other clients must read
+    static void serializeSharedDataDescription(ClusteredDataDescription const& data, std::ostream& stream);
     static bool deserializeDataDescription(ClusteredDataDescription& data, std::string const& filename);
     static void deserializeDataDescription(ClusteredDataDescription& data, std::istream& stream);
+    static void deserializeCompressedDataDescription(ClusteredDataDescription& data, std::string_view const& compressedData);
+    static void deserializeUncompressedDataDescription(ClusteredDataDescription& data, std::istream& stream);
+    static void deserializeUncompressedDataDescription(ClusteredDataDescription& data, std::string_view const& uncompressedData);
 
     static void serializeAuxiliaryData(AuxiliaryData const& auxiliaryData, std::ostream& stream);
     static void deserializeAuxiliaryData(AuxiliaryData& auxiliaryData, std::istream& stream);
@@ -56,6 +86,8 @@ private:
     static void deserializeSimulationParameters(SimulationParameters& parameters, std::istream& stream);
 
     static void serializeStatistics(StatisticsHistoryData const& statistics, std::ostream& stream);
+    static void serializeStatisticsHeader(std::ostream& stream);
+    static void serializeStatisticsContent(StatisticsHistoryData const& statistics, std::ostream& stream);
     static void deserializeStatistics(StatisticsHistoryData& statistics, std::istream& stream);
 
     static bool wrapGenome(ClusteredDataDescription& output, std::vector<uint8_t> const& input);
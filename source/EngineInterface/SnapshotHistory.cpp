@@ -0,0 +1,196 @@
+#include "SnapshotHistory.h"
+
+#include <unordered_map>
+#include <unordered_set>
+
+#include "SerializerService.h"
+
+namespace
+{
+    std::string encode(DataDescription const& data)
+    {
+        ClusteredDataDescription clusteredData;
+        if (!data.cells.empty()) {
+            clusteredData.addCluster(ClusterDescription().addCells(data.cells));
+        }
+        clusteredData.particles = data.particles;
+
+        std::string result;
+        if (!SerializerService::serializeContentToString(result, clusteredData)) {
+            throw std::runtime_error("Snapshot could not be encoded.");
+        }
+        return result;
+    }
+
+    DataDescription decode(std::string const& data)
+    {
+        ClusteredDataDescription clusteredData;
+        if (!SerializerService::deserializeContentFromString(clusteredData, data)) {
+            throw std::runtime_error("Snapshot could not be decoded.");
+        }
+        return DataDescription(clusteredData);
+    }
+
+    //returns the objects of origObjects which are missing or different in objects, and the ids of the objects which are only in objects
+    template <typename Object>
+    std::pair<std::vector<Object>, std::vector<uint64_t>> calcBackwardDelta(std::vector<Object> const& objects, std::vector<Object> const& origObjects)
+    {
+        std::unordered_map<uint64_t, Object const*> objectById;
+        objectById.reserve(objects.size());
+        for (auto const& object : objects) {
+            objectById.emplace(object.id, &object);
+        }
+
+        std::pair<std::vector<Object>, std::vector<uint64_t>> result;
+        for (auto const& origObject : origObjects) {
+            auto findResult = objectById.find(origObject.id);
+            if (findResult == objectById.end()) {
+                result.first.emplace_back(origObject);
+            } else {
+                if (!(*findResult->second == origObject)) {
+                    result.first.emplace_back(origObject);
+                }
+                objectById.erase(findResult);
+            }
+        }
+        for (auto const& object : objects) {
+            if (objectById.contains(object.id)) {
+                result.second.emplace_back(object.id);
+            }
+        }
+        return result;
+    }
+
+    template <typename Object>
+    void applyBackwardDelta(std::vector<Object>& objects, std::vector<Object> const& changedObjects, std::vector<uint64_t> const& addedObjectIds)
+    {
+        if (!addedObjectIds.empty()) {
+            std::unordered_set<uint64_t> addedObjectIdSet(addedObjectIds.begin(), addedObjectIds.end());
+            std::erase_if(objects, [&](auto const& object) { return addedObjectIdSet.contains(object.id); });
+        }
+
+        std::unordered_map<uint64_t, size_t> indexById;
+        indexById.reserve(objects.size());
+        for (size_t i = 0; i < objects.size(); ++i) {
+            indexById.emplace(objects[i].id, i);
+        }
+        for (auto const& changedObject : changedObjects) {
+            auto findResult = indexById.find(changedObject.id);
+            if (findResult != indexById.end()) {
+                objects[findResult->second] = changedObject;
+            } else {
+                objects.emplace_back(changedObject);
+            }
+        }
+    }
+}
+
+SnapshotHistory::SnapshotHistory(uint64_t memoryBudget)
+    : _memoryBudget(memoryBudget)
+{}
+
+void SnapshotHistory::push(HistorySnapshot const& snapshot)
+{
+    //replace keyframe of the newest entry by a delta to the new snapshot
+    if (!_entries.empty()) {
+        auto& newestEntry = _entries.back();
+        auto newestData = decode(newestEntry.compressedData);
+        _memoryUsage -= getMemoryUsage(newestEntry);
+
+        DataDescription delta;
+        std::tie(delta.cells, newestEntry.addedCellIds) = calcBackwardDelta(snapshot.data.cells, newestData.cells);
+        std::tie(delta.particles, newestEntry.addedParticleIds) = calcBackwardDelta(snapshot.data.particles, newestData.particles);
+        newestEntry.compressedData = encode(delta);
+        _memoryUsage += getMemoryUsage(newestEntry);
+    }
+
+    Entry entry;
+    entry.timestep = snapshot.timestep;
+    entry.realTime = snapshot.realTime;
+    entry.parameters = snapshot.parameters;
+    entry.compressedData = encode(snapshot.data);
+    _memoryUsage += getMemoryUsage(entry);
+    _entries.emplace_back(std::move(entry));
+
+    evictOldestEntries();
+}
+
+std::optional<HistorySnapshot> SnapshotHistory::pop()
+{
+    if (_entries.empty()) {
+        return std::nullopt;
+    }
+    auto& newestEntry = _entries.back();
+
+    HistorySnapshot result;
+    result.timestep = newestEntry.timestep;
+    result.realTime = newestEntry.realTime;
+    result.parameters = newestEntry.parameters;
+    result.data = decode(newestEntry.compressedData);
+
+    _memoryUsage -= getMemoryUsage(newestEntry);
+    _entries.pop_back();
+
+    //the delta of the previous entry becomes a keyframe
+    if (!_entries.empty()) {
+        auto& previousEntry = _entries.back();
+        auto delta = decode(previousEntry.compressedData);
+
+        auto previousData = result.data;
+        applyBackwardDelta(previousData.cells, delta.cells, previousEntry.addedCellIds);
+        applyBackwardDelta(previousData.particles, delta.particles, previousEntry.addedParticleIds);
+
+        _memoryUsage -= getMemoryUsage(previousEntry);
+        previousEntry.compressedData = encode(previousData);
+        previousEntry.addedCellIds.clear();
+        previousEntry.addedParticleIds.clear();
+        _memoryUsage += getMemoryUsage(previousEntry);
+    }
+    return result;
+}
+
+void SnapshotHistory::clear()
+{
+    _entries.clear();
+    _memoryUsage = 0;
+}
+
+bool SnapshotHistory::isEmpty() const
+{
+    return _entries.empty();
+}
+
+int SnapshotHistory::getNumSnapshots() const
+{
+    return toInt(_entries.size());
+}
+
+uint64_t SnapshotHistory::getMemoryUsage() const
+{
+    return _memoryUsage;
+}
+
+uint64_t SnapshotHistory::getMemoryBudget() const
+{
+    return _memoryBudget;
+}
+
+void SnapshotHistory::setMemoryBudget(uint64_t value)
+{
+    _memoryBudget = value;
+    evictOldestEntries();
+}
+
+uint64_t SnapshotHistory::getMemoryUsage(Entry const& entry) const
+{
+    return sizeof(Entry) + entry.compressedData.size() + (entry.addedCellIds.size() + entry.addedParticleIds.size()) * sizeof(uint64_t);
+}
+
+void SnapshotHistory::evictOldestEntries()
+{
+    //the newest entry is always kept
+    while (_memoryUsage > _memoryBudget && _entries.size() > 1) {
+        _memoryUsage -= getMemoryUsage(_entries.front());
+        _entries.pop_front();
+    }
+}
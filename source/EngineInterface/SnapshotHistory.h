@@ -0,0 +1,60 @@
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <optional>
+
+#include "Definitions.h"
+#include "Descriptions.h"
+#include "SimulationParameters.h"
+
+struct HistorySnapshot
+{
+    uint64_t timestep = 0;
+    std::chrono::milliseconds realTime = std::chrono::milliseconds(0);
+    SimulationParameters parameters;
+    DataDescription data;
+};
+
+/**
+ * Memory-bounded stack of simulation snapshots for stepping backward.
+ * The most recent snapshot is stored as a compressed keyframe. Each older snapshot is stored as a compressed backward
+ * delta which contains only the cells and particles (keyed by id) that differ from the next newer snapshot. Hence
+ * popping a snapshot only decodes a single delta and the oldest snapshots can be evicted without re-encoding.
+ * Restored snapshots contain the same objects as the original ones but not necessarily in the same order.
+ */
+class SnapshotHistory
+{
+public:
+    static uint64_t constexpr DefaultMemoryBudget = 512ull * 1024 * 1024;
+
+    SnapshotHistory(uint64_t memoryBudget = DefaultMemoryBudget);
+
+    void push(HistorySnapshot const& snapshot);
+    std::optional<HistorySnapshot> pop();
+    void clear();
+
+    bool isEmpty() const;
+    int getNumSnapshots() const;
+    uint64_t getMemoryUsage() const;
+
+    uint64_t getMemoryBudget() const;
+    void setMemoryBudget(uint64_t value);  //oldest snapshots are evicted when the budget is exceeded
+
+private:
+    struct Entry
+    {
+        uint64_t timestep = 0;
+        std::chrono::milliseconds realTime;
+        SimulationParameters parameters;
+        std::string compressedData;  //keyframe for the newest entry, backward delta otherwise
+        std::vector<uint64_t> addedCellIds;  //cells which are present in the next newer entry only
+        std::vector<uint64_t> addedParticleIds;
+    };
+    uint64_t getMemoryUsage(Entry const& entry) const;
+    void evictOldestEntries();
+
+    uint64_t _memoryBudget = 0;
+    uint64_t _memoryUsage = 0;
+    std::deque<Entry> _entries;
+};
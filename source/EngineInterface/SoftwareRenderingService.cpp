@@ -0,0 +1,788 @@
+#include "SoftwareRenderingService.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <optional>
+#include <unordered_map>
+
+#include <zlib.h>
+
+#include "Base/Math.h"
+#include "Base/ParallelExecution.h"
+
+#include "Colors.h"
+#include "SpaceCalculator.h"
+
+namespace
+{
+    auto constexpr ZoomLevelForConnections = 1.0f;
+    auto constexpr ZoomLevelForShadedCells = 10.0f;
+    auto constexpr ZoomLevelForArrows = 15.0f;
+
+    auto constexpr BandHeight = 32;
+    auto constexpr PlacementChunkSize = 4096;
+
+    struct Color
+    {
+        float r = 0;
+        float g = 0;
+        float b = 0;
+
+        Color operator*(float factor) const { return {r * factor, g * factor, b * factor}; }
+    };
+
+    //lowest byte is red as in the background color of the parameters
+    Color toColor(uint32_t value)
+    {
+        return {toFloat(value & 0xff) / 255, toFloat((value >> 8) & 0xff) / 255, toFloat((value >> 16) & 0xff) / 255};
+    }
+
+    //highest byte is red as in the cell colors
+    Color toColor(uint32_t value, float factor)
+    {
+        return {toFloat((value >> 16) & 0xff) / 256.0f * factor, toFloat((value >> 8) & 0xff) / 256.0f * factor, toFloat(value & 0xff) / 256.0f * factor};
+    }
+
+    uint32_t convertHSVtoRGB(float h, float s, float v)
+    {
+        auto c = v * s;
+        auto x = c * (1 - std::abs(std::fmod(h / 60, 2.0f) - 1));
+        auto m = v - c;
+
+        float r_ = 0, g_ = 0, b_ = 0;
+        if (h < 60.0f) {
+            r_ = c;
+            g_ = x;
+        } else if (h < 120.0f) {
+            r_ = x;
+            g_ = c;
+        } else if (h < 180.0f) {
+            g_ = c;
+            b_ = x;
+        } else if (h < 240.0f) {
+            g_ = x;
+            b_ = c;
+        } else if (h < 300.0f) {
+            r_ = x;
+            b_ = c;
+        } else {
+            r_ = c;
+            b_ = x;
+        }
+        auto toByte = [](float value) { return static_cast<uint32_t>(toInt(value * 255)); };
+        return (toByte(r_ + m) << 16) | (toByte(g_ + m) << 8) | toByte(b_ + m);
+    }
+
+    RealVector2D normalized(RealVector2D vec)
+    {
+        Math::normalize(vec);
+        return vec;
+    }
+
+    bool isActive(CellDescription const& cell)
+    {
+        return std::any_of(cell.activity.channels.begin(), cell.activity.channels.end(), [](float value) { return std::abs(value) > NEAR_ZERO; });
+    }
+
+    struct RenderingContext
+    {
+        DataDescription const& data;
+        SimulationParameters const& parameters;
+        SpaceCalculator space;
+        std::unordered_map<uint64_t, int> cellIndexById;
+        uint64_t timestep = 0;
+
+        RealVector2D rectUpperLeft;
+        RealVector2D rectLowerRight;
+        float zoom = 1.0f;
+        IntVector2D worldSize;
+        IntVector2D imageSize;
+        RealVector2D universeImageSize;
+
+        CellColoring backgroundColoring = CellColoring_None;
+        CellColoring foregroundColoring = CellColoring_None;
+
+        CellDescription const* findCell(uint64_t id) const
+        {
+            auto findResult = cellIndexById.find(id);
+            return findResult != cellIndexById.end() ? &data.cells.at(findResult->second) : nullptr;
+        }
+
+        RealVector2D mapWorldPosToImagePos(RealVector2D const& pos) const
+        {
+            RealVector2D result{(pos.x - rectUpperLeft.x) * zoom, (pos.y - rectUpperLeft.y) * zoom};
+            if (parameters.borderlessRendering) {
+                result.x = Math::modulo(result.x, universeImageSize.x);
+                result.y = Math::modulo(result.y, universeImageSize.y);
+            }
+            return result;
+        }
+
+        bool isContainedInImage(RealVector2D const& imagePos) const
+        {
+            return imagePos.x >= 0 && imagePos.x <= toFloat(imageSize.x) && imagePos.y >= 0 && imagePos.y <= toFloat(imageSize.y);
+        }
+
+        bool isLineVisible(RealVector2D const& startImagePos, RealVector2D const& endImagePos) const
+        {
+            return std::abs(startImagePos.x - endImagePos.x) < universeImageSize.x / 2 && std::abs(startImagePos.y - endImagePos.y) < universeImageSize.y / 2;
+        }
+    };
+
+    Color calcColor(RenderingContext const& context, CellDescription const& cell, CellColoring cellColoring)
+    {
+        auto factor = std::min(300.0f, cell.energy) / 320.0f;
+
+        uint32_t cellColor = 0;
+        if (cellColoring == CellColoring_None) {
+            cellColor = 0xbfbfbf;
+        }
+        if (cellColoring == CellColoring_CellColor) {
+            cellColor = Const::IndividualCellColors[((cell.color % MAX_COLORS) + MAX_COLORS) % MAX_COLORS];
+        }
+        if (cellColoring == CellColoring_MutationId) {
+            auto h = std::abs(toInt((cell.mutationId * 12107) % 360));
+            auto s = 0.6f + toFloat(std::abs(toInt(cell.mutationId * 12107)) % 400) / 1000;
+            cellColor = convertHSVtoRGB(toFloat(h), s, 1.0f);
+        }
+        if (cellColoring == CellColoring_LivingState) {
+            switch (cell.livingState) {
+            case LivingState_Ready:
+                cellColor = 0x0000ff;
+                break;
+            case LivingState_UnderConstruction:
+                cellColor = 0x00ff00;
+                break;
+            case LivingState_Activating:
+                cellColor = 0xffffff;
+                break;
+            case LivingState_Dying:
+                cellColor = 0xff0000;
+                break;
+            default:
+                cellColor = 0x000000;
+                break;
+            }
+        }
+        if (cellColoring == CellColoring_GenomeSize) {
+            cellColor = convertHSVtoRGB(std::min(360.0f, 240.0f + std::pow(toFloat(cell.genomeComplexity), 0.3f) * 5.0f), 1.0f, 1.0f);
+        }
+        if (cellColoring == CellColoring_CellFunction) {
+            auto cellFunction = cell.getCellFunctionType();
+            if (cellFunction == context.parameters.highlightedCellFunction) {
+                auto h = (toFloat(cellFunction) / toFloat(CellFunction_Count - 1)) * 360.0f;
+                cellColor = convertHSVtoRGB(h, 0.7f, 1.0f);
+                factor = 5.0f;
+            } else {
+                cellColor = 0x404040;
+            }
+        }
+        if (cellColoring == CellColoring_AllCellFunction) {
+            auto h = (toFloat(cell.getCellFunctionType()) / toFloat(CellFunction_Count - 1)) * 360.0f;
+            cellColor = convertHSVtoRGB(h, 0.7f, 1.0f);
+            factor = 0.42f;
+        }
+        return toColor(cellColor, factor);
+    }
+
+    Color calcColor(ParticleDescription const& particle)
+    {
+        auto intensity = std::max(std::min((toInt(particle.energy) + 10.0f) * 5, 450.0f), 20.0f) / 1000.0f;
+        return {intensity, intensity, 0.08f};
+    }
+
+    std::optional<float> calcDetonationRadius(RenderingContext const& context, CellDescription const& cell)
+    {
+        if (cell.getCellFunctionType() != CellFunction_Detonator) {
+            return std::nullopt;
+        }
+        auto const& detonator = std::get<DetonatorDescription>(*cell.cellFunction);
+        if (detonator.state != DetonatorState_Activated || detonator.countdown >= 2) {
+            return std::nullopt;
+        }
+        auto radius = toFloat((context.timestep - static_cast<uint64_t>(cell.executionOrderNumber) + 5) % 6 + (6 - detonator.countdown * 6));
+        radius *= radius;
+        radius *= context.parameters.cellFunctionDetonatorRadius[cell.color] * context.zoom / 36;
+        return radius;
+    }
+
+    //calls func(startImagePos, endImagePos) for the visible connections of a cell
+    template <typename Func>
+    void forEachConnectionLine(RenderingContext const& context, CellDescription const& cell, Func const& func)
+    {
+        for (auto const& connection : cell.connections) {
+            auto otherCell = context.findCell(connection.cellId);
+            if (!otherCell) {
+                continue;
+            }
+            auto otherCellPos = cell.pos + context.space.getCorrectedDirection(otherCell->pos - cell.pos);
+            auto distFromCellCenter = normalized(otherCellPos - cell.pos) / 3;
+            auto startImagePos = context.mapWorldPosToImagePos(cell.pos + distFromCellCenter);
+            auto endImagePos = context.mapWorldPosToImagePos(otherCellPos - distFromCellCenter);
+            if (context.isLineVisible(startImagePos, endImagePos)) {
+                func(startImagePos, endImagePos);
+            }
+        }
+    }
+
+    //image position of an object and the range of image rows it may draw to
+    struct Placement
+    {
+        RealVector2D imagePos;
+        float minY = 0;
+        float maxY = 0;
+        bool visible = false;
+    };
+
+    Placement calcPlacement(RenderingContext const& context, CellDescription const& cell)
+    {
+        Placement result;
+        result.imagePos = context.mapWorldPosToImagePos(cell.pos);
+        result.visible = context.isContainedInImage(result.imagePos);
+        if (!result.visible) {
+            return result;
+        }
+
+        //circles and arrows plus the splatting of the dots
+        auto extent = context.zoom * 0.6f + 2.0f;
+        if (auto detonationRadius = calcDetonationRadius(context, cell)) {
+            extent = std::max(extent, *detonationRadius + 2.0f);
+        }
+        result.minY = result.imagePos.y - extent;
+        result.maxY = result.imagePos.y + extent;
+        if (context.zoom >= ZoomLevelForConnections) {
+            forEachConnectionLine(context, cell, [&](RealVector2D const& startImagePos, RealVector2D const& endImagePos) {
+                result.minY = std::min(result.minY, std::min(startImagePos.y, endImagePos.y) - 1.0f);
+                result.maxY = std::max(result.maxY, std::max(startImagePos.y, endImagePos.y) + 1.0f);
+            });
+        }
+        return result;
+    }
+
+    Placement calcPlacement(RenderingContext const& context, ParticleDescription const& particle)
+    {
+        Placement result;
+        result.imagePos = context.mapWorldPosToImagePos(context.space.getCorrectedPosition(particle.pos));
+        result.visible = context.isContainedInImage(result.imagePos);
+        auto extent = context.zoom / 3 + 2.0f;
+        result.minY = result.imagePos.y - extent;
+        result.maxY = result.imagePos.y + extent;
+        return result;
+    }
+
+    //color planes with the raw channel values of the 16 bit image of the rendering kernels
+    struct ImagePlanes
+    {
+        IntVector2D size;
+        std::vector<float> red;
+        std::vector<float> green;
+        std::vector<float> blue;
+    };
+
+    //draws into the rows [beginY, endY) of the image planes, everything outside is clipped
+    class BandCanvas
+    {
+    public:
+        BandCanvas(ImagePlanes& planes, int beginY, int endY)
+            : _planes(planes)
+            , _beginY(beginY)
+            , _endY(endY)
+        {}
+
+        int getBeginY() const { return _beginY; }
+        int getEndY() const { return _endY; }
+
+        void setRawPixel(int x, int y, Color const& rawColor)
+        {
+            if (x >= 0 && x < _planes.size.x && y >= _beginY && y < _endY) {
+                auto index = x + y * _planes.size.x;
+                _planes.red[index] = rawColor.r;
+                _planes.green[index] = rawColor.g;
+                _planes.blue[index] = rawColor.b;
+            }
+        }
+
+        void setPixels(int y, int beginX, int endX, Color const& color)
+        {
+            auto offset = y * _planes.size.x;
+            std::fill(_planes.red.begin() + offset + beginX, _planes.red.begin() + offset + endX, color.r * 225.0f);
+            std::fill(_planes.green.begin() + offset + beginX, _planes.green.begin() + offset + endX, color.g * 225.0f);
+            std::fill(_planes.blue.begin() + offset + beginX, _planes.blue.begin() + offset + endX, color.b * 225.0f);
+        }
+
+        void addPixel(int x, int y, Color const& color)
+        {
+            if (x >= 0 && x < _planes.size.x && y >= _beginY && y < _endY) {
+                auto index = x + y * _planes.size.x;
+                _planes.red[index] += color.r * 255.0f;
+                _planes.green[index] += color.g * 255.0f;
+                _planes.blue[index] += color.b * 255.0f;
+            }
+        }
+
+        //bilinear splatting
+        void drawDot(RealVector2D const& pos, Color const& color)
+        {
+            if (pos.x < 0 || pos.y < 0) {
+                return;
+            }
+            auto x = toInt(pos.x);
+            auto y = toInt(pos.y);
+            if (y + 1 < _beginY || y >= _endY) {
+                return;
+            }
+            auto fracX = pos.x - toFloat(x);
+            auto fracY = pos.y - toFloat(y);
+            addPixel(x, y, color * ((1.0f - fracX) * (1.0f - fracY)));
+            addPixel(x + 1, y, color * (fracX * (1.0f - fracY)));
+            addPixel(x, y + 1, color * ((1.0f - fracX) * fracY));
+            addPixel(x + 1, y + 1, color * (fracX * fracY));
+        }
+
+        void drawCircle(RealVector2D const& pos, Color color, float radius, bool shaded = true, bool inverted = false)
+        {
+            if (radius > 2.0f - NEAR_ZERO) {
+                auto radiusSquared = radius * radius;
+                for (float y = -radius; y <= radius; y += 1.0f) {
+                    if (pos.y + y + 1.0f < toFloat(_beginY)) {
+                        continue;
+                    }
+                    if (pos.y + y >= toFloat(_endY)) {
+                        break;
+                    }
+                    for (float x = -radius; x <= radius; x += 1.0f) {
+                        auto rSquared = x * x + y * y;
+                        if (rSquared <= radiusSquared) {
+                            auto factor = inverted ? (rSquared / radiusSquared) * 2 : (1.0f - rSquared / radiusSquared) * 2;
+                            if (shaded) {
+                                auto angle = Math::angleOfVector({x, y}) - 45.0f;
+                                if (angle > 180.0f) {
+                                    angle -= 360.0f;
+                                }
+                                if (angle < -180.0f) {
+                                    angle += 360.0f;
+                                }
+                                factor *= 65.0f / (std::abs(angle) + 1.0f);
+                            }
+                            drawDot(pos + RealVector2D{x, y}, color * std::min(factor, 1.0f));
+                        }
+                    }
+                }
+            } else {
+                color = color * radius * 2;
+                drawDot(pos, color);
+                color = color * 0.3f;
+                drawDot(pos + RealVector2D{1, 0}, color);
+                drawDot(pos + RealVector2D{-1, 0}, color);
+                drawDot(pos + RealVector2D{0, 1}, color);
+                drawDot(pos + RealVector2D{0, -1}, color);
+            }
+        }
+
+        void drawLine(RealVector2D const& start, RealVector2D const& end, Color const& color, float pixelDistance = 1.5f)
+        {
+            auto dist = Math::length(end - start);
+            if (dist < NEAR_ZERO) {
+                drawDot(start, color);
+                return;
+            }
+            auto v = (end - start) * (pixelDistance / dist);
+            auto pos = start;
+            for (float d = 0; d <= dist; d += pixelDistance) {
+                drawDot(pos, color);
+                pos += v;
+            }
+        }
+
+    private:
+        ImagePlanes& _planes;
+        int _beginY = 0;
+        int _endY = 0;
+    };
+
+    Color calcSpotMixedColor(RenderingContext const& context, RealVector2D const& worldPos, Color const& baseColor, Color const* spotColors)
+    {
+        auto const& parameters = context.parameters;
+        float spotWeights[MAX_SPOTS];
+        for (int i = 0; i < parameters.numSpots; ++i) {
+            auto const& spot = parameters.spots[i];
+            auto delta = context.space.getCorrectedDirection(RealVector2D{spot.posX, spot.posY} - worldPos);
+            if (spot.shapeType == SpotShapeType_Rectangular) {
+                auto const& rect = spot.shapeData.rectangularSpot;
+                spotWeights[i] = 0;
+                if (std::abs(delta.x) > rect.width / 2 || std::abs(delta.y) > rect.height / 2) {
+                    RealVector2D distanceFromRect{std::max(0.0f, std::abs(delta.x) - rect.width / 2), std::max(0.0f, std::abs(delta.y) - rect.height / 2)};
+                    spotWeights[i] = std::min(1.0f, Math::length(distanceFromRect) / (spot.fadeoutRadius + 1));
+                }
+            } else {
+                auto distance = Math::length(delta);
+                auto coreRadius = spot.shapeData.circularSpot.coreRadius;
+                spotWeights[i] = distance < coreRadius ? 0.0f : std::min(1.0f, (distance - coreRadius) / (spot.fadeoutRadius + 1));
+            }
+        }
+
+        float baseFactor = 1;
+        float sum = 0;
+        for (int i = 0; i < parameters.numSpots; ++i) {
+            baseFactor *= spotWeights[i];
+            sum += 1.0f - spotWeights[i];
+        }
+        sum += baseFactor;
+        auto result = baseColor * baseFactor;
+        for (int i = 0; i < parameters.numSpots; ++i) {
+            auto spotColor = spotColors[i] * ((1.0f - spotWeights[i]) / sum);
+            result.r += spotColor.r;
+            result.g += spotColor.g;
+            result.b += spotColor.b;
+        }
+        return result;
+    }
+
+    void drawBackground(BandCanvas& canvas, RenderingContext const& context)
+    {
+        auto const& parameters = context.parameters;
+        auto const& imageSize = context.imageSize;
+        auto zoom = context.zoom;
+
+        IntVector2D outsideRectUpperLeft{-std::min(toInt(context.rectUpperLeft.x * zoom), 0), -std::min(toInt(context.rectUpperLeft.y * zoom), 0)};
+        IntVector2D outsideRectLowerRight{
+            imageSize.x - std::max(toInt((context.rectLowerRight.x - toFloat(context.worldSize.x)) * zoom), 0),
+            imageSize.y - std::max(toInt((context.rectLowerRight.y - toFloat(context.worldSize.y)) * zoom), 0)};
+
+        auto baseColor = toColor(parameters.backgroundColor);
+        Color spotColors[MAX_SPOTS];
+        for (int i = 0; i < parameters.numSpots; ++i) {
+            spotColors[i] = toColor(parameters.spots[i].color);
+        }
+
+        for (int y = canvas.getBeginY(); y < canvas.getEndY(); ++y) {
+            auto beginX = 0;
+            auto endX = imageSize.x;
+            if (!parameters.borderlessRendering) {
+                if (y < outsideRectUpperLeft.y || y >= outsideRectLowerRight.y) {
+                    endX = 0;
+                } else {
+                    beginX = std::clamp(outsideRectUpperLeft.x, 0, imageSize.x);
+                    endX = std::clamp(outsideRectLowerRight.x, beginX, imageSize.x);
+                }
+                canvas.setPixels(y, 0, beginX, Color());
+                canvas.setPixels(y, endX, imageSize.x, Color());
+            }
+            if (parameters.numSpots == 0) {
+                canvas.setPixels(y, beginX, endX, baseColor);
+            } else {
+                for (int x = beginX; x < endX; ++x) {
+                    RealVector2D worldPos{toFloat(x) / zoom + context.rectUpperLeft.x, toFloat(y) / zoom + context.rectUpperLeft.y};
+                    canvas.setPixels(y, x, x + 1, calcSpotMixedColor(context, worldPos, baseColor, spotColors));
+                }
+            }
+        }
+
+        if (!parameters.gridLines) {
+            return;
+        }
+        auto viewWidth = std::max(1.0f, context.rectLowerRight.x - context.rectUpperLeft.x);
+        auto pixelInWorldSize = viewWidth / toFloat(context.worldSize.x);
+        auto gridDistance = std::pow(10.0f, std::trunc(std::log10(viewWidth))) / 10.0f;
+        auto maxGridDistance = viewWidth / 10;
+        auto gridRemainder = (maxGridDistance - gridDistance) / maxGridDistance;
+        auto drawGridLine = [&](int x, int y, float distance, float intensity) {
+            if (std::abs(distance) <= pixelInWorldSize * 8) {
+                auto viewDistance = std::max(0.0f, 0.1f - std::abs(distance) * zoom / 10) * intensity * 0.7f;
+                canvas.addPixel(x, y, {viewDistance, viewDistance, viewDistance});
+            }
+        };
+        for (int y = canvas.getBeginY(); y < canvas.getEndY(); ++y) {
+            for (int x = 0; x < imageSize.x; ++x) {
+                RealVector2D worldPos{toFloat(x) / zoom + context.rectUpperLeft.x, toFloat(y) / zoom + context.rectUpperLeft.y};
+                drawGridLine(x, y, Math::modulo(worldPos.x + gridDistance / 2, gridDistance) - gridDistance / 2, gridRemainder);
+                drawGridLine(x, y, Math::modulo(worldPos.y + gridDistance / 2, gridDistance) - gridDistance / 2, gridRemainder);
+                drawGridLine(x, y, Math::modulo(worldPos.x + gridDistance / 20, gridDistance / 10) - gridDistance / 20, 1.0f - gridRemainder);
+                drawGridLine(x, y, Math::modulo(worldPos.y + gridDistance / 20, gridDistance / 10) - gridDistance / 20, 1.0f - gridRemainder);
+            }
+        }
+    }
+
+    void drawArrows(BandCanvas& canvas, RenderingContext const& context, CellDescription const& cell, Color const& lineColor)
+    {
+        if (!cell.inputExecutionOrderNumber || *cell.inputExecutionOrderNumber == cell.executionOrderNumber) {
+            return;
+        }
+        for (auto const& connection : cell.connections) {
+            auto otherCell = context.findCell(connection.cellId);
+            if (!otherCell || otherCell->executionOrderNumber != *cell.inputExecutionOrderNumber || otherCell->outputBlocked) {
+                continue;
+            }
+            auto otherCellPos = cell.pos + context.space.getCorrectedDirection(otherCell->pos - cell.pos);
+            auto otherCellImagePos = context.mapWorldPosToImagePos(otherCellPos);
+            if (!context.isContainedInImage(otherCellImagePos)) {
+                continue;
+            }
+            auto arrowEnd = context.mapWorldPosToImagePos(cell.pos + normalized(otherCellPos - cell.pos) / 3);
+            if (!context.isContainedInImage(arrowEnd)) {
+                continue;
+            }
+            auto direction = normalized(arrowEnd - otherCellImagePos);
+            for (auto const& arrowPartDirection : {RealVector2D{-direction.x + direction.y, -direction.x - direction.y}, RealVector2D{-direction.x - direction.y, direction.x - direction.y}}) {
+                auto arrowPartStart = arrowPartDirection * context.zoom / 8 + arrowEnd;
+                if (context.isLineVisible(arrowPartStart, arrowEnd)) {
+                    canvas.drawLine(arrowPartStart, arrowEnd, lineColor, 0.5f);
+                }
+            }
+        }
+    }
+
+    void drawCell(BandCanvas& canvas, RenderingContext const& context, CellDescription const& cell, RealVector2D const& cellImagePos)
+    {
+        auto zoom = context.zoom;
+        auto shadedCells = zoom >= ZoomLevelForShadedCells;
+
+        //draw background for cell
+        auto backgroundColor = calcColor(context, cell, context.backgroundColoring) * 0.85f;
+        canvas.drawCircle(cellImagePos, backgroundColor * 0.6f, zoom / 2.5f, false, false);
+
+        //draw foreground for cell
+        auto foregroundColor =
+            context.backgroundColoring == context.foregroundColoring ? backgroundColor : calcColor(context, cell, context.foregroundColoring) * 0.85f;
+        auto radius = zoom / 3;
+        canvas.drawCircle(cellImagePos, foregroundColor * 0.4f, radius, shadedCells, true);
+
+        //draw activity
+        if (zoom >= context.parameters.zoomLevelNeuronalActivity && isActive(cell)) {
+            canvas.drawCircle(cellImagePos, {0.3f, 0.3f, 0.3f}, radius, shadedCells);
+        }
+
+        //draw detonation
+        if (auto detonationRadius = calcDetonationRadius(context, cell)) {
+            canvas.drawCircle(cellImagePos, {0.3f, 0.3f, 0.0f}, *detonationRadius, shadedCells);
+        }
+
+        //draw connections
+        auto lineColor = backgroundColor * (std::min((zoom - 1.0f) / 3, 1.0f) * 2 * 0.7f);
+        if (zoom >= ZoomLevelForConnections) {
+            forEachConnectionLine(context, cell, [&](RealVector2D const& startImagePos, RealVector2D const& endImagePos) {
+                canvas.drawLine(startImagePos, endImagePos, lineColor);
+            });
+        }
+
+        //draw arrows
+        if (zoom >= ZoomLevelForArrows) {
+            drawArrows(canvas, context, cell, lineColor);
+        }
+    }
+
+    void drawRadiationSources(BandCanvas& canvas, RenderingContext const& context)
+    {
+        for (int i = 0; i < context.parameters.numParticleSources; ++i) {
+            RealVector2D sourcePos{context.parameters.particleSources[i].posX, context.parameters.particleSources[i].posY};
+            auto imagePos = context.mapWorldPosToImagePos(sourcePos);
+            if (context.isContainedInImage(imagePos)) {
+                for (int delta = -5; delta <= 5; ++delta) {
+                    canvas.setRawPixel(toInt(imagePos.x) + delta, toInt(imagePos.y), {511.0f, 0, 0});
+                    canvas.setRawPixel(toInt(imagePos.x), toInt(imagePos.y) + delta, {511.0f, 0, 0});
+                }
+            }
+        }
+    }
+
+    //repeats the world outside of the universe image in case of borderless rendering
+    void drawRepetition(ImagePlanes& planes, RenderingContext const& context, int beginY, int endY)
+    {
+        auto universeImageSizeX = toInt(context.universeImageSize.x);
+        auto universeImageSizeY = toInt(context.universeImageSize.y);
+        for (int y = beginY; y < endY; ++y) {
+            auto refY = toInt(Math::modulo(toFloat(y), context.universeImageSize.y));
+            for (int x = 0; x < planes.size.x; ++x) {
+                if (x < universeImageSizeX && y < universeImageSizeY) {
+                    continue;
+                }
+                auto refX = toInt(Math::modulo(toFloat(x), context.universeImageSize.x));
+                if (refX >= 0 && refX < planes.size.x && refY >= 0 && refY < planes.size.y) {
+                    auto index = x + y * planes.size.x;
+                    auto refIndex = refX + refY * planes.size.x;
+                    planes.red[index] = planes.red[refIndex];
+                    planes.green[index] = planes.green[refIndex];
+                    planes.blue[index] = planes.blue[refIndex];
+                }
+            }
+        }
+    }
+
+    //the display shader maps the channels nonlinearly and adds the mapped image to itself if glow is disabled
+    uint8_t mapColorChannel(float rawValue)
+    {
+        auto value = std::min(rawValue, 65535.0f) / 65535.0f;
+        auto mappedValue = std::clamp(std::sqrt(value * 256.0f) - 0.7f + 0.5f, 0.0f, 1.0f);
+        return static_cast<uint8_t>(std::min(mappedValue * 2, 1.0f) * 255.0f + 0.5f);
+    }
+
+    void appendUInt32(std::string& target, uint32_t value)
+    {
+        target.push_back(static_cast<char>((value >> 24) & 0xff));
+        target.push_back(static_cast<char>((value >> 16) & 0xff));
+        target.push_back(static_cast<char>((value >> 8) & 0xff));
+        target.push_back(static_cast<char>(value & 0xff));
+    }
+
+    void appendPngChunk(std::string& target, char const* type, std::string const& data)
+    {
+        appendUInt32(target, static_cast<uint32_t>(data.size()));
+        auto chunkBegin = target.size();
+        target.append(type, 4);
+        target.append(data);
+        auto crc = crc32(0, reinterpret_cast<Bytef const*>(target.data() + chunkBegin), static_cast<uInt>(target.size() - chunkBegin));
+        appendUInt32(target, static_cast<uint32_t>(crc));
+    }
+}
+
+RgbaImage SoftwareRenderingService::render(
+    DataDescription const& data,
+    IntVector2D const& worldSize,
+    uint64_t timestep,
+    SimulationParameters const& parameters,
+    RenderingViewport const& viewport)
+{
+    auto const& imageSize = viewport.imageSize;
+    CHECK(imageSize.x > 0 && imageSize.y > 0 && viewport.zoom > 0);
+
+    RenderingContext context{data, parameters, SpaceCalculator(worldSize)};
+    context.timestep = timestep;
+    context.zoom = viewport.zoom;
+    context.worldSize = worldSize;
+    context.imageSize = imageSize;
+    RealVector2D halfViewSize{toFloat(imageSize.x) / 2 / viewport.zoom, toFloat(imageSize.y) / 2 / viewport.zoom};
+    context.rectUpperLeft = viewport.center - halfViewSize;
+    context.rectLowerRight = viewport.center + halfViewSize;
+    context.universeImageSize = RealVector2D{toFloat(worldSize.x), toFloat(worldSize.y)} * viewport.zoom;
+    context.backgroundColoring = parameters.cellColoring == CellColoring_MutationId_AllCellFunction ? CellColoring_MutationId : parameters.cellColoring;
+    context.foregroundColoring = parameters.cellColoring == CellColoring_MutationId_AllCellFunction ? CellColoring_AllCellFunction : parameters.cellColoring;
+    context.cellIndexById.reserve(data.cells.size());
+    for (int i = 0; i < toInt(data.cells.size()); ++i) {
+        context.cellIndexById.emplace(data.cells.at(i).id, i);
+    }
+
+    //determine the bands each object overlaps
+    std::vector<Placement> cellPlacements(data.cells.size());
+    ParallelExecution::forEachInChunks(data.cells.size(), PlacementChunkSize, [&](size_t index) {
+        cellPlacements[index] = calcPlacement(context, data.cells[index]);
+    });
+    std::vector<Placement> particlePlacements(data.particles.size());
+    ParallelExecution::forEachInChunks(data.particles.size(), PlacementChunkSize, [&](size_t index) {
+        particlePlacements[index] = calcPlacement(context, data.particles[index]);
+    });
+
+    auto numBands = (imageSize.y + BandHeight - 1) / BandHeight;
+    auto assignToBands = [&](std::vector<Placement> const& placements) {
+        std::vector<std::vector<int>> result(numBands);
+        for (int i = 0; i < toInt(placements.size()); ++i) {
+            auto const& placement = placements[i];
+            if (!placement.visible) {
+                continue;
+            }
+            auto firstBand = std::clamp(toInt(std::floor(placement.minY)) / BandHeight, 0, numBands - 1);
+            auto lastBand = std::clamp(toInt(std::floor(placement.maxY) + 1) / BandHeight, 0, numBands - 1);
+            for (auto band = firstBand; band <= lastBand; ++band) {
+                result[band].emplace_back(i);
+            }
+        }
+        return result;
+    };
+    auto cellIndicesByBand = assignToBands(cellPlacements);
+    auto particleIndicesByBand = assignToBands(particlePlacements);
+
+    //draw bands in the order of the rendering kernels
+    ImagePlanes planes;
+    planes.size = imageSize;
+    planes.red.resize(imageSize.x * imageSize.y);
+    planes.green.resize(imageSize.x * imageSize.y);
+    planes.blue.resize(imageSize.x * imageSize.y);
+    ParallelExecution::forEach(numBands, [&](size_t band) {
+        BandCanvas canvas(planes, toInt(band) * BandHeight, std::min(toInt(band + 1) * BandHeight, imageSize.y));
+        drawBackground(canvas, context);
+        for (auto const& index : cellIndicesByBand[band]) {
+            drawCell(canvas, context, data.cells[index], cellPlacements[index].imagePos);
+        }
+        for (auto const& index : particleIndicesByBand[band]) {
+            canvas.drawCircle(particlePlacements[index].imagePos, calcColor(data.particles[index]), viewport.zoom / 3);
+        }
+        drawRadiationSources(canvas, context);
+    });
+
+    //the pixels inside the universe image are only read by the repetition
+    if (parameters.borderlessRendering) {
+        ParallelExecution::forEach(numBands, [&](size_t band) {
+            drawRepetition(planes, context, toInt(band) * BandHeight, std::min(toInt(band + 1) * BandHeight, imageSize.y));
+        });
+    }
+
+    RgbaImage result;
+    result.size = imageSize;
+    result.pixels.resize(imageSize.x * imageSize.y * 4);
+    ParallelExecution::forEachInChunks(imageSize.x * imageSize.y, BandHeight * imageSize.x, [&](size_t index) {
+        result.pixels[index * 4] = mapColorChannel(planes.red[index]);
+        result.pixels[index * 4 + 1] = mapColorChannel(planes.green[index]);
+        result.pixels[index * 4 + 2] = mapColorChannel(planes.blue[index]);
+        result.pixels[index * 4 + 3] = 255;
+    });
+    return result;
+}
+
+RenderingViewport SoftwareRenderingService::calcViewportForWorld(IntVector2D const& worldSize, IntVector2D const& imageSize)
+{
+    RenderingViewport result;
+    result.center = {toFloat(worldSize.x) / 2, toFloat(worldSize.y) / 2};
+    result.zoom = std::min(toFloat(imageSize.x) / toFloat(worldSize.x), toFloat(imageSize.y) / toFloat(worldSize.y));
+    result.imageSize = imageSize;
+    return result;
+}
+
+bool SoftwareRenderingService::writePng(std::string const& filename, RgbaImage const& image)
+{
+    //scanlines with filter type 1 (difference to the left pixel)
+    auto rowSize = image.size.x * 4;
+    std::string scanlines(toInt(image.size.y) * (rowSize + 1), 0);
+    for (int y = 0; y < image.size.y; ++y) {
+        auto source = image.pixels.data() + y * rowSize;
+        auto target = scanlines.data() + y * (rowSize + 1);
+        target[0] = 1;
+        for (int i = 0; i < rowSize; ++i) {
+            target[i + 1] = static_cast<char>(i < 4 ? source[i] : source[i] - source[i - 4]);
+        }
+    }
+    auto compressedSize = compressBound(static_cast<uLong>(scanlines.size()));
+    std::string compressedScanlines(compressedSize, 0);
+    if (compress2(
+            reinterpret_cast<Bytef*>(compressedScanlines.data()),
+            &compressedSize,
+            reinterpret_cast<Bytef const*>(scanlines.data()),
+            static_cast<uLong>(scanlines.size()),
+            Z_BEST_SPEED)
+        != Z_OK) {
+        return false;
+    }
+    compressedScanlines.resize(compressedSize);
+
+    std::string header;
+    appendUInt32(header, static_cast<uint32_t>(image.size.x));
+    appendUInt32(header, static_cast<uint32_t>(image.size.y));
+    header.append({8, 6, 0, 0, 0});  //bit depth, color type RGBA, compression, filter and interlace method
+
+    std::string png("\x89PNG\r\n\x1a\n", 8);
+    appendPngChunk(png, "IHDR", header);
+    appendPngChunk(png, "IDAT", compressedScanlines);
+    appendPngChunk(png, "IEND", {});
+
+    std::ofstream stream(filename, std::ios::binary);
+    if (!stream) {
+        return false;
+    }
+    stream.write(png.data(), png.size());
+    return stream.good();
+}
+
+bool SoftwareRenderingService::writeRawFrame(std::ostream& stream, RgbaImage const& image)
+{
+    stream.write(reinterpret_cast<char const*>(image.pixels.data()), image.pixels.size());
+    return stream.good();
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Base/Vector2D.h"
+
+#include "Descriptions.h"
+#include "SimulationParameters.h"
+
+struct RenderingViewport
+{
+    RealVector2D center;
+    float zoom = 1.0f;  //pixels per world unit
+    IntVector2D imageSize = {1280, 720};
+};
+
+//pixels are stored row by row with 4 bytes (red, green, blue, alpha) per pixel
+struct RgbaImage
+{
+    IntVector2D size;
+    std::vector<uint8_t> pixels;
+};
+
+/**
+ * Renders simulation data on the host with the appearance of the rendering kernels and the display shader (without
+ * glow and motion blur), e.g. for headless runs.
+ * The image is divided into horizontal bands which are drawn in parallel. Each band draws all objects overlapping it
+ * into its own rows of floating-point color planes such that no synchronization between the threads is needed.
+ */
+class SoftwareRenderingService
+{
+public:
+    static RgbaImage render(
+        DataDescription const& data,
+        IntVector2D const& worldSize,
+        uint64_t timestep,
+        SimulationParameters const& parameters,
+        RenderingViewport const& viewport);
+
+    //viewport showing the whole world
+    static RenderingViewport calcViewportForWorld(IntVector2D const& worldSize, IntVector2D const& imageSize);
+
+    static bool writePng(std::string const& filename, RgbaImage const& image);
+    static bool writeRawFrame(std::ostream& stream, RgbaImage const& image);  //pixels without header
+};
@@ -0,0 +1,265 @@
+#include "SpatialGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Base/Math.h"
+
+namespace
+{
+    auto constexpr MinNumInsertedIndicesForRebuild = 256;
+    auto constexpr MinMaxNumGridCells = 1024;
+
+    int getPeriodicCoordinate(int value, int size)
+    {
+        value %= size;
+        return value < 0 ? value + size : value;
+    }
+}
+
+SpatialGrid::SpatialGrid(float cellSize, std::optional<IntVector2D> const& worldSize)
+    : _minCellSize(std::max(cellSize, std::numeric_limits<float>::epsilon()))
+    , _worldSize(worldSize)
+{
+    rebuild();
+}
+
+SpatialGrid::SpatialGrid(std::vector<RealVector2D> const& positions, float cellSize, std::optional<IntVector2D> const& worldSize)
+    : _minCellSize(std::max(cellSize, std::numeric_limits<float>::epsilon()))
+    , _worldSize(worldSize)
+{
+    _positions.reserve(positions.size());
+    for (auto const& pos : positions) {
+        _positions.emplace_back(getCorrectedPosition(pos));
+    }
+    rebuild();
+}
+
+void SpatialGrid::clear()
+{
+    _positions.clear();
+    rebuild();
+}
+
+int SpatialGrid::insert(RealVector2D const& pos)
+{
+    auto index = toInt(_positions.size());
+    _positions.emplace_back(getCorrectedPosition(pos));
+
+    auto const& correctedPos = _positions.back();
+    _insertedIndicesByGridIndex[getGridIndex(getGridCoordinateX(correctedPos.x), getGridCoordinateY(correctedPos.y))].emplace_back(index);
+    ++_numInsertedIndices;
+    if (_numInsertedIndices > std::max(MinNumInsertedIndicesForRebuild, toInt(_sortedIndices.size()))) {
+        rebuild();
+    }
+    return index;
+}
+
+int SpatialGrid::getNumEntries() const
+{
+    return toInt(_positions.size());
+}
+
+RealVector2D const& SpatialGrid::getPos(int index) const
+{
+    return _positions.at(index);
+}
+
+bool SpatialGrid::isOccupied(RealVector2D const& pos, float radius) const
+{
+    auto correctedPos = getCorrectedPosition(pos);
+    return forEachEntryNearby(correctedPos, radius, [&](int index) { return getDistance(_positions[index], correctedPos) < radius; });
+}
+
+std::vector<int> SpatialGrid::getEntriesWithinRadius(RealVector2D const& pos, float radius) const
+{
+    auto correctedPos = getCorrectedPosition(pos);
+    std::vector<int> result;
+    forEachEntryNearby(correctedPos, radius, [&](int index) {
+        if (getDistance(_positions[index], correctedPos) <= radius) {
+            result.emplace_back(index);
+        }
+        return false;
+    });
+    return result;
+}
+
+std::optional<int> SpatialGrid::getNearestEntry(RealVector2D const& pos, float maxRadius) const
+{
+    auto correctedPos = getCorrectedPosition(pos);
+    std::optional<int> result;
+    auto minDistance = maxRadius;
+    forEachEntryNearby(correctedPos, maxRadius, [&](int index) {
+        auto distance = getDistance(_positions[index], correctedPos);
+        if (distance < minDistance || (distance == minDistance && !result)) {
+            minDistance = distance;
+            result = index;
+        }
+        return false;
+    });
+    return result;
+}
+
+float SpatialGrid::getDistance(RealVector2D const& pos1, RealVector2D const& pos2) const
+{
+    auto displacement = pos1 - pos2;
+    if (_worldSize) {
+        auto worldSizeX = toFloat(_worldSize->x);
+        auto worldSizeY = toFloat(_worldSize->y);
+        displacement.x -= std::round(displacement.x / worldSizeX) * worldSizeX;
+        displacement.y -= std::round(displacement.y / worldSizeY) * worldSizeY;
+    }
+    return Math::length(displacement);
+}
+
+RealVector2D SpatialGrid::getCorrectedPosition(RealVector2D const& pos) const
+{
+    if (!_worldSize) {
+        return pos;
+    }
+    auto worldSizeX = toFloat(_worldSize->x);
+    auto worldSizeY = toFloat(_worldSize->y);
+    RealVector2D result{pos.x - std::floor(pos.x / worldSizeX) * worldSizeX, pos.y - std::floor(pos.y / worldSizeY) * worldSizeY};
+
+    //rounding errors may yield the world size
+    if (result.x >= worldSizeX) {
+        result.x = 0;
+    }
+    if (result.y >= worldSizeY) {
+        result.y = 0;
+    }
+    return result;
+}
+
+void SpatialGrid::rebuild()
+{
+    auto numEntries = toInt(_positions.size());
+
+    //determine grid layout
+    RealVector2D extent;
+    if (_worldSize) {
+        _origin = {0, 0};
+        extent = {toFloat(_worldSize->x), toFloat(_worldSize->y)};
+    } else if (numEntries > 0) {
+        RealVector2D minPos = _positions.front();
+        RealVector2D maxPos = _positions.front();
+        for (auto const& pos : _positions) {
+            minPos.x = std::min(minPos.x, pos.x);
+            minPos.y = std::min(minPos.y, pos.y);
+            maxPos.x = std::max(maxPos.x, pos.x);
+            maxPos.y = std::max(maxPos.y, pos.y);
+        }
+        _origin = minPos;
+        extent = maxPos - minPos;
+    } else {
+        _origin = {0, 0};
+        extent = {0, 0};
+    }
+
+    //the number of grid cells is bounded by the number of entries to avoid huge offset arrays for sparse data
+    auto numCellsX = std::max(1.0f, std::floor(extent.x / _minCellSize));
+    auto numCellsY = std::max(1.0f, std::floor(extent.y / _minCellSize));
+    auto maxNumCells = toFloat(std::max(MinMaxNumGridCells, 4 * numEntries));
+    if (numCellsX * numCellsY > maxNumCells) {
+        auto scaling = std::sqrt(numCellsX * numCellsY / maxNumCells);
+        numCellsX = std::max(1.0f, std::floor(numCellsX / scaling));
+        numCellsY = std::max(1.0f, std::floor(numCellsY / scaling));
+    }
+    _numCellsX = toInt(numCellsX);
+    _numCellsY = toInt(numCellsY);
+    if (_worldSize) {
+        _cellSize = {extent.x / numCellsX, extent.y / numCellsY};
+    } else {
+        //border grid cells also contain entries outside the bounding box, in particular entries inserted later on
+        _cellSize = {std::max(_minCellSize, extent.x / numCellsX), std::max(_minCellSize, extent.y / numCellsY)};
+    }
+
+    //counting sort of the entries by grid index
+    std::vector<int> gridIndices(numEntries);
+    _offsets.assign(_numCellsX * _numCellsY + 1, 0);
+    for (int i = 0; i < numEntries; ++i) {
+        auto const& pos = _positions[i];
+        gridIndices[i] = getGridIndex(getGridCoordinateX(pos.x), getGridCoordinateY(pos.y));
+        ++_offsets[gridIndices[i] + 1];
+    }
+    for (size_t i = 1; i < _offsets.size(); ++i) {
+        _offsets[i] += _offsets[i - 1];
+    }
+    _sortedIndices.resize(numEntries);
+    std::vector<int> insertPositions(_offsets.begin(), _offsets.end() - 1);
+    for (int i = 0; i < numEntries; ++i) {
+        _sortedIndices[insertPositions[gridIndices[i]]++] = i;
+    }
+
+    _insertedIndicesByGridIndex.clear();
+    _numInsertedIndices = 0;
+}
+
+int SpatialGrid::getGridIndex(int x, int y) const
+{
+    return x + y * _numCellsX;
+}
+
+int SpatialGrid::getGridCoordinateX(float x) const
+{
+    auto result = toInt(std::floor((x - _origin.x) / _cellSize.x));
+    return _worldSize ? getPeriodicCoordinate(result, _numCellsX) : std::max(0, std::min(_numCellsX - 1, result));
+}
+
+int SpatialGrid::getGridCoordinateY(float y) const
+{
+    auto result = toInt(std::floor((y - _origin.y) / _cellSize.y));
+    return _worldSize ? getPeriodicCoordinate(result, _numCellsY) : std::max(0, std::min(_numCellsY - 1, result));
+}
+
+template <typename Func>
+bool SpatialGrid::forEachEntryNearby(RealVector2D const& pos, float radius, Func const& func) const
+{
+    auto processGridCell = [&](int gridIndex) {
+        for (int i = _offsets[gridIndex]; i < _offsets[gridIndex + 1]; ++i) {
+            if (func(_sortedIndices[i])) {
+                return true;
+            }
+        }
+        if (_numInsertedIndices > 0) {
+            auto findResult = _insertedIndicesByGridIndex.find(gridIndex);
+            if (findResult != _insertedIndicesByGridIndex.end()) {
+                for (auto const& index : findResult->second) {
+                    if (func(index)) {
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    };
+
+    if (_worldSize) {
+        auto startX = toInt(std::floor((pos.x - radius) / _cellSize.x));
+        auto startY = toInt(std::floor((pos.y - radius) / _cellSize.y));
+        auto numX = std::min(_numCellsX, toInt(std::floor((pos.x + radius) / _cellSize.x)) - startX + 1);
+        auto numY = std::min(_numCellsY, toInt(std::floor((pos.y + radius) / _cellSize.y)) - startY + 1);
+        for (int dy = 0; dy < numY; ++dy) {
+            auto y = getPeriodicCoordinate(startY + dy, _numCellsY);
+            for (int dx = 0; dx < numX; ++dx) {
+                if (processGridCell(getGridIndex(getPeriodicCoordinate(startX + dx, _numCellsX), y))) {
+                    return true;
+                }
+            }
+        }
+    } else {
+        auto startX = getGridCoordinateX(pos.x - radius);
+        auto startY = getGridCoordinateY(pos.y - radius);
+        auto endX = getGridCoordinateX(pos.x + radius);
+        auto endY = getGridCoordinateY(pos.y + radius);
+        for (int y = startY; y <= endY; ++y) {
+            for (int x = startX; x <= endX; ++x) {
+                if (processGridCell(getGridIndex(x, y))) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "Base/Definitions.h"
+#include "Base/Vector2D.h"
+
+/**
+ * Uniform grid for radius and nearest neighbor queries on positions.
+ * The entries are stored sorted by grid cell in one array plus an offset array per grid cell. Entries which are
+ * inserted after construction are kept in a small per-grid-cell overflow map which is merged into the sorted arrays
+ * once it becomes as large as them (amortized constant insertion time).
+ * If a world size is given, positions and distances are periodic with respect to it.
+ */
+class SpatialGrid
+{
+public:
+    SpatialGrid(float cellSize = 1.0f, std::optional<IntVector2D> const& worldSize = std::nullopt);
+    SpatialGrid(std::vector<RealVector2D> const& positions, float cellSize, std::optional<IntVector2D> const& worldSize = std::nullopt);
+
+    void clear();
+    int insert(RealVector2D const& pos);  //returns the index of the entry
+
+    int getNumEntries() const;
+    RealVector2D const& getPos(int index) const;  //corrected position in case of periodic grid
+
+    //true if an entry has a distance less than radius
+    bool isOccupied(RealVector2D const& pos, float radius) const;
+
+    //indices of all entries with a distance less than or equal to radius (in no particular order)
+    std::vector<int> getEntriesWithinRadius(RealVector2D const& pos, float radius) const;
+
+    std::optional<int> getNearestEntry(RealVector2D const& pos, float maxRadius) const;
+
+    float getDistance(RealVector2D const& pos1, RealVector2D const& pos2) const;
+
+private:
+    RealVector2D getCorrectedPosition(RealVector2D const& pos) const;
+    void rebuild();
+    int getGridIndex(int x, int y) const;
+    int getGridCoordinateX(float x) const;
+    int getGridCoordinateY(float y) const;
+
+    //calls func(index) for all entries in the grid cells intersecting the square around pos, stops if func returns true
+    template <typename Func>
+    bool forEachEntryNearby(RealVector2D const& pos, float radius, Func const& func) const;
+
+    float _minCellSize = 1.0f;
+    std::optional<IntVector2D> _worldSize;
+    std::vector<RealVector2D> _positions;
+
+    //sorted part
+    RealVector2D _origin;
+    RealVector2D _cellSize = {1.0f, 1.0f};
+    int _numCellsX = 1;
+    int _numCellsY = 1;
+    std::vector<int> _offsets;  //size: number of grid cells + 1
+    std::vector<int> _sortedIndices;
+
+    //overflow part
+    std::unordered_map<int, std::vector<int>> _insertedIndicesByGridIndex;
+    int _numInsertedIndices = 0;
+};
@@ -1,23 +1,341 @@
 #include "StatisticsHistory.h"
 
+#include <algorithm>
+#include <cmath>
+
+#include "Base/Definitions.h"
+
+using namespace StatisticsHistoryConstants;
+
+static_assert(sizeof(DataPointCollection) == NumColumns * sizeof(double));
+
+namespace
+{
+    double* getValues(DataPointCollection& dataPoint)
+    {
+        return reinterpret_cast<double*>(&dataPoint);
+    }
+
+    double const* getValues(DataPointCollection const& dataPoint)
+    {
+        return reinterpret_cast<double const*>(&dataPoint);
+    }
+}
+
+int _StatisticsHistorySnapshot::getNumDataPoints() const
+{
+    return _numDataPoints;
+}
+
+DataPointCollection _StatisticsHistorySnapshot::getDataPoint(int index) const
+{
+    DataPointCollection result;
+    auto values = getValues(result);
+    for (int column = 0; column < NumColumns; ++column) {
+        values[column] = getValue(index, column);
+    }
+    return result;
+}
+
+double _StatisticsHistorySnapshot::getTime(int index) const
+{
+    return getValue(index, 0);
+}
+
+StatisticsHistoryData _StatisticsHistorySnapshot::getData() const
+{
+    StatisticsHistoryData result(_numDataPoints);
+    forEachSegment(0, _numDataPoints, [&](StatisticsHistoryChunk const& chunk, int rowBegin, int rowEnd, int index) {
+        for (int column = 0; column < NumColumns; ++column) {
+            auto columnValues = chunk.values + column * ChunkSize;
+            for (int row = rowBegin; row < rowEnd; ++row) {
+                getValues(result[index + row - rowBegin])[column] = columnValues[row];
+            }
+        }
+    });
+    return result;
+}
+
+StatisticsHistoryData _StatisticsHistorySnapshot::getData(double startTime, double endTime, int maxDataPoints) const
+{
+    //times are ascending
+    auto findFirstIndex = [&](auto const& predicate) {
+        int low = 0;
+        int high = _numDataPoints;
+        while (low < high) {
+            auto mid = (low + high) / 2;
+            if (predicate(getTime(mid))) {
+                high = mid;
+            } else {
+                low = mid + 1;
+            }
+        }
+        return low;
+    };
+    auto beginIndex = findFirstIndex([&](double time) { return time >= startTime; });
+    auto endIndex = findFirstIndex([&](double time) { return time > endTime; });
+    auto numDataPoints = std::max(0, endIndex - beginIndex);
+    if (numDataPoints == 0 || maxDataPoints <= 0) {
+        return {};
+    }
+
+    auto groupSize = (numDataPoints + maxDataPoints - 1) / maxDataPoints;
+    StatisticsHistoryData result((numDataPoints + groupSize - 1) / groupSize, DataPointCollection());
+    std::vector<int> numSummands(result.size(), 0);
+    forEachSegment(beginIndex, endIndex, [&](StatisticsHistoryChunk const& chunk, int rowBegin, int rowEnd, int index) {
+        for (int row = rowBegin; row < rowEnd; ++row) {
+            ++numSummands[(index + row - rowBegin - beginIndex) / groupSize];
+        }
+        for (int column = 0; column < NumColumns; ++column) {
+            auto columnValues = chunk.values + column * ChunkSize;
+            for (int row = rowBegin; row < rowEnd; ++row) {
+                getValues(result[(index + row - rowBegin - beginIndex) / groupSize])[column] += columnValues[row];
+            }
+        }
+    });
+
+    //the time of an averaged data point is the time of its first data point as in StatisticsHistory
+    for (size_t i = 0; i < result.size(); ++i) {
+        result[i] = result[i] / toDouble(numSummands[i]);
+        result[i].time = getTime(beginIndex + toInt(i) * groupSize);
+    }
+    return result;
+}
+
+StatisticsHistoryData _StatisticsHistorySnapshot::getFullResolutionData(uint64_t sequenceNumber) const
+{
+    auto const& finestTier = _tiers.back();
+    auto firstSequenceNumber = _nextSequenceNumber - finestTier.numRows;
+    auto beginSequenceNumber = std::max(sequenceNumber, firstSequenceNumber);
+    if (beginSequenceNumber >= _nextSequenceNumber) {
+        return {};
+    }
+    StatisticsHistoryData result;
+    result.reserve(_nextSequenceNumber - beginSequenceNumber);
+    for (auto index = _tierStartIndices.back() + toInt(beginSequenceNumber - firstSequenceNumber); index < _numDataPoints; ++index) {
+        result.emplace_back(getDataPoint(index));
+    }
+    return result;
+}
+
+uint64_t _StatisticsHistorySnapshot::getNextSequenceNumber() const
+{
+    return _nextSequenceNumber;
+}
+
+double _StatisticsHistorySnapshot::getValue(int index, int column) const
+{
+    auto tierIndex = toInt(std::upper_bound(_tierStartIndices.begin(), _tierStartIndices.end(), index) - _tierStartIndices.begin()) - 1;
+    while (_tiers[tierIndex].numRows == 0) {
+        --tierIndex;
+    }
+    auto const& tier = _tiers[tierIndex];
+    auto row = tier.startRow + index - _tierStartIndices[tierIndex];
+    return tier.chunks[row / ChunkSize]->values[column * ChunkSize + row % ChunkSize];
+}
+
+template <typename Func>
+void _StatisticsHistorySnapshot::forEachSegment(int beginIndex, int endIndex, Func const& func) const
+{
+    for (size_t tierIndex = 0; tierIndex < _tiers.size(); ++tierIndex) {
+        auto const& tier = _tiers[tierIndex];
+        auto tierBeginIndex = std::max(beginIndex, _tierStartIndices[tierIndex]);
+        auto tierEndIndex = std::min(endIndex, _tierStartIndices[tierIndex] + tier.numRows);
+        for (auto index = tierBeginIndex; index < tierEndIndex;) {
+            auto row = tier.startRow + index - _tierStartIndices[tierIndex];
+            auto rowInChunk = row % ChunkSize;
+            auto numRows = std::min(ChunkSize - rowInChunk, tierEndIndex - index);
+            func(*tier.chunks[row / ChunkSize], rowInChunk, rowInChunk + numRows, index);
+            index += numRows;
+        }
+    }
+}
+
+StatisticsHistory::StatisticsHistory()
+{
+    _tiers.resize(NumTiers);
+    publishSnapshot();
+}
+
+StatisticsHistorySnapshot StatisticsHistory::getSnapshot() const
+{
+    return _snapshot.load();
+}
 
 StatisticsHistoryData StatisticsHistory::getCopiedData() const
 {
-    std::lock_guard lock(_mutex);
-    return _data;
+    return getSnapshot()->getData();
+}
+
+std::optional<DataPointCollection> StatisticsHistory::getLastDataPoint() const
+{
+    auto snapshot = getSnapshot();
+    if (snapshot->getNumDataPoints() == 0) {
+        return std::nullopt;
+    }
+    return snapshot->getDataPoint(snapshot->getNumDataPoints() - 1);
+}
+
+void StatisticsHistory::add(DataPointCollection const& dataPoint)
+{
+    std::lock_guard lock(_writeMutex);
+
+    //the last data point is located in the finest non-empty tier
+    auto findResult = std::find_if(_tiers.begin(), _tiers.end(), [](auto const& tier) { return tier.numRows > 0; });
+    if (findResult != _tiers.end()) {
+        auto& tier = *findResult;
+        if (std::abs(getRow(tier, tier.numRows - 1).time - dataPoint.time) < NEAR_ZERO) {
+            truncateTier(tier, tier.numRows - 1);
+            if (findResult == _tiers.begin()) {
+                --_nextSequenceNumber;
+            }
+        }
+    }
+    addIntern(dataPoint);
+    publishSnapshot();
+}
+
+void StatisticsHistory::removeDataPoints(double fromTime)
+{
+    std::lock_guard lock(_writeMutex);
+
+    for (size_t tierIndex = 0; tierIndex < _tiers.size(); ++tierIndex) {
+        auto& tier = _tiers[tierIndex];
+        auto numRows = tier.numRows;
+        while (numRows > 0 && getRow(tier, numRows - 1).time >= fromTime) {
+            --numRows;
+        }
+        if (tierIndex == 0) {
+            _nextSequenceNumber -= tier.numRows - numRows;
+        }
+        truncateTier(tier, numRows);
+    }
+    publishSnapshot();
+}
+
+void StatisticsHistory::setData(StatisticsHistoryData const& data)
+{
+    std::lock_guard lock(_writeMutex);
+
+    _tiers.clear();
+    _tiers.resize(NumTiers);
+    _nextSequenceNumber = 0;
+    for (auto const& dataPoint : data) {
+        addIntern(dataPoint);
+    }
+    publishSnapshot();
 }
 
-std::mutex& StatisticsHistory::getMutex() const
+void StatisticsHistory::clear()
 {
-    return _mutex;
+    setData({});
+}
+
+void StatisticsHistory::addIntern(DataPointCollection const& dataPoint)
+{
+    addToTier(0, dataPoint);
+    ++_nextSequenceNumber;
+}
+
+void StatisticsHistory::addToTier(int tierIndex, DataPointCollection const& dataPoint)
+{
+    auto& tier = _tiers[tierIndex];
+    appendRow(tier, dataPoint);
+    if (tier.numRows <= TierSize) {
+        return;
+    }
+
+    if (tierIndex + 1 < NumTiers) {
+
+        //move the two oldest data points averaged to the next coarser tier
+        auto firstDataPoint = getRow(tier, 0);
+        DataPointCollection mergedDataPoint = (firstDataPoint + getRow(tier, 1)) / 2.0;
+        mergedDataPoint.time = firstDataPoint.time;
+
+        tier.startRow += 2;
+        tier.numRows -= 2;
+        while (tier.startRow >= ChunkSize) {
+            tier.chunks.pop_front();
+            tier.startRow -= ChunkSize;
+        }
+        addToTier(tierIndex + 1, mergedDataPoint);
+    } else {
+
+        //halve the resolution of the coarsest tier
+        Tier newTier;
+        for (int row = 0; row < tier.numRows; row += 2) {
+            auto dataPoint = getRow(tier, row);
+            if (row + 1 < tier.numRows) {
+                auto time = dataPoint.time;
+                dataPoint = (dataPoint + getRow(tier, row + 1)) / 2.0;
+                dataPoint.time = time;
+            }
+            appendRow(newTier, dataPoint);
+        }
+        tier = std::move(newTier);
+    }
+}
+
+void StatisticsHistory::appendRow(Tier& tier, DataPointCollection const& dataPoint)
+{
+    auto row = tier.startRow + tier.numRows;
+    if (row / ChunkSize == toInt(tier.chunks.size())) {
+        tier.chunks.emplace_back(std::make_shared<StatisticsHistoryChunk>());
+    }
+
+    //rows behind the filled rows are not visible to snapshots
+    auto& chunk = *tier.chunks[row / ChunkSize];
+    auto values = getValues(dataPoint);
+    for (int column = 0; column < NumColumns; ++column) {
+        chunk.values[column * ChunkSize + row % ChunkSize] = values[column];
+    }
+    ++tier.numRows;
+}
+
+void StatisticsHistory::truncateTier(Tier& tier, int numRows)
+{
+    if (numRows >= tier.numRows) {
+        return;
+    }
+    tier.numRows = numRows;
+    if (numRows == 0) {
+        tier.chunks.clear();
+        tier.startRow = 0;
+        return;
+    }
+    auto endRow = tier.startRow + numRows;
+    tier.chunks.resize((endRow + ChunkSize - 1) / ChunkSize);
+
+    //removed rows of the last chunk may still be visible to snapshots and must not be overwritten
+    if (endRow % ChunkSize != 0) {
+        tier.chunks.back() = std::make_shared<StatisticsHistoryChunk>(*tier.chunks.back());
+    }
 }
 
-StatisticsHistoryData& StatisticsHistory::getDataRef()
+DataPointCollection StatisticsHistory::getRow(Tier const& tier, int row) const
 {
-    return _data;
+    DataPointCollection result;
+    auto values = getValues(result);
+    auto const& chunk = *tier.chunks[(tier.startRow + row) / ChunkSize];
+    auto rowInChunk = (tier.startRow + row) % ChunkSize;
+    for (int column = 0; column < NumColumns; ++column) {
+        values[column] = chunk.values[column * ChunkSize + rowInChunk];
+    }
+    return result;
 }
 
-StatisticsHistoryData const& StatisticsHistory::getDataRef() const
+void StatisticsHistory::publishSnapshot()
 {
-    return _data;
+    auto snapshot = std::make_shared<_StatisticsHistorySnapshot>();
+    snapshot->_nextSequenceNumber = _nextSequenceNumber;
+    for (auto it = _tiers.rbegin(); it != _tiers.rend(); ++it) {
+        _StatisticsHistorySnapshot::Tier tier;
+        tier.chunks.assign(it->chunks.begin(), it->chunks.end());
+        tier.startRow = it->startRow;
+        tier.numRows = it->numRows;
+        snapshot->_tierStartIndices.emplace_back(snapshot->_numDataPoints);
+        snapshot->_numDataPoints += tier.numRows;
+        snapshot->_tiers.emplace_back(std::move(tier));
+    }
+    _snapshot.store(std::move(snapshot));
 }
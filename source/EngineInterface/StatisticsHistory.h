@@ -1,6 +1,10 @@
 #pragma once
 
+#include <atomic>
+#include <deque>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <vector>
 
 #include "DataPointCollection.h"
@@ -8,16 +12,94 @@
 
 using StatisticsHistoryData = std::vector<DataPointCollection>;
 
+namespace StatisticsHistoryConstants
+{
+    auto constexpr NumColumns = static_cast<int>(sizeof(DataPointCollection) / sizeof(double));  //a DataPointCollection consists only of doubles
+    auto constexpr ChunkSize = 64;  //number of data points per chunk
+    auto constexpr TierSize = 1024;  //max number of data points per tier
+    auto constexpr NumTiers = 8;
+}
+
+//data points in column-major order, filled rows are never modified
+struct StatisticsHistoryChunk
+{
+    double values[StatisticsHistoryConstants::NumColumns * StatisticsHistoryConstants::ChunkSize];
+};
+
+//immutable view of the history which can be read without synchronization
+class _StatisticsHistorySnapshot
+{
+public:
+    int getNumDataPoints() const;
+    DataPointCollection getDataPoint(int index) const;  //index 0 refers to the oldest data point
+    double getTime(int index) const;
+
+    StatisticsHistoryData getData() const;
+
+    //returns the data points within [startTime, endTime] where consecutive data points are averaged if their number exceeds maxDataPoints
+    StatisticsHistoryData getData(double startTime, double endTime, int maxDataPoints) const;
+
+    //data points in full resolution with a sequence number not less than sequenceNumber (as long as they are still in full resolution)
+    StatisticsHistoryData getFullResolutionData(uint64_t sequenceNumber) const;
+    uint64_t getNextSequenceNumber() const;
+
+private:
+    friend class StatisticsHistory;
+
+    struct Tier
+    {
+        std::vector<std::shared_ptr<StatisticsHistoryChunk const>> chunks;
+        int startRow = 0;
+        int numRows = 0;
+    };
+    double getValue(int index, int column) const;
+
+    //calls func(chunk, rowBegin, rowEnd, index) for the contiguous segments of the data points in [beginIndex, endIndex)
+    template <typename Func>
+    void forEachSegment(int beginIndex, int endIndex, Func const& func) const;
+
+    std::vector<Tier> _tiers;  //coarsest tier first
+    std::vector<int> _tierStartIndices;
+    int _numDataPoints = 0;
+    uint64_t _nextSequenceNumber = 0;
+};
+
+/**
+ * Multi-resolution history of the timeline statistics. The most recent data points are kept in full resolution (tier 0).
+ * If a tier is full, its two oldest data points are averaged and moved to the next coarser tier.
+ * Data is stored column-wise in chunks which are shared with the snapshots such that snapshots are cheap and
+ * readers never wait for the writer.
+ */
 class StatisticsHistory
 {
 public:
+    StatisticsHistory();
+
+    StatisticsHistorySnapshot getSnapshot() const;
     StatisticsHistoryData getCopiedData() const;
 
-    std::mutex& getMutex() const;
-    StatisticsHistoryData& getDataRef();
-    StatisticsHistoryData const& getDataRef() const;
+    std::optional<DataPointCollection> getLastDataPoint() const;
+    void add(DataPointCollection const& dataPoint);  //replaces the last data point if it has the same time
+    void removeDataPoints(double fromTime);  //removes all data points with time >= fromTime
+    void setData(StatisticsHistoryData const& data);
+    void clear();
 
 private:
-    mutable std::mutex _mutex;
-    StatisticsHistoryData _data;
+    struct Tier
+    {
+        std::deque<std::shared_ptr<StatisticsHistoryChunk>> chunks;
+        int startRow = 0;  //row of the oldest data point in the first chunk
+        int numRows = 0;
+    };
+    void addIntern(DataPointCollection const& dataPoint);
+    void addToTier(int tierIndex, DataPointCollection const& dataPoint);
+    void appendRow(Tier& tier, DataPointCollection const& dataPoint);
+    void truncateTier(Tier& tier, int numRows);
+    DataPointCollection getRow(Tier const& tier, int row) const;
+    void publishSnapshot();
+
+    mutable std::mutex _writeMutex;
+    std::vector<Tier> _tiers;  //finest tier first
+    uint64_t _nextSequenceNumber = 0;
+    std::atomic<StatisticsHistorySnapshot> _snapshot;
 };
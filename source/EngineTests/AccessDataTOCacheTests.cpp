@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include "EngineImpl/AccessDataTOCache.h"
+
+class AccessDataTOCacheTests : public ::testing::Test
+{
+public:
+    AccessDataTOCacheTests() = default;
+    ~AccessDataTOCacheTests() = default;
+};
+
+TEST_F(AccessDataTOCacheTests, reuseBuffer)
+{
+    _AccessDataTOCache cache;
+    ArraySizes arraySizes{1000, 500, 20000};
+
+    auto dataTO = cache.getDataTO(arraySizes);
+    *dataTO.numCells = 100;
+    *dataTO.numParticles = 50;
+    for (int i = 0; i < 10; ++i) {
+        auto reusedDataTO = cache.getDataTO(arraySizes);
+        EXPECT_TRUE(dataTO == reusedDataTO);
+        EXPECT_EQ(0, *reusedDataTO.numCells);
+        EXPECT_EQ(0, *reusedDataTO.numParticles);
+        EXPECT_EQ(0, *reusedDataTO.numAuxiliaryData);
+    }
+
+    auto const& statistics = cache.getStatistics();
+    EXPECT_EQ(11, statistics.numRequests);
+    EXPECT_EQ(1, statistics.numAllocations);
+    EXPECT_EQ(10, statistics.numAvoidedAllocations);
+}
+
+TEST_F(AccessDataTOCacheTests, growBuffer)
+{
+    AccessDataTOCacheSettings settings;
+    settings.growthFactor = 2.0f;
+    _AccessDataTOCache cache(settings);
+
+    cache.getDataTO({1000, 1000, 1000});
+    cache.getDataTO({1500, 2000, 10});
+    EXPECT_EQ(1, cache.getStatistics().numAllocations);
+
+    cache.getDataTO({2001, 0, 0});
+    EXPECT_EQ(2, cache.getStatistics().numAllocations);
+
+    cache.getDataTO({4000, 0, 0});
+    EXPECT_EQ(2, cache.getStatistics().numAllocations);
+}
+
+TEST_F(AccessDataTOCacheTests, doubleBuffered)
+{
+    AccessDataTOCacheSettings settings;
+    settings.doubleBuffered = true;
+    _AccessDataTOCache cache(settings);
+    ArraySizes arraySizes{100, 100, 100};
+
+    auto dataTO1 = cache.getDataTO(arraySizes);
+    auto dataTO2 = cache.getDataTO(arraySizes);
+    EXPECT_FALSE(dataTO1 == dataTO2);
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_TRUE(dataTO1 == cache.getDataTO(arraySizes));
+        EXPECT_TRUE(dataTO2 == cache.getDataTO(arraySizes));
+    }
+    EXPECT_EQ(2, cache.getStatistics().numAllocations);
+    EXPECT_EQ(10, cache.getStatistics().numAvoidedAllocations);
+}
@@ -0,0 +1,171 @@
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <iostream>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "EngineImpl/AccessSynchronizer.h"
+
+class AccessSynchronizerTests : public ::testing::Test
+{
+public:
+    AccessSynchronizerTests() = default;
+    ~AccessSynchronizerTests() = default;
+
+protected:
+    //emulates the worker thread loop: busy for timestepDuration, then access is allowed or the thread sleeps until the next time step
+    void runWorker(std::chrono::microseconds const& timestepDuration, std::optional<int> tpsRestriction)
+    {
+        while (!_isShutdown) {
+            auto startTimepoint = std::chrono::steady_clock::now();
+            while (std::chrono::steady_clock::now() - startTimepoint < timestepDuration) {
+                _workerCounter = _workerCounter + 1;
+            }
+            if (tpsRestriction) {
+                auto deadline = startTimepoint + std::chrono::microseconds(1000000 / *tpsRestriction);
+                while (std::chrono::steady_clock::now() < deadline && !_isShutdown) {
+                    _synchronizer.wait(deadline);
+                }
+            } else {
+                _synchronizer.allowAccess();
+            }
+        }
+    }
+
+    void shutdownWorker(std::thread& workerThread)
+    {
+        _isShutdown = true;
+        _synchronizer.notify();
+        workerThread.join();
+    }
+
+    AccessSynchronizer _synchronizer;
+    std::atomic<bool> _isShutdown{false};
+    volatile uint64_t _workerCounter = 0;
+};
+
+TEST_F(AccessSynchronizerTests, exclusiveAccess)
+{
+    std::thread workerThread([&] { runWorker(std::chrono::microseconds(10), std::nullopt); });
+
+    //gtest assertions are not used in the accessor threads, the results are checked after joining them
+    struct AccessorResult
+    {
+        int numTimeouts = 0;
+        int numWorkerProgressesDuringAccess = 0;
+    };
+    int sharedValue = 0;
+    std::vector<AccessorResult> results(4);
+    std::vector<std::thread> accessorThreads;
+    for (size_t i = 0; i < results.size(); ++i) {
+        accessorThreads.emplace_back([&, i] {
+            auto& result = results.at(i);
+            for (int j = 0; j < 200; ++j) {
+                if (!_synchronizer.acquire(std::chrono::seconds(5))) {
+                    ++result.numTimeouts;
+                    continue;
+                }
+                uint64_t workerCounter = _workerCounter;
+                ++sharedValue;
+                std::this_thread::yield();
+                if (workerCounter != _workerCounter) {
+                    ++result.numWorkerProgressesDuringAccess;
+                }
+                _synchronizer.release();
+            }
+        });
+    }
+    for (auto& thread : accessorThreads) {
+        thread.join();
+    }
+    shutdownWorker(workerThread);
+
+    for (auto const& result : results) {
+        EXPECT_EQ(0, result.numTimeouts);
+        EXPECT_EQ(0, result.numWorkerProgressesDuringAccess);
+    }
+    EXPECT_EQ(800, sharedValue);
+}
+
+TEST_F(AccessSynchronizerTests, reentrantAccess)
+{
+    std::thread workerThread([&] { runWorker(std::chrono::microseconds(10), std::nullopt); });
+
+    auto isAcquired = _synchronizer.acquire(std::chrono::seconds(5));
+    auto isReacquired = isAcquired && _synchronizer.acquire(std::chrono::seconds(5));
+    std::optional<uint64_t> workerCounterBeforeSleep;
+    std::optional<uint64_t> workerCounterAfterSleep;
+    if (isReacquired) {
+        _synchronizer.release();
+        workerCounterBeforeSleep = _workerCounter;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        workerCounterAfterSleep = _workerCounter;
+    }
+    if (isAcquired) {
+        _synchronizer.release();
+    }
+    shutdownWorker(workerThread);
+
+    ASSERT_TRUE(isAcquired);
+    ASSERT_TRUE(isReacquired);
+    EXPECT_EQ(workerCounterBeforeSleep, workerCounterAfterSleep);
+}
+
+TEST_F(AccessSynchronizerTests, timeoutWithoutWorker)
+{
+    EXPECT_FALSE(_synchronizer.acquire(std::chrono::milliseconds(10)));
+
+    //a timed out request must not block the worker afterwards
+    _synchronizer.allowAccess();
+}
+
+//the benchmarks measure AccessSynchronizer with the emulated worker loop in isolation, not the access to the simulation in EngineWorker
+TEST_F(AccessSynchronizerTests, benchmark_acquireLatency)
+{
+    std::thread workerThread([&] { runWorker(std::chrono::microseconds(0), std::nullopt); });
+
+    int const NumAcquisitions = 10000;
+    auto numTimeouts = 0;
+    auto startTimepoint = std::chrono::steady_clock::now();
+    for (int i = 0; i < NumAcquisitions; ++i) {
+        if (!_synchronizer.acquire(std::chrono::seconds(5))) {
+            ++numTimeouts;
+            continue;
+        }
+        _synchronizer.release();
+    }
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimepoint);
+    shutdownWorker(workerThread);
+
+    ASSERT_EQ(0, numTimeouts);
+    std::cout << "[          ] mean acquire latency: " << duration.count() * 1000 / NumAcquisitions << " ns" << std::endl;
+}
+
+TEST_F(AccessSynchronizerTests, benchmark_idleCpuUsageWithTpsRestriction)
+{
+    auto startClock = std::clock();
+    auto startTimepoint = std::chrono::steady_clock::now();
+    std::thread workerThread([&] { runWorker(std::chrono::microseconds(100), 100); });
+
+    //accessor requests access from time to time while the worker sleeps most of the time
+    auto numTimeouts = 0;
+    for (int i = 0; i < 50; ++i) {
+        if (_synchronizer.acquire(std::chrono::seconds(5))) {
+            _synchronizer.release();
+        } else {
+            ++numTimeouts;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    shutdownWorker(workerThread);
+    ASSERT_EQ(0, numTimeouts);
+
+    //std::clock measures the processor time of the process on POSIX systems
+    auto cpuTime = 1000.0 * (std::clock() - startClock) / CLOCKS_PER_SEC;
+    auto wallTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint).count();
+    std::cout << "[          ] cpu time " << cpuTime << " ms in " << wallTime << " ms with a TPS restriction of 100" << std::endl;
+}
@@ -0,0 +1,247 @@
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <boost/property_tree/json_parser.hpp>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/AuxiliaryDataParserService.h"
+#include "EngineInterface/SimulationParameters.h"
+
+class AuxiliaryDataParserServiceTests : public ::testing::Test
+{
+protected:
+    //all spots and particle sources in use with all shape and flow types
+    AuxiliaryData createPopulatedData() const
+    {
+        AuxiliaryData result{};
+        result.timestep = 123456789;
+        result.realTime = std::chrono::milliseconds(987654);
+        result.zoom = 2.5f;
+        result.center = {100.25f, 200.75f};
+        result.generalSettings.worldSizeX = 1000;
+        result.generalSettings.worldSizeY = 500;
+
+        auto& parameters = result.simulationParameters;
+        parameters.motionType = MotionType_Collision;
+        parameters.timestepSize = 0.5f;
+        parameters.baseValues.friction = 0.25f;
+        parameters.features.externalEnergyControl = true;
+        for (int i = 0; i < MAX_COLORS; ++i) {
+            parameters.baseValues.radiationCellAgeStrength[i] = 0.125f * toFloat(i);
+            for (int j = 0; j < MAX_COLORS; ++j) {
+                parameters.baseValues.cellFunctionAttackerFoodChainColorMatrix[i][j] = 0.25f * toFloat(i + j);
+            }
+        }
+
+        parameters.numParticleSources = MAX_PARTICLE_SOURCES;
+        for (int i = 0; i < MAX_PARTICLE_SOURCES; ++i) {
+            auto& source = parameters.particleSources[i];
+            source.posX = 10.0f * toFloat(i);
+            source.posY = 20.0f * toFloat(i);
+            source.shapeType = i % 2 == 0 ? RadiationSourceShapeType_Circular : RadiationSourceShapeType_Rectangular;
+        }
+
+        parameters.numSpots = MAX_SPOTS;
+        for (int i = 0; i < MAX_SPOTS; ++i) {
+            auto& spot = parameters.spots[i];
+            spot.color = 0x102030 + i;
+            spot.posX = 15.0f * toFloat(i);
+            spot.posY = 25.0f * toFloat(i);
+            spot.shapeType = i % 2 == 0 ? SpotShapeType_Circular : SpotShapeType_Rectangular;
+            spot.flowType = i % 4;
+            spot.activatedValues.friction = true;
+            spot.values.friction = 0.125f * toFloat(i);
+            spot.activatedValues.cellFunctionAttackerFoodChainColorMatrix = i % 2 == 1;
+            spot.values.cellFunctionAttackerFoodChainColorMatrix[1][2] = 0.5f;
+        }
+        return result;
+    }
+
+    std::string writeJson(boost::property_tree::ptree const& tree) const
+    {
+        std::stringstream stream;
+        boost::property_tree::write_json(stream, tree);
+        return stream.str();
+    }
+
+    boost::property_tree::ptree readJson(std::string const& json) const
+    {
+        std::stringstream stream(json);
+        boost::property_tree::ptree result;
+        boost::property_tree::read_json(stream, result);
+        return result;
+    }
+
+    //settings file written by the property tree implementation which the field table has replaced
+    std::string readBaselineSettingsFile() const
+    {
+        std::ifstream stream(std::string(ENGINE_TESTS_DATA_DIRECTORY) + "/baseline.settings.json", std::ios::binary);
+        return std::string{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+    }
+
+    float toFloat(int value) const { return static_cast<float>(value); }
+};
+
+TEST_F(AuxiliaryDataParserServiceTests, decodeFromJson_baselineFile)
+{
+    auto json = readBaselineSettingsFile();
+    ASSERT_FALSE(json.empty());
+
+    auto data = AuxiliaryDataParserService::decodeAuxiliaryDataFromJson(json);
+    EXPECT_EQ(123456789, data.timestep);
+    EXPECT_EQ(std::chrono::milliseconds(987654), data.realTime);
+    EXPECT_EQ(2.5f, data.zoom);
+    EXPECT_EQ(RealVector2D(100.25f, 200.75f), data.center);
+    EXPECT_EQ(1000, data.generalSettings.worldSizeX);
+    EXPECT_EQ(500, data.generalSettings.worldSizeY);
+    EXPECT_EQ(SpatialMapType_SparseTiled, data.generalSettings.spatialMapType);
+
+    auto const& parameters = data.simulationParameters;
+    EXPECT_EQ(MotionType_Collision, parameters.motionType);
+    EXPECT_EQ(0.5f, parameters.timestepSize);
+    EXPECT_EQ(0.25f, parameters.baseValues.friction);
+    EXPECT_TRUE(parameters.features.externalEnergyControl);
+    for (int i = 0; i < MAX_COLORS; ++i) {
+        EXPECT_EQ(0.125f * toFloat(i), parameters.baseValues.radiationCellAgeStrength[i]);
+        for (int j = 0; j < MAX_COLORS; ++j) {
+            EXPECT_EQ(0.25f * toFloat(i + j), parameters.baseValues.cellFunctionAttackerFoodChainColorMatrix[i][j]);
+        }
+    }
+
+    ASSERT_EQ(2, parameters.numParticleSources);
+    EXPECT_EQ(10.0f, parameters.particleSources[0].posX);
+    EXPECT_EQ(20.0f, parameters.particleSources[1].posY);
+    EXPECT_EQ(RadiationSourceShapeType_Rectangular, parameters.particleSources[1].shapeType);
+    EXPECT_EQ(30.0f, parameters.particleSources[1].shapeData.rectangularRadiationSource.width);
+
+    ASSERT_EQ(2, parameters.numSpots);
+    EXPECT_EQ(0x102030u, parameters.spots[0].color);
+    EXPECT_EQ(15.0f, parameters.spots[0].posX);
+    EXPECT_EQ(FlowType_Radial, parameters.spots[0].flowType);
+    EXPECT_TRUE(parameters.spots[0].activatedValues.friction);
+    EXPECT_EQ(0.125f, parameters.spots[0].values.friction);
+    EXPECT_FALSE(parameters.spots[0].activatedValues.cellFunctionAttackerFoodChainColorMatrix);
+    EXPECT_EQ(SpotShapeType_Rectangular, parameters.spots[1].shapeType);
+    EXPECT_FALSE(parameters.spots[1].activatedValues.friction);
+    EXPECT_TRUE(parameters.spots[1].activatedValues.cellFunctionAttackerFoodChainColorMatrix);
+    EXPECT_EQ(0.5f, parameters.spots[1].values.cellFunctionAttackerFoodChainColorMatrix[1][2]);
+}
+
+TEST_F(AuxiliaryDataParserServiceTests, encodeToJson_baselineFile)
+{
+    auto json = readBaselineSettingsFile();
+    ASSERT_FALSE(json.empty());
+
+    EXPECT_EQ(json, AuxiliaryDataParserService::encodeAuxiliaryDataToJson(AuxiliaryDataParserService::decodeAuxiliaryDataFromJson(json)));
+}
+
+//the property tree functions share the field table and are still used for parameter overrides, compatibility with files
+//of earlier versions is checked by the baseline file tests
+TEST_F(AuxiliaryDataParserServiceTests, encodeToJson_consistentWithPropertyTree)
+{
+    auto data = createPopulatedData();
+    EXPECT_EQ(writeJson(AuxiliaryDataParserService::encodeAuxiliaryData(data)), AuxiliaryDataParserService::encodeAuxiliaryDataToJson(data));
+
+    data.simulationParameters.motionType = MotionType_Fluid;
+    auto const& parameters = data.simulationParameters;
+    EXPECT_EQ(
+        writeJson(AuxiliaryDataParserService::encodeSimulationParameters(parameters)),
+        AuxiliaryDataParserService::encodeSimulationParametersToJson(parameters));
+}
+
+TEST_F(AuxiliaryDataParserServiceTests, decodeFromJson_consistentWithPropertyTree)
+{
+    auto json = writeJson(AuxiliaryDataParserService::encodeAuxiliaryData(createPopulatedData()));
+
+    auto expectedData = AuxiliaryDataParserService::decodeAuxiliaryData(readJson(json));
+    auto actualData = AuxiliaryDataParserService::decodeAuxiliaryDataFromJson(json);
+    EXPECT_EQ(expectedData.timestep, actualData.timestep);
+    EXPECT_EQ(expectedData.realTime, actualData.realTime);
+    EXPECT_EQ(expectedData.zoom, actualData.zoom);
+    EXPECT_EQ(expectedData.center, actualData.center);
+    EXPECT_EQ(expectedData.generalSettings.worldSizeX, actualData.generalSettings.worldSizeX);
+    EXPECT_EQ(expectedData.generalSettings.worldSizeY, actualData.generalSettings.worldSizeY);
+    EXPECT_EQ(expectedData.simulationParameters, actualData.simulationParameters);
+}
+
+TEST_F(AuxiliaryDataParserServiceTests, encodeDecode_roundTrip)
+{
+    auto data = createPopulatedData();
+    auto decodedData = AuxiliaryDataParserService::decodeAuxiliaryDataFromJson(AuxiliaryDataParserService::encodeAuxiliaryDataToJson(data));
+    EXPECT_EQ(data.timestep, decodedData.timestep);
+    EXPECT_EQ(data.realTime, decodedData.realTime);
+    EXPECT_EQ(data.zoom, decodedData.zoom);
+    EXPECT_EQ(data.center, decodedData.center);
+    EXPECT_EQ(data.simulationParameters, decodedData.simulationParameters);
+
+    auto parameters = createPopulatedData().simulationParameters;
+    EXPECT_EQ(
+        parameters,
+        AuxiliaryDataParserService::decodeSimulationParametersFromJson(AuxiliaryDataParserService::encodeSimulationParametersToJson(parameters)));
+}
+
+TEST_F(AuxiliaryDataParserServiceTests, decodeFromJson_missingAndInvalidValues)
+{
+    auto json = R"({
+        "general": {"zoom": "abc", "time step": 42},
+        "simulation parameters": {
+            "time step size": "+0.25",
+            "cell": {"max velocity": "1.5 x"},
+            "spots": {
+                "num spots": "1",
+                "0": {"pos": {"x": "12.5"}, "friction": {"activated": true, "value": "0.5"}},
+                "1": {"pos": {"x": "13.5"}}
+            },
+            "unknown": [1, 2, {"a": "b"}]
+        }
+    })";
+    auto data = AuxiliaryDataParserService::decodeAuxiliaryDataFromJson(json);
+    auto expectedData = AuxiliaryDataParserService::decodeAuxiliaryData(readJson(json));
+    SimulationParameters defaultParameters;
+
+    EXPECT_EQ(4.0f, data.zoom);
+    EXPECT_EQ(42, data.timestep);
+    EXPECT_EQ(0.25f, data.simulationParameters.timestepSize);
+    EXPECT_EQ(defaultParameters.cellMaxVelocity, data.simulationParameters.cellMaxVelocity);
+    EXPECT_EQ(1, data.simulationParameters.numSpots);
+    EXPECT_EQ(12.5f, data.simulationParameters.spots[0].posX);
+    EXPECT_TRUE(data.simulationParameters.spots[0].activatedValues.friction);
+    EXPECT_EQ(0.5f, data.simulationParameters.spots[0].values.friction);
+    EXPECT_EQ(defaultParameters.spots[1].posX, data.simulationParameters.spots[1].posX);
+
+    //features missing in legacy files are activated in the same way
+    EXPECT_EQ(expectedData.simulationParameters, data.simulationParameters);
+}
+
+TEST_F(AuxiliaryDataParserServiceTests, decodeFromJson_malformed)
+{
+    EXPECT_THROW(AuxiliaryDataParserService::decodeAuxiliaryDataFromJson(R"({"general": {"zoom": "1.0"})"), std::runtime_error);
+    EXPECT_THROW(AuxiliaryDataParserService::decodeAuxiliaryDataFromJson(R"({"general": {"zoom": 1.0,}})"), std::runtime_error);
+    EXPECT_THROW(AuxiliaryDataParserService::decodeAuxiliaryDataFromJson(R"({"general": {"zoom": "\q"}})"), std::runtime_error);
+}
+
+TEST_F(AuxiliaryDataParserServiceTests, benchmark_encodeDecode)
+{
+    auto constexpr NumRepetitions = 20;
+    auto data = createPopulatedData();
+
+    auto measure = [](auto const& function) {
+        auto startTimepoint = std::chrono::steady_clock::now();
+        for (int i = 0; i < NumRepetitions; ++i) {
+            function();
+        }
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimepoint).count() / NumRepetitions;
+    };
+    std::string json;
+    auto propertyTreeEncodeDuration = measure([&] { json = writeJson(AuxiliaryDataParserService::encodeAuxiliaryData(data)); });
+    auto propertyTreeDecodeDuration = measure([&] { data = AuxiliaryDataParserService::decodeAuxiliaryData(readJson(json)); });
+    auto streamingEncodeDuration = measure([&] { json = AuxiliaryDataParserService::encodeAuxiliaryDataToJson(data); });
+    auto streamingDecodeDuration = measure([&] { data = AuxiliaryDataParserService::decodeAuxiliaryDataFromJson(json); });
+
+    std::cout << "settings with " << json.size() << " bytes: property tree encode " << propertyTreeEncodeDuration << " us, decode "
+              << propertyTreeDecodeDuration << " us; streaming encode " << streamingEncodeDuration << " us, decode " << streamingDecodeDuration
+              << " us" << std::endl;
+}
@@ -0,0 +1,276 @@
+#if !defined(_WIN32)
+
+#include <cstring>
+#include <filesystem>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/RawStatisticsData.h"
+#include "EngineInterface/SerializerService.h"
+#include "EngineInterface/SimulationController.h"
+#include "EngineImpl/ControlServer.h"
+
+#include "IntegrationTestFramework.h"
+
+class ControlServerTests : public IntegrationTestFramework
+{
+public:
+    ControlServerTests()
+        : IntegrationTestFramework()
+    {
+        _socketPath = (std::filesystem::temp_directory_path() / "alien control server test.sock").string();
+        _saveDirectory = std::filesystem::temp_directory_path() / "alien control server test";
+        std::filesystem::create_directories(_saveDirectory);
+        _server = std::make_shared<_ControlServer>(_simController, _socketPath, _saveDirectory);
+
+        _clientSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, _socketPath.c_str(), sizeof(address.sun_path) - 1);
+        connect(_clientSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    }
+
+    ~ControlServerTests()
+    {
+        close(_clientSocket);
+        _server.reset();
+        std::filesystem::remove_all(_saveDirectory);
+    }
+
+protected:
+    struct Response
+    {
+        ControlResponse type = ControlResponse_Error;
+        std::string payload;
+    };
+
+    void sendRequest(ControlRequest type, std::string const& payload = std::string())
+    {
+        auto frame = encodeUInt32(static_cast<uint32_t>(payload.size()));
+        frame.push_back(static_cast<char>(type));
+        frame.append(payload);
+        ASSERT_EQ(static_cast<ssize_t>(frame.size()), send(_clientSocket, frame.data(), frame.size(), 0));
+    }
+
+    //requests are executed here as in the main loop of the CLI
+    Response receiveResponse()
+    {
+        pollfd pollEntry{_clientSocket, POLLIN, 0};
+        while (poll(&pollEntry, 1, 0) == 0) {
+            _server->processRequests(std::chrono::milliseconds(10));
+        }
+
+        Response result;
+        auto header = receiveBytes(5);
+        uint32_t size;
+        std::memcpy(&size, header.data(), sizeof(size));
+        result.type = static_cast<ControlResponse>(header.at(4));
+        result.payload = receiveBytes(size);
+        return result;
+    }
+
+    std::string receiveBytes(size_t size)
+    {
+        std::string result(size, 0);
+        for (size_t pos = 0; pos < size;) {
+            auto received = recv(_clientSocket, result.data() + pos, size - pos, 0);
+            if (received <= 0) {
+                return result;
+            }
+            pos += received;
+        }
+        return result;
+    }
+
+    std::string encodeUInt32(uint32_t value) const
+    {
+        std::string result(sizeof(value), 0);
+        std::memcpy(result.data(), &value, sizeof(value));
+        return result;
+    }
+
+    std::string encodeString(std::string const& value) const { return encodeUInt32(static_cast<uint32_t>(value.size())) + value; }
+
+    template <typename T>
+    T decode(std::string const& data, size_t& pos) const
+    {
+        T result;
+        std::memcpy(&result, data.data() + pos, sizeof(T));
+        pos += sizeof(T);
+        return result;
+    }
+
+    std::string _socketPath;
+    std::filesystem::path _saveDirectory;
+    ControlServer _server;
+    int _clientSocket = -1;
+};
+
+TEST_F(ControlServerTests, pauseAndResume)
+{
+    sendRequest(ControlRequest_Resume);
+    EXPECT_EQ(ControlResponse_Ok, receiveResponse().type);
+    EXPECT_TRUE(_simController->isSimulationRunning());
+
+    sendRequest(ControlRequest_Pause);
+    EXPECT_EQ(ControlResponse_Ok, receiveResponse().type);
+    EXPECT_FALSE(_simController->isSimulationRunning());
+
+    sendRequest(ControlRequest_GetStatus);
+    auto response = receiveResponse();
+    ASSERT_EQ(ControlResponse_Status, response.type);
+    ASSERT_EQ(13, response.payload.size());
+    uint64_t timestep;
+    std::memcpy(&timestep, response.payload.data(), sizeof(timestep));
+    EXPECT_EQ(_simController->getCurrentTimestep(), timestep);
+    EXPECT_EQ(0, response.payload.at(12));
+}
+
+TEST_F(ControlServerTests, setParameters)
+{
+    sendRequest(
+        ControlRequest_SetParameters,
+        encodeUInt32(1) + encodeString("simulation parameters.time step size") + encodeString("0.25"));
+    EXPECT_EQ(ControlResponse_Ok, receiveResponse().type);
+    EXPECT_EQ(0.25f, _simController->getSimulationParameters().timestepSize);
+
+    sendRequest(ControlRequest_SetParameters, encodeUInt32(1) + encodeString("unknown parameter") + encodeString("1"));
+    EXPECT_EQ(ControlResponse_Error, receiveResponse().type);
+    EXPECT_EQ(0.25f, _simController->getSimulationParameters().timestepSize);
+}
+
+TEST_F(ControlServerTests, malformedRequest)
+{
+    sendRequest(ControlRequest_Save, encodeUInt32(100));
+    EXPECT_EQ(ControlResponse_Error, receiveResponse().type);
+
+    sendRequest(ControlRequest_Shutdown + 1);
+    EXPECT_EQ(ControlResponse_Error, receiveResponse().type);
+
+    //the connection is still usable
+    sendRequest(ControlRequest_GetStatus);
+    EXPECT_EQ(ControlResponse_Status, receiveResponse().type);
+}
+
+TEST_F(ControlServerTests, save)
+{
+    _simController->setSimulationData(DataDescription().addCells({
+        CellDescription().setId(1).setPos({100.0f, 100.0f}),
+        CellDescription().setId(2).setPos({200.0f, 100.0f}),
+    }));
+    _simController->runSimulation();
+
+    sendRequest(ControlRequest_Save, encodeString("test.sim"));
+    EXPECT_EQ(ControlResponse_Ok, receiveResponse().type);
+    _simController->pauseSimulation();
+
+    DeserializedSimulation simData;
+    ASSERT_TRUE(SerializerService::deserializeSimulationFromFiles(simData, (_saveDirectory / "test.sim").string()));
+    EXPECT_EQ(2, simData.mainData.getNumberOfCellAndParticles());
+}
+
+TEST_F(ControlServerTests, save_outsideSaveDirectory)
+{
+    auto absoluteFilename = (std::filesystem::temp_directory_path() / "alien control server test.sim").string();
+    for (auto const& filename : {absoluteFilename, std::string("../test.sim"), std::string("subdirectory/../../test.sim"), std::string()}) {
+        sendRequest(ControlRequest_Save, encodeString(filename));
+        EXPECT_EQ(ControlResponse_Error, receiveResponse().type) << filename;
+    }
+    EXPECT_FALSE(std::filesystem::exists(absoluteFilename));
+    EXPECT_FALSE(std::filesystem::exists(_saveDirectory.parent_path() / "test.sim"));
+}
+
+TEST_F(ControlServerTests, socketOnlyAccessibleByOwner)
+{
+    struct stat status;
+    ASSERT_EQ(0, stat(_socketPath.c_str(), &status));
+    EXPECT_EQ(S_IRUSR | S_IWUSR, status.st_mode & 0777);
+}
+
+TEST_F(ControlServerTests, socketInUse)
+{
+    EXPECT_THROW(std::make_shared<_ControlServer>(_simController, _socketPath, _saveDirectory), std::runtime_error);
+    EXPECT_TRUE(std::filesystem::is_socket(_socketPath));
+
+    sendRequest(ControlRequest_Pause);
+    EXPECT_EQ(ControlResponse_Ok, receiveResponse().type);
+}
+
+TEST_F(ControlServerTests, staleSocketFile)
+{
+    auto staleSocketPath = (std::filesystem::temp_directory_path() / "alien control server stale test.sock").string();
+    std::filesystem::remove(staleSocketPath);
+
+    //a bound socket which is closed without removing its file is left behind by a terminated process
+    auto staleSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, staleSocketPath.c_str(), sizeof(address.sun_path) - 1);
+    ASSERT_EQ(0, bind(staleSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)));
+    close(staleSocket);
+    ASSERT_TRUE(std::filesystem::is_socket(staleSocketPath));
+
+    EXPECT_NO_THROW(std::make_shared<_ControlServer>(_simController, staleSocketPath, _saveDirectory));
+}
+
+TEST_F(ControlServerTests, multipleSaves)
+{
+    _simController->setSimulationData(DataDescription().addCells({CellDescription().setId(1).setPos({100.0f, 100.0f})}));
+
+    for (int i = 0; i < 3; ++i) {
+        sendRequest(ControlRequest_Save, encodeString("test" + std::to_string(i) + ".sim"));
+    }
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(ControlResponse_Ok, receiveResponse().type);
+    }
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_TRUE(std::filesystem::exists(_saveDirectory / ("test" + std::to_string(i) + ".sim")));
+    }
+}
+
+TEST_F(ControlServerTests, statisticsSubscription)
+{
+    _simController->setSimulationData(DataDescription().addCells({CellDescription().setId(1).setPos({100.0f, 100.0f}).setColor(2)}));
+
+    sendRequest(ControlRequest_GetStatistics);
+    auto response = receiveResponse();
+    ASSERT_EQ(ControlResponse_Statistics, response.type);
+    size_t pos = 0;
+    EXPECT_EQ(ControlStatisticsFormatVersion, decode<uint32_t>(response.payload, pos));
+    EXPECT_EQ(_simController->getCurrentTimestep(), decode<uint64_t>(response.payload, pos));
+    ASSERT_EQ(MAX_COLORS, decode<uint32_t>(response.payload, pos));
+    ASSERT_LT(0, decode<uint32_t>(response.payload, pos));
+    auto nameSize = decode<uint32_t>(response.payload, pos);
+    EXPECT_EQ(std::string("numCells"), response.payload.substr(pos, nameSize));
+    pos += nameSize;
+    for (int color = 0; color < MAX_COLORS; ++color) {
+        EXPECT_EQ(color == 2 ? 1.0 : 0.0, decode<double>(response.payload, pos));
+    }
+
+    sendRequest(ControlRequest_SubscribeStatistics, encodeUInt32(10));
+    EXPECT_EQ(ControlResponse_Ok, receiveResponse().type);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(ControlResponse_Statistics, receiveResponse().type);
+    }
+
+    sendRequest(ControlRequest_SubscribeStatistics, encodeUInt32(0));
+    while (receiveResponse().type == ControlResponse_Statistics) {
+    }
+}
+
+TEST_F(ControlServerTests, shutdownRequest)
+{
+    EXPECT_FALSE(_server->isShutdownRequested());
+    sendRequest(ControlRequest_Shutdown);
+    EXPECT_EQ(ControlResponse_Ok, receiveResponse().type);
+    EXPECT_TRUE(_server->isShutdownRequested());
+}
+
+#endif
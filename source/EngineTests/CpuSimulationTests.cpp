@@ -0,0 +1,197 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/Descriptions.h"
+#include "EngineImpl/CpuSimulation.h"
+
+class CpuSimulationTests : public ::testing::Test
+{
+public:
+    CpuSimulationTests()
+    {
+        _settings.generalSettings.worldSizeX = 100;
+        _settings.generalSettings.worldSizeY = 100;
+        _settings.simulationParameters.baseValues.friction = 0;
+    }
+    ~CpuSimulationTests() = default;
+
+protected:
+    DataDescription createPair(RealVector2D const& pos, float distance, float connectionDistance) const
+    {
+        DataDescription result;
+        result.addCells({
+            CellDescription().setId(1).setPos(pos).setMaxConnections(1),
+            CellDescription().setId(2).setPos(pos + RealVector2D{distance, 0}).setMaxConnections(1),
+        });
+        result.addConnection(1, 2);
+        for (auto& cell : result.cells) {
+            cell.connections.front().distance = connectionDistance;
+        }
+        return result;
+    }
+
+    CellDescription getCell(DataDescription const& data, uint64_t id) const
+    {
+        for (auto const& cell : data.cells) {
+            if (cell.id == id) {
+                return cell;
+            }
+        }
+        throw std::runtime_error("Cell not found.");
+    }
+
+    bool approxCompare(float expected, float actual) const
+    {
+        return std::abs(expected - actual) < 0.001f;
+    }
+
+    Settings _settings;
+};
+
+TEST_F(CpuSimulationTests, freeMotionWithWrapAround)
+{
+    _CpuSimulation simulation(0, _settings);
+    simulation.setSimulationData(DataDescription()
+                                     .addCell(CellDescription().setId(1).setPos({98.0f, 50.0f}).setVel({1.0f, 0}))
+                                     .addParticle(ParticleDescription().setId(2).setPos({50.0f, 1.0f}).setVel({0, -0.5f})));
+
+    simulation.calcTimesteps(4);
+
+    auto actualData = simulation.getSimulationData();
+    ASSERT_EQ(1, actualData.cells.size());
+    ASSERT_EQ(1, actualData.particles.size());
+    EXPECT_TRUE(approxCompare(2.0f, actualData.cells.front().pos.x));
+    EXPECT_TRUE(approxCompare(50.0f, actualData.cells.front().pos.y));
+    EXPECT_TRUE(approxCompare(50.0f, actualData.particles.front().pos.x));
+    EXPECT_TRUE(approxCompare(99.0f, actualData.particles.front().pos.y));
+    EXPECT_EQ(4, simulation.getCurrentTimestep());
+}
+
+TEST_F(CpuSimulationTests, stretchedConnectionContracts)
+{
+    _CpuSimulation simulation(0, _settings);
+    simulation.setSimulationData(createPair({50.0f, 50.0f}, 1.5f, 1.0f));
+
+    simulation.calcTimesteps(1);
+
+    auto actualData = simulation.getSimulationData();
+    auto cell1 = getCell(actualData, 1);
+    auto cell2 = getCell(actualData, 2);
+    EXPECT_GT(cell1.vel.x, 0);
+    EXPECT_LT(cell2.vel.x, 0);
+    EXPECT_TRUE(approxCompare(cell1.vel.x, -cell2.vel.x));
+    EXPECT_LT(cell2.pos.x - cell1.pos.x, 1.5f);
+    EXPECT_EQ(1, cell1.connections.size());
+}
+
+TEST_F(CpuSimulationTests, friction)
+{
+    _settings.simulationParameters.baseValues.friction = 0.1f;
+    _CpuSimulation simulation(0, _settings);
+    simulation.setSimulationData(DataDescription().addCell(CellDescription().setId(1).setPos({50.0f, 50.0f}).setVel({1.0f, 0})));
+
+    simulation.calcTimesteps(2);
+
+    auto actualData = simulation.getSimulationData();
+    EXPECT_TRUE(approxCompare(0.81f, actualData.cells.front().vel.x));
+}
+
+TEST_F(CpuSimulationTests, overstretchedConnectionIsRemoved)
+{
+    _CpuSimulation simulation(0, _settings);
+    simulation.setSimulationData(createPair({50.0f, 50.0f}, 4.0f, 4.0f));
+
+    simulation.calcTimesteps(1);
+
+    auto actualData = simulation.getSimulationData();
+    EXPECT_TRUE(getCell(actualData, 1).connections.empty());
+    EXPECT_TRUE(getCell(actualData, 2).connections.empty());
+}
+
+TEST_F(CpuSimulationTests, overstretchedConnectionWithClusterDecay_cellsAreRadiated)
+{
+    _settings.simulationParameters.clusterDecay = true;
+    for (int i = 0; i < MAX_COLORS; ++i) {
+        _settings.simulationParameters.clusterDecayProb[i] = 1.0f;
+    }
+    _CpuSimulation simulation(0, _settings);
+    simulation.setSimulationData(createPair({50.0f, 50.0f}, 4.0f, 4.0f));
+
+    simulation.calcTimesteps(1);
+
+    auto actualData = simulation.getSimulationData();
+    EXPECT_TRUE(actualData.cells.empty());
+    ASSERT_EQ(2, actualData.particles.size());
+    EXPECT_TRUE(approxCompare(200.0f, actualData.particles.at(0).energy + actualData.particles.at(1).energy));
+    EXPECT_NE(actualData.particles.at(0).id, actualData.particles.at(1).id);
+}
+
+TEST_F(CpuSimulationTests, dyingStateIsPassedOnWithinCreature)
+{
+    for (int i = 0; i < MAX_COLORS; ++i) {
+        _settings.simulationParameters.clusterDecayProb[i] = 0;
+    }
+    DataDescription data;
+    data.addCells({
+        CellDescription().setId(1).setPos({50.0f, 50.0f}).setCreatureId(1).setMaxConnections(2).setLivingState(LivingState_Dying),
+        CellDescription().setId(2).setPos({51.0f, 50.0f}).setCreatureId(1).setMaxConnections(2),
+        CellDescription().setId(3).setPos({52.0f, 50.0f}).setCreatureId(1).setMaxConnections(2),
+        CellDescription().setId(4).setPos({53.0f, 50.0f}).setCreatureId(2).setMaxConnections(2),
+    });
+    data.addConnection(1, 2);
+    data.addConnection(2, 3);
+    data.addConnection(3, 4);
+    _CpuSimulation simulation(0, _settings);
+    simulation.setSimulationData(data);
+
+    simulation.calcTimesteps(3);
+
+    auto actualData = simulation.getSimulationData();
+    EXPECT_EQ(LivingState_Dying, getCell(actualData, 2).livingState);
+    EXPECT_EQ(LivingState_Dying, getCell(actualData, 3).livingState);
+    EXPECT_NE(LivingState_Dying, getCell(actualData, 4).livingState);
+}
+
+TEST_F(CpuSimulationTests, cellBelowMinEnergyIsRemoved)
+{
+    for (int i = 0; i < MAX_COLORS; ++i) {
+        _settings.simulationParameters.clusterDecayProb[i] = 1.0f;
+    }
+    auto data = createPair({50.0f, 50.0f}, 1.0f, 1.0f);
+    data.cells.front().energy = 10.0f;
+    _CpuSimulation simulation(0, _settings);
+    simulation.setSimulationData(data);
+
+    simulation.calcTimesteps(1);
+
+    auto actualData = simulation.getSimulationData();
+    ASSERT_EQ(1, actualData.cells.size());
+    EXPECT_EQ(2, actualData.cells.front().id);
+    EXPECT_TRUE(actualData.cells.front().connections.empty());
+    ASSERT_EQ(1, actualData.particles.size());
+    EXPECT_TRUE(approxCompare(10.0f, actualData.particles.front().energy));
+}
+
+TEST_F(CpuSimulationTests, resultIndependentOfNumberOfThreads)
+{
+    DataDescription data;
+    for (int i = 0; i < 50; ++i) {
+        auto pair = createPair({toFloat(i * 2 % 100), toFloat(i)}, 1.2f + toFloat(i % 5) * 0.1f, 1.0f);
+        for (auto& cell : pair.cells) {
+            cell.id += i * 2;
+            cell.connections.front().cellId += i * 2;
+        }
+        data.add(pair);
+    }
+
+    _CpuSimulation sequentialSimulation(0, _settings, 1);
+    sequentialSimulation.setSimulationData(data);
+    sequentialSimulation.calcTimesteps(20);
+
+    _CpuSimulation parallelSimulation(0, _settings, 8);
+    parallelSimulation.setSimulationData(data);
+    parallelSimulation.calcTimesteps(20);
+
+    EXPECT_TRUE(sequentialSimulation.getClusteredSimulationData() == parallelSimulation.getClusteredSimulationData());
+}
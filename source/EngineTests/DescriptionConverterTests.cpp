@@ -0,0 +1,168 @@
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/GenomeDescriptions.h"
+#include "EngineInterface/GenomeDescriptionService.h"
+#include "EngineImpl/DescriptionConverter.h"
+
+class DescriptionConverterTests : public ::testing::Test
+{
+public:
+    DescriptionConverterTests() = default;
+    ~DescriptionConverterTests() = default;
+
+protected:
+    //transfer object whose arrays are located in host memory
+    struct HostDataTO
+    {
+        uint64_t numCells = 0;
+        uint64_t numParticles = 0;
+        uint64_t numAuxiliaryData = 0;
+        std::vector<CellTO> cells;
+        std::vector<ParticleTO> particles;
+        std::vector<uint8_t> auxiliaryData;
+
+        HostDataTO(ArraySizes const& arraySizes)
+            : cells(arraySizes.cellArraySize)
+            , particles(arraySizes.particleArraySize)
+            , auxiliaryData(arraySizes.auxiliaryDataSize)
+        {}
+
+        DataTO getDataTO()
+        {
+            DataTO result;
+            result.numCells = &numCells;
+            result.cells = cells.data();
+            result.numParticles = &numParticles;
+            result.particles = particles.data();
+            result.numAuxiliaryData = &numAuxiliaryData;
+            result.auxiliaryData = auxiliaryData.data();
+            return result;
+        }
+    };
+
+    //clusters are chains of cells, the cells of different clusters are interleaved in the cell array
+    ClusteredDataDescription createData(int numClusters, int numCellsPerCluster) const
+    {
+        auto genome = GenomeDescriptionService::convertDescriptionToBytes(GenomeDescription().setCells({CellGenomeDescription()}));
+
+        ClusteredDataDescription result;
+        for (int i = 0; i < numClusters; ++i) {
+            ClusterDescription cluster;
+            for (int j = 0; j < numCellsPerCluster; ++j) {
+                uint64_t id = j * numClusters + i + 1;
+                CellDescription cell;
+                cell.setId(id).setPos({toFloat(i), toFloat(j)}).setEnergy(100.0f).setMaxConnections(2).setExecutionOrderNumber(j % 6);
+                if (j > 0) {
+                    cell.connections.emplace_back(ConnectionDescription().setCellId(id - numClusters).setDistance(1.0f).setAngleFromPrevious(360.0f));
+                }
+                if (j + 1 < numCellsPerCluster) {
+                    cell.connections.emplace_back(ConnectionDescription().setCellId(id + numClusters).setDistance(1.0f).setAngleFromPrevious(180.0f));
+                }
+                switch (j % 3) {
+                case 0: {
+                    NeuronDescription neuron;
+                    neuron.weights[1][2] = toFloat(j);
+                    cell.setCellFunction(neuron);
+                } break;
+                case 1:
+                    cell.setCellFunction(ConstructorDescription().setGenome(genome));
+                    break;
+                default:
+                    cell.setMetadata(CellMetadataDescription().setName("cell").setDescription("test"));
+                }
+                cluster.addCell(cell);
+            }
+            result.addCluster(cluster);
+        }
+        for (int i = 0; i < numClusters; ++i) {
+            result.addParticle(ParticleDescription().setId(numClusters * numCellsPerCluster + i + 1).setPos({toFloat(i), 0.5f}).setEnergy(10.0f));
+        }
+        return result;
+    }
+
+    //builds the transfer object in the order of the ids such that the clusters are interleaved
+    void convertDescriptionToTO(HostDataTO& hostDataTO, ClusteredDataDescription const& data) const
+    {
+        DataDescription flattenedData(data);
+        std::sort(flattenedData.cells.begin(), flattenedData.cells.end(), [](auto const& left, auto const& right) { return left.id < right.id; });
+
+        DescriptionConverter converter(_parameters);
+        auto dataTO = hostDataTO.getDataTO();
+        converter.convertDescriptionToTO(dataTO, flattenedData);
+    }
+
+    SimulationParameters _parameters;
+};
+
+TEST_F(DescriptionConverterTests, clusterLabeling)
+{
+    auto data = createData(100, 30);
+
+    DescriptionConverter converter(_parameters);
+    HostDataTO hostDataTO(converter.getArraySizes(data));
+    convertDescriptionToTO(hostDataTO, data);
+
+    auto actualData = converter.convertTOtoClusteredDataDescription(hostDataTO.getDataTO());
+    EXPECT_TRUE(data == actualData);
+}
+
+TEST_F(DescriptionConverterTests, resultIndependentOfNumberOfThreads)
+{
+    auto data = createData(1000, 20);
+
+    DescriptionConverter sequentialConverter(_parameters, 1);
+    HostDataTO sequentialHostDataTO(sequentialConverter.getArraySizes(data));
+    auto sequentialDataTO = sequentialHostDataTO.getDataTO();
+    sequentialConverter.convertDescriptionToTO(sequentialDataTO, data);
+
+    DescriptionConverter parallelConverter(_parameters, 8);
+    HostDataTO parallelHostDataTO(parallelConverter.getArraySizes(data));
+    auto parallelDataTO = parallelHostDataTO.getDataTO();
+    parallelConverter.convertDescriptionToTO(parallelDataTO, data);
+
+    EXPECT_EQ(sequentialHostDataTO.numCells, parallelHostDataTO.numCells);
+    EXPECT_EQ(sequentialHostDataTO.numAuxiliaryData, parallelHostDataTO.numAuxiliaryData);
+    EXPECT_EQ(sequentialHostDataTO.auxiliaryData, parallelHostDataTO.auxiliaryData);
+
+    auto sequentialData = sequentialConverter.convertTOtoClusteredDataDescription(sequentialDataTO);
+    auto parallelData = parallelConverter.convertTOtoClusteredDataDescription(parallelDataTO);
+    EXPECT_TRUE(data == sequentialData);
+    EXPECT_TRUE(data == parallelData);
+    EXPECT_TRUE(DataDescription(data) == parallelConverter.convertTOtoDataDescription(parallelDataTO));
+}
+
+TEST_F(DescriptionConverterTests, benchmark_sequentialVsParallel)
+{
+    auto data = createData(10000, 50);
+
+    DescriptionConverter converter(_parameters);
+    HostDataTO hostDataTO(converter.getArraySizes(data));
+    convertDescriptionToTO(hostDataTO, data);
+    auto dataTO = hostDataTO.getDataTO();
+
+    auto measure = [&](int maxThreads) {
+        DescriptionConverter converter(_parameters, maxThreads);
+        auto startTimepoint = std::chrono::steady_clock::now();
+        auto actualData = converter.convertTOtoClusteredDataDescription(dataTO);
+        auto toDescriptionDuration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint).count();
+
+        HostDataTO targetHostDataTO(converter.getArraySizes(actualData));
+        auto targetDataTO = targetHostDataTO.getDataTO();
+        startTimepoint = std::chrono::steady_clock::now();
+        converter.convertDescriptionToTO(targetDataTO, actualData);
+        auto toTODuration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint).count();
+
+        EXPECT_EQ(data.clusters.size(), actualData.clusters.size());
+        return std::make_pair(toDescriptionDuration, toTODuration);
+    };
+    auto sequentialDurations = measure(1);
+    auto parallelDurations = measure(0);
+
+    std::cout << "[          ] conversion of " << data.getNumberOfCellAndParticles() << " objects to descriptions: sequential "
+              << sequentialDurations.first << " ms, parallel " << parallelDurations.first << " ms" << std::endl;
+    std::cout << "[          ] conversion of " << data.getNumberOfCellAndParticles() << " objects to transfer objects: sequential "
+              << sequentialDurations.second << " ms, parallel " << parallelDurations.second << " ms" << std::endl;
+}
@@ -0,0 +1,167 @@
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+#include "Base/DiskCache.h"
+
+class DiskCacheTests : public ::testing::Test
+{
+public:
+    DiskCacheTests()
+    {
+        std::filesystem::remove_all(_directory);
+    }
+    ~DiskCacheTests() { std::filesystem::remove_all(_directory); }
+
+protected:
+    std::string createData(char value, int size) const { return std::string(size, value); }
+
+    void expectEntry(std::optional<DiskCacheEntry> const& entry, std::vector<std::string> const& expectedParts) const
+    {
+        ASSERT_TRUE(entry.has_value());
+        ASSERT_EQ(expectedParts.size(), entry->parts.size());
+        for (size_t i = 0; i < expectedParts.size(); ++i) {
+            EXPECT_EQ(expectedParts.at(i), entry->parts.at(i));
+        }
+    }
+
+    std::filesystem::path _directory = std::filesystem::temp_directory_path() / "alien disk cache tests";
+};
+
+TEST_F(DiskCacheTests, entriesArePersistent)
+{
+    auto mainData = createData('a', 1000);
+    {
+        _DiskCache cache(_directory, 1024 * 1024);
+        cache.insertOrAssign("id1", std::string("2024-01-01"), {mainData, "settings", ""});
+    }
+    _DiskCache cache(_directory, 1024 * 1024);
+    expectEntry(cache.find("id1", "2024-01-01"), {mainData, "settings", ""});
+    EXPECT_FALSE(cache.find("id2", "2024-01-01").has_value());
+}
+
+TEST_F(DiskCacheTests, outdatedEntryIsRemoved)
+{
+    _DiskCache cache(_directory, 1024 * 1024);
+    cache.insertOrAssign("id1", std::string("2024-01-01"), {"data"});
+
+    EXPECT_FALSE(cache.find("id1", "2024-02-01").has_value());
+    EXPECT_FALSE(cache.find("id1", "2024-01-01").has_value());
+    EXPECT_EQ(0, cache.getSize());
+}
+
+TEST_F(DiskCacheTests, entryWithoutVersionAdoptsVersion)
+{
+    _DiskCache cache(_directory, 1024 * 1024);
+    cache.insertOrAssign("id1", std::nullopt, {"data"});
+
+    expectEntry(cache.find("id1", "2024-01-01"), {"data"});
+    expectEntry(cache.find("id1", "2024-01-01"), {"data"});
+    EXPECT_FALSE(cache.find("id1", "2024-02-01").has_value());
+}
+
+TEST_F(DiskCacheTests, leastRecentlyUsedEntriesAreEvicted)
+{
+    _DiskCache cache(_directory, 3500);
+    cache.insertOrAssign("id1", std::string("v"), {createData('a', 1000)});
+    cache.insertOrAssign("id2", std::string("v"), {createData('b', 1000)});
+    cache.insertOrAssign("id3", std::string("v"), {createData('c', 1000)});
+    EXPECT_TRUE(cache.find("id1", "v").has_value());
+
+    cache.insertOrAssign("id4", std::string("v"), {createData('d', 1000)});
+    EXPECT_LE(cache.getSize(), 3500);
+    EXPECT_TRUE(cache.find("id1", "v").has_value());
+    EXPECT_FALSE(cache.find("id2", "v").has_value());
+    EXPECT_TRUE(cache.find("id3", "v").has_value());
+    EXPECT_TRUE(cache.find("id4", "v").has_value());
+}
+
+TEST_F(DiskCacheTests, recencyIsPersistedOnDestruction)
+{
+    {
+        _DiskCache cache(_directory, 1024 * 1024);
+        cache.insertOrAssign("id1", std::string("v"), {createData('a', 1000)});
+        cache.insertOrAssign("id2", std::string("v"), {createData('b', 1000)});
+        EXPECT_TRUE(cache.find("id1", "v").has_value());
+    }
+    _DiskCache cache(_directory, 1500);
+    EXPECT_TRUE(cache.find("id1", "v").has_value());
+    EXPECT_FALSE(cache.find("id2", "v").has_value());
+}
+
+TEST_F(DiskCacheTests, entriesWithEqualContentShareFile)
+{
+    _DiskCache cache(_directory, 1024 * 1024);
+    cache.insertOrAssign("id1", std::string("v"), {"data"});
+    auto size = cache.getSize();
+    cache.insertOrAssign("id2", std::string("v"), {"data"});
+    EXPECT_EQ(size, cache.getSize());
+    cache.remove("id1");
+    EXPECT_EQ(size, cache.getSize());
+
+    EXPECT_FALSE(cache.find("id1", "v").has_value());
+    expectEntry(cache.find("id2", "v"), {"data"});
+
+    cache.remove("id2");
+    EXPECT_EQ(0, cache.getSize());
+}
+
+TEST_F(DiskCacheTests, contentWithEqualHashIsComparedBeforeSharing)
+{
+    uint64_t size;
+    {
+        _DiskCache cache(_directory, 1024 * 1024);
+        cache.insertOrAssign("id1", std::string("v"), {"data"});
+        size = cache.getSize();
+    }
+
+    //emulates a different content with equal hash and size
+    for (auto const& directoryEntry : std::filesystem::directory_iterator(_directory)) {
+        if (directoryEntry.path().extension() == ".bin") {
+            std::fstream stream(directoryEntry.path(), std::ios::binary | std::ios::in | std::ios::out);
+            stream.seekp(-4, std::ios::end);
+            stream << "diff";
+        }
+    }
+    {
+        _DiskCache cache(_directory, 1024 * 1024);
+        cache.insertOrAssign("id2", std::string("v"), {"data"});
+        EXPECT_EQ(2 * size, cache.getSize());
+        expectEntry(cache.find("id1", "v"), {"diff"});
+        expectEntry(cache.find("id2", "v"), {"data"});
+    }
+    _DiskCache cache(_directory, 1024 * 1024);
+    expectEntry(cache.find("id1", "v"), {"diff"});
+    expectEntry(cache.find("id2", "v"), {"data"});
+}
+
+TEST_F(DiskCacheTests, sharedContentIsCountedOnceAfterLoading)
+{
+    uint64_t size;
+    {
+        _DiskCache cache(_directory, 1024 * 1024);
+        cache.insertOrAssign("id1", std::string("v"), {createData('a', 1000)});
+        size = cache.getSize();
+        cache.insertOrAssign("id2", std::string("v"), {createData('a', 1000)});
+    }
+    _DiskCache cache(_directory, 1500);
+    EXPECT_EQ(size, cache.getSize());
+    EXPECT_TRUE(cache.find("id1", "v").has_value());
+    EXPECT_TRUE(cache.find("id2", "v").has_value());
+}
+
+TEST_F(DiskCacheTests, corruptedFileIsIgnored)
+{
+    {
+        _DiskCache cache(_directory, 1024 * 1024);
+        cache.insertOrAssign("id1", std::string("v"), {"data"});
+    }
+    for (auto const& directoryEntry : std::filesystem::directory_iterator(_directory)) {
+        if (directoryEntry.path().extension() == ".bin") {
+            std::ofstream stream(directoryEntry.path(), std::ios::binary | std::ios::app);
+            stream << "garbage";
+        }
+    }
+    _DiskCache cache(_directory, 1024 * 1024);
+    EXPECT_FALSE(cache.find("id1", "v").has_value());
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include "EngineImpl/EngineCommandQueue.h"
+
+class EngineCommandQueueTests : public ::testing::Test
+{
+public:
+    EngineCommandQueueTests() = default;
+    ~EngineCommandQueueTests() = default;
+};
+
+TEST_F(EngineCommandQueueTests, mergeConsecutiveShallowUpdates)
+{
+    EngineCommandQueue queue;
+    for (int i = 0; i < 10; ++i) {
+        ShallowUpdateSelectionData updateData;
+        updateData.posDeltaX = 1.0f;
+        updateData.angleDelta = 2.0f;
+        queue.add(ShallowUpdateSelectedObjectsCommand{updateData});
+    }
+
+    auto commands = queue.takeAll();
+    ASSERT_EQ(1, commands.size());
+    auto const& updateData = std::get<ShallowUpdateSelectedObjectsCommand>(commands.front()).updateData;
+    EXPECT_EQ(10.0f, updateData.posDeltaX);
+    EXPECT_EQ(0.0f, updateData.posDeltaY);
+    EXPECT_EQ(20.0f, updateData.angleDelta);
+    EXPECT_EQ(9, queue.getNumMergedCommands());
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST_F(EngineCommandQueueTests, keepShallowUpdatesWithDifferentScope)
+{
+    EngineCommandQueue queue;
+    ShallowUpdateSelectionData updateData;
+    updateData.considerClusters = true;
+    queue.add(ShallowUpdateSelectedObjectsCommand{updateData});
+    updateData.considerClusters = false;
+    queue.add(ShallowUpdateSelectedObjectsCommand{updateData});
+
+    EXPECT_EQ(2, queue.takeAll().size());
+}
+
+TEST_F(EngineCommandQueueTests, replaceCellChangesOfSameId)
+{
+    EngineCommandQueue queue;
+    queue.add(ChangeCellCommand{CellDescription().setId(1).setEnergy(10.0f)});
+    queue.add(ChangeCellCommand{CellDescription().setId(2).setEnergy(20.0f)});
+    queue.add(ColorSelectedObjectsCommand{1, true});
+    queue.add(ChangeCellCommand{CellDescription().setId(1).setEnergy(30.0f)});
+
+    auto commands = queue.takeAll();
+    ASSERT_EQ(3, commands.size());
+    EXPECT_EQ(2, std::get<ChangeCellCommand>(commands.at(0)).cell.id);
+    EXPECT_TRUE(std::holds_alternative<ColorSelectedObjectsCommand>(commands.at(1)));
+    auto const& cell = std::get<ChangeCellCommand>(commands.at(2)).cell;
+    EXPECT_EQ(1, cell.id);
+    EXPECT_EQ(30.0f, cell.energy);
+}
+
+TEST_F(EngineCommandQueueTests, keepOrderOfDifferentCommands)
+{
+    EngineCommandQueue queue;
+    queue.add(ColorSelectedObjectsCommand{1, true});
+    queue.add(MakeStickyCommand{true});
+    queue.add(ColorSelectedObjectsCommand{2, true});
+    queue.add(ColorSelectedObjectsCommand{3, true});
+    queue.add(ApplyForceCommand{{0, 0}, {1, 1}, {1, 0}, 5.0f});
+    queue.add(ApplyForceCommand{{0, 0}, {1, 1}, {1, 0}, 5.0f});
+
+    auto commands = queue.takeAll();
+    ASSERT_EQ(5, commands.size());
+    EXPECT_EQ(1, std::get<ColorSelectedObjectsCommand>(commands.at(0)).color);
+    EXPECT_TRUE(std::holds_alternative<MakeStickyCommand>(commands.at(1)));
+    EXPECT_EQ(3, std::get<ColorSelectedObjectsCommand>(commands.at(2)).color);
+    EXPECT_TRUE(std::holds_alternative<ApplyForceCommand>(commands.at(3)));
+    EXPECT_TRUE(std::holds_alternative<ApplyForceCommand>(commands.at(4)));
+}
+
+TEST_F(EngineCommandQueueTests, replaceGpuSettings)
+{
+    EngineCommandQueue queue;
+    GpuSettings gpuSettings;
+    gpuSettings.numBlocks = 16;
+    queue.add(SetGpuSettingsCommand{gpuSettings});
+    gpuSettings.numBlocks = 32;
+    queue.add(SetGpuSettingsCommand{gpuSettings});
+
+    auto commands = queue.takeAll();
+    ASSERT_EQ(1, commands.size());
+    EXPECT_EQ(32, std::get<SetGpuSettingsCommand>(commands.front()).gpuSettings.numBlocks);
+}
+
+TEST_F(EngineCommandQueueTests, replaceGpuSettings_keepsOrderToCommandsInBetween)
+{
+    EngineCommandQueue queue;
+    GpuSettings gpuSettings;
+    gpuSettings.numBlocks = 16;
+    queue.add(SetGpuSettingsCommand{gpuSettings});
+    queue.add(ApplyForceCommand{});
+    gpuSettings.numBlocks = 32;
+    queue.add(SetGpuSettingsCommand{gpuSettings});
+
+    auto commands = queue.takeAll();
+    ASSERT_EQ(2, commands.size());
+    EXPECT_TRUE(std::holds_alternative<ApplyForceCommand>(commands.at(0)));
+    EXPECT_EQ(32, std::get<SetGpuSettingsCommand>(commands.at(1)).gpuSettings.numBlocks);
+    EXPECT_EQ(1, queue.getNumMergedCommands());
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include "Base/NumberGenerator.h"
+
+#include "EngineInterface/GenomeDescriptionService.h"
+#include "EngineInterface/GenomeView.h"
+
+class GenomeViewTests : public ::testing::Test
+{
+public:
+    GenomeViewTests() = default;
+    ~GenomeViewTests() = default;
+
+protected:
+    GenomeDescription createGenome() const
+    {
+        auto subgenome = GenomeDescriptionService::convertDescriptionToBytes(
+            GenomeDescription()
+                .setHeader(GenomeHeaderDescription().setNumRepetitions(3).setNumBranches(2).setSeparateConstruction(false))
+                .setCells({
+                    CellGenomeDescription().setCellFunction(NerveGenomeDescription()),
+                    CellGenomeDescription().setCellFunction(InjectorGenomeDescription().setMakeSelfCopy()),
+                    CellGenomeDescription(),
+                }));
+        return GenomeDescription().setCells({
+            CellGenomeDescription().setCellFunction(NeuronGenomeDescription()),
+            CellGenomeDescription().setCellFunction(ConstructorGenomeDescription().setGenome(subgenome)),
+            CellGenomeDescription().setCellFunction(SensorGenomeDescription()),
+            CellGenomeDescription().setCellFunction(InjectorGenomeDescription().setGenome(subgenome)),
+            CellGenomeDescription().setCellFunction(ConstructorGenomeDescription().setMakeSelfCopy()),
+            CellGenomeDescription().setCellFunction(DetonatorGenomeDescription()),
+            CellGenomeDescription().setCellFunction(TransmitterGenomeDescription()),
+        });
+    }
+
+    //reference implementation based on the decoded genome
+    int getNumNodesRecursively_reference(std::vector<uint8_t> const& data, bool includeRepetitions) const
+    {
+        auto genome = GenomeDescriptionService::convertBytesToDescription(data);
+        auto result = toInt(genome.cells.size());
+        for (auto const& node : genome.cells) {
+            if (auto subgenome = node.getGenome()) {
+                result += getNumNodesRecursively_reference(*subgenome, includeRepetitions);
+            }
+        }
+        auto numRepetitions = genome.header.numRepetitions == std::numeric_limits<int>::max() ? 1 : genome.header.numRepetitions;
+        return includeRepetitions ? result * numRepetitions * genome.header.getNumBranches() : result;
+    }
+
+    std::vector<uint8_t> createRandomBytes(int maxSize) const
+    {
+        auto& numberGen = NumberGenerator::getInstance();
+        std::vector<uint8_t> result(numberGen.getRandomInt(maxSize));
+        for (auto& byte : result) {
+            byte = static_cast<uint8_t>(numberGen.getRandomInt(256));
+        }
+        return result;
+    }
+};
+
+TEST_F(GenomeViewTests, nodeAddresses)
+{
+    auto genome = createGenome();
+    auto data = GenomeDescriptionService::convertDescriptionToBytes(genome);
+    GenomeView view(data);
+    GenomeView indexedView(data);
+    indexedView.buildNodeIndex();
+
+    ASSERT_EQ(genome.cells.size(), view.getNumNodes());
+    ASSERT_EQ(genome.cells.size(), indexedView.getNumNodes());
+    for (int i = 0; i <= toInt(genome.cells.size()); ++i) {
+        auto prefixGenome = genome;
+        prefixGenome.cells.resize(i);
+        auto expectedAddress = toInt(GenomeDescriptionService::convertDescriptionToBytes(prefixGenome).size());
+
+        EXPECT_EQ(expectedAddress, view.convertNodeIndexToNodeAddress(i));
+        EXPECT_EQ(expectedAddress, indexedView.convertNodeIndexToNodeAddress(i));
+        EXPECT_EQ(i, view.convertNodeAddressToNodeIndex(expectedAddress));
+        EXPECT_EQ(i, indexedView.convertNodeAddressToNodeIndex(expectedAddress));
+    }
+}
+
+TEST_F(GenomeViewTests, subgenome)
+{
+    auto genome = createGenome();
+    auto data = GenomeDescriptionService::convertDescriptionToBytes(genome);
+    GenomeView view(data);
+
+    auto subgenome = view.getSubgenome(view.convertNodeIndexToNodeAddress(1));
+    ASSERT_TRUE(subgenome.has_value());
+    EXPECT_EQ(3, subgenome->getNumNodes());
+    EXPECT_EQ(3, subgenome->getNumRepetitions());
+    EXPECT_EQ(2, subgenome->getNumBranches());
+
+    EXPECT_FALSE(view.getSubgenome(view.convertNodeIndexToNodeAddress(0)).has_value());
+    EXPECT_FALSE(view.getSubgenome(view.convertNodeIndexToNodeAddress(4)).has_value());
+}
+
+TEST_F(GenomeViewTests, numNodesRecursively)
+{
+    auto data = GenomeDescriptionService::convertDescriptionToBytes(createGenome());
+    GenomeView view(data);
+
+    EXPECT_EQ(7 + 3 + 3, view.getNumNodesRecursively(false));
+    EXPECT_EQ(7 + 3 * 6 + 3 * 6, view.getNumNodesRecursively(true));
+}
+
+TEST_F(GenomeViewTests, arbitraryBytes)
+{
+    for (int i = 0; i < 1000; ++i) {
+        auto data = createRandomBytes(300);
+        GenomeView view(data);
+        GenomeView indexedView(data);
+        indexedView.buildNodeIndex();
+
+        auto numNodes = toInt(GenomeDescriptionService::convertBytesToDescription(data).cells.size());
+        ASSERT_EQ(numNodes, view.getNumNodes());
+        ASSERT_EQ(numNodes, indexedView.getNumNodes());
+        ASSERT_EQ(getNumNodesRecursively_reference(data, true), view.getNumNodesRecursively(true));
+        ASSERT_EQ(getNumNodesRecursively_reference(data, false), view.getNumNodesRecursively(false));
+        for (int nodeIndex = 0; nodeIndex <= numNodes; ++nodeIndex) {
+            auto nodeAddress = view.convertNodeIndexToNodeAddress(nodeIndex);
+            ASSERT_EQ(nodeAddress, indexedView.convertNodeIndexToNodeAddress(nodeIndex));
+            ASSERT_EQ(nodeIndex, view.convertNodeAddressToNodeIndex(nodeAddress));
+            ASSERT_EQ(nodeIndex, indexedView.convertNodeAddressToNodeIndex(nodeAddress));
+        }
+    }
+}
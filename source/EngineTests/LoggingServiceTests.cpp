@@ -0,0 +1,184 @@
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <regex>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "Base/LoggingService.h"
+
+class LoggingServiceTests
+    : public ::testing::Test
+    , public LoggingCallBack
+{
+public:
+    LoggingServiceTests() { LoggingService::getInstance().registerCallBack(this); }
+    ~LoggingServiceTests() { LoggingService::getInstance().unregisterCallBack(this); }
+
+    void newLogMessage(Priority priority, std::string const& message) override
+    {
+        if (_blockNextMessage) {
+            _blockNextMessage = false;
+            _blockedFuture.wait();
+        }
+        _messages.emplace_back(message);
+        _priorities.emplace_back(priority);
+    }
+
+    void flushLogMessages() override { ++_numFlushes; }
+
+protected:
+    //accessed by the writer thread and after LoggingService::flush by the test
+    std::vector<std::string> _messages;
+    std::vector<Priority> _priorities;
+    int _numFlushes = 0;
+
+    std::atomic<bool> _blockNextMessage{false};
+    std::shared_future<void> _blockedFuture;
+};
+
+TEST_F(LoggingServiceTests, messageFormat)
+{
+    log(Priority::Important, "test message");
+    LoggingService::getInstance().flush();
+
+    ASSERT_EQ(1, _messages.size());
+    EXPECT_EQ(Priority::Important, _priorities.front());
+    EXPECT_TRUE(std::regex_match(_messages.front(), std::regex(R"(\d{4}-\d{2}-\d{2} \d{2}-\d{2}-\d{2}\.\d{3} \[thread \d+\]: test message)")));
+    EXPECT_GE(_numFlushes, 1);
+}
+
+TEST_F(LoggingServiceTests, messagesFromMultipleThreads)
+{
+    auto constexpr NumThreads = 4;
+    auto constexpr NumMessagesPerThread = 1000;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NumThreads; ++i) {
+        threads.emplace_back([i] {
+            for (int j = 0; j < NumMessagesPerThread; ++j) {
+                log(Priority::Unimportant, std::to_string(i) + ":" + std::to_string(j));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    LoggingService::getInstance().flush();
+
+    //messages of each thread arrive in order
+    ASSERT_EQ(NumThreads * NumMessagesPerThread, _messages.size());
+    std::vector<int> nextMessageIndices(NumThreads, 0);
+    for (auto const& message : _messages) {
+        auto text = message.substr(message.find("]: ") + 3);
+        auto threadIndex = std::stoi(text.substr(0, text.find(':')));
+        auto messageIndex = std::stoi(text.substr(text.find(':') + 1));
+        ASSERT_EQ(nextMessageIndices.at(threadIndex), messageIndex);
+        ++nextMessageIndices.at(threadIndex);
+    }
+}
+
+TEST_F(LoggingServiceTests, minPriority)
+{
+    LoggingService::getInstance().setMinPriority(Priority::Important);
+    log(Priority::Unimportant, "unimportant");
+    log(Priority::Important, "important");
+    LoggingService::getInstance().setMinPriority(Priority::Unimportant);
+    LoggingService::getInstance().flush();
+
+    ASSERT_EQ(1, _messages.size());
+    EXPECT_EQ(Priority::Important, _priorities.front());
+}
+
+TEST_F(LoggingServiceTests, registerCallBack_onlyLaterMessagesDelivered)
+{
+    class CallBack : public LoggingCallBack
+    {
+    public:
+        void newLogMessage(Priority priority, std::string const& message) override { messages.emplace_back(message); }
+        std::vector<std::string> messages;
+    };
+
+    log(Priority::Important, "before registration");
+    CallBack callback;
+    LoggingService::getInstance().registerCallBack(&callback);
+    log(Priority::Important, "after registration");
+    LoggingService::getInstance().unregisterCallBack(&callback);
+
+    ASSERT_EQ(1, callback.messages.size());
+    EXPECT_TRUE(callback.messages.front().ends_with("after registration"));
+    EXPECT_EQ(2, _messages.size());
+}
+
+TEST_F(LoggingServiceTests, idleWriterIsWokenUp)
+{
+    //the writer thread falls asleep between the messages
+    for (int i = 0; i < 100; ++i) {
+        log(Priority::Unimportant, std::to_string(i));
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    LoggingService::getInstance().flush();
+
+    EXPECT_EQ(100, _messages.size());
+}
+
+TEST_F(LoggingServiceTests, overflow)
+{
+    std::promise<void> unblockPromise;
+    _blockedFuture = unblockPromise.get_future().share();
+    _blockNextMessage = true;
+    auto numDroppedMessagesBefore = LoggingService::getInstance().getNumDroppedMessages();
+
+    //the writer thread is blocked in the call back while the queue runs full
+    log(Priority::Unimportant, "blocking message");
+    while (_blockNextMessage) {
+        std::this_thread::yield();
+    }
+    for (int i = 0; i < 10000; ++i) {
+        log(Priority::Unimportant, "message");
+    }
+    unblockPromise.set_value();
+    LoggingService::getInstance().flush();
+
+    auto numDroppedMessages = LoggingService::getInstance().getNumDroppedMessages() - numDroppedMessagesBefore;
+    EXPECT_GT(numDroppedMessages, 0);
+    ASSERT_EQ(10001 - numDroppedMessages + 1, _messages.size());
+    auto dropMessage = std::to_string(numDroppedMessages) + " log messages dropped";
+    EXPECT_TRUE(std::any_of(_messages.begin(), _messages.end(), [&](auto const& message) { return message.find(dropMessage) != std::string::npos; }));
+}
+
+TEST_F(LoggingServiceTests, benchmark_logLatency)
+{
+    struct Latencies
+    {
+        std::chrono::nanoseconds total{0};
+        std::chrono::nanoseconds max{0};
+    };
+    auto constexpr NumThreads = 4;
+    auto constexpr NumMessagesPerThread = 100000;
+    std::vector<std::future<Latencies>> futures;
+    for (int i = 0; i < NumThreads; ++i) {
+        futures.emplace_back(std::async(std::launch::async, [] {
+            Latencies result;
+            for (int j = 0; j < NumMessagesPerThread; ++j) {
+                auto startTimepoint = std::chrono::steady_clock::now();
+                log(Priority::Unimportant, "benchmark message with a length typical for log messages");
+                auto latency = std::chrono::steady_clock::now() - startTimepoint;
+                result.total += latency;
+                result.max = std::max(result.max, std::chrono::duration_cast<std::chrono::nanoseconds>(latency));
+            }
+            return result;
+        }));
+    }
+    Latencies latencies;
+    for (auto& future : futures) {
+        auto threadLatencies = future.get();
+        latencies.total += threadLatencies.total;
+        latencies.max = std::max(latencies.max, threadLatencies.max);
+    }
+    LoggingService::getInstance().flush();
+
+    std::cout << "log call latency: " << latencies.total.count() / (NumThreads * NumMessagesPerThread) << " ns on average, "
+              << std::chrono::duration_cast<std::chrono::microseconds>(latencies.max).count() << " us at most, "
+              << LoggingService::getInstance().getNumDroppedMessages() << " messages dropped in total" << std::endl;
+}
@@ -0,0 +1,143 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "Base/Math.h"
+
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/PatternAnalysisService.h"
+
+class PatternAnalysisServiceTests : public ::testing::Test
+{
+public:
+    PatternAnalysisServiceTests() = default;
+    ~PatternAnalysisServiceTests() = default;
+
+protected:
+    //chain of cells with the given colors
+    ClusterDescription createChain(uint64_t startId, RealVector2D const& pos, std::vector<int> const& colors) const
+    {
+        DataDescription data;
+        for (size_t i = 0; i < colors.size(); ++i) {
+            data.addCell(CellDescription().setId(startId + i).setPos(pos + RealVector2D{toFloat(i), 0}).setColor(colors[i]).setMaxConnections(2));
+        }
+        for (size_t i = 1; i < colors.size(); ++i) {
+            data.addConnection(startId + i - 1, startId + i);
+        }
+        return ClusterDescription().addCells(data.cells);
+    }
+
+    ClusterDescription createRing(uint64_t startId, RealVector2D const& pos, int numCells) const
+    {
+        DataDescription data;
+        for (int i = 0; i < numCells; ++i) {
+            auto angle = toFloat(i) * 2 * Const::Pi / toFloat(numCells);
+            data.addCell(CellDescription().setId(startId + i).setPos(pos + RealVector2D{std::cos(angle), std::sin(angle)} * 2.0f).setMaxConnections(2));
+        }
+        for (int i = 0; i < numCells; ++i) {
+            data.addConnection(startId + i, startId + (i + 1) % numCells);
+        }
+        return ClusterDescription().addCells(data.cells);
+    }
+};
+
+TEST_F(PatternAnalysisServiceTests, identicalClustersAreGrouped)
+{
+    ClusteredDataDescription data;
+    for (int i = 0; i < 5; ++i) {
+        data.addCluster(createChain(100 * i + 1, {0, toFloat(i * 10)}, {0, 1, 2, 1}));
+    }
+    for (int i = 0; i < 3; ++i) {
+        data.addCluster(createRing(1000 + 100 * i, {50.0f, toFloat(i * 10)}, 8));
+    }
+    data.addCluster(createChain(5000, {100.0f, 0}, {3, 3}));
+
+    auto patterns = PatternAnalysisService::calcRepetitivePatterns(data);
+
+    ASSERT_EQ(2, patterns.size());
+    EXPECT_EQ(5, patterns.at(0).numberOfElements);
+    EXPECT_EQ(4, patterns.at(0).representant.cells.size());
+    EXPECT_EQ(3, patterns.at(1).numberOfElements);
+    EXPECT_EQ(8, patterns.at(1).representant.cells.size());
+}
+
+TEST_F(PatternAnalysisServiceTests, cellOrderDoesNotMatter)
+{
+    auto cluster = createChain(1, {0, 0}, {0, 1, 2, 3, 4});
+    auto permutedCluster = createChain(10, {0, 10.0f}, {0, 1, 2, 3, 4});
+    std::reverse(permutedCluster.cells.begin(), permutedCluster.cells.end());
+    std::swap(permutedCluster.cells.at(1), permutedCluster.cells.at(3));
+
+    EXPECT_TRUE(PatternAnalysisService::isStructurallyEqual(cluster, permutedCluster));
+}
+
+TEST_F(PatternAnalysisServiceTests, differentAttributes)
+{
+    EXPECT_FALSE(PatternAnalysisService::isStructurallyEqual(createChain(1, {0, 0}, {0, 1, 0}), createChain(10, {0, 0}, {0, 2, 0})));
+}
+
+TEST_F(PatternAnalysisServiceTests, sameCellsDifferentTopology)
+{
+    EXPECT_FALSE(PatternAnalysisService::isStructurallyEqual(createChain(1, {0, 0}, {0, 1, 0, 1}), createChain(10, {0, 0}, {0, 0, 1, 1})));
+    EXPECT_FALSE(PatternAnalysisService::isStructurallyEqual(createRing(1, {0, 0}, 6), createRing(10, {0, 0}, 7)));
+}
+
+TEST_F(PatternAnalysisServiceTests, sameRefinedLabelsDifferentTopology)
+{
+    //all cells have two connections, hence the label refinement cannot distinguish a ring of 6 cells from two rings of 3 cells
+    auto twoRings = createRing(10, {0, 0}, 3);
+    twoRings.addCells(createRing(20, {10.0f, 0}, 3).cells);
+    EXPECT_FALSE(PatternAnalysisService::isStructurallyEqual(createRing(1, {0, 0}, 6), twoRings));
+    EXPECT_TRUE(PatternAnalysisService::isStructurallyEqual(twoRings, twoRings));
+
+    ClusteredDataDescription data;
+    data.addCluster(createRing(1, {0, 0}, 6));
+    data.addCluster(twoRings);
+    EXPECT_TRUE(PatternAnalysisService::calcRepetitivePatterns(data).empty());
+}
+
+TEST_F(PatternAnalysisServiceTests, largeSymmetricClusters)
+{
+    auto ring = createRing(1, {0, 0}, 2000);
+    auto rotatedRing = createRing(10000, {0, 0}, 2000);
+    std::rotate(rotatedRing.cells.begin(), rotatedRing.cells.begin() + 777, rotatedRing.cells.end());
+    EXPECT_TRUE(PatternAnalysisService::isStructurallyEqual(ring, rotatedRing));
+}
+
+TEST_F(PatternAnalysisServiceTests, abortedSearchFallsBackToCanonicalForms)
+{
+    //the clusters are not isomorphic, but the search would try all mappings of the first rings before the last ring fails, hence it is
+    //aborted and the clusters are compared by their equal canonical forms
+    ClusterDescription tenRings;
+    ClusterDescription nineRingsAndTwoSmallRings;
+    for (int i = 0; i < 10; ++i) {
+        tenRings.addCells(createRing(100 * i + 1, {toFloat(i * 10), 0}, 6).cells);
+    }
+    for (int i = 0; i < 9; ++i) {
+        nineRingsAndTwoSmallRings.addCells(createRing(10000 + 100 * i, {toFloat(i * 10), 0}, 6).cells);
+    }
+    nineRingsAndTwoSmallRings.addCells(createRing(20000, {100.0f, 0}, 3).cells);
+    nineRingsAndTwoSmallRings.addCells(createRing(20100, {110.0f, 0}, 3).cells);
+
+    EXPECT_TRUE(PatternAnalysisService::isStructurallyEqual(tenRings, nineRingsAndTwoSmallRings));
+}
+
+TEST_F(PatternAnalysisServiceTests, resultIndependentOfNumberOfThreads)
+{
+    ClusteredDataDescription data;
+    for (int i = 0; i < 500; ++i) {
+        data.addCluster(createChain(100 * i + 1, {0, toFloat(i * 10)}, {i % 3, i % 5, i % 7}));
+    }
+
+    auto sequentialPatterns = PatternAnalysisService::calcRepetitivePatterns(data, 1);
+    auto parallelPatterns = PatternAnalysisService::calcRepetitivePatterns(data, 8);
+
+    ASSERT_EQ(sequentialPatterns.size(), parallelPatterns.size());
+    auto numClusters = 0;
+    for (size_t i = 0; i < sequentialPatterns.size(); ++i) {
+        EXPECT_EQ(sequentialPatterns.at(i).numberOfElements, parallelPatterns.at(i).numberOfElements);
+        EXPECT_TRUE(sequentialPatterns.at(i).representant == parallelPatterns.at(i).representant);
+        numClusters += sequentialPatterns.at(i).numberOfElements;
+    }
+    EXPECT_EQ(500, numClusters);
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include "EngineInterface/GenomeDescriptionService.h"
+#include "EngineInterface/PreviewDescriptionService.h"
+
+class PreviewDescriptionServiceTests : public ::testing::Test
+{
+public:
+    PreviewDescriptionServiceTests() { PreviewDescriptionService::clearCache(); }
+    ~PreviewDescriptionServiceTests() = default;
+
+protected:
+    std::vector<uint8_t> createSubgenome(float referenceAngle) const
+    {
+        auto subsubgenome = GenomeDescriptionService::convertDescriptionToBytes(
+            GenomeDescription().setCells({CellGenomeDescription(), CellGenomeDescription()}));
+        return GenomeDescriptionService::convertDescriptionToBytes(
+            GenomeDescription()
+                .setHeader(GenomeHeaderDescription().setNumRepetitions(2).setSeparateConstruction(false))
+                .setCells({
+                    CellGenomeDescription().setReferenceAngle(referenceAngle),
+                    CellGenomeDescription().setCellFunction(ConstructorGenomeDescription().setGenome(subsubgenome)),
+                    CellGenomeDescription(),
+                }));
+    }
+
+    GenomeDescription createGenome(float referenceAngle) const
+    {
+        return GenomeDescription().setCells({
+            CellGenomeDescription().setCellFunction(ConstructorGenomeDescription().setGenome(createSubgenome(0))),
+            CellGenomeDescription().setCellFunction(ConstructorGenomeDescription().setMakeSelfCopy()),
+            CellGenomeDescription().setCellFunction(ConstructorGenomeDescription().setGenome(createSubgenome(referenceAngle))),
+            CellGenomeDescription(),
+        });
+    }
+
+    void expectEqual(PreviewDescription const& expected, PreviewDescription const& actual) const
+    {
+        ASSERT_EQ(expected.cells.size(), actual.cells.size());
+        for (size_t i = 0; i < expected.cells.size(); ++i) {
+            EXPECT_EQ(expected.cells.at(i).pos, actual.cells.at(i).pos);
+            EXPECT_EQ(expected.cells.at(i).nodeIndex, actual.cells.at(i).nodeIndex);
+        }
+        ASSERT_EQ(expected.connections.size(), actual.connections.size());
+        for (size_t i = 0; i < expected.connections.size(); ++i) {
+            EXPECT_EQ(expected.connections.at(i).cell1, actual.connections.at(i).cell1);
+            EXPECT_EQ(expected.connections.at(i).cell2, actual.connections.at(i).cell2);
+        }
+    }
+};
+
+TEST_F(PreviewDescriptionServiceTests, nodeIndicesOfSubgenomes)
+{
+    auto preview = PreviewDescriptionService::convert(createGenome(0), SimulationParameters());
+
+    std::map<int, int> numCellsByNodeIndex;
+    for (auto const& cell : preview.cells) {
+        ++numCellsByNodeIndex[cell.nodeIndex];
+    }
+    EXPECT_EQ(1 + 2 * (3 + 2), numCellsByNodeIndex[0]);
+    EXPECT_EQ(1, numCellsByNodeIndex[1]);
+    EXPECT_EQ(1 + 2 * (3 + 2), numCellsByNodeIndex[2]);
+    EXPECT_EQ(1, numCellsByNodeIndex[3]);
+}
+
+TEST_F(PreviewDescriptionServiceTests, editedSubgenome)
+{
+    PreviewDescriptionService::convert(createGenome(0), SimulationParameters());
+    auto preview = PreviewDescriptionService::convert(createGenome(90.0f), SimulationParameters());
+
+    PreviewDescriptionService::clearCache();
+    auto expectedPreview = PreviewDescriptionService::convert(createGenome(90.0f), SimulationParameters());
+    expectEqual(expectedPreview, preview);
+}
+
+TEST_F(PreviewDescriptionServiceTests, editedPrincipalPart)
+{
+    auto genome = createGenome(0);
+    PreviewDescriptionService::convert(genome, SimulationParameters());
+    genome.cells.at(3).setReferenceAngle(-90.0f);
+    auto preview = PreviewDescriptionService::convert(genome, SimulationParameters());
+
+    PreviewDescriptionService::clearCache();
+    auto expectedPreview = PreviewDescriptionService::convert(genome, SimulationParameters());
+    expectEqual(expectedPreview, preview);
+}
@@ -0,0 +1,388 @@
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/BlockCompressionService.h"
+#include "EngineInterface/ColumnarSerializerService.h"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/GenomeDescriptions.h"
+#include "EngineInterface/GenomeDescriptionService.h"
+#include "EngineInterface/MappedSimulationFile.h"
+#include "EngineInterface/SerializerService.h"
+
+class SerializerTests : public ::testing::Test
+{
+public:
+    SerializerTests() = default;
+    ~SerializerTests() = default;
+
+protected:
+    ClusteredDataDescription createData(int numClusters, int numCellsPerCluster) const
+    {
+        auto genome = GenomeDescriptionService::convertDescriptionToBytes(GenomeDescription().setCells(
+            {CellGenomeDescription(), CellGenomeDescription().setColor(2), CellGenomeDescription().setExecutionOrderNumber(3)}));
+
+        ClusteredDataDescription result;
+        uint64_t id = 1;
+        for (int i = 0; i < numClusters; ++i) {
+            ClusterDescription cluster;
+            for (int j = 0; j < numCellsPerCluster; ++j) {
+                CellDescription cell;
+                cell.setId(id)
+                    .setPos({toFloat(i), toFloat(j)})
+                    .setVel({0.1f, -0.2f})
+                    .setEnergy(toFloat(100 + j))
+                    .setColor(j % MAX_COLORS)
+                    .setMaxConnections(2)
+                    .setExecutionOrderNumber(j % 6)
+                    .setAge(i + j)
+                    .setCreatureId(i);
+                if (j > 0) {
+                    cell.connections.emplace_back(ConnectionDescription().setCellId(id - 1).setDistance(1.0f).setAngleFromPrevious(360.0f));
+                }
+                if (j + 1 < numCellsPerCluster) {
+                    cell.connections.emplace_back(ConnectionDescription().setCellId(id + 1).setDistance(1.0f).setAngleFromPrevious(180.0f));
+                }
+                switch (j % 4) {
+                case 0: {
+                    NeuronDescription neuron;
+                    neuron.weights[1][2] = toFloat(j);
+                    neuron.biases[3] = 0.5f;
+                    cell.setCellFunction(neuron);
+                } break;
+                case 1:
+                    cell.setCellFunction(ConstructorDescription().setGenome(genome).setGenomeCurrentNodeIndex(1));
+                    break;
+                case 2:
+                    cell.setCellFunction(SensorDescription().setFixedAngle(toFloat(j)).setColor(3));
+                    break;
+                default:
+                    cell.setInputExecutionOrderNumber(1);
+                    cell.setMetadata(CellMetadataDescription().setName("cell").setDescription("test"));
+                }
+                cluster.addCell(cell);
+                ++id;
+            }
+            result.addCluster(cluster);
+        }
+        for (int i = 0; i < numClusters; ++i) {
+            result.addParticle(ParticleDescription().setId(id++).setPos({toFloat(i), 0.5f}).setEnergy(10.0f).setColor(i % MAX_COLORS));
+        }
+        return result;
+    }
+};
+
+TEST_F(SerializerTests, columnarFormat_roundTrip)
+{
+    auto data = createData(10, 20);
+
+    std::string serializedData;
+    ASSERT_TRUE(SerializerService::serializeContentToString(serializedData, data, DataFormat::Columnar));
+
+    ClusteredDataDescription actualData;
+    ASSERT_TRUE(SerializerService::deserializeContentFromString(actualData, serializedData));
+
+    EXPECT_TRUE(data == actualData);
+}
+
+TEST_F(SerializerTests, columnarFormat_uncompressed_roundTrip)
+{
+    auto data = createData(10, 20);
+
+    std::string serializedData;
+    ASSERT_TRUE(SerializerService::serializeContentToString(serializedData, data, DataFormat::ColumnarUncompressed));
+    EXPECT_FALSE(BlockCompressionService::isBlockCompressed(serializedData));
+
+    ClusteredDataDescription actualData;
+    ASSERT_TRUE(SerializerService::deserializeContentFromString(actualData, serializedData));
+
+    EXPECT_TRUE(data == actualData);
+}
+
+TEST_F(SerializerTests, columnarFormat_emptyData)
+{
+    ClusteredDataDescription data;
+
+    std::string serializedData;
+    ASSERT_TRUE(SerializerService::serializeContentToString(serializedData, data, DataFormat::Columnar));
+
+    ClusteredDataDescription actualData;
+    ASSERT_TRUE(SerializerService::deserializeContentFromString(actualData, serializedData));
+
+    EXPECT_TRUE(actualData.isEmpty());
+}
+
+TEST_F(SerializerTests, cerealFormat_isStillReadable)
+{
+    auto data = createData(10, 20);
+
+    std::string serializedData;
+    ASSERT_TRUE(SerializerService::serializeContentToString(serializedData, data, DataFormat::Cereal));
+
+    ClusteredDataDescription actualData;
+    ASSERT_TRUE(SerializerService::deserializeContentFromString(actualData, serializedData));
+
+    EXPECT_TRUE(data == actualData);
+}
+
+TEST_F(SerializerTests, columnarFormat_detectedByCompleteMagic)
+{
+    EXPECT_TRUE(ColumnarSerializerService::isColumnarFormat(std::string_view("ALIENSOA\x01")));
+    EXPECT_FALSE(ColumnarSerializerService::isColumnarFormat(std::string_view("ALIENSOB\x01")));
+    EXPECT_FALSE(ColumnarSerializerService::isColumnarFormat(std::string_view("A")));
+}
+
+TEST_F(SerializerTests, columnarFormat_corruptedRowCount)
+{
+    std::stringstream stream;
+    ColumnarSerializerService::serializeDataDescription(createData(2, 3), stream);
+    auto serializedData = stream.str();
+
+    //header: magic, schema versions, size of program version, program version; first section: id, payload size, number of rows
+    uint32_t versionSize;
+    std::memcpy(&versionSize, serializedData.data() + 16, sizeof(versionSize));
+    auto numRowsPos = 20 + versionSize + sizeof(uint32_t) + sizeof(uint64_t);
+
+    //the first section is the cluster table with a single column of 4 byte elements, its size overflows to the original size
+    uint64_t numRows = (uint64_t(1) << 62) + 2;
+    std::memcpy(serializedData.data() + numRowsPos, &numRows, sizeof(numRows));
+
+    ClusteredDataDescription data;
+    EXPECT_THROW(ColumnarSerializerService::deserializeDataDescription(data, std::string_view(serializedData)), std::runtime_error);
+}
+
+TEST_F(SerializerTests, sharedGenome_legacyEncoding)
+{
+    auto genome = GenomeDescriptionService::convertDescriptionToBytes(GenomeDescription().setCells({CellGenomeDescription().setColor(4)}));
+
+    std::string serializedGenome;
+    ASSERT_TRUE(SerializerService::serializeGenomeToString(serializedGenome, genome));
+    EXPECT_FALSE(BlockCompressionService::isBlockCompressed(serializedGenome));
+
+    std::vector<uint8_t> actualGenome;
+    ASSERT_TRUE(SerializerService::deserializeGenomeFromString(actualGenome, serializedGenome));
+    EXPECT_EQ(genome, actualGenome);
+}
+
+TEST_F(SerializerTests, benchmark_columnarVsCereal)
+{
+    auto data = createData(2000, 50);
+
+    auto measure = [&](DataFormat format) {
+        auto startTimepoint = std::chrono::steady_clock::now();
+        std::string serializedData;
+        EXPECT_TRUE(SerializerService::serializeContentToString(serializedData, data, format));
+        ClusteredDataDescription actualData;
+        EXPECT_TRUE(SerializerService::deserializeContentFromString(actualData, serializedData));
+        EXPECT_TRUE(data == actualData);
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint).count();
+    };
+    auto cerealDuration = measure(DataFormat::Cereal);
+    auto columnarDuration = measure(DataFormat::Columnar);
+
+    std::cout << "[          ] round trip of " << data.getNumberOfCellAndParticles() << " objects: cereal " << cerealDuration << " ms, columnar "
+              << columnarDuration << " ms" << std::endl;
+}
+
+TEST_F(SerializerTests, columnarFormat_sharedAndDistinctGenomes)
+{
+    auto genome1 = GenomeDescriptionService::convertDescriptionToBytes(GenomeDescription().setCells({CellGenomeDescription()}));
+    auto genome2 = GenomeDescriptionService::convertDescriptionToBytes(GenomeDescription().setCells({CellGenomeDescription().setColor(4)}));
+
+    ClusteredDataDescription data;
+    ClusterDescription cluster;
+    for (int i = 0; i < 100; ++i) {
+        cluster.addCell(CellDescription().setId(i + 1).setCellFunction(ConstructorDescription().setGenome(i % 10 == 0 ? genome2 : genome1)));
+    }
+    cluster.addCell(CellDescription().setId(101).setCellFunction(InjectorDescription().setGenome(genome2)));
+    data.addCluster(cluster);
+
+    std::string serializedData;
+    ASSERT_TRUE(SerializerService::serializeContentToString(serializedData, data, DataFormat::Columnar));
+
+    ClusteredDataDescription actualData;
+    ASSERT_TRUE(SerializerService::deserializeContentFromString(actualData, serializedData));
+
+    EXPECT_TRUE(data == actualData);
+}
+
+TEST_F(SerializerTests, blockCompression_multipleBlocks)
+{
+    std::string data;
+    for (int i = 0; i < 3000000; ++i) {
+        data.append(std::to_string(i % 7919));
+    }
+
+    auto compressedData = BlockCompressionService::compress(data);
+    EXPECT_TRUE(BlockCompressionService::isBlockCompressed(compressedData));
+    EXPECT_LT(compressedData.size(), data.size());
+    EXPECT_EQ(data, BlockCompressionService::decompress(compressedData));
+}
+
+TEST_F(SerializerTests, blockCompression_emptyData)
+{
+    auto compressedData = BlockCompressionService::compress(std::string());
+    EXPECT_TRUE(BlockCompressionService::decompress(compressedData).empty());
+}
+
+TEST_F(SerializerTests, blockCompression_corruptedHeader)
+{
+    auto compressedData = BlockCompressionService::compress(std::string(100, 'x'));
+    auto setHeaderValue = [](std::string& data, size_t pos, uint64_t value) { std::memcpy(data.data() + pos, &value, sizeof(value)); };
+    auto constexpr NumBlocksPos = 12;  //after magic and version
+    auto constexpr UncompressedSizePos = 20;
+    auto constexpr FirstBlockUncompressedSizePos = 36;
+
+    auto tooManyBlocks = compressedData;
+    setHeaderValue(tooManyBlocks, NumBlocksPos, uint64_t(1) << 60);
+    EXPECT_THROW(BlockCompressionService::decompress(tooManyBlocks), std::runtime_error);
+
+    auto hugeSize = compressedData;
+    setHeaderValue(hugeSize, UncompressedSizePos, uint64_t(1) << 50);
+    EXPECT_THROW(BlockCompressionService::decompress(hugeSize), std::runtime_error);
+
+    auto hugeBlock = compressedData;
+    setHeaderValue(hugeBlock, FirstBlockUncompressedSizePos, uint64_t(1) << 50);
+    EXPECT_THROW(BlockCompressionService::decompress(hugeBlock), std::runtime_error);
+
+    EXPECT_THROW(BlockCompressionService::decompress(compressedData.substr(0, compressedData.size() - 1)), std::runtime_error);
+}
+
+TEST_F(SerializerTests, columnarReader_selectedClustersAndParticles)
+{
+    auto data = createData(10, 20);
+
+    std::stringstream stream;
+    ColumnarSerializerService::serializeDataDescription(data, stream);
+    auto serializedData = stream.str();
+
+    _ColumnarDataReader reader(serializedData);
+    EXPECT_EQ(10, reader.getNumClusters());
+    EXPECT_EQ(200, reader.getNumCells());
+    EXPECT_EQ(10, reader.getNumParticles());
+
+    auto actualData = reader.getData({7, 2}, {3});
+
+    ClusteredDataDescription expectedData;
+    expectedData.addCluster(data.clusters.at(7));
+    expectedData.addCluster(data.clusters.at(2));
+    expectedData.addParticle(data.particles.at(3));
+    EXPECT_TRUE(expectedData == actualData);
+}
+
+TEST_F(SerializerTests, mappedFile_regionQuery)
+{
+    auto data = createData(100, 5);
+    auto filename = (std::filesystem::temp_directory_path() / "alien_serializer_tests.sim").string();
+    for (auto format : {DataFormat::Columnar, DataFormat::ColumnarUncompressed}) {
+        ASSERT_TRUE(SerializerService::serializeContentToFile(filename, data, format));
+
+        auto file = std::make_shared<_MappedSimulationFile>(filename);
+        EXPECT_EQ(format == DataFormat::ColumnarUncompressed, file->isAccessedInPlace());
+        EXPECT_EQ(100, file->getNumClusters());
+        EXPECT_EQ(500, file->getNumCells());
+        EXPECT_EQ(100, file->getNumParticles());
+
+        //cluster i covers x = i and y in [0, 4], particle i is located at (i, 0.5)
+        auto actualData = file->getData(RealRect{{9.5f, 1.0f}, {12.5f, 2.0f}});
+        ASSERT_EQ(3, actualData.clusters.size());
+        EXPECT_TRUE(data.clusters.at(10) == actualData.clusters.at(0));
+        EXPECT_TRUE(data.clusters.at(11) == actualData.clusters.at(1));
+        EXPECT_TRUE(data.clusters.at(12) == actualData.clusters.at(2));
+        EXPECT_TRUE(actualData.particles.empty());
+
+        actualData = file->getData(RealRect{{-1.0f, 0.0f}, {0.5f, 0.5f}});
+        ASSERT_EQ(1, actualData.clusters.size());
+        ASSERT_EQ(1, actualData.particles.size());
+        EXPECT_TRUE(data.particles.at(0) == actualData.particles.at(0));
+
+        EXPECT_TRUE(file->getData(RealRect{{200.0f, 0.0f}, {300.0f, 10.0f}}).isEmpty());
+
+        ClusteredDataDescription streamedData;
+        file->forEachBatch(30, [&](ClusteredDataDescription const& batch) {
+            EXPECT_GE(30, batch.clusters.size() + batch.particles.size());
+            streamedData.addClusters(batch.clusters);
+            streamedData.addParticles(batch.particles);
+        });
+        EXPECT_TRUE(data == streamedData);
+    }
+    std::filesystem::remove(filename);
+}
+
+TEST_F(SerializerTests, mappedFile_blocksDecompressedOnDemand)
+{
+    auto data = createData(2000, 5);
+    std::stringstream stream;
+    ColumnarSerializerService::serializeDataDescription(data, stream);
+    auto filename = (std::filesystem::temp_directory_path() / "alien_serializer_tests_blocks.sim").string();
+    {
+        std::ofstream file(filename, std::ios::binary);
+        file << BlockCompressionService::compress(stream.str(), 4096);
+    }
+
+    auto file = std::make_shared<_MappedSimulationFile>(filename);
+    EXPECT_FALSE(file->isAccessedInPlace());
+    EXPECT_LT(file->getNumDecompressedBlocks(), file->getNumBlocks());
+
+    //cluster i covers x = i and y in [0, 4]
+    auto actualData = file->getData(RealRect{{999.5f, 1.0f}, {1000.5f, 2.0f}});
+    ASSERT_EQ(1, actualData.clusters.size());
+    EXPECT_TRUE(data.clusters.at(1000) == actualData.clusters.at(0));
+    EXPECT_LT(file->getNumDecompressedBlocks(), file->getNumBlocks() / 4);
+
+    ClusteredDataDescription streamedData;
+    file->forEachBatch(1000, [&](ClusteredDataDescription const& batch) {
+        streamedData.addClusters(batch.clusters);
+        streamedData.addParticles(batch.particles);
+    });
+    EXPECT_TRUE(data == streamedData);
+    EXPECT_EQ(file->getNumBlocks(), file->getNumDecompressedBlocks());
+
+    file.reset();
+    std::filesystem::remove(filename);
+}
+
+TEST_F(SerializerTests, mappedFile_wrappedRegionQuery)
+{
+    //cluster 0 crosses the world boundary at x = 0, cluster 1 is located in the middle of the world
+    auto data = createData(2, 3);
+    data.clusters.at(0).cells.at(0).setPos({98.5f, 10.0f});
+    data.clusters.at(0).cells.at(1).setPos({99.5f, 10.0f});
+    data.clusters.at(0).cells.at(2).setPos({0.5f, 10.0f});
+    for (auto& cell : data.clusters.at(1).cells) {
+        cell.setPos({50.0f, 10.0f});
+    }
+    data.particles.at(0).setPos({1.0f, 49.5f});
+    data.particles.at(1).setPos({50.0f, 20.0f});
+
+    auto filename = (std::filesystem::temp_directory_path() / "alien_serializer_tests_wrapped.sim").string();
+    ASSERT_TRUE(SerializerService::serializeContentToFile(filename, data, DataFormat::ColumnarUncompressed));
+    {
+        auto file = std::make_shared<_MappedSimulationFile>(filename, IntVector2D{100, 50});
+
+        auto actualData = file->getData(RealRect{{40.0f, 5.0f}, {60.0f, 15.0f}});
+        ASSERT_EQ(1, actualData.clusters.size());
+        EXPECT_TRUE(data.clusters.at(1) == actualData.clusters.at(0));
+
+        actualData = file->getData(RealRect{{-1.0f, 9.0f}, {0.0f, 11.0f}});
+        ASSERT_EQ(1, actualData.clusters.size());
+        EXPECT_TRUE(data.clusters.at(0) == actualData.clusters.at(0));
+
+        actualData = file->getData(RealRect{{100.0f, 49.0f}, {102.0f, 51.0f}});
+        EXPECT_TRUE(actualData.clusters.empty());
+        ASSERT_EQ(1, actualData.particles.size());
+        EXPECT_TRUE(data.particles.at(0) == actualData.particles.at(0));
+
+        EXPECT_EQ(2, file->getData(RealRect{{-10.0f, 0.0f}, {200.0f, 50.0f}}).clusters.size());
+    }
+    {
+        //without world size, the bounding box of cluster 0 spans the world
+        auto file = std::make_shared<_MappedSimulationFile>(filename);
+        EXPECT_EQ(2, file->getData(RealRect{{40.0f, 5.0f}, {60.0f, 15.0f}}).clusters.size());
+    }
+    std::filesystem::remove(filename);
+}
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/SnapshotHistory.h"
+
+class SnapshotHistoryTests : public ::testing::Test
+{
+public:
+    SnapshotHistoryTests() = default;
+    ~SnapshotHistoryTests() = default;
+
+protected:
+    HistorySnapshot createSnapshot(uint64_t timestep, int numCells) const
+    {
+        HistorySnapshot result;
+        result.timestep = timestep;
+        for (int i = 0; i < numCells; ++i) {
+            result.data.addCell(CellDescription().setId(i + 1).setPos({toFloat(i % 100), toFloat(i / 100)}).setEnergy(100.0f).setMaxConnections(2));
+        }
+        for (int i = 1; i < numCells; ++i) {
+            if (i % 100 != 0) {
+                result.data.addConnection(i, i + 1);
+            }
+        }
+        result.data.addParticle(ParticleDescription().setId(numCells + 1).setPos({0, 0.5f}).setEnergy(10.0f));
+        return result;
+    }
+
+    //moves some cells, removes the first cell and adds a new cell and particle
+    HistorySnapshot createNextSnapshot(HistorySnapshot const& snapshot, uint64_t newId) const
+    {
+        auto result = snapshot;
+        ++result.timestep;
+        for (size_t i = 0; i < result.data.cells.size(); i += 10) {
+            result.data.cells[i].pos.x += 0.1f;
+        }
+        auto removedCellId = result.data.cells.front().id;
+        result.data.cells.erase(result.data.cells.begin());
+        for (auto& cell : result.data.cells) {
+            std::erase_if(cell.connections, [&](auto const& connection) { return connection.cellId == removedCellId; });
+        }
+        result.data.addCell(CellDescription().setId(newId).setPos({50.0f, 50.0f}));
+        result.data.addParticle(ParticleDescription().setId(newId + 1).setPos({50.0f, 51.0f}));
+        return result;
+    }
+
+    bool isEqual(DataDescription const& expected, DataDescription const& actual) const
+    {
+        auto sortById = [](auto& objects) { std::sort(objects.begin(), objects.end(), [](auto const& left, auto const& right) { return left.id < right.id; }); };
+        auto expectedCopy = expected;
+        auto actualCopy = actual;
+        sortById(expectedCopy.cells);
+        sortById(expectedCopy.particles);
+        sortById(actualCopy.cells);
+        sortById(actualCopy.particles);
+        return expectedCopy.cells == actualCopy.cells && expectedCopy.particles == actualCopy.particles;
+    }
+};
+
+TEST_F(SnapshotHistoryTests, pushAndPop)
+{
+    std::vector<HistorySnapshot> snapshots{createSnapshot(10, 1000)};
+    for (int i = 0; i < 5; ++i) {
+        snapshots.emplace_back(createNextSnapshot(snapshots.back(), 10000 + i * 2));
+    }
+
+    SnapshotHistory history;
+    for (auto const& snapshot : snapshots) {
+        history.push(snapshot);
+    }
+    EXPECT_EQ(snapshots.size(), history.getNumSnapshots());
+
+    for (auto it = snapshots.rbegin(); it != snapshots.rend(); ++it) {
+        auto actualSnapshot = history.pop();
+        ASSERT_TRUE(actualSnapshot.has_value());
+        EXPECT_EQ(it->timestep, actualSnapshot->timestep);
+        EXPECT_TRUE(isEqual(it->data, actualSnapshot->data));
+    }
+    EXPECT_TRUE(history.isEmpty());
+    EXPECT_FALSE(history.pop().has_value());
+    EXPECT_EQ(0, history.getMemoryUsage());
+}
+
+TEST_F(SnapshotHistoryTests, pushAfterPop)
+{
+    auto snapshot1 = createSnapshot(0, 300);
+    auto snapshot2 = createNextSnapshot(snapshot1, 1000);
+    auto snapshot3 = createNextSnapshot(snapshot2, 2000);
+
+    SnapshotHistory history;
+    history.push(snapshot1);
+    history.push(snapshot2);
+    history.pop();
+    history.push(snapshot3);
+
+    EXPECT_TRUE(isEqual(snapshot3.data, history.pop()->data));
+    EXPECT_TRUE(isEqual(snapshot1.data, history.pop()->data));
+}
+
+TEST_F(SnapshotHistoryTests, deltasAreSmallerThanKeyframes)
+{
+    auto snapshot = createSnapshot(0, 10000);
+
+    SnapshotHistory history;
+    history.push(snapshot);
+    auto keyframeMemoryUsage = history.getMemoryUsage();
+
+    for (int i = 0; i < 10; ++i) {
+        snapshot = createNextSnapshot(snapshot, 100000 + i * 2);
+        history.push(snapshot);
+    }
+    EXPECT_LT(history.getMemoryUsage(), keyframeMemoryUsage * 5);
+}
+
+TEST_F(SnapshotHistoryTests, oldestSnapshotsAreEvicted)
+{
+    std::vector<HistorySnapshot> snapshots{createSnapshot(0, 1000)};
+    for (int i = 0; i < 20; ++i) {
+        snapshots.emplace_back(createNextSnapshot(snapshots.back(), 10000 + i * 2));
+    }
+
+    SnapshotHistory history;
+    history.push(snapshots.front());
+    history.setMemoryBudget(history.getMemoryUsage() * 2);
+    for (size_t i = 1; i < snapshots.size(); ++i) {
+        history.push(snapshots.at(i));
+        EXPECT_LE(history.getMemoryUsage(), history.getMemoryBudget());
+    }
+    auto numSnapshots = history.getNumSnapshots();
+    EXPECT_GT(numSnapshots, 1);
+    EXPECT_LT(numSnapshots, snapshots.size());
+
+    //the remaining snapshots are the newest ones
+    for (int i = 0; i < numSnapshots; ++i) {
+        auto const& expectedSnapshot = snapshots.at(snapshots.size() - 1 - i);
+        auto actualSnapshot = history.pop();
+        EXPECT_EQ(expectedSnapshot.timestep, actualSnapshot->timestep);
+        EXPECT_TRUE(isEqual(expectedSnapshot.data, actualSnapshot->data));
+    }
+}
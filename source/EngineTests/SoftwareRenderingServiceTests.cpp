@@ -0,0 +1,140 @@
+#include <filesystem>
+#include <fstream>
+
+#include <gtest/gtest.h>
+#include <zlib.h>
+
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/SoftwareRenderingService.h"
+
+class SoftwareRenderingServiceTests : public ::testing::Test
+{
+public:
+    SoftwareRenderingServiceTests()
+    {
+        _parameters.backgroundColor = 0;
+        _parameters.cellColoring = CellColoring_CellColor;
+    }
+    ~SoftwareRenderingServiceTests() = default;
+
+protected:
+    struct Pixel
+    {
+        int red = 0;
+        int green = 0;
+        int blue = 0;
+    };
+
+    Pixel getPixel(RgbaImage const& image, int x, int y) const
+    {
+        auto index = (x + y * image.size.x) * 4;
+        return {image.pixels.at(index), image.pixels.at(index + 1), image.pixels.at(index + 2)};
+    }
+
+    RenderingViewport createViewport(float zoom) const
+    {
+        RenderingViewport result;
+        result.center = {50.0f, 50.0f};
+        result.zoom = zoom;
+        result.imageSize = {200, 200};
+        return result;
+    }
+
+    IntVector2D const _worldSize = {100, 100};
+    SimulationParameters _parameters;
+};
+
+TEST_F(SoftwareRenderingServiceTests, emptyWorld)
+{
+    auto image = SoftwareRenderingService::render(DataDescription(), _worldSize, 0, _parameters, createViewport(4.0f));
+
+    ASSERT_EQ(200 * 200 * 4, image.pixels.size());
+    for (size_t i = 0; i < image.pixels.size(); i += 4) {
+        ASSERT_EQ(0, image.pixels.at(i));
+        ASSERT_EQ(0, image.pixels.at(i + 1));
+        ASSERT_EQ(0, image.pixels.at(i + 2));
+        ASSERT_EQ(255, image.pixels.at(i + 3));
+    }
+}
+
+TEST_F(SoftwareRenderingServiceTests, cellColor)
+{
+    auto data = DataDescription().addCells({
+        CellDescription().setId(1).setPos({45.0f, 50.0f}).setColor(0).setEnergy(200.0f),
+        CellDescription().setId(2).setPos({55.0f, 50.0f}).setColor(1).setEnergy(200.0f),
+    });
+    auto image = SoftwareRenderingService::render(data, _worldSize, 0, _parameters, createViewport(10.0f));
+
+    //cell positions in the image: (50, 100) and (150, 100)
+    auto bluishPixel = getPixel(image, 50, 100);
+    EXPECT_GT(bluishPixel.blue, bluishPixel.red);
+    auto reddishPixel = getPixel(image, 150, 100);
+    EXPECT_GT(reddishPixel.red, reddishPixel.blue);
+
+    auto backgroundPixel = getPixel(image, 100, 20);
+    EXPECT_EQ(0, backgroundPixel.red + backgroundPixel.green + backgroundPixel.blue);
+}
+
+TEST_F(SoftwareRenderingServiceTests, connectionAcrossBands)
+{
+    auto data = DataDescription().addCells({
+        CellDescription().setId(1).setPos({50.0f, 40.0f}).setMaxConnections(1),
+        CellDescription().setId(2).setPos({50.0f, 60.0f}).setMaxConnections(1),
+    });
+    data.addConnection(1, 2);
+    auto image = SoftwareRenderingService::render(data, _worldSize, 0, _parameters, createViewport(4.0f));
+
+    //the connection is drawn in all rows between the cells
+    for (int y = 70; y < 130; ++y) {
+        auto pixel = getPixel(image, 100, y);
+        ASSERT_GT(pixel.red + pixel.green + pixel.blue, 0);
+    }
+}
+
+TEST_F(SoftwareRenderingServiceTests, viewportForWorld)
+{
+    auto viewport = SoftwareRenderingService::calcViewportForWorld({400, 100}, {200, 200});
+    EXPECT_EQ(200.0f, viewport.center.x);
+    EXPECT_EQ(50.0f, viewport.center.y);
+    EXPECT_EQ(0.5f, viewport.zoom);
+}
+
+TEST_F(SoftwareRenderingServiceTests, pngFile)
+{
+    auto data = DataDescription().addParticle(ParticleDescription().setId(1).setPos({50.0f, 50.0f}).setEnergy(50.0f));
+    auto image = SoftwareRenderingService::render(data, _worldSize, 0, _parameters, createViewport(20.0f));
+
+    auto filename = (std::filesystem::temp_directory_path() / "software rendering test.png").string();
+    ASSERT_TRUE(SoftwareRenderingService::writePng(filename, image));
+
+    std::ifstream stream(filename, std::ios::binary);
+    std::string png((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    stream.close();
+    std::filesystem::remove(filename);
+
+    ASSERT_EQ(std::string("\x89PNG\r\n\x1a\n", 8), png.substr(0, 8));
+    auto readUInt32 = [&](size_t pos) {
+        return static_cast<uint32_t>(static_cast<uint8_t>(png[pos])) << 24 | static_cast<uint32_t>(static_cast<uint8_t>(png[pos + 1])) << 16
+            | static_cast<uint32_t>(static_cast<uint8_t>(png[pos + 2])) << 8 | static_cast<uint32_t>(static_cast<uint8_t>(png[pos + 3]));
+    };
+    EXPECT_EQ("IHDR", png.substr(12, 4));
+    EXPECT_EQ(200, readUInt32(16));
+    EXPECT_EQ(200, readUInt32(20));
+
+    //decode the scanlines which are filtered with the left pixel
+    auto idatPos = png.find("IDAT");
+    ASSERT_NE(std::string::npos, idatPos);
+    auto idatSize = readUInt32(idatPos - 4);
+    std::vector<uint8_t> scanlines(200 * (200 * 4 + 1));
+    uLongf scanlinesSize = static_cast<uLongf>(scanlines.size());
+    ASSERT_EQ(Z_OK, uncompress(scanlines.data(), &scanlinesSize, reinterpret_cast<Bytef const*>(png.data() + idatPos + 4), idatSize));
+    ASSERT_EQ(scanlines.size(), scanlinesSize);
+    for (int y = 0; y < 200; ++y) {
+        auto scanline = scanlines.data() + y * (200 * 4 + 1);
+        ASSERT_EQ(1, scanline[0]);
+        for (int i = 0; i < 200 * 4; ++i) {
+            auto value = static_cast<uint8_t>(scanline[i + 1] + (i < 4 ? 0 : image.pixels.at(y * 200 * 4 + i - 4)));
+            ASSERT_EQ(image.pixels.at(y * 200 * 4 + i), value);
+        }
+    }
+}
@@ -0,0 +1,165 @@
+#include <map>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "EngineImpl/SparseMapReference.h"
+
+class SparseMapTests : public ::testing::Test
+{
+public:
+    SparseMapTests() = default;
+    ~SparseMapTests() = default;
+};
+
+TEST_F(SparseMapTests, setAndGet_hugeWorld)
+{
+    IntVector2D worldSize{1000000, 1000000};
+    SparseMapReference map(worldSize, 10000);
+
+    std::mt19937 randomEngine(42);
+    std::uniform_int_distribution<int> distribution(0, worldSize.x - 1);
+    std::map<std::pair<int, int>, uint64_t> expectedValues;
+    for (uint64_t value = 1; value <= 10000; ++value) {
+        IntVector2D pos{distribution(randomEngine), distribution(randomEngine)};
+        uint64_t previousValue;
+        ASSERT_TRUE(map.set(pos, value, previousValue));
+        auto& expectedValue = expectedValues[{pos.x, pos.y}];
+        EXPECT_EQ(expectedValue, previousValue);
+        expectedValue = value;
+    }
+    for (auto const& [pos, value] : expectedValues) {
+        EXPECT_EQ(value, map.get({pos.first, pos.second}));
+        EXPECT_EQ(0, map.get({pos.first, pos.second + 1})) << "neighbor positions are empty with high probability";
+    }
+}
+
+TEST_F(SparseMapTests, neighboringPositionsInSameTile)
+{
+    SparseMapReference map({100, 100}, 100);
+
+    uint64_t previousValue;
+    for (int x = 0; x < SparseMapLayout::TileSize; ++x) {
+        for (int y = 0; y < SparseMapLayout::TileSize; ++y) {
+            ASSERT_TRUE(map.set({x, y}, 1 + x + y * SparseMapLayout::TileSize, previousValue));
+        }
+    }
+    EXPECT_EQ(1, map.getNumOccupiedTiles());
+    for (int x = 0; x < SparseMapLayout::TileSize; ++x) {
+        for (int y = 0; y < SparseMapLayout::TileSize; ++y) {
+            EXPECT_EQ(1 + x + y * SparseMapLayout::TileSize, map.get({x, y}));
+        }
+    }
+    EXPECT_EQ(0, map.get({SparseMapLayout::TileSize, 0}));
+}
+
+TEST_F(SparseMapTests, positionsAreWrappedAround)
+{
+    SparseMapReference map({101, 53}, 10);
+
+    uint64_t previousValue;
+    ASSERT_TRUE(map.set({-1, -1}, 7, previousValue));
+    EXPECT_EQ(7, map.get({100, 52}));
+    EXPECT_EQ(7, map.get({201, 105}));
+}
+
+TEST_F(SparseMapTests, clear)
+{
+    SparseMapReference map({10000, 10000}, 1000);
+
+    for (int timestep = 0; timestep < 100; ++timestep) {
+        for (int i = 0; i < 1000; ++i) {
+            uint64_t previousValue;
+            ASSERT_TRUE(map.set({i * 7 + timestep, i * 3}, i + 1, previousValue));
+            EXPECT_EQ(0, previousValue);
+        }
+        EXPECT_EQ(1000, map.get({999 * 7 + timestep, 999 * 3}));
+        map.clear();
+        EXPECT_EQ(0, map.getNumOccupiedTiles());
+        EXPECT_EQ(0, map.get({999 * 7 + timestep, 999 * 3}));
+    }
+}
+
+TEST_F(SparseMapTests, overflow_countedAndMapGrown)
+{
+    //more occupied tiles than estimated by maxEntries
+    SparseMapReference map({100000, 100000}, 10);
+    auto numTileSlots = SparseMapLayout::calcNumTileSlots({100000, 100000}, 10);
+
+    auto setAll = [&] {
+        int numFailed = 0;
+        for (int i = 0; i < numTileSlots + 10; ++i) {
+            uint64_t previousValue;
+            if (!map.set({i * SparseMapLayout::TileSize, 0}, i + 1, previousValue)) {
+                ++numFailed;
+            }
+        }
+        return numFailed;
+    };
+    EXPECT_EQ(10, setAll());
+    map.clear();
+    EXPECT_EQ(10, map.growIfOverflowed());
+    EXPECT_EQ(0, map.growIfOverflowed());
+
+    EXPECT_EQ(0, setAll());
+    EXPECT_EQ(numTileSlots + 10, map.get({(numTileSlots + 9) * SparseMapLayout::TileSize, 0}));
+    map.clear();
+    EXPECT_EQ(0, map.growIfOverflowed());
+}
+
+TEST_F(SparseMapTests, overflow_grownInOneStep)
+{
+    //far more occupied tiles than estimated by maxEntries
+    SparseMapReference map({100000, 100000}, 10);
+    auto numTileSlots = SparseMapLayout::calcNumTileSlots({100000, 100000}, 10);
+    auto numObjects = numTileSlots * 16;
+
+    auto setAll = [&] {
+        int numFailed = 0;
+        for (int i = 0; i < numObjects; ++i) {
+            uint64_t previousValue;
+            if (!map.set({(i % 1000) * SparseMapLayout::TileSize, (i / 1000) * SparseMapLayout::TileSize}, i + 1, previousValue)) {
+                ++numFailed;
+            }
+        }
+        return numFailed;
+    };
+    EXPECT_EQ(numObjects - numTileSlots, setAll());
+    map.clear();
+    EXPECT_EQ(numObjects - numTileSlots, map.growIfOverflowed());
+
+    EXPECT_EQ(0, setAll());
+    EXPECT_EQ(numObjects, map.getNumOccupiedTiles());
+}
+
+TEST_F(SparseMapTests, reserve_keepsGrownMap)
+{
+    SparseMapReference map({100000, 100000}, 1000);
+    auto memorySize = map.getMemorySize();
+
+    EXPECT_FALSE(map.reserve(1000));
+    EXPECT_FALSE(map.reserve(10));
+    EXPECT_EQ(memorySize, map.getMemorySize());
+
+    EXPECT_TRUE(map.reserve(10000));
+    EXPECT_LT(memorySize, map.getMemorySize());
+    memorySize = map.getMemorySize();
+    EXPECT_FALSE(map.reserve(1000));
+    EXPECT_EQ(memorySize, map.getMemorySize());
+}
+
+TEST_F(SparseMapTests, memoryProportionalToEntries)
+{
+    IntVector2D worldSize{100000, 100000};
+    SparseMapReference smallMap(worldSize, 10000);
+    SparseMapReference largeMap(worldSize, 100000);
+
+    EXPECT_LT(smallMap.getMemorySize() * 100, SparseMapReference::getDenseMemorySize(worldSize));
+    EXPECT_LE(largeMap.getMemorySize(), smallMap.getMemorySize() * 16);
+    EXPECT_GE(largeMap.getMemorySize(), smallMap.getMemorySize() * 8);
+
+    //a small world is never exceeded by more than the hash table overhead
+    IntVector2D smallWorldSize{64, 64};
+    SparseMapReference denseMap(smallWorldSize, 1000000);
+    EXPECT_LE(denseMap.getMemorySize(), SparseMapReference::getDenseMemorySize(smallWorldSize) * 5);
+}
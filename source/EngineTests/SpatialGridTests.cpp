@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+#include "Base/NumberGenerator.h"
+
+#include "EngineInterface/DescriptionEditService.h"
+#include "EngineInterface/SpatialGrid.h"
+
+class SpatialGridTests : public ::testing::Test
+{
+public:
+    SpatialGridTests() = default;
+    ~SpatialGridTests() = default;
+
+protected:
+    std::vector<RealVector2D> createRandomPositions(int number, float maxX, float maxY) const
+    {
+        std::vector<RealVector2D> result;
+        auto& numberGen = NumberGenerator::getInstance();
+        for (int i = 0; i < number; ++i) {
+            result.emplace_back(toFloat(numberGen.getRandomReal(0, maxX)), toFloat(numberGen.getRandomReal(0, maxY)));
+        }
+        return result;
+    }
+
+    std::vector<int> getEntriesWithinRadius_bruteForce(SpatialGrid const& grid, RealVector2D const& pos, float radius) const
+    {
+        std::vector<int> result;
+        for (int i = 0; i < grid.getNumEntries(); ++i) {
+            if (grid.getDistance(grid.getPos(i), pos) <= radius) {
+                result.emplace_back(i);
+            }
+        }
+        return result;
+    }
+
+    std::vector<int> getSorted(std::vector<int> values) const
+    {
+        std::sort(values.begin(), values.end());
+        return values;
+    }
+};
+
+TEST_F(SpatialGridTests, radiusQuery)
+{
+    SpatialGrid grid(createRandomPositions(2000, 100.0f, 50.0f), 2.0f);
+
+    for (auto const& pos : createRandomPositions(200, 100.0f, 50.0f)) {
+        for (auto const& radius : {0.5f, 2.0f, 7.0f}) {
+            EXPECT_EQ(getEntriesWithinRadius_bruteForce(grid, pos, radius), getSorted(grid.getEntriesWithinRadius(pos, radius)));
+        }
+    }
+}
+
+TEST_F(SpatialGridTests, radiusQuery_periodic)
+{
+    SpatialGrid grid(createRandomPositions(2000, 100.0f, 50.0f), 2.0f, IntVector2D{100, 50});
+
+    for (auto const& pos : createRandomPositions(200, 100.0f, 50.0f)) {
+        for (auto const& radius : {0.5f, 2.0f, 7.0f, 40.0f}) {
+            EXPECT_EQ(getEntriesWithinRadius_bruteForce(grid, pos, radius), getSorted(grid.getEntriesWithinRadius(pos, radius)));
+        }
+    }
+}
+
+TEST_F(SpatialGridTests, periodicBoundary)
+{
+    SpatialGrid grid(std::vector<RealVector2D>{{99.5f, 10.0f}, {50.0f, 49.5f}}, 2.0f, IntVector2D{100, 50});
+
+    EXPECT_TRUE(grid.isOccupied({0.2f, 10.0f}, 1.0f));
+    EXPECT_TRUE(grid.isOccupied({50.0f, 0.2f}, 1.0f));
+    EXPECT_TRUE(grid.isOccupied({100.2f, 10.0f}, 1.0f));
+    EXPECT_FALSE(grid.isOccupied({2.0f, 10.0f}, 1.0f));
+    EXPECT_EQ(std::vector<int>{0}, grid.getEntriesWithinRadius({-0.5f, 10.0f}, 1.0f));
+}
+
+TEST_F(SpatialGridTests, nearestQuery)
+{
+    auto positions = createRandomPositions(2000, 100.0f, 100.0f);
+    SpatialGrid grid(positions, 1.0f, IntVector2D{100, 100});
+
+    for (auto const& pos : createRandomPositions(200, 100.0f, 100.0f)) {
+        auto nearestIndex = grid.getNearestEntry(pos, 10.0f);
+        ASSERT_TRUE(nearestIndex.has_value());
+
+        auto minDistance = std::numeric_limits<float>::max();
+        for (int i = 0; i < grid.getNumEntries(); ++i) {
+            minDistance = std::min(minDistance, grid.getDistance(grid.getPos(i), pos));
+        }
+        EXPECT_EQ(minDistance, grid.getDistance(grid.getPos(*nearestIndex), pos));
+    }
+    EXPECT_FALSE(SpatialGrid(std::vector<RealVector2D>{{0, 0}}, 1.0f).getNearestEntry({5.0f, 5.0f}, 2.0f).has_value());
+}
+
+TEST_F(SpatialGridTests, insertAfterConstruction)
+{
+    SpatialGrid grid(createRandomPositions(100, 100.0f, 100.0f), 1.0f);
+    for (auto const& pos : createRandomPositions(1000, 200.0f, 200.0f)) {
+        grid.insert(pos - RealVector2D{50.0f, 50.0f});
+    }
+    EXPECT_EQ(1100, grid.getNumEntries());
+
+    for (auto const& pos : createRandomPositions(200, 200.0f, 200.0f)) {
+        EXPECT_EQ(getEntriesWithinRadius_bruteForce(grid, pos, 3.0f), getSorted(grid.getEntriesWithinRadius(pos, 3.0f)));
+    }
+
+    grid.clear();
+    EXPECT_EQ(0, grid.getNumEntries());
+    EXPECT_FALSE(grid.isOccupied({0, 0}, 1000.0f));
+}
+
+TEST_F(SpatialGridTests, benchmark_randomMultiplyWithOverlappingCheck)
+{
+    auto pattern = DescriptionEditService::createRect(DescriptionEditService::CreateRectParameters().width(3).height(3));
+    IntVector2D worldSize{2000, 2000};
+
+    auto startTimepoint = std::chrono::steady_clock::now();
+    bool overlappingCheckSuccessful = false;
+    auto result = DescriptionEditService::randomMultiply(
+        pattern, DescriptionEditService::RandomMultiplyParameters().number(10000).overlappingCheck(true), worldSize, DataDescription(), overlappingCheckSuccessful);
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimepoint);
+    std::cout << "random multiply of 10000 copies with overlapping check: " << duration.count() << " ms" << std::endl;
+
+    EXPECT_TRUE(overlappingCheckSuccessful);
+    EXPECT_EQ(10001 * 9, result.cells.size());
+
+    //copies must not overlap
+    std::vector<RealVector2D> copyPositions;
+    for (size_t i = 9; i < result.cells.size(); ++i) {
+        copyPositions.emplace_back(result.cells[i].pos);
+    }
+    SpatialGrid grid(copyPositions, 2.0f, worldSize);
+    for (size_t i = 0; i < copyPositions.size(); ++i) {
+        auto copyIndex = toInt(i) / 9;
+        for (auto const& index : grid.getEntriesWithinRadius(copyPositions[i], 1.9f)) {
+            EXPECT_EQ(copyIndex, index / 9);
+        }
+    }
+}
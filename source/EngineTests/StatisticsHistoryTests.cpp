@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+
+#include "EngineInterface/StatisticsHistory.h"
+
+class StatisticsHistoryTests : public ::testing::Test
+{
+public:
+    StatisticsHistoryTests() = default;
+    ~StatisticsHistoryTests() = default;
+
+protected:
+    DataPointCollection createDataPoint(double time, double numCells) const
+    {
+        DataPointCollection result;
+        result.time = time;
+        result.numCells.summedValues = numCells;
+        result.numCells.values[1] = numCells * 2;
+        return result;
+    }
+
+    void addDataPoints(StatisticsHistory& history, int fromIndex, int toIndex) const
+    {
+        for (int i = fromIndex; i < toIndex; ++i) {
+            history.add(createDataPoint(toDouble(i) * 10, toDouble(i)));
+        }
+    }
+};
+
+TEST_F(StatisticsHistoryTests, fullResolution)
+{
+    StatisticsHistory history;
+    addDataPoints(history, 0, 100);
+
+    auto data = history.getCopiedData();
+    ASSERT_EQ(100, data.size());
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(toDouble(i) * 10, data.at(i).time);
+        EXPECT_EQ(toDouble(i), data.at(i).numCells.summedValues);
+        EXPECT_EQ(toDouble(i) * 2, data.at(i).numCells.values[1]);
+    }
+}
+
+TEST_F(StatisticsHistoryTests, olderDataPointsAreDownsampled)
+{
+    StatisticsHistory history;
+    addDataPoints(history, 0, 100000);
+
+    auto data = history.getCopiedData();
+    EXPECT_LE(data.size(), StatisticsHistoryConstants::TierSize * StatisticsHistoryConstants::NumTiers);
+    EXPECT_EQ(0.0, data.front().time);
+    EXPECT_EQ(999990.0, data.back().time);
+    for (size_t i = 1; i < data.size(); ++i) {
+        ASSERT_LT(data.at(i - 1).time, data.at(i).time);
+    }
+
+    //recent data points in full resolution
+    for (int i = 0; i < StatisticsHistoryConstants::TierSize; ++i) {
+        auto const& dataPoint = data.at(data.size() - 1 - i);
+        EXPECT_EQ(toDouble(99999 - i), dataPoint.numCells.summedValues);
+    }
+}
+
+TEST_F(StatisticsHistoryTests, replaceDataPointWithSameTime)
+{
+    StatisticsHistory history;
+    addDataPoints(history, 0, 10);
+    history.add(createDataPoint(90.0, 42.0));
+
+    auto data = history.getCopiedData();
+    ASSERT_EQ(10, data.size());
+    EXPECT_EQ(42.0, data.back().numCells.summedValues);
+}
+
+TEST_F(StatisticsHistoryTests, removeDataPoints)
+{
+    StatisticsHistory history;
+    addDataPoints(history, 0, 5000);
+    history.removeDataPoints(30000.0);
+
+    auto data = history.getCopiedData();
+    ASSERT_FALSE(data.empty());
+    EXPECT_LT(data.back().time, 30000.0);
+
+    addDataPoints(history, 3000, 3010);
+    EXPECT_EQ(30090.0, history.getLastDataPoint()->time);
+}
+
+TEST_F(StatisticsHistoryTests, snapshotIsUnaffectedByLaterChanges)
+{
+    StatisticsHistory history;
+    addDataPoints(history, 0, 100);
+    auto snapshot = history.getSnapshot();
+    auto origData = snapshot->getData();
+
+    history.removeDataPoints(500.0);
+    addDataPoints(history, 1000, 5000);
+
+    EXPECT_EQ(100, snapshot->getNumDataPoints());
+    auto data = snapshot->getData();
+    ASSERT_EQ(origData.size(), data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+        EXPECT_EQ(origData.at(i).time, data.at(i).time);
+        EXPECT_EQ(origData.at(i).numCells.summedValues, data.at(i).numCells.summedValues);
+    }
+}
+
+TEST_F(StatisticsHistoryTests, rangeQueryWithReducedResolution)
+{
+    StatisticsHistory history;
+    addDataPoints(history, 0, 1000);
+
+    auto data = history.getSnapshot()->getData(1000.0, 2990.0, 50);
+    ASSERT_EQ(50, data.size());
+    EXPECT_EQ(1000.0, data.front().time);
+    EXPECT_EQ(101.5, data.front().numCells.summedValues);
+    EXPECT_EQ(2960.0, data.back().time);
+    EXPECT_EQ(297.5, data.back().numCells.summedValues);
+
+    EXPECT_TRUE(history.getSnapshot()->getData(20000.0, 30000.0, 50).empty());
+}
+
+TEST_F(StatisticsHistoryTests, fullResolutionDataSinceSequenceNumber)
+{
+    StatisticsHistory history;
+    addDataPoints(history, 0, 10);
+    auto sequenceNumber = history.getSnapshot()->getNextSequenceNumber();
+    addDataPoints(history, 10, 15);
+
+    auto data = history.getSnapshot()->getFullResolutionData(sequenceNumber);
+    ASSERT_EQ(5, data.size());
+    EXPECT_EQ(100.0, data.front().time);
+    EXPECT_EQ(140.0, data.back().time);
+    EXPECT_EQ(15, history.getSnapshot()->getNextSequenceNumber());
+}
@@ -0,0 +1,42 @@
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "Base/ThreadPool.h"
+
+class ThreadPoolTests : public ::testing::Test
+{};
+
+TEST_F(ThreadPoolTests, allItemsProcessedOnce_repeatedLoops)
+{
+    for (auto numThreads : {1, 2, 8}) {
+        ThreadPool pool(numThreads);
+        EXPECT_EQ(numThreads, pool.getNumThreads());
+        for (int i = 0; i < 100; ++i) {
+            std::vector<int> counts(10000, 0);
+            pool.forEachInChunks(counts.size(), 64, [&](size_t index) { ++counts[index]; });
+            EXPECT_EQ(10000, std::accumulate(counts.begin(), counts.end(), 0));
+            EXPECT_EQ(1, *std::max_element(counts.begin(), counts.end()));
+        }
+    }
+}
+
+TEST_F(ThreadPoolTests, exceptionIsRethrown)
+{
+    ThreadPool pool(4);
+    EXPECT_THROW(
+        pool.forEachInChunks(1000, 10, [](size_t index) {
+            if (index == 500) {
+                throw std::runtime_error("test");
+            }
+        }),
+        std::runtime_error);
+
+    //the pool is still usable
+    std::atomic<int> numItems = 0;
+    pool.forEachInChunks(1000, 10, [&](size_t) { ++numItems; });
+    EXPECT_EQ(1000, numItems.load());
+}
@@ -1285,8 +1285,8 @@ namespace
 
 void AlienImGui::NeuronSelection(
     NeuronSelectionParameters const& parameters,
-    std::vector<std::vector<float>>& weights,
-    std::vector<float>& biases,
+    NeuronWeights& weights,
+    NeuronBiases& biases,
     std::vector<NeuronActivationFunction>& activationFunctions)
 {
     auto& selectedInput = getIdBasedValue(_neuronSelectedInput);
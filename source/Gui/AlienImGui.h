@@ -5,6 +5,7 @@
 #include <imgui.h>
 
 #include "Base/Definitions.h"
+#include "EngineInterface/Definitions.h"
 #include "EngineInterface/EngineConstants.h"
 #include "EngineInterface/PreviewDescriptions.h"
 #include "Definitions.h"
@@ -310,8 +311,8 @@ public:
     };
     static void NeuronSelection(
         NeuronSelectionParameters const& parameters,
-        std::vector<std::vector<float>>& weights,
-        std::vector<float>& biases,
+        NeuronWeights& weights,
+        NeuronBiases& biases,
         std::vector<NeuronActivationFunction>& activationFunctions);
 
     static void OnlineSymbol();
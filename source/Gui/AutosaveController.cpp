@@ -1,34 +1,103 @@
 #include "AutosaveController.h"
 
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
 #include <imgui.h>
 
 #include "Base/Resources.h"
 #include "Base/GlobalSettings.h"
-#include "EngineInterface/SerializerService.h"
+#include "Base/LoggingService.h"
 #include "EngineInterface/SimulationController.h"
 
 #include "Viewport.h"
 #include "DelayedExecutionController.h"
 #include "OverlayMessageController.h"
+#include "StyleRepository.h"
+
+namespace
+{
+    //each autosave is written into its own generation directory, the manifest which names the latest complete generation
+    //is replaced last such that a crash at any point leaves a consistent set of files
+    std::filesystem::path const AutosaveDirectory = std::filesystem::path(Const::BasePath) / "autosave";
+    std::filesystem::path const ManifestFilename = AutosaveDirectory / "latest.txt";
+
+    //generations are numbered consecutively, other entries of the autosave directory are ignored
+    std::vector<uint64_t> getGenerations()
+    {
+        std::vector<uint64_t> result;
+        std::error_code errorCode;
+        for (auto const& entry : std::filesystem::directory_iterator(AutosaveDirectory, errorCode)) {
+            auto name = entry.path().filename().string();
+            if (entry.is_directory() && !name.empty() && std::ranges::all_of(name, [](char c) { return c >= '0' && c <= '9'; })) {
+                result.emplace_back(std::stoull(name));
+            }
+        }
+        std::ranges::sort(result);
+        return result;
+    }
+
+    std::filesystem::path getGenerationDirectory(uint64_t generation)
+    {
+        return AutosaveDirectory / std::to_string(generation);
+    }
+
+    std::filesystem::path getAutosaveFilename(uint64_t generation)
+    {
+        return getGenerationDirectory(generation) / Const::AutosaveFileWithoutPath;
+    }
+
+    //renaming within a directory is atomic
+    void writeManifest(uint64_t generation)
+    {
+        auto temporaryFilename = ManifestFilename;
+        temporaryFilename.replace_extension(".tmp");
+        {
+            std::ofstream stream(temporaryFilename, std::ios::binary);
+            stream << generation;
+            stream.close();
+            if (!stream) {
+                throw std::runtime_error("manifest could not be written");
+            }
+        }
+        std::filesystem::rename(temporaryFilename, ManifestFilename);
+    }
+
+    std::optional<uint64_t> readManifest()
+    {
+        std::ifstream stream(ManifestFilename, std::ios::binary);
+        uint64_t result;
+        if (!(stream >> result)) {
+            return std::nullopt;
+        }
+        return result;
+    }
+}
 
 _AutosaveController::_AutosaveController(SimulationController const& simController)
     : _simController(simController)
 {
     _startTimePoint = std::chrono::steady_clock::now();
     _on = GlobalSettings::getInstance().getBool("controllers.auto save.active", true);
+    _numAutosaveFiles = std::max(1, GlobalSettings::getInstance().getInt("controllers.auto save.number of files", _numAutosaveFiles));
 }
 
 _AutosaveController::~_AutosaveController()
 {
+    waitForSaveThread();
     GlobalSettings::getInstance().setBool("controllers.auto save.active", _on);
+    GlobalSettings::getInstance().setInt("controllers.auto save.number of files", _numAutosaveFiles);
 }
 
 void _AutosaveController::shutdown()
 {
     if (!_on) {
+        waitForSaveThread();
         return;
     }
     onSave();
+    waitForSaveThread();
 }
 
 bool _AutosaveController::isOn() const
@@ -43,6 +112,7 @@ void _AutosaveController::setOn(bool value)
 
 void _AutosaveController::process()
 {
+    processProgress();
     if (!_on) {
         return;
     }
@@ -60,6 +130,13 @@ void _AutosaveController::process()
 
 void _AutosaveController::onSave()
 {
+    if (_saveInProgress) {
+        log(Priority::Important, "autosave skipped since the previous one is still in progress");
+        return;
+    }
+    waitForSaveThread();
+
+    //only the capture of the simulation is done on the GUI thread
     DeserializedSimulation sim;
     sim.auxiliaryData.timestep = _simController->getCurrentTimestep();
     sim.auxiliaryData.zoom = Viewport::getZoomFactor();
@@ -68,5 +145,71 @@ void _AutosaveController::onSave()
     sim.auxiliaryData.simulationParameters = _simController->getSimulationParameters();
     sim.mainData = _simController->getClusteredSimulationData();
     sim.statistics = _simController->getStatisticsHistory().getCopiedData();
-    SerializerService::serializeSimulationToFiles(Const::AutosaveFile, sim);
+
+    _saveInProgress = true;
+    _saveThread.emplace([this, sim = std::move(sim), numAutosaveFiles = _numAutosaveFiles] {
+        saveIntern(sim, numAutosaveFiles);
+        _saveInProgress = false;
+    });
+}
+
+void _AutosaveController::processProgress()
+{
+    if (!_saveInProgress) {
+        return;
+    }
+    std::string text = "Auto saving ...";
+    auto& styleRep = StyleRepository::getInstance();
+    auto viewportSize = ImGui::GetMainViewport()->Size;
+    auto textSize = ImGui::CalcTextSize(text.c_str());
+    ImGui::GetForegroundDrawList()->AddText(
+        {viewportSize.x - textSize.x - styleRep.scale(10.0f), viewportSize.y - textSize.y - styleRep.scale(10.0f)},
+        ImColor::HSV(0.0f, 0.0f, 1.0f, 0.7f),
+        text.c_str());
+}
+
+std::string _AutosaveController::getLatestAutosaveFilename()
+{
+    if (auto generation = readManifest()) {
+        auto result = getAutosaveFilename(*generation);
+        if (std::filesystem::exists(result)) {
+            return result.string();
+        }
+    }
+    return Const::AutosaveFile;
+}
+
+void _AutosaveController::saveIntern(DeserializedSimulation const& sim, int numAutosaveFiles)
+{
+    try {
+        std::filesystem::create_directories(AutosaveDirectory);
+        auto latestGeneration = readManifest();
+        auto generation = latestGeneration ? *latestGeneration + 1 : 0;
+
+        //generations which are not referenced by the manifest are incomplete (e.g. due to a crash) and are replaced
+        for (auto const& existingGeneration : getGenerations()) {
+            if (!latestGeneration || existingGeneration > *latestGeneration) {
+                std::filesystem::remove_all(getGenerationDirectory(existingGeneration));
+            }
+        }
+        std::filesystem::create_directories(getGenerationDirectory(generation));
+        if (!SerializerService::serializeSimulationToFiles(getAutosaveFilename(generation).string(), sim)) {
+            throw std::runtime_error("simulation could not be written");
+        }
+        writeManifest(generation);
+
+        //older generations are removed only after the manifest refers to the new one
+        for (auto const& existingGeneration : getGenerations()) {
+            if (existingGeneration + numAutosaveFiles <= generation) {
+                std::filesystem::remove_all(getGenerationDirectory(existingGeneration));
+            }
+        }
+    } catch (std::exception const& e) {
+        log(Priority::Important, std::string("autosave failed: ") + e.what());
+    }
+}
+
+void _AutosaveController::waitForSaveThread()
+{
+    _saveThread.reset();
 }
@@ -1,8 +1,13 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <optional>
+#include <string>
+#include <thread>
 
 #include "EngineInterface/Definitions.h"
+#include "EngineInterface/SerializerService.h"
 #include "Definitions.h"
 
 class _AutosaveController
@@ -18,12 +23,24 @@ public:
 
     void process();
 
+    //file of the latest complete autosave or the default simulation if there is none
+    static std::string getLatestAutosaveFilename();
+
 private:
     void onSave();
+    void processProgress();
+
+    //runs on the save thread: serialization, compression and writing of the captured simulation
+    void saveIntern(DeserializedSimulation const& sim, int numAutosaveFiles);
+    void waitForSaveThread();
 
     SimulationController _simController;
 
     bool _on = true;
+    int _numAutosaveFiles = 3;
     std::optional<std::chrono::steady_clock::time_point> _startTimePoint;
     bool _alreadySaved = false;
+
+    std::optional<std::jthread> _saveThread;
+    std::atomic<bool> _saveInProgress = false;
 };
\ No newline at end of file
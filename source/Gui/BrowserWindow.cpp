@@ -1195,23 +1195,12 @@ void _BrowserWindow::processActivated()
 
 void _BrowserWindow::createTreeTOs(Workspace& workspace)
 {
-    //sorting
-    if (workspace.rawTOs.size() > 1) {
-        std::sort(workspace.rawTOs.begin(), workspace.rawTOs.end(), [&](auto const& left, auto const& right) {
-            return _NetworkResourceRawTO::compare(left, right, workspace.sortSpecs) < 0;
-        });
-    }
-
-    //filtering
-    std::vector<NetworkResourceRawTO> filteredRawTOs;
-    for (auto const& rawTO : workspace.rawTOs) {
-        if (rawTO->matchWithFilter(_filter)) {
-            filteredRawTOs.emplace_back(rawTO);
-        }
-    }
-
-    //create treeTOs
-    workspace.treeTOs = NetworkResourceService::createTreeTOs(filteredRawTOs, workspace.collapsedFolderNames);
+    //only the stages affected by changed inputs are recalculated
+    workspace.index.setRawTOs(workspace.rawTOs);
+    workspace.index.setSortSpecs(workspace.sortSpecs);
+    workspace.index.setFilter(_filter);
+    workspace.index.setCollapsedFolderNames(workspace.collapsedFolderNames);
+    workspace.treeTOs = workspace.index.getTreeTOs();
     _selectedTreeTO = nullptr;
 }
 
@@ -1224,6 +1213,7 @@ void _BrowserWindow::onDownloadResource(BrowserLeaf const& leaf)
 {
     printOverlayMessage("Downloading ...");
     ++leaf.rawTO->numDownloads;
+    invalidateResourceValues();
 
     delayedExecution([=, this] {
         std::string dataTypeString = _currentWorkspace.resourceType == NetworkResourceType_Simulation ? "simulation" : "genome";
@@ -1231,9 +1221,9 @@ void _BrowserWindow::onDownloadResource(BrowserLeaf const& leaf)
         if (_currentWorkspace.resourceType == NetworkResourceType_Simulation) {
             cachedSimulation = _simulationCache.find(leaf.rawTO->id);
         }
-        SerializedSimulation serializedSim;
+        ResourceData resourceData;
         if (!cachedSimulation.has_value()) {
-            if (!NetworkService::downloadResource(serializedSim.mainData, serializedSim.auxiliaryData, serializedSim.statistics, leaf.rawTO->id)) {
+            if (!NetworkService::downloadResource(resourceData, leaf.rawTO->id, leaf.rawTO->timestamp)) {
                 MessageDialog::getInstance().information("Error", "Failed to download " + dataTypeString + ".");
                 return;
             }
@@ -1242,6 +1232,7 @@ void _BrowserWindow::onDownloadResource(BrowserLeaf const& leaf)
         if (_currentWorkspace.resourceType == NetworkResourceType_Simulation) {
             DeserializedSimulation deserializedSim;
             if (!cachedSimulation.has_value()) {
+                SerializedSimulationView serializedSim{resourceData.mainData, resourceData.auxiliaryData, resourceData.statistics};
                 if (!SerializerService::deserializeSimulationFromStrings(deserializedSim, serializedSim)) {
                     MessageDialog::getInstance().information("Error", "Failed to load simulation. Your program version may not match.");
                     return;
@@ -1281,7 +1272,7 @@ void _BrowserWindow::onDownloadResource(BrowserLeaf const& leaf)
 
         } else {
             std::vector<uint8_t> genome;
-            if (!SerializerService::deserializeGenomeFromString(genome, serializedSim.mainData)) {
+            if (!SerializerService::deserializeGenomeFromString(genome, resourceData.mainData)) {
                 MessageDialog::getInstance().information("Error", "Failed to load genome. Your program version may not match.");
                 return;
             }
@@ -1363,7 +1354,7 @@ void _BrowserWindow::onEditResource(NetworkResourceTreeTO const& treeTO)
     if (treeTO->isLeaf()) {
         _editSimulationDialog.lock()->openForLeaf(treeTO);
     } else {
-        auto rawTOs = NetworkResourceService::getMatchingRawTOs(treeTO, _workspaces.at(_currentWorkspace).rawTOs);
+        auto rawTOs = _workspaces.at(_currentWorkspace).index.getMatchingRawTOs(treeTO);
         _editSimulationDialog.lock()->openForFolder(treeTO, rawTOs);
     }
 }
@@ -1371,7 +1362,7 @@ void _BrowserWindow::onEditResource(NetworkResourceTreeTO const& treeTO)
 void _BrowserWindow::onMoveResource(NetworkResourceTreeTO const& treeTO)
 {
     auto& source = _workspaces.at(_currentWorkspace);
-    auto rawTOs = NetworkResourceService::getMatchingRawTOs(treeTO, source.rawTOs);
+    auto rawTOs = source.index.getMatchingRawTOs(treeTO);
 
     for (auto const& rawTO : rawTOs) {
         switch (rawTO->workspaceType) {
@@ -1412,7 +1403,7 @@ void _BrowserWindow::onMoveResource(NetworkResourceTreeTO const& treeTO)
 void _BrowserWindow::onDeleteResource(NetworkResourceTreeTO const& treeTO)
 {
     auto& currentWorkspace = _workspaces.at(_currentWorkspace);
-    auto rawTOs = NetworkResourceService::getMatchingRawTOs(treeTO, currentWorkspace.rawTOs);
+    auto rawTOs = currentWorkspace.index.getMatchingRawTOs(treeTO);
 
     auto message = treeTO->isLeaf() ? "Do you really want to delete the selected item?" : "Do you really want to delete the selected folder?";
     MessageDialog::getInstance().yesNo("Delete", message, [rawTOs = rawTOs, this]() {
@@ -1473,6 +1464,7 @@ void _BrowserWindow::onToggleLike(NetworkResourceTreeTO const& to, int emojiType
         }
 
         _userNamesByEmojiTypeBySimIdCache.erase(std::make_pair(leaf.rawTO->id, emojiType));  //invalidate cache entry
+        invalidateResourceValues();
         NetworkService::toggleReactToResource(leaf.rawTO->id, emojiType);
     } else {
         _loginDialog.lock()->open();
@@ -1489,10 +1481,17 @@ void _BrowserWindow::onExpandFolders()
 void _BrowserWindow::onCollapseFolders()
 {
     auto& workspace = _workspaces.at(_currentWorkspace);
-    workspace.collapsedFolderNames = NetworkResourceService::getFolderNames(workspace.rawTOs, 1);
+    workspace.collapsedFolderNames = workspace.index.getFolderNames(1);
     createTreeTOs(workspace);
 }
 
+void _BrowserWindow::invalidateResourceValues()
+{
+    for (auto& workspace : _workspaces | std::views::values) {
+        workspace.index.invalidateValues();
+    }
+}
+
 void _BrowserWindow::openWeblink(std::string const& link)
 {
 #ifdef _WIN32
@@ -1507,7 +1506,7 @@ bool _BrowserWindow::isOwner(NetworkResourceTreeTO const& treeTO) const
     }
     auto const& workspace = _workspaces.at(_currentWorkspace);
 
-    auto rawTOs = NetworkResourceService::getMatchingRawTOs(treeTO, workspace.rawTOs);
+    auto rawTOs = workspace.index.getMatchingRawTOs(treeTO);
     auto userName = NetworkService::getLoggedInUserName().value_or("");
     return std::ranges::all_of(rawTOs, [&](NetworkResourceRawTO const& rawTO) { return rawTO->userName == userName; });
 }
@@ -5,6 +5,7 @@
 #include "Base/Hashes.h"
 #include "Base/Cache.h"
 #include "EngineInterface/Definitions.h"
+#include "Network/NetworkResourceIndex.h"
 #include "Network/NetworkResourceTreeTO.h"
 #include "Network/NetworkResourceRawTO.h"
 #include "Network/UserTO.h"
@@ -49,9 +50,10 @@ private:
     struct Workspace
     {
         std::vector<ImGuiTableColumnSortSpecs> sortSpecs;
-        std::vector<NetworkResourceRawTO> rawTOs;    //unfiltered, sorted
+        std::vector<NetworkResourceRawTO> rawTOs;    //unfiltered, unsorted
         std::vector<NetworkResourceTreeTO> treeTOs;  //filtered, sorted
         std::set<std::vector<std::string>> collapsedFolderNames;
+        NetworkResourceIndex index;  //caches sorting, filtering and the folder hierarchy of rawTOs
     };
 
     void refreshIntern(bool withRetry);
@@ -104,6 +106,7 @@ private:
     void onToggleLike(NetworkResourceTreeTO const& to, int emojiType);
     void onExpandFolders();
     void onCollapseFolders();
+    void invalidateResourceValues();  //after download counts or reactions have been changed
     void openWeblink(std::string const& link);
 
     bool isOwner(NetworkResourceTreeTO const& treeTO) const;
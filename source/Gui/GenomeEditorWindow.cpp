@@ -928,7 +928,7 @@ void _GenomeEditorWindow::onCreateSpore()
 void _GenomeEditorWindow::showPreview(TabData& tab)
 {
     auto const& genome = _tabDatas.at(_selectedTabIndex).genome;
-    auto preview = PreviewDescriptionService::convert(genome, tab.selectedNode, _simController->getSimulationParameters());
+    auto preview = PreviewDescriptionService::convert(genome, _simController->getSimulationParameters());
     if (AlienImGui::ShowPreviewDescription(preview, tab.previewZoom, tab.selectedNode)) {
         _nodeIndexToJump = tab.selectedNode;
     }
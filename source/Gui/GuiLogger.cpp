@@ -12,18 +12,26 @@ _GuiLogger::~_GuiLogger()
     LoggingService::getInstance().unregisterCallBack(this);
 }
 
-std::vector<std::string> const& _GuiLogger::getMessages(Priority minPriority) const
+uint64_t _GuiLogger::getChangeCounter() const
 {
-    if (Priority::Important == minPriority) {
-        return _importantLogMessages;
-    }
-    return _allLogMessages;
+    return _changeCounter.load();
+}
+
+std::vector<std::string> _GuiLogger::getMessages(Priority minPriority) const
+{
+    std::lock_guard lock(_mutex);
+    auto const& messages = Priority::Important == minPriority ? _importantLogMessages : _allLogMessages;
+    return std::vector<std::string>(messages.begin(), messages.end());
 }
 
 void _GuiLogger::newLogMessage(Priority priority, std::string const& message)
 {
-    _allLogMessages.emplace_back(message);
-    if (Priority::Important == priority) {
-        _importantLogMessages.emplace_back(message);
+    {
+        std::lock_guard lock(_mutex);
+        _allLogMessages.push_back(message);
+        if (Priority::Important == priority) {
+            _importantLogMessages.push_back(message);
+        }
     }
+    ++_changeCounter;
 }
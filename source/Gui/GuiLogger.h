@@ -1,5 +1,10 @@
 #pragma once
 
+#include <atomic>
+#include <mutex>
+
+#include <boost/circular_buffer.hpp>
+
 #include "Base/LoggingService.h"
 #include "Definitions.h"
 
@@ -9,12 +14,18 @@ public:
     _GuiLogger();
     virtual ~_GuiLogger();
 
-    std::vector<std::string> const& getMessages(Priority minPriority) const;
+    //changes with each new message, i.e. the messages only need to be fetched again if it differs from the last value
+    uint64_t getChangeCounter() const;
+    std::vector<std::string> getMessages(Priority minPriority) const;
 
 private:
 
     void newLogMessage(Priority priority, std::string const& message) override;
 
-    std::vector<std::string> _allLogMessages;
-    std::vector<std::string> _importantLogMessages;
+    static size_t constexpr MaxNumMessages = 10000;  //older messages are discarded
+
+    mutable std::mutex _mutex;  //messages are added on the writer thread of LoggingService
+    boost::circular_buffer<std::string> _allLogMessages{MaxNumMessages};
+    boost::circular_buffer<std::string> _importantLogMessages{MaxNumMessages};
+    std::atomic<uint64_t> _changeCounter{0};
 };
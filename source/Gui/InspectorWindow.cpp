@@ -376,7 +376,7 @@ void _InspectorWindow::processCellGenomeTab(Description& desc)
             if (ImGui::TreeNodeEx("Data", TreeNodeFlags)) {
                 if (ImGui::BeginChild("##child", ImVec2(0, scale(200)), true, ImGuiWindowFlags_HorizontalScrollbar)) {
                     auto genomDesc = GenomeDescriptionService::convertBytesToDescription(desc.genome);
-                    auto previewDesc = PreviewDescriptionService::convert(genomDesc, std::nullopt, parameters);
+                    auto previewDesc = PreviewDescriptionService::convert(genomDesc, parameters);
                     std::optional<int> selectedNodeDummy;
                     AlienImGui::ShowPreviewDescription(previewDesc, _genomeZoom, selectedNodeDummy);
                 }
@@ -2,8 +2,6 @@
 
 #include <imgui.h>
 
-#include <boost/range/adaptor/reversed.hpp>
-
 #include "Base/GlobalSettings.h"
 
 #include "StyleRepository.h"
@@ -30,8 +28,20 @@ void _LogWindow::processIntern()
         ImGui::PushFont(StyleRepository::getInstance().getMonospaceMediumFont());
         ImGui::PushStyleColor(ImGuiCol_Text, (ImVec4)Const::MonospaceColor);
 
-        for (auto const& logMessage : _logger->getMessages(_verbose ? Priority::Unimportant : Priority::Important) | boost::adaptors::reversed) {
-            ImGui::TextUnformatted(logMessage.c_str());
+        auto changeCounter = _logger->getChangeCounter();
+        if (changeCounter != _cachedChangeCounter || _verbose != _cachedVerbose) {
+            _cachedMessages = _logger->getMessages(_verbose ? Priority::Unimportant : Priority::Important);
+            _cachedChangeCounter = changeCounter;
+            _cachedVerbose = _verbose;
+        }
+
+        //newest messages first, only visible lines are submitted
+        ImGuiListClipper clipper;
+        clipper.Begin(toInt(_cachedMessages.size()));
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                ImGui::TextUnformatted(_cachedMessages.at(_cachedMessages.size() - 1 - row).c_str());
+            }
         }
         ImGui::PopStyleColor();
         ImGui::PopFont();
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <optional>
+
 #include "Definitions.h"
 #include "AlienWindow.h"
 
@@ -15,4 +17,9 @@ private:
     bool _verbose = false;
 
     GuiLogger _logger;
+
+    //messages are only fetched from the logger if they have changed
+    std::vector<std::string> _cachedMessages;
+    std::optional<uint64_t> _cachedChangeCounter;
+    bool _cachedVerbose = false;
 };
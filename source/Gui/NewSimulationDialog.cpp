@@ -37,6 +37,14 @@ void _NewSimulationDialog::processIntern()
 {
     AlienImGui::InputInt(AlienImGui::InputIntParameters().name("Width").textWidth(ContentTextInputWidth), _width);
     AlienImGui::InputInt(AlienImGui::InputIntParameters().name("Height").textWidth(ContentTextInputWidth), _height);
+    AlienImGui::Combo(
+        AlienImGui::ComboParameters()
+            .name("Spatial map")
+            .values({"Dense", "Sparse tiled"})
+            .textWidth(ContentTextInputWidth)
+            .tooltip("The sparse tiled map needs memory proportional to the number of occupied regions instead of the world size. It is "
+                     "suited for huge, sparsely populated worlds."),
+        _spatialMapType);
     AlienImGui::Checkbox(
         AlienImGui::CheckboxParameters().name("Adopt simulation parameters").textWidth(0), _adoptSimulationParameters);
 
@@ -64,6 +72,7 @@ void _NewSimulationDialog::openIntern()
     auto worldSize = _simController->getWorldSize();
     _width = worldSize.x;
     _height = worldSize.y;
+    _spatialMapType = _simController->getGeneralSettings().spatialMapType;
 }
 
 void _NewSimulationDialog::onNewSimulation()
@@ -77,6 +86,7 @@ void _NewSimulationDialog::onNewSimulation()
     GeneralSettings generalSettings;
     generalSettings.worldSizeX = _width;
     generalSettings.worldSizeY = _height;
+    generalSettings.spatialMapType = _spatialMapType;
     _simController->newSimulation(0, generalSettings, parameters);
     Viewport::setCenterInWorldPos({toFloat(_width) / 2, toFloat(_height) / 2});
     Viewport::setZoomFactor(4.0f);
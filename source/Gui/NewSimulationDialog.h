@@ -2,6 +2,7 @@
 
 #include "EngineInterface/Definitions.h"
 #include "EngineInterface/Descriptions.h"
+#include "EngineInterface/GeneralSettings.h"
 #include "Definitions.h"
 #include "AlienDialog.h"
 
@@ -28,4 +29,5 @@ private:
     bool _adoptSimulationParameters = true;
     int _width = 0;
     int _height = 0;
+    SpatialMapType _spatialMapType = SpatialMapType_Dense;
 };
\ No newline at end of file
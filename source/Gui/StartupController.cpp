@@ -9,6 +9,7 @@
 #include "EngineInterface/SerializerService.h"
 #include "EngineInterface/SimulationController.h"
 
+#include "AutosaveController.h"
 #include "OpenGLHelper.h"
 #include "Viewport.h"
 #include "StyleRepository.h"
@@ -50,7 +51,7 @@ void _StartupController::process()
 
     if (_state == State::LoadSimulation) {
         DeserializedSimulation deserializedSim;
-        if (!SerializerService::deserializeSimulationFromFiles(deserializedSim, Const::AutosaveFile)) {
+        if (!SerializerService::deserializeSimulationFromFiles(deserializedSim, _AutosaveController::getLatestAutosaveFilename())) {
             MessageDialog::getInstance().information("Error", "The default simulation file could not be read.\nAn empty simulation will be created.");
             deserializedSim.auxiliaryData.generalSettings.worldSizeX = 1000;
             deserializedSim.auxiliaryData.generalSettings.worldSizeY = 500;
@@ -143,6 +143,10 @@ void _StatisticsWindow::processTimelines()
 
 void _StatisticsWindow::processTimelineStatistics()
 {
+    if (_mode == 1) {
+        updateLongtermStatistics();
+    }
+
     ImGui::Spacing();
     AlienImGui::Group("Time step data");
     ImGui::PushID(1);
@@ -389,10 +393,7 @@ void _StatisticsWindow::processPlot(int row, DataPoint DataPointCollection::*val
     ImGui::PopID();
     ImGui::SameLine();
 
-    auto const& statisticsHistory = _simController->getStatisticsHistory();
-
-    std::lock_guard lock(statisticsHistory.getMutex());
-    auto longtermStatistics = &statisticsHistory.getDataRef();
+    auto longtermStatistics = &_longtermStatistics;
 
     //create dummy history if empty
     std::vector dummy = {DataPointCollection()};
@@ -420,6 +421,22 @@ void _StatisticsWindow::processPlot(int row, DataPoint DataPointCollection::*val
     ImGui::Spacing();
 }
 
+void _StatisticsWindow::updateLongtermStatistics()
+{
+    //the data only needs to be resampled if new data points have been added
+    auto snapshot = _simController->getStatisticsHistory().getSnapshot();
+    if (snapshot == _longtermSnapshot) {
+        return;
+    }
+    _longtermSnapshot = snapshot;
+    auto numDataPoints = snapshot->getNumDataPoints();
+    if (numDataPoints == 0) {
+        _longtermStatistics.clear();
+        return;
+    }
+    _longtermStatistics = snapshot->getData(snapshot->getTime(0), snapshot->getTime(numDataPoints - 1), MaxLongtermDataPoints);
+}
+
 void _StatisticsWindow::processBackground()
 {
     auto timestep = _simController->getCurrentTimestep();
@@ -2,6 +2,7 @@
 
 #include "EngineInterface/Definitions.h"
 #include "EngineInterface/RawStatisticsData.h"
+#include "EngineInterface/StatisticsHistory.h"
 
 #include "Definitions.h"
 #include "AlienWindow.h"
@@ -24,6 +25,7 @@ private:
     void processHistograms();
 
     void processPlot(int row, DataPoint DataPointCollection::*valuesPtr, int fracPartDecimals = 0);
+    void updateLongtermStatistics();
 
     void processBackground() override;
 
@@ -56,5 +58,9 @@ private:
     std::unordered_set<int> _collapsedPlotIndices;
 
     TimelineLiveStatistics _liveStatistics;
+
+    static auto constexpr MaxLongtermDataPoints = 1000;
+    StatisticsHistorySnapshot _longtermSnapshot;
+    StatisticsHistoryData _longtermStatistics;
 };
 
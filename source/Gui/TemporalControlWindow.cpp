@@ -5,6 +5,7 @@
 #include "Fonts/IconsFontAwesome5.h"
 
 #include "Base/Definitions.h"
+#include "Base/GlobalSettings.h"
 #include "Base/StringHelper.h"
 #include "EngineInterface/SimulationController.h"
 #include "EngineInterface/SpaceCalculator.h"
@@ -26,7 +27,16 @@ _TemporalControlWindow::_TemporalControlWindow(
     : _AlienWindow("Temporal control", "windows.temporal control", true)
     , _simController(simController)
     , _statisticsWindow(statisticsWindow)
-{}
+{
+    _historyMemoryBudget = GlobalSettings::getInstance().getInt(
+        "windows.temporal control.history memory budget", toInt(SnapshotHistory::DefaultMemoryBudget / (1024 * 1024)));
+    _history.setMemoryBudget(static_cast<uint64_t>(_historyMemoryBudget) * 1024 * 1024);
+}
+
+_TemporalControlWindow::~_TemporalControlWindow()
+{
+    GlobalSettings::getInstance().setInt("windows.temporal control.history memory budget", _historyMemoryBudget);
+}
 
 void _TemporalControlWindow::onSnapshot()
 {
@@ -60,6 +70,7 @@ void _TemporalControlWindow::processIntern()
 
         AlienImGui::Separator();
         processTpsRestriction();
+        processHistoryMemoryBudget();
     }
     ImGui::EndChild();
 }
@@ -126,6 +137,16 @@ void _TemporalControlWindow::processTpsRestriction()
     ImGui::EndDisabled();
 }
 
+void _TemporalControlWindow::processHistoryMemoryBudget()
+{
+    ImGui::Text("Step back memory");
+    ImGui::SameLine(scale(LeftColumnWidth) - (ImGui::GetWindowWidth() - ImGui::GetContentRegionAvail().x));
+    auto format = StringHelper::format(toFloat(_history.getMemoryUsage()) / (1024 * 1024), 1) + " / %d MB";
+    if (AlienImGui::SliderInt(AlienImGui::SliderIntParameters().textWidth(0).min(16).max(8192).logarithmic(true).format(format), &_historyMemoryBudget)) {
+        _history.setMemoryBudget(static_cast<uint64_t>(_historyMemoryBudget) * 1024 * 1024);
+    }
+}
+
 void _TemporalControlWindow::processRunButton()
 {
     ImGui::BeginDisabled(_simController->isSimulationRunning());
@@ -153,15 +174,16 @@ void _TemporalControlWindow::processPauseButton()
 
 void _TemporalControlWindow::processStepBackwardButton()
 {
-    ImGui::BeginDisabled(_history.empty() || _simController->isSimulationRunning());
+    ImGui::BeginDisabled(_history.isEmpty() || _simController->isSimulationRunning());
     auto result = AlienImGui::ToolbarButton(ICON_FA_CHEVRON_LEFT);
     AlienImGui::Tooltip("Load previous time step");
     if (result) {
-        auto const& snapshot = _history.back();
-        delayedExecution([this, snapshot] { applySnapshot(snapshot); });
+        delayedExecution([this] {
+            if (auto snapshot = _history.pop()) {
+                applySnapshot(*snapshot);
+            }
+        });
         printOverlayMessage("Loading previous time step ...");
-
-        _history.pop_back();
     }
     ImGui::EndDisabled();
 }
@@ -172,7 +194,7 @@ void _TemporalControlWindow::processStepForwardButton()
     auto result = AlienImGui::ToolbarButton(ICON_FA_CHEVRON_RIGHT);
     AlienImGui::Tooltip("Process single time step");
     if (result) {
-        _history.emplace_back(createSnapshot());
+        _history.push(createSnapshot());
         _simController->calcTimesteps(1);
     }
     ImGui::EndDisabled();
@@ -5,6 +5,7 @@
 #include "EngineInterface/Definitions.h"
 #include "EngineInterface/Descriptions.h"
 #include "EngineInterface/SimulationParameters.h"
+#include "EngineInterface/SnapshotHistory.h"
 
 #include "Definitions.h"
 #include "AlienWindow.h"
@@ -13,17 +14,12 @@ class _TemporalControlWindow : public _AlienWindow
 {
 public:
     _TemporalControlWindow(SimulationController const& simController, StatisticsWindow const& statisticsWindow);
+    ~_TemporalControlWindow();
 
     void onSnapshot();
 
 private:
-    struct Snapshot
-    {
-        uint64_t timestep;
-        std::chrono::milliseconds realTime;
-        SimulationParameters parameters;
-        DataDescription data;
-    };
+    using Snapshot = HistorySnapshot;
 
     void processIntern();
 
@@ -31,6 +27,7 @@ private:
     void processTotalTimestepsInfo();
     void processRealTimeInfo();
     void processTpsRestriction();
+    void processHistoryMemoryBudget();
 
     void processRunButton();
     void processPauseButton();
@@ -50,7 +47,8 @@ private:
 
     std::optional<Snapshot> _snapshot;
 
-    std::vector<Snapshot> _history;
+    SnapshotHistory _history;
+    int _historyMemoryBudget = 0;  //in MB
 
     bool _slowDown = false;
     int _tpsRestriction = 30;
@@ -0,0 +1,538 @@
+#include "NetworkResourceIndex.h"
+
+#include <algorithm>
+#include <cctype>
+#include <numeric>
+#include <string_view>
+
+#include <imgui.h>
+
+#include "NetworkResourceRawTO.h"
+#include "NetworkResourceService.h"
+
+namespace
+{
+    int getNumEqualFolders(std::vector<std::string> const& folderNames, std::vector<std::string> const& otherFolderNames)
+    {
+        auto equalFolders = 0;
+        auto numFolders = std::min(folderNames.size(), otherFolderNames.size());
+        for (int i = 0; i < numFolders; ++i) {
+            if (folderNames[i] == otherFolderNames[i]) {
+                ++equalFolders;
+            } else {
+                return equalFolders;
+            }
+        }
+        return equalFolders;
+    }
+
+    //returns true iff folderNames contains otherFolderNames
+    bool contains(std::vector<std::string> const& folderNames, std::vector<std::string> const& otherFolderNames)
+    {
+        if (folderNames.size() < otherFolderNames.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < otherFolderNames.size(); ++i) {
+            if (folderNames.at(i) != otherFolderNames.at(i)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void appendLowerCase(std::string& result, std::string const& text)
+    {
+        for (auto c : text) {
+            result.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+        }
+    }
+
+    uint32_t getTrigram(std::string const& text, size_t pos)
+    {
+        return (static_cast<uint32_t>(static_cast<unsigned char>(text[pos])) << 16) | (static_cast<uint32_t>(static_cast<unsigned char>(text[pos + 1])) << 8)
+            | static_cast<uint32_t>(static_cast<unsigned char>(text[pos + 2]));
+    }
+
+    //folders and leafs are kept in the order of their first occurrence
+    struct TreeNode
+    {
+        int entryIndex = -1;  //-1 for folders
+        std::string_view folderName;
+        std::vector<int> childNodeIndices;
+        std::unordered_map<std::string_view, int> folderNodeIndexByName;
+    };
+
+    void calcTreeSymbols(std::vector<NetworkResourceTreeTO>& treeTOs)
+    {
+        for (int i = 0; i < treeTOs.size(); ++i) {
+            auto& treeTO = treeTOs.at(i);
+
+            if (i == 0) {
+                if (!treeTO->isLeaf()) {
+                    treeTO->treeSymbols.emplace_back(FolderTreeSymbols::Expanded);
+                }
+            } else {
+                auto const& prevTreeTO = treeTOs.at(i - 1);
+                auto numEqualFolders = getNumEqualFolders(treeTO->folderNames, prevTreeTO->folderNames);
+
+                treeTO->treeSymbols.resize(treeTO->folderNames.size(), FolderTreeSymbols::None);
+
+                //calc symbols at position numEqualFolders - 1
+                if (numEqualFolders > 0) {
+                    int f = numEqualFolders - 1;
+                    if (prevTreeTO->treeSymbols.at(f) == FolderTreeSymbols::Expanded) {
+                        treeTO->treeSymbols.at(f) = FolderTreeSymbols::End;
+                    } else if (prevTreeTO->treeSymbols.at(f) == FolderTreeSymbols::End) {
+                        prevTreeTO->treeSymbols.at(f) = FolderTreeSymbols::Branch;
+                        treeTO->treeSymbols.at(f) = FolderTreeSymbols::End;
+                    } else if (prevTreeTO->treeSymbols.at(f) == FolderTreeSymbols::Branch) {
+                        treeTO->treeSymbols.at(f) = FolderTreeSymbols::End;
+                    } else if (prevTreeTO->treeSymbols.at(f) == FolderTreeSymbols::None) {
+                        for (int j = i - 1; j >= 0; --j) {
+                            auto& otherTreeTO = treeTOs.at(j);
+                            if (otherTreeTO->treeSymbols.at(f) == FolderTreeSymbols::None) {
+                                otherTreeTO->treeSymbols.at(f) = FolderTreeSymbols::Continue;
+                            } else if (otherTreeTO->treeSymbols.at(f) == FolderTreeSymbols::End) {
+                                otherTreeTO->treeSymbols.at(f) = FolderTreeSymbols::Branch;
+                            } else {
+                                break;
+                            }
+                        }
+                    }
+                }
+
+                //calc symbols before position numEqualFolders - 1
+                for (int f = 0; f < numEqualFolders - 1; ++f) {
+                    if (prevTreeTO->treeSymbols.at(f) == FolderTreeSymbols::Branch) {
+                        treeTO->treeSymbols.at(f) = FolderTreeSymbols::None;
+                    }
+                }
+
+                if (numEqualFolders < treeTO->folderNames.size()) {
+                    CHECK(numEqualFolders + 1 == treeTO->folderNames.size());
+                    treeTO->treeSymbols.back() = FolderTreeSymbols::Expanded;
+
+                    if (numEqualFolders > 0 && numEqualFolders < prevTreeTO->folderNames.size()) {
+                        treeTO->treeSymbols.at(numEqualFolders - 1) = FolderTreeSymbols::End;
+                        bool noneFound = false;
+                        for (int j = i - 1; j >= 0; --j) {
+                            auto& otherTreeTO = treeTOs.at(j);
+                            if (otherTreeTO->treeSymbols.at(numEqualFolders - 1) == FolderTreeSymbols::None) {
+                                otherTreeTO->treeSymbols.at(numEqualFolders - 1) = FolderTreeSymbols::Continue;
+                                noneFound = true;
+                            } else if (noneFound && otherTreeTO->treeSymbols.at(numEqualFolders - 1) == FolderTreeSymbols::End) {
+                                otherTreeTO->treeSymbols.at(numEqualFolders - 1) = FolderTreeSymbols::Branch;
+                            } else {
+                                break;
+                            }
+                        }
+                    }
+                }
+                if (numEqualFolders > 0 && numEqualFolders < prevTreeTO->folderNames.size() && numEqualFolders == treeTO->folderNames.size()) {
+                    treeTO->treeSymbols.back() = FolderTreeSymbols::End;
+                }
+            }
+        }
+    }
+}
+
+void NetworkResourceIndex::setRawTOs(std::vector<NetworkResourceRawTO> const& rawTOs)
+{
+    if (_rawTOs == rawTOs) {
+        return;
+    }
+    _rawTOs = rawTOs;
+
+    _entries.clear();
+    _entries.reserve(rawTOs.size());
+    for (auto const& rawTO : rawTOs) {
+        Entry entry;
+        entry.rawTO = rawTO;
+        entry.folderNames = NetworkResourceService::getNameParts(rawTO->resourceName);
+        entry.leafName = entry.folderNames.back();
+        entry.folderNames.pop_back();
+        _entries.emplace_back(std::move(entry));
+    }
+    updateSearchTexts();
+    invalidateSearchResults();
+    _matchingRawTOsByFolder.clear();
+}
+
+void NetworkResourceIndex::setSortSpecs(std::vector<ImGuiTableColumnSortSpecs> const& sortSpecs)
+{
+    std::vector<SortKey> sortKeys;
+    for (auto const& sortSpec : sortSpecs) {
+        sortKeys.emplace_back(SortKey{.columnId = sortSpec.ColumnUserID, .ascending = sortSpec.SortDirection == ImGuiSortDirection_Ascending});
+    }
+    if (_sortKeys == sortKeys) {
+        return;
+    }
+    _sortKeys = sortKeys;
+    _sortOrderValid = false;
+    _matchingRawTOsByFolder.clear();
+}
+
+void NetworkResourceIndex::setFilter(std::string const& filter)
+{
+    std::string lowerCaseFilter;
+    appendLowerCase(lowerCaseFilter, filter);
+    if (_filter == lowerCaseFilter) {
+        return;
+    }
+    _filter = lowerCaseFilter;
+    _matchesValid = false;
+}
+
+void NetworkResourceIndex::setCollapsedFolderNames(std::set<std::vector<std::string>> const& collapsedFolderNames)
+{
+    if (_collapsedFolderNames == collapsedFolderNames) {
+        return;
+    }
+    _collapsedFolderNames = collapsedFolderNames;
+    _treeTOsValid = false;
+}
+
+void NetworkResourceIndex::invalidateValues()
+{
+    updateSearchTexts();
+    invalidateSearchResults();
+}
+
+std::vector<NetworkResourceTreeTO> const& NetworkResourceIndex::getTreeTOs()
+{
+    if (!_sortOrderValid) {
+        updateSortOrder();
+        _treeValid = false;
+    }
+    if (!_matchesValid && updateMatches()) {
+        _treeValid = false;
+    }
+    if (!_treeValid) {
+        updateTree();
+        _treeTOsValid = false;
+    }
+    if (!_treeTOsValid) {
+        updateVisibleTreeTOs();
+    }
+    return _treeTOs;
+}
+
+std::vector<NetworkResourceRawTO> NetworkResourceIndex::getMatchingRawTOs(NetworkResourceTreeTO const& treeTO) const
+{
+    if (treeTO->isLeaf()) {
+        return {treeTO->getLeaf().rawTO};
+    }
+    auto folderString = NetworkResourceService::concatenateFolderName(treeTO->folderNames, false);
+    auto findResult = _matchingRawTOsByFolder.find(folderString);
+    if (findResult != _matchingRawTOsByFolder.end()) {
+        return findResult->second;
+    }
+
+    std::vector<NetworkResourceRawTO> result;
+    auto addIfMatching = [&](Entry const& entry) {
+        if (contains(entry.folderNames, treeTO->folderNames)) {
+            result.emplace_back(entry.rawTO);
+        }
+    };
+    if (_sortOrderValid) {
+        for (auto const& entryIndex : _sortedEntryIndices) {
+            addIfMatching(_entries.at(entryIndex));
+        }
+    } else {
+        for (auto const& entry : _entries) {
+            addIfMatching(entry);
+        }
+    }
+    _matchingRawTOsByFolder.emplace(folderString, result);
+    return result;
+}
+
+std::set<std::vector<std::string>> NetworkResourceIndex::getFolderNames(int minNesting) const
+{
+    std::set<std::vector<std::string>> result;
+    for (auto const& entry : _entries) {
+        for (int i = minNesting; i <= toInt(entry.folderNames.size()); ++i) {
+            result.insert(std::vector(entry.folderNames.begin(), entry.folderNames.begin() + i));
+        }
+    }
+    return result;
+}
+
+void NetworkResourceIndex::updateSearchTexts()
+{
+    for (auto& entry : _entries) {
+        auto const& rawTO = entry.rawTO;
+        entry.searchText.clear();
+        for (auto const& value : {
+                 rawTO->timestamp,
+                 rawTO->userName,
+                 rawTO->resourceName,
+                 std::to_string(rawTO->numDownloads),
+                 std::to_string(rawTO->width),
+                 std::to_string(rawTO->height),
+                 std::to_string(rawTO->particles),
+                 std::to_string(rawTO->contentSize),
+                 rawTO->description,
+                 rawTO->version}) {
+            appendLowerCase(entry.searchText, value);
+            entry.searchText.push_back('\0');
+        }
+    }
+}
+
+void NetworkResourceIndex::invalidateSearchResults()
+{
+    _columnOrderById.clear();
+    _sortOrderValid = false;
+    _trigramIndexValid = false;
+    _matchesFilter.reset();
+    _matchesValid = false;
+    _treeValid = false;
+}
+
+auto NetworkResourceIndex::getColumnOrder(unsigned int columnId) -> ColumnOrder const&
+{
+    auto findResult = _columnOrderById.find(columnId);
+    if (findResult != _columnOrderById.end()) {
+        return findResult->second;
+    }
+
+    ImGuiTableColumnSortSpecs sortSpec;
+    sortSpec.ColumnUserID = columnId;
+    sortSpec.SortDirection = ImGuiSortDirection_Ascending;
+    std::vector const sortSpecs{sortSpec};
+    auto compare = [&](int left, int right) { return _NetworkResourceRawTO::compare(_entries.at(left).rawTO, _entries.at(right).rawTO, sortSpecs); };
+
+    ColumnOrder result;
+    result.ascendingEntryIndices.resize(_entries.size());
+    std::iota(result.ascendingEntryIndices.begin(), result.ascendingEntryIndices.end(), 0);
+    std::stable_sort(
+        result.ascendingEntryIndices.begin(), result.ascendingEntryIndices.end(), [&](int left, int right) { return compare(left, right) < 0; });
+
+    result.rankByEntryIndex.resize(_entries.size());
+    auto rank = 0;
+    for (size_t i = 0; i < result.ascendingEntryIndices.size(); ++i) {
+        if (i > 0 && compare(result.ascendingEntryIndices.at(i - 1), result.ascendingEntryIndices.at(i)) != 0) {
+            ++rank;
+        }
+        result.rankByEntryIndex.at(result.ascendingEntryIndices.at(i)) = rank;
+    }
+    return _columnOrderById.emplace(columnId, std::move(result)).first->second;
+}
+
+void NetworkResourceIndex::updateSortOrder()
+{
+    _sortOrderValid = true;
+
+    if (_sortKeys.size() == 1) {
+        auto const& columnOrder = getColumnOrder(_sortKeys.front().columnId);
+        auto const& ascendingEntryIndices = columnOrder.ascendingEntryIndices;
+        if (_sortKeys.front().ascending) {
+            _sortedEntryIndices = ascendingEntryIndices;
+            return;
+        }
+
+        //reverse the groups of equal values but not the order within a group
+        _sortedEntryIndices.clear();
+        _sortedEntryIndices.reserve(ascendingEntryIndices.size());
+        auto getRank = [&](size_t i) { return columnOrder.rankByEntryIndex.at(ascendingEntryIndices.at(i)); };
+        for (auto groupEnd = ascendingEntryIndices.size(); groupEnd > 0;) {
+            auto groupStart = groupEnd - 1;
+            while (groupStart > 0 && getRank(groupStart - 1) == getRank(groupEnd - 1)) {
+                --groupStart;
+            }
+            _sortedEntryIndices.insert(_sortedEntryIndices.end(), ascendingEntryIndices.begin() + groupStart, ascendingEntryIndices.begin() + groupEnd);
+            groupEnd = groupStart;
+        }
+        return;
+    }
+
+    _sortedEntryIndices.resize(_entries.size());
+    std::iota(_sortedEntryIndices.begin(), _sortedEntryIndices.end(), 0);
+    if (_sortKeys.empty()) {
+        return;
+    }
+    std::vector<std::vector<int> const*> ranksBySortKey;
+    for (auto const& sortKey : _sortKeys) {
+        ranksBySortKey.emplace_back(&getColumnOrder(sortKey.columnId).rankByEntryIndex);
+    }
+    std::stable_sort(_sortedEntryIndices.begin(), _sortedEntryIndices.end(), [&](int left, int right) {
+        for (size_t i = 0; i < _sortKeys.size(); ++i) {
+            auto leftRank = (*ranksBySortKey[i])[left];
+            auto rightRank = (*ranksBySortKey[i])[right];
+            if (leftRank != rightRank) {
+                return _sortKeys[i].ascending ? leftRank < rightRank : leftRank > rightRank;
+            }
+        }
+        return false;
+    });
+}
+
+void NetworkResourceIndex::updateTrigramIndex()
+{
+    _trigramIndexValid = true;
+    _entryIndicesByTrigram.clear();
+    for (int entryIndex = 0; entryIndex < toInt(_entries.size()); ++entryIndex) {
+        auto const& searchText = _entries.at(entryIndex).searchText;
+        for (size_t pos = 0; pos + 2 < searchText.size(); ++pos) {
+            auto& entryIndices = _entryIndicesByTrigram[getTrigram(searchText, pos)];
+            if (entryIndices.empty() || entryIndices.back() != entryIndex) {
+                entryIndices.emplace_back(entryIndex);
+            }
+        }
+    }
+}
+
+bool NetworkResourceIndex::updateMatches()
+{
+    _matchesValid = true;
+
+    std::vector<int> result;
+    if (_filter.empty()) {
+        result.resize(_entries.size());
+        std::iota(result.begin(), result.end(), 0);
+    } else {
+
+        //candidates: previous matches if the filter has been extended and/or the entries containing the rarest trigram of the filter
+        std::vector<int> const* candidates = nullptr;
+        if (_matchesFilter.has_value() && _filter.find(*_matchesFilter) != std::string::npos) {
+            candidates = &_matchingEntryIndices;
+        }
+        if (_filter.size() >= 3) {
+            if (!_trigramIndexValid) {
+                updateTrigramIndex();
+            }
+            static std::vector<int> const NoEntryIndices;
+            for (size_t pos = 0; pos + 2 < _filter.size(); ++pos) {
+                auto findResult = _entryIndicesByTrigram.find(getTrigram(_filter, pos));
+                if (findResult == _entryIndicesByTrigram.end()) {
+                    candidates = &NoEntryIndices;
+                    break;
+                }
+                if (!candidates || findResult->second.size() < candidates->size()) {
+                    candidates = &findResult->second;
+                }
+            }
+        }
+
+        auto isMatching = [&](int entryIndex) { return _entries.at(entryIndex).searchText.find(_filter) != std::string::npos; };
+        if (candidates) {
+            for (auto const& entryIndex : *candidates) {
+                if (isMatching(entryIndex)) {
+                    result.emplace_back(entryIndex);
+                }
+            }
+        } else {
+            for (int entryIndex = 0; entryIndex < toInt(_entries.size()); ++entryIndex) {
+                if (isMatching(entryIndex)) {
+                    result.emplace_back(entryIndex);
+                }
+            }
+        }
+    }
+
+    auto changed = !_matchesFilter.has_value() || result != _matchingEntryIndices;
+    _matchingEntryIndices = std::move(result);
+    _matchesFilter = _filter;
+    _isMatchingByEntryIndex.assign(_entries.size(), false);
+    for (auto const& entryIndex : _matchingEntryIndices) {
+        _isMatchingByEntryIndex[entryIndex] = true;
+    }
+    return changed;
+}
+
+void NetworkResourceIndex::updateTree()
+{
+    _treeValid = true;
+
+    //insert matching entries in sorted order into folder hierarchy
+    std::vector<TreeNode> nodes(1);
+    for (auto const& entryIndex : _sortedEntryIndices) {
+        if (!_isMatchingByEntryIndex[entryIndex]) {
+            continue;
+        }
+        auto nodeIndex = 0;
+        for (auto const& folderName : _entries.at(entryIndex).folderNames) {
+            auto newNodeIndex = toInt(nodes.size());
+            auto childNodeIndex = nodes[nodeIndex].folderNodeIndexByName.try_emplace(folderName, newNodeIndex).first->second;
+            if (childNodeIndex == newNodeIndex) {
+                nodes[nodeIndex].childNodeIndices.emplace_back(newNodeIndex);
+                nodes.emplace_back();
+                nodes.back().folderName = folderName;
+            }
+            nodeIndex = childNodeIndex;
+        }
+        nodes[nodeIndex].childNodeIndices.emplace_back(toInt(nodes.size()));
+        nodes.emplace_back();
+        nodes.back().entryIndex = entryIndex;
+    }
+
+    //create treeTOs in depth-first order
+    _allTreeTOs.clear();
+    _subtreeEnds.clear();
+    std::vector<std::string> folderNames;
+    auto addTreeTOs = [&](auto& self, int nodeIndex, BrowserFolder* parentFolder) -> void {
+        auto const& node = nodes[nodeIndex];
+        auto treeTOIndex = _allTreeTOs.size();
+        auto treeTO = std::make_shared<_NetworkResourceTreeTO>();
+        _allTreeTOs.emplace_back(treeTO);
+        _subtreeEnds.emplace_back();
+
+        if (node.entryIndex != -1) {
+            auto const& entry = _entries.at(node.entryIndex);
+            treeTO->type = entry.rawTO->resourceType;
+            treeTO->folderNames = entry.folderNames;
+            treeTO->node = BrowserLeaf{.leafName = entry.leafName, .rawTO = entry.rawTO};
+            if (parentFolder) {
+                ++parentFolder->numLeafs;
+                parentFolder->numReactions += entry.rawTO->getTotalLikes();
+            }
+        } else {
+            folderNames.emplace_back(node.folderName);
+            treeTO->folderNames = folderNames;
+            treeTO->node = BrowserFolder();
+            auto& folder = treeTO->getFolder();
+            for (auto const& childNodeIndex : node.childNodeIndices) {
+                self(self, childNodeIndex, &folder);
+            }
+            folderNames.pop_back();
+
+            treeTO->type = _allTreeTOs.at(treeTOIndex + 1)->type;
+            if (parentFolder) {
+                parentFolder->numLeafs += folder.numLeafs;
+                parentFolder->numReactions += folder.numReactions;
+            }
+        }
+        _subtreeEnds.at(treeTOIndex) = toInt(_allTreeTOs.size());
+    };
+    for (auto const& childNodeIndex : nodes.front().childNodeIndices) {
+        addTreeTOs(addTreeTOs, childNodeIndex, nullptr);
+    }
+
+    calcTreeSymbols(_allTreeTOs);
+    _expandedSymbols.clear();
+    for (auto const& treeTO : _allTreeTOs) {
+        _expandedSymbols.emplace_back(treeTO->treeSymbols.empty() ? FolderTreeSymbols::None : treeTO->treeSymbols.back());
+    }
+}
+
+void NetworkResourceIndex::updateVisibleTreeTOs()
+{
+    _treeTOsValid = true;
+
+    //items of collapsed folders are skipped
+    _treeTOs.clear();
+    for (int i = 0; i < toInt(_allTreeTOs.size());) {
+        auto const& treeTO = _allTreeTOs.at(i);
+        _treeTOs.emplace_back(treeTO);
+        if (!treeTO->isLeaf() && _collapsedFolderNames.contains(treeTO->folderNames)) {
+            treeTO->treeSymbols.back() = FolderTreeSymbols::Collapsed;
+            i = _subtreeEnds.at(i);
+        } else {
+            if (!treeTO->isLeaf()) {
+                treeTO->treeSymbols.back() = _expandedSymbols.at(i);
+            }
+            ++i;
+        }
+    }
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Definitions.h"
+#include "NetworkResourceTreeTO.h"
+
+/**
+ * Provides the browser tree of a workspace for changing sort specs, filters and collapsed folders.
+ * Derived data (split resource names, search texts, sort orders, the uncollapsed tree) is kept between calls and only
+ * the stages affected by a changed input are recomputed in getTreeTOs:
+ * - sorting uses a cached permutation per column (multiple sort specs are resolved by per-column ranks)
+ * - filtering uses a trigram index and only checks the previous matches if the filter has been extended
+ * - collapsing and expanding folders only selects the visible items of the uncollapsed tree
+ */
+class NetworkResourceIndex
+{
+public:
+    void setRawTOs(std::vector<NetworkResourceRawTO> const& rawTOs);
+    void setSortSpecs(std::vector<ImGuiTableColumnSortSpecs> const& sortSpecs);
+    void setFilter(std::string const& filter);
+    void setCollapsedFolderNames(std::set<std::vector<std::string>> const& collapsedFolderNames);
+
+    //to be called after sortable or searchable values of the rawTOs have been changed (e.g. number of downloads)
+    void invalidateValues();
+
+    std::vector<NetworkResourceTreeTO> const& getTreeTOs();  //filtered, sorted, without items in collapsed folders
+
+    std::vector<NetworkResourceRawTO> getMatchingRawTOs(NetworkResourceTreeTO const& treeTO) const;  //unfiltered
+    std::set<std::vector<std::string>> getFolderNames(int minNesting = 2) const;
+
+private:
+    struct Entry
+    {
+        NetworkResourceRawTO rawTO;
+        std::vector<std::string> folderNames;
+        std::string leafName;
+        std::string searchText;  //lower case values which can be filtered, separated by '\0'
+    };
+    struct SortKey
+    {
+        unsigned int columnId;
+        bool ascending;
+        bool operator==(SortKey const&) const = default;
+    };
+    struct ColumnOrder
+    {
+        std::vector<int> ascendingEntryIndices;
+        std::vector<int> rankByEntryIndex;  //equal values have equal ranks
+    };
+
+    void updateSearchTexts();
+    void invalidateSearchResults();
+
+    ColumnOrder const& getColumnOrder(unsigned int columnId);
+    void updateSortOrder();
+
+    void updateTrigramIndex();
+    bool updateMatches();  //returns true if the matching entries have been changed
+
+    void updateTree();
+    void updateVisibleTreeTOs();
+
+    std::vector<NetworkResourceRawTO> _rawTOs;
+    std::vector<Entry> _entries;
+
+    std::vector<SortKey> _sortKeys;
+    std::unordered_map<unsigned int, ColumnOrder> _columnOrderById;
+    std::vector<int> _sortedEntryIndices;
+    bool _sortOrderValid = false;
+
+    std::string _filter;  //lower case
+    std::unordered_map<uint32_t, std::vector<int>> _entryIndicesByTrigram;
+    bool _trigramIndexValid = false;
+    std::optional<std::string> _matchesFilter;  //filter for which _matchingEntryIndices have been calculated
+    std::vector<int> _matchingEntryIndices;     //ascending
+    std::vector<bool> _isMatchingByEntryIndex;
+    bool _matchesValid = false;
+
+    std::vector<NetworkResourceTreeTO> _allTreeTOs;  //uncollapsed
+    std::vector<FolderTreeSymbols> _expandedSymbols;  //last tree symbol of each item in _allTreeTOs when not collapsed
+    std::vector<int> _subtreeEnds;                    //index in _allTreeTOs after the last descendant of each item
+    bool _treeValid = false;
+
+    std::set<std::vector<std::string>> _collapsedFolderNames;
+    std::vector<NetworkResourceTreeTO> _treeTOs;
+    bool _treeTOsValid = false;
+
+    mutable std::unordered_map<std::string, std::vector<NetworkResourceRawTO>> _matchingRawTOsByFolder;
+};
@@ -1,5 +1,6 @@
 #include "NetworkService.h"
 
+#include <array>
 #include <ranges>
 #include <boost/property_tree/json_parser.hpp>
 
@@ -18,14 +19,24 @@ namespace
 {
     auto constexpr RefreshInterval = 20;  //in minutes
     auto constexpr MaxChunkSize = 24 * 1024 * 1024;
+    auto constexpr DefaultDownloadCacheSize = 2048;  //in MB
 
-    void configureClient(httplib::SSLClient& client)
+    //server addresses without scheme are accessed via HTTPS, a scheme allows e.g. to use a local plain HTTP server for tests
+    httplib::Client createClient(std::string const& serverAddress)
     {
-        client.set_ca_cert_path("./resources/ca-bundle.crt");
-        client.enable_server_certificate_verification(true);
-        if (auto result = client.get_openssl_verify_result()) {
-            throw std::runtime_error("OpenSSL verify error: " + std::string(X509_verify_cert_error_string(result)));
+        auto url = serverAddress.find("://") != std::string::npos ? serverAddress : "https://" + serverAddress;
+        httplib::Client result(url);
+        if (!result.is_valid()) {
+            throw std::runtime_error("Invalid server address.");
         }
+        if (url.starts_with("https://")) {
+            result.set_ca_cert_path("./resources/ca-bundle.crt");
+            result.enable_server_certificate_verification(true);
+            if (auto verifyResult = result.get_openssl_verify_result()) {
+                throw std::runtime_error("OpenSSL verify error: " + std::string(X509_verify_cert_error_string(verifyResult)));
+            }
+        }
+        return result;
     }
 
     httplib::Result executeRequest(std::function<httplib::Result()> const& func, bool withRetry = true)
@@ -71,16 +82,21 @@ std::string NetworkService::_serverAddress;
 std::optional<std::string> NetworkService::_loggedInUserName;
 std::optional<std::string> NetworkService::_password;
 std::optional<std::chrono::steady_clock::time_point> NetworkService::_lastRefreshTime;
-Cache<std::string, NetworkService::ResourceData, 20> NetworkService::_downloadCache;
+std::string NetworkService::_downloadCacheDirectory;
+DiskCache NetworkService::_downloadCache;
 
 void NetworkService::init()
 {
     _serverAddress = GlobalSettings::getInstance().getString("settings.server", "alien-project.org");
+    auto downloadCacheSize = GlobalSettings::getInstance().getInt("settings.download cache.size", DefaultDownloadCacheSize);
+    _downloadCacheDirectory = Const::DownloadCacheDirectory;
+    _downloadCache = std::make_shared<_DiskCache>(_downloadCacheDirectory, uint64_t(std::max(0, downloadCacheSize)) * 1024 * 1024);
 }
 
 void NetworkService::shutdown()
 {
     GlobalSettings::getInstance().setString("settings.server", _serverAddress);
+    GlobalSettings::getInstance().setInt("settings.download cache.size", toInt(_downloadCache->getMaxBytes() / 1024 / 1024));
     logout();
 }
 
@@ -95,6 +111,18 @@ void NetworkService::setServerAddress(std::string const& value)
     logout();
 }
 
+std::string NetworkService::getDownloadCacheDirectory()
+{
+    return _downloadCacheDirectory;
+}
+
+void NetworkService::setDownloadCacheDirectory(std::string const& value)
+{
+    auto maxBytes = _downloadCache ? _downloadCache->getMaxBytes() : uint64_t(DefaultDownloadCacheSize) * 1024 * 1024;
+    _downloadCacheDirectory = value;
+    _downloadCache = !value.empty() ? std::make_shared<_DiskCache>(_downloadCacheDirectory, maxBytes) : nullptr;
+}
+
 std::optional<std::string> NetworkService::getLoggedInUserName()
 {
     return _loggedInUserName;
@@ -109,8 +137,7 @@ bool NetworkService::createUser(std::string const& userName, std::string const&
 {
     log(Priority::Important, "network: create user '" + userName + "'");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    auto client = createClient(_serverAddress);
 
     httplib::Params params;
     params.emplace("userName", userName);
@@ -130,8 +157,7 @@ bool NetworkService::activateUser(std::string const& userName, std::string const
 {
     log(Priority::Important, "network: activate user '" + userName + "'");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    auto client = createClient(_serverAddress);
 
     httplib::Params params;
     params.emplace("userName", userName);
@@ -154,8 +180,7 @@ bool NetworkService::login(LoginErrorCode& errorCode, std::string const& userNam
 {
     log(Priority::Important, "network: login user '" + userName + "'");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    auto client = createClient(_serverAddress);
 
     httplib::Params params;
     params.emplace("userName", userName);
@@ -192,8 +217,7 @@ bool NetworkService::logout()
     bool result = true;
 
     if (_loggedInUserName && _password) {
-        httplib::SSLClient client(_serverAddress);
-        configureClient(client);
+        auto client = createClient(_serverAddress);
 
         httplib::Params params;
         params.emplace("userName", *_loggedInUserName);
@@ -217,8 +241,7 @@ void NetworkService::refreshLogin()
     if (_loggedInUserName && _password) {
         log(Priority::Important, "network: refresh login");
 
-        httplib::SSLClient client(_serverAddress);
-        configureClient(client);
+        auto client = createClient(_serverAddress);
 
         httplib::Params params;
         params.emplace("userName", *_loggedInUserName);
@@ -235,8 +258,7 @@ bool NetworkService::deleteUser()
 {
     log(Priority::Important, "network: delete user '" + *_loggedInUserName + "'");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    auto client = createClient(_serverAddress);
 
     httplib::Params params;
     params.emplace("userName", *_loggedInUserName);
@@ -260,8 +282,7 @@ bool NetworkService::resetPassword(std::string const& userName, std::string cons
 {
     log(Priority::Important, "network: reset password of user '" + userName + "'");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    auto client = createClient(_serverAddress);
 
     httplib::Params params;
     params.emplace("userName", userName);
@@ -280,8 +301,7 @@ bool NetworkService::setNewPassword(std::string const& userName, std::string con
 {
     log(Priority::Important, "network: set new password for user '" + userName + "'");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    auto client = createClient(_serverAddress);
 
     httplib::Params params;
     params.emplace("userName", userName);
@@ -301,8 +321,7 @@ bool NetworkService::getNetworkResources(std::vector<NetworkResourceRawTO>& resu
 {
     log(Priority::Important, "network: get resource list");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    auto client = createClient(_serverAddress);
 
     httplib::Params params;
     params.emplace("version", Const::ProgramVersion);
@@ -329,8 +348,7 @@ bool NetworkService::getUserList(std::vector<UserTO>& result, bool withRetry)
 {
     log(Priority::Important, "network: get user list");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    auto client = createClient(_serverAddress);
 
     try {
         httplib::Params params;
@@ -355,8 +373,7 @@ bool NetworkService::getEmojiTypeByResourceId(std::unordered_map<std::string, in
 {
     log(Priority::Important, "network: get liked resources");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    auto client = createClient(_serverAddress);
 
     httplib::Params params;
     params.emplace("userName", *_loggedInUserName);
@@ -384,8 +401,7 @@ bool NetworkService::getUserNamesForResourceAndEmojiType(std::set<std::string>&
 {
     log(Priority::Important, "network: get user reactions for resource with id=" + simId + " and reaction type=" + std::to_string(likeType));
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    auto client = createClient(_serverAddress);
 
     httplib::Params params;
     params.emplace("simId", simId);
@@ -413,8 +429,7 @@ bool NetworkService::toggleReactToResource(std::string const& simId, int likeTyp
 {
     log(Priority::Important, "network: toggle like for resource with id=" + simId);
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    auto client = createClient(_serverAddress);
 
     httplib::Params params;
     params.emplace("userName", *_loggedInUserName);
@@ -453,8 +468,7 @@ bool NetworkService::uploadResource(
         chunks.emplace_back(chunk);
     }
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    auto client = createClient(_serverAddress);
 
     httplib::MultipartFormDataItems items = {
         {"userName", *_loggedInUserName, "", ""},
@@ -493,7 +507,9 @@ bool NetworkService::uploadResource(
         }
         ++index;
     }
-    _downloadCache.insertOrAssign(resourceId, ResourceData{mainData, settings, statistics});
+    if (_downloadCache) {
+        _downloadCache->insertOrAssign(resourceId, std::nullopt, {mainData, settings, statistics});
+    }
 
     return true;
 }
@@ -514,8 +530,7 @@ bool NetworkService::replaceResource(
         chunks.emplace_back(chunk);
     }
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    auto client = createClient(_serverAddress);
 
     httplib::MultipartFormDataItems items = {
         {"userName", *_loggedInUserName, "", ""},
@@ -549,26 +564,31 @@ bool NetworkService::replaceResource(
         }
         ++index;
     }
-    _downloadCache.insertOrAssign(resourceId, ResourceData{mainData, settings, statistics});
+    if (_downloadCache) {
+        _downloadCache->insertOrAssign(resourceId, std::nullopt, {mainData, settings, statistics});
+    }
 
     return true;
 }
 
-bool NetworkService::downloadResource(std::string& mainData, std::string& auxiliaryData, std::string& statistics, std::string const& simId)
+bool NetworkService::downloadResource(ResourceData& result, std::string const& simId, std::string const& timestamp)
 {
     try {
-        if (auto cachedEntry = _downloadCache.find(simId)) {
+        if (auto cachedEntry = _downloadCache ? _downloadCache->find(simId, timestamp) : std::optional<DiskCacheEntry>(); cachedEntry && cachedEntry->parts.size() == 3) {
             log(Priority::Important, "network: get resource with id=" + simId + " from download cache");
-            mainData = cachedEntry->content;
-            auxiliaryData = cachedEntry->auxiliaryData;
-            statistics = cachedEntry->statistics;
+            result.mainData = cachedEntry->parts.at(0);
+            result.auxiliaryData = cachedEntry->parts.at(1);
+            result.statistics = cachedEntry->parts.at(2);
+            result.storage = cachedEntry->storage;
             incDownloadCounter(simId);
             return true;
         } else {
             log(Priority::Important, "network: download resource with id=" + simId);
 
-            httplib::SSLClient client(_serverAddress);
-            configureClient(client);
+            auto client = createClient(_serverAddress);
+
+            auto data = std::make_shared<std::array<std::string, 3>>();
+            auto& [mainData, auxiliaryData, statistics] = *data;
 
             httplib::Params params;
             params.emplace("id", simId);
@@ -577,22 +597,29 @@ bool NetworkService::downloadResource(std::string& mainData, std::string& auxili
                 for (int chunkIndex = 0; chunkIndex < 6; ++chunkIndex) {
                     auto paramsClone = params;
                     paramsClone.emplace("chunkIndex", std::to_string(chunkIndex));
-                    auto result = executeRequest([&] { return client.Get("/alien-server/downloadcontent.php", paramsClone, {}); });
-                    if (result->body.empty()) {
+                    auto response = executeRequest([&] { return client.Get("/alien-server/downloadcontent.php", paramsClone, {}); });
+                    if (response->body.empty()) {
                         break;
                     }
-                    mainData.append(result->body);
+                    mainData.append(response->body);
                 }
             }
             {
-                auto result = executeRequest([&] { return client.Get("/alien-server/downloadsettings.php", params, {}); });
-                auxiliaryData = result->body;
+                auto response = executeRequest([&] { return client.Get("/alien-server/downloadsettings.php", params, {}); });
+                auxiliaryData = response->body;
             }
             {
-                auto result = executeRequest([&] { return client.Get("/alien-server/downloadstatistics.php", params, {}); });
-                statistics = result->body;
+                auto response = executeRequest([&] { return client.Get("/alien-server/downloadstatistics.php", params, {}); });
+                statistics = response->body;
+            }
+            if (_downloadCache) {
+                _downloadCache->insertOrAssign(simId, timestamp, {mainData, auxiliaryData, statistics});
             }
-            _downloadCache.insertOrAssign(simId, ResourceData{mainData, auxiliaryData, statistics});
+
+            result.mainData = mainData;
+            result.auxiliaryData = auxiliaryData;
+            result.statistics = statistics;
+            result.storage = data;
             return true;
         }
     } catch (...) {
@@ -606,8 +633,7 @@ void NetworkService::incDownloadCounter(std::string const& simId)
     try {
         log(Priority::Important, "network: increment download counter for resource with id=" + simId);
 
-        httplib::SSLClient client(_serverAddress);
-        configureClient(client);
+        auto client = createClient(_serverAddress);
 
         httplib::Params params;
         params.emplace("id", simId);
@@ -622,8 +648,7 @@ bool NetworkService::editResource(std::string const& simId, std::string const& n
 {
     log(Priority::Important, "network: edit resource with id=" + simId);
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    auto client = createClient(_serverAddress);
 
     httplib::Params params;
     params.emplace("userName", *_loggedInUserName);
@@ -645,8 +670,7 @@ bool NetworkService::moveResource(std::string const& simId, WorkspaceType target
 {
     log(Priority::Important, "network: move resource with id=" + simId + " to other workspace");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    auto client = createClient(_serverAddress);
 
     httplib::Params params;
     params.emplace("userName", *_loggedInUserName);
@@ -667,8 +691,7 @@ bool NetworkService::deleteResource(std::string const& simId)
 {
     log(Priority::Important, "network: delete resource with id=" + simId);
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    auto client = createClient(_serverAddress);
 
     httplib::Params params;
     params.emplace("userName", *_loggedInUserName);
@@ -677,7 +700,13 @@ bool NetworkService::deleteResource(std::string const& simId)
 
     try {
         auto result = executeRequest([&] { return client.Post("/alien-server/deletesimulation.php", params); });
-        return parseBoolResult(result->body);
+        if (!parseBoolResult(result->body)) {
+            return false;
+        }
+        if (_downloadCache) {
+            _downloadCache->remove(simId);
+        }
+        return true;
     } catch (...) {
         logNetworkError();
         return false;
@@ -686,8 +715,7 @@ bool NetworkService::deleteResource(std::string const& simId)
 
 bool NetworkService::appendResourceData(std::string const& resourceId, std::string const& data, int chunkIndex)
 {
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    auto client = createClient(_serverAddress);
 
     httplib::MultipartFormDataItems items = {
         {"userName", *_loggedInUserName, "", ""},
@@ -2,7 +2,7 @@
 
 #include <chrono>
 
-#include "Base/Cache.h"
+#include "Base/DiskCache.h"
 #include "NetworkResourceRawTO.h"
 #include "UserTO.h"
 #include "Definitions.h"
@@ -19,6 +19,15 @@ struct UserInfo
     std::optional<std::string> gpu;
 };
 
+//the data may be memory-mapped from the download cache and remains valid as long as the storage exists
+struct ResourceData
+{
+    std::string_view mainData;
+    std::string_view auxiliaryData;
+    std::string_view statistics;
+    std::shared_ptr<void const> storage;
+};
+
 class NetworkService
 {
 public:
@@ -28,7 +37,9 @@ public:
     static void shutdown();
 
     static std::string getServerAddress();
-    static void setServerAddress(std::string const& value);
+    static void setServerAddress(std::string const& value);  //e.g. "alien-project.org" (HTTPS) or "http://localhost:8080"
+    static std::string getDownloadCacheDirectory();
+    static void setDownloadCacheDirectory(std::string const& value);  //keeps the cache size, the cached entries are not moved; empty value disables the cache
     static std::optional<std::string> getLoggedInUserName();
     static std::optional<std::string> getPassword();
 
@@ -66,7 +77,7 @@ public:
         std::string const& data,
         std::string const& settings,
         std::string const& statistics);
-    static bool downloadResource(std::string& mainData, std::string& auxiliaryData, std::string& statistics, std::string const& simId);
+    static bool downloadResource(ResourceData& result, std::string const& simId, std::string const& timestamp);
         static void incDownloadCounter(std::string const& simId);
     static bool editResource(std::string const& simId, std::string const& newName, std::string const& newDescription);
     static bool moveResource(std::string const& simId, WorkspaceType targetWorkspace);
@@ -79,12 +90,6 @@ private:
     static std::optional<std::string> _loggedInUserName;
     static std::optional<std::string> _password;
     static std::optional<std::chrono::steady_clock::time_point> _lastRefreshTime;
-
-    struct ResourceData
-    {
-        std::string content;
-        std::string auxiliaryData;
-        std::string statistics;
-    };
-    static Cache<std::string, ResourceData, 20> _downloadCache;
+    static std::string _downloadCacheDirectory;
+    static DiskCache _downloadCache;
 };
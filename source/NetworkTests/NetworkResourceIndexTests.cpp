@@ -0,0 +1,253 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+
+#include <imgui.h>
+
+#include <gtest/gtest.h>
+
+#include "Network/NetworkResourceIndex.h"
+#include "Network/NetworkResourceRawTO.h"
+#include "Network/NetworkResourceService.h"
+#include "Network/NetworkResourceTreeTO.h"
+
+class NetworkResourceIndexTests : public ::testing::Test
+{
+protected:
+    NetworkResourceRawTO createRawTO(std::string const& resourceName, std::string const& userName = "user", int numDownloads = 0) const
+    {
+        auto result = std::make_shared<_NetworkResourceRawTO>();
+        result->resourceName = resourceName;
+        result->userName = userName;
+        result->numDownloads = numDownloads;
+        result->width = 0;
+        result->height = 0;
+        result->particles = 0;
+        result->contentSize = 0;
+        result->workspaceType = WorkspaceType_Public;
+        result->resourceType = NetworkResourceType_Simulation;
+        return result;
+    }
+
+    //resources with nested folders and repeating values for sorting
+    std::vector<NetworkResourceRawTO> createRawTOs(int numRawTOs) const
+    {
+        std::mt19937 generator(42);
+        std::vector<NetworkResourceRawTO> result;
+        for (int i = 0; i < numRawTOs; ++i) {
+            std::string resourceName;
+            auto depth = generator() % 4;
+            for (int j = 0; j < depth; ++j) {
+                resourceName += "Folder " + std::to_string(generator() % 5) + "/";
+            }
+            resourceName += "Simulation " + std::to_string(i);
+
+            auto rawTO = createRawTO(resourceName, "User" + std::to_string(generator() % 7), toInt(generator() % 20));
+            rawTO->timestamp = "2024-01-" + std::to_string(10 + generator() % 20);
+            rawTO->description = "Description with Keyword" + std::to_string(generator() % 50);
+            rawTO->width = toInt(generator() % 3) * 1000;
+            rawTO->numLikesByEmojiType[toInt(generator() % 3)] = toInt(generator() % 4);
+            result.emplace_back(rawTO);
+        }
+        return result;
+    }
+
+    ImGuiTableColumnSortSpecs createSortSpec(NetworkResourceColumnId columnId, bool ascending) const
+    {
+        ImGuiTableColumnSortSpecs result;
+        result.ColumnUserID = columnId;
+        result.SortDirection = ascending ? ImGuiSortDirection_Ascending : ImGuiSortDirection_Descending;
+        return result;
+    }
+
+    //sorts and filters the resources without index
+    std::vector<NetworkResourceTreeTO> createExpectedTreeTOs(
+        std::vector<NetworkResourceRawTO> rawTOs,
+        std::vector<ImGuiTableColumnSortSpecs> const& sortSpecs,
+        std::string const& filter,
+        std::set<std::vector<std::string>> const& collapsedFolderNames) const
+    {
+        std::stable_sort(rawTOs.begin(), rawTOs.end(), [&](auto const& left, auto const& right) {
+            return _NetworkResourceRawTO::compare(left, right, sortSpecs) < 0;
+        });
+        std::vector<NetworkResourceRawTO> filteredRawTOs;
+        for (auto const& rawTO : rawTOs) {
+            if (rawTO->matchWithFilter(filter)) {
+                filteredRawTOs.emplace_back(rawTO);
+            }
+        }
+        return NetworkResourceService::createTreeTOs(filteredRawTOs, collapsedFolderNames);
+    }
+
+    std::vector<std::string> getDescriptions(std::vector<NetworkResourceTreeTO> const& treeTOs) const
+    {
+        std::vector<std::string> result;
+        for (auto const& treeTO : treeTOs) {
+            auto description = NetworkResourceService::concatenateFolderName(treeTO->folderNames, true);
+            if (treeTO->isLeaf()) {
+                description += treeTO->getLeaf().leafName;
+            } else {
+                auto const& folder = treeTO->getFolder();
+                description += " (" + std::to_string(folder.numLeafs) + ", " + std::to_string(folder.numReactions) + ")";
+            }
+            description += " ";
+            for (auto const& symbol : treeTO->treeSymbols) {
+                description += std::to_string(static_cast<int>(symbol));
+            }
+            result.emplace_back(description);
+        }
+        return result;
+    }
+};
+
+TEST_F(NetworkResourceIndexTests, sortAndFilter_sameAsWithoutIndex)
+{
+    auto rawTOs = createRawTOs(300);
+    std::vector<std::vector<ImGuiTableColumnSortSpecs>> sortSpecsList = {
+        {},
+        {createSortSpec(NetworkResourceColumnId_Timestamp, false)},
+        {createSortSpec(NetworkResourceColumnId_UserName, true)},
+        {createSortSpec(NetworkResourceColumnId_Likes, false)},
+        {createSortSpec(NetworkResourceColumnId_UserName, false), createSortSpec(NetworkResourceColumnId_Width, true)},
+        {createSortSpec(NetworkResourceColumnId_Width, false),
+         createSortSpec(NetworkResourceColumnId_NumDownloads, true),
+         createSortSpec(NetworkResourceColumnId_Timestamp, false)},
+    };
+    std::vector<std::string> filters = {"", "k", "ke", "KEY", "keyword1", "keyword12", "keyword1", "user3", "2024-01-1", "folder 2", "1000", "xyz", ""};
+    std::set<std::vector<std::string>> collapsedFolderNames = {{"Folder 1"}, {"Folder 2", "Folder 3"}};
+
+    NetworkResourceIndex index;
+    index.setRawTOs(rawTOs);
+    index.setCollapsedFolderNames(collapsedFolderNames);
+    for (auto const& sortSpecs : sortSpecsList) {
+        index.setSortSpecs(sortSpecs);
+        for (auto const& filter : filters) {
+            index.setFilter(filter);
+            EXPECT_EQ(getDescriptions(createExpectedTreeTOs(rawTOs, sortSpecs, filter, collapsedFolderNames)), getDescriptions(index.getTreeTOs()))
+                << "filter: " << filter;
+        }
+    }
+}
+
+TEST_F(NetworkResourceIndexTests, collapseAndExpand_reusesTreeTOs)
+{
+    std::vector<NetworkResourceRawTO> rawTOs = {createRawTO("A/B/C"), createRawTO("A/D"), createRawTO("E")};
+
+    NetworkResourceIndex index;
+    index.setRawTOs(rawTOs);
+    auto expandedTreeTOs = index.getTreeTOs();
+    ASSERT_EQ(5, expandedTreeTOs.size());
+
+    index.setCollapsedFolderNames({{"A", "B"}});
+    auto treeTOs = index.getTreeTOs();
+    ASSERT_EQ(4, treeTOs.size());
+    EXPECT_EQ(expandedTreeTOs.at(0), treeTOs.at(0));
+    EXPECT_EQ(expandedTreeTOs.at(1), treeTOs.at(1));
+    EXPECT_EQ(expandedTreeTOs.at(3), treeTOs.at(2));
+    EXPECT_EQ(expandedTreeTOs.at(4), treeTOs.at(3));
+    EXPECT_EQ(FolderTreeSymbols::Collapsed, treeTOs.at(1)->treeSymbols.back());
+
+    index.setCollapsedFolderNames({{"A"}});
+    treeTOs = index.getTreeTOs();
+    ASSERT_EQ(2, treeTOs.size());
+    EXPECT_EQ(FolderTreeSymbols::Collapsed, treeTOs.at(0)->treeSymbols.back());
+
+    index.setCollapsedFolderNames({});
+    EXPECT_EQ(expandedTreeTOs, index.getTreeTOs());
+    EXPECT_EQ(FolderTreeSymbols::Expanded, expandedTreeTOs.at(0)->treeSymbols.back());
+    EXPECT_EQ(FolderTreeSymbols::Expanded, expandedTreeTOs.at(1)->treeSymbols.back());
+}
+
+TEST_F(NetworkResourceIndexTests, folderCounts)
+{
+    std::vector<NetworkResourceRawTO> rawTOs = {createRawTO("A/B/C"), createRawTO("A/D"), createRawTO("A/B/F"), createRawTO("G")};
+    rawTOs.at(0)->numLikesByEmojiType = {{0, 2}, {1, 1}};
+    rawTOs.at(1)->numLikesByEmojiType = {{0, 4}};
+
+    NetworkResourceIndex index;
+    index.setRawTOs(rawTOs);
+    auto treeTOs = index.getTreeTOs();
+    ASSERT_EQ(6, treeTOs.size());
+    EXPECT_EQ(3, treeTOs.at(0)->getFolder().numLeafs);
+    EXPECT_EQ(7, treeTOs.at(0)->getFolder().numReactions);
+    EXPECT_EQ(2, treeTOs.at(1)->getFolder().numLeafs);
+    EXPECT_EQ(3, treeTOs.at(1)->getFolder().numReactions);
+}
+
+TEST_F(NetworkResourceIndexTests, invalidateValues)
+{
+    std::vector<NetworkResourceRawTO> rawTOs = {createRawTO("A", "user", 5), createRawTO("B", "user", 7)};
+
+    NetworkResourceIndex index;
+    index.setRawTOs(rawTOs);
+    index.setSortSpecs({createSortSpec(NetworkResourceColumnId_NumDownloads, true)});
+    index.setFilter("6");
+    EXPECT_TRUE(index.getTreeTOs().empty());
+
+    rawTOs.at(1)->numDownloads = 6;
+    EXPECT_TRUE(index.getTreeTOs().empty());
+
+    index.invalidateValues();
+    ASSERT_EQ(1, index.getTreeTOs().size());
+
+    index.setFilter("");
+    rawTOs.at(0)->numDownloads = 10;
+    index.invalidateValues();
+    auto treeTOs = index.getTreeTOs();
+    ASSERT_EQ(2, treeTOs.size());
+    EXPECT_EQ(std::string("B"), treeTOs.at(0)->getLeaf().leafName);
+}
+
+TEST_F(NetworkResourceIndexTests, getMatchingRawTOs_unfiltered)
+{
+    std::vector<NetworkResourceRawTO> rawTOs = {createRawTO("A/B/C", "user1"), createRawTO("A/D", "user2"), createRawTO("E", "user1")};
+
+    NetworkResourceIndex index;
+    index.setRawTOs(rawTOs);
+    index.setFilter("user1");
+    auto treeTOs = index.getTreeTOs();
+    ASSERT_EQ(4, treeTOs.size());
+
+    EXPECT_EQ(std::vector({rawTOs.at(0), rawTOs.at(1)}), index.getMatchingRawTOs(treeTOs.at(0)));
+    EXPECT_EQ(std::vector({rawTOs.at(0)}), index.getMatchingRawTOs(treeTOs.at(1)));
+    EXPECT_EQ(std::vector({rawTOs.at(2)}), index.getMatchingRawTOs(treeTOs.at(3)));
+    EXPECT_EQ((std::set<std::vector<std::string>>{{"A"}, {"A", "B"}}), index.getFolderNames(1));
+}
+
+TEST_F(NetworkResourceIndexTests, benchmark_filterSortCollapse)
+{
+    auto rawTOs = createRawTOs(10000);
+    auto sortSpecs = std::vector{createSortSpec(NetworkResourceColumnId_Timestamp, false)};
+    std::vector<std::string> filters = {"k", "ke", "key", "keyw", "keywo", "keywor", "keyword", "keyword2"};
+    std::set<std::vector<std::string>> collapsedFolderNames = {{"Folder 1"}};
+
+    auto measure = [](auto const& function) {
+        auto startTimepoint = std::chrono::steady_clock::now();
+        function();
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimepoint).count();
+    };
+    auto withoutIndexDuration = measure([&] {
+        for (auto const& filter : filters) {
+            createExpectedTreeTOs(rawTOs, sortSpecs, filter, collapsedFolderNames);
+        }
+        createExpectedTreeTOs(rawTOs, sortSpecs, filters.back(), {});
+    });
+
+    NetworkResourceIndex index;
+    index.setRawTOs(rawTOs);
+    index.setSortSpecs(sortSpecs);
+    index.setCollapsedFolderNames(collapsedFolderNames);
+    index.getTreeTOs();
+    auto withIndexDuration = measure([&] {
+        for (auto const& filter : filters) {
+            index.setFilter(filter);
+            index.getTreeTOs();
+        }
+        index.setCollapsedFolderNames({});
+        index.getTreeTOs();
+    });
+
+    std::cout << rawTOs.size() << " resources, " << filters.size() << " filter changes and one collapse change: without index " << withoutIndexDuration
+              << " us, with index " << withIndexDuration << " us" << std::endl;
+}
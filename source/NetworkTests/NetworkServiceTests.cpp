@@ -0,0 +1,85 @@
+#include <atomic>
+#include <filesystem>
+#include <thread>
+
+#define CPPHTTPLIB_OPENSSL_SUPPORT
+#include <cpp-httplib/httplib.h>
+
+#include <gtest/gtest.h>
+
+#include "Network/NetworkService.h"
+
+//runs the requests against a local plain HTTP server
+class NetworkServiceTests : public ::testing::Test
+{
+public:
+    NetworkServiceTests()
+    {
+        std::filesystem::remove_all(_cacheDirectory);
+        _origDownloadCacheDirectory = NetworkService::getDownloadCacheDirectory();
+        NetworkService::setDownloadCacheDirectory(_cacheDirectory.string());
+
+        _server.Get("/alien-server/downloadcontent.php", [this](httplib::Request const& request, httplib::Response& response) {
+            ++_numContentRequests;
+            response.set_content(request.get_param_value("chunkIndex") == "0" ? "content of " + request.get_param_value("id") : "", "text/plain");
+        });
+        _server.Get("/alien-server/downloadsettings.php", [](httplib::Request const& request, httplib::Response& response) {
+            response.set_content("settings", "text/plain");
+        });
+        _server.Get("/alien-server/downloadstatistics.php", [](httplib::Request const& request, httplib::Response& response) {
+            response.set_content("statistics", "text/plain");
+        });
+        _server.Get("/alien-server/incdownloadcount.php", [this](httplib::Request const& request, httplib::Response& response) {
+            ++_numIncDownloadCountRequests;
+            response.set_content("{\"result\": true}", "application/json");
+        });
+        auto port = _server.bind_to_any_port("127.0.0.1");
+        _serverThread = std::thread([this] { _server.listen_after_bind(); });
+
+        _origServerAddress = NetworkService::getServerAddress();
+        NetworkService::setServerAddress("http://127.0.0.1:" + std::to_string(port));
+    }
+
+    ~NetworkServiceTests()
+    {
+        NetworkService::setServerAddress(_origServerAddress);
+        NetworkService::setDownloadCacheDirectory(_origDownloadCacheDirectory);
+        _server.stop();
+        _serverThread.join();
+        std::filesystem::remove_all(_cacheDirectory);
+    }
+
+protected:
+    std::filesystem::path _cacheDirectory = std::filesystem::temp_directory_path() / "alien network service tests";
+    httplib::Server _server;
+    std::thread _serverThread;
+    std::string _origServerAddress;
+    std::string _origDownloadCacheDirectory;
+    std::atomic<int> _numContentRequests = 0;
+    std::atomic<int> _numIncDownloadCountRequests = 0;
+};
+
+TEST_F(NetworkServiceTests, downloadResource)
+{
+    ResourceData data;
+    ASSERT_TRUE(NetworkService::downloadResource(data, "id1", "2024-01-01"));
+    EXPECT_EQ("content of id1", data.mainData);
+    EXPECT_EQ("settings", data.auxiliaryData);
+    EXPECT_EQ("statistics", data.statistics);
+    EXPECT_EQ(2, _numContentRequests.load());  //second chunk is empty
+}
+
+TEST_F(NetworkServiceTests, downloadResource_fromCache)
+{
+    ResourceData data;
+    ASSERT_TRUE(NetworkService::downloadResource(data, "id1", "2024-01-01"));
+    ASSERT_TRUE(NetworkService::downloadResource(data, "id1", "2024-01-01"));
+    EXPECT_EQ("content of id1", data.mainData);
+    EXPECT_EQ("settings", data.auxiliaryData);
+    EXPECT_EQ(2, _numContentRequests.load());
+    EXPECT_EQ(1, _numIncDownloadCountRequests.load());
+
+    //a new timestamp invalidates the cached entry
+    ASSERT_TRUE(NetworkService::downloadResource(data, "id1", "2024-02-01"));
+    EXPECT_EQ(4, _numContentRequests.load());
+}